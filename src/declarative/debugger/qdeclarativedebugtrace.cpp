@@ -41,12 +41,17 @@
 
 #include "qdeclarativedebugtrace_p.h"
 
+#include <QtCore/qatomic.h>
 #include <QtCore/qdatastream.h>
 #include <QtCore/qurl.h>
 #include <QtCore/qtimer.h>
 
 Q_GLOBAL_STATIC(QDeclarativeDebugTrace, traceInstance);
 
+// Whether a client is connected and tracing.  Written in the GUI thread, and read by
+// isEnabled() from any thread without touching the trace service itself.
+static QAtomicInt traceEnabled(0);
+
 // convert to a QByteArray that can be sent to the debug client
 // use of QDataStream can skew results if m_deferredSend == false
 //     (see tst_qdeclarativedebugtrace::trace() benchmark)
@@ -60,6 +65,11 @@ QByteArray QDeclarativeDebugData::toByteArray() const
         ds << detailData;
     if (messageType == (int)QDeclarativeDebugTrace::RangeLocation)
         ds << detailData << line;
+    if (messageType == (int)QDeclarativeDebugTrace::Event
+            && detailType == (int)QDeclarativeDebugTrace::SceneGraphFrame) {
+        for (int i = 0; i < frameData.size(); ++i)
+            ds << frameData.at(i);
+    }
     return data;
 }
 
@@ -75,12 +85,32 @@ QDeclarativeDebugTrace::QDeclarativeDebugTrace()
     }
 }
 
+/*
+    Returns true if a client is connected and has asked for tracing to be enabled, so
+    that callers can avoid gathering data which would be dropped
+*/
+bool QDeclarativeDebugTrace::isEnabled()
+{
+    return QDeclarativeDebugService::isDebuggingEnabled() && int(traceEnabled) != 0;
+}
+
 void QDeclarativeDebugTrace::addEvent(EventType t)
 {
     if (QDeclarativeDebugService::isDebuggingEnabled()) 
         traceInstance()->addEventImpl(t);
 }
 
+/*
+    Records the timings and counts of a scene graph frame, indexed by SceneGraphFrameValue.
+    May be called from the render thread.
+*/
+void QDeclarativeDebugTrace::sceneGraphFrame(const QVector<qint64> &values)
+{
+    // Only reached once tracing is enabled, so the service already exists
+    if (isEnabled())
+        traceInstance()->sceneGraphFrameImpl(values);
+}
+
 void QDeclarativeDebugTrace::startRange(RangeType t)
 {
     if (QDeclarativeDebugService::isDebuggingEnabled()) 
@@ -126,6 +156,15 @@ void QDeclarativeDebugTrace::addEventImpl(EventType event)
     processMessage(ed);
 }
 
+void QDeclarativeDebugTrace::sceneGraphFrameImpl(const QVector<qint64> &values)
+{
+    if (status() != Enabled || !m_enabled)
+        return;
+
+    QDeclarativeDebugData ed = {m_timer.nsecsElapsed(), (int)Event, (int)SceneGraphFrame, QString(), -1, values};
+    processMessage(ed);
+}
+
 void QDeclarativeDebugTrace::startRangeImpl(RangeType range)
 {
     if (status() != Enabled || !m_enabled)
@@ -186,9 +225,11 @@ void QDeclarativeDebugTrace::endRangeImpl(RangeType range)
 */
 void QDeclarativeDebugTrace::processMessage(const QDeclarativeDebugData &message)
 {
-    if (m_deferredSend)
+    if (m_deferredSend) {
+        // Scene graph frames are recorded from the render thread
+        QMutexLocker locker(&m_dataMutex);
         m_data.append(message);
-    else
+    } else
         sendMessage(message.toByteArray());
 }
 
@@ -198,10 +239,16 @@ void QDeclarativeDebugTrace::processMessage(const QDeclarativeDebugData &message
 void QDeclarativeDebugTrace::sendMessages()
 {
     if (m_deferredSend) {
+        QList<QDeclarativeDebugData> messages;
+        {
+            QMutexLocker locker(&m_dataMutex);
+            messages = m_data;
+            m_data.clear();
+        }
+
         //### this is a suboptimal way to send batched messages
-        for (int i = 0; i < m_data.count(); ++i)
-            sendMessage(m_data.at(i).toByteArray());
-        m_data.clear();
+        for (int i = 0; i < messages.count(); ++i)
+            sendMessage(messages.at(i).toByteArray());
 
         //indicate completion
         QByteArray data;
@@ -219,7 +266,18 @@ void QDeclarativeDebugTrace::messageReceived(const QByteArray &message)
     stream >> m_enabled;
 
     m_messageReceived = true;
+    updateEnabled();
 
     if (!m_enabled)
         sendMessages();
 }
+
+void QDeclarativeDebugTrace::statusChanged(Status)
+{
+    updateEnabled();
+}
+
+void QDeclarativeDebugTrace::updateEnabled()
+{
+    traceEnabled.fetchAndStoreOrdered(status() == Enabled && m_enabled ? 1 : 0);
+}
@@ -44,6 +44,8 @@
 
 #include <private/qdeclarativedebugservice_p.h>
 #include <QtCore/qelapsedtimer.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qvector.h>
 
 QT_BEGIN_HEADER
 
@@ -58,6 +60,7 @@ struct QDeclarativeDebugData
     //###
     QString detailData; //used by RangeData and RangeLocation
     int line;           //used by RangeLocation
+    QVector<qint64> frameData; //used by SceneGraphFrame events
 
     QByteArray toByteArray() const;
 };
@@ -81,10 +84,28 @@ public:
         FramePaint,
         Mouse,
         Key,
+        SceneGraphFrame,
 
         MaximumEventType
     };
 
+    // Values sent with a SceneGraphFrame event, times are in nanoseconds
+    enum SceneGraphFrameValue {
+        SceneGraphPolishTime,
+        SceneGraphSyncTime,
+        SceneGraphPreprocessTime,
+        SceneGraphUpdateTime,
+        SceneGraphBuildListsTime,
+        SceneGraphSortTime,
+        SceneGraphDrawTime,
+        SceneGraphSwapTime,
+        SceneGraphGeometryNodes,
+        SceneGraphMaterialChanges,
+        SceneGraphDrawCalls,
+
+        MaximumSceneGraphFrameValue
+    };
+
     enum RangeType {
         Painting,
         Compiling,
@@ -95,7 +116,10 @@ public:
         MaximumRangeType
     };
 
+    static bool isEnabled();
+
     static void addEvent(EventType);
+    static void sceneGraphFrame(const QVector<qint64> &values);
 
     static void startRange(RangeType);
     static void rangeData(RangeType, const QString &);
@@ -106,9 +130,12 @@ public:
 
     QDeclarativeDebugTrace();
 protected:
+    virtual void statusChanged(Status);
     virtual void messageReceived(const QByteArray &);
 private:
+    void updateEnabled();
     void addEventImpl(EventType);
+    void sceneGraphFrameImpl(const QVector<qint64> &values);
     void startRangeImpl(RangeType);
     void rangeDataImpl(RangeType, const QString &);
     void rangeDataImpl(RangeType, const QUrl &);
@@ -121,6 +148,7 @@ private:
     bool m_enabled;
     bool m_deferredSend;
     bool m_messageReceived;
+    QMutex m_dataMutex;
     QList<QDeclarativeDebugData> m_data;
 };
 
@@ -39,25 +39,104 @@
 **
 ****************************************************************************/
 
+#include <QtGui/qfontdatabase.h>
 #include <QtGui/qpainter.h>
 
 #include "private/qsgadaptationlayer_p.h"
 #include "qsgcanvasitem_p.h"
 #include "qsgpainteditem_p.h"
 #include "qsgcontext2d_p.h"
+#include "qsgcontext2d_p_p.h"
 #include "private/qsgpainternode_p.h"
 #include <qdeclarativeinfo.h>
 #include "qdeclarativeengine_p.h"
+#include <private/qdeclarativeglobal_p.h>
 #include <QtCore/QBuffer>
+#include <QtCore/QThread>
 
 QT_BEGIN_NAMESPACE
 
+DEFINE_BOOL_CONFIG_OPTION(qmlNoThreadedCanvas, QML_NO_THREADED_CANVAS)
+
+/*
+    Replays the command buffers of a canvas item on a background thread.
+
+    The thread keeps a retained raster of the whole canvas. Each job repaints only
+    the requested region of it, which is then copied into the front image under the
+    lock. The render thread copies from the front image when the paint node asks for
+    the dirty region, so JavaScript drawing, rasterization and rendering all overlap.
+*/
+class QSGCanvasItemPainter : public QThread
+{
+public:
+    struct Job {
+        QSGContext2DCommandBuffer *buffer;
+        QRegion region;
+        QSize size;
+        QColor fillColor;
+        QPointF canvasPos;
+        QSizeF itemSize;
+        qreal contentsScale;
+        bool antialiasing;
+    };
+
+    QSGCanvasItemPainter(QSGCanvasItem *item)
+        : canvasItem(item)
+        , notifyPending(false)
+        , shouldExit(false)
+    {
+    }
+
+    ~QSGCanvasItemPainter()
+    {
+        mutex.lock();
+        shouldExit = true;
+        condition.wakeOne();
+        mutex.unlock();
+        wait();
+
+        foreach (const Job &job, jobs)
+            delete job.buffer;
+        qDeleteAll(finishedBuffers);
+    }
+
+    void submit(const Job &job)
+    {
+        QMutexLocker locker(&mutex);
+        jobs.append(job);
+        condition.wakeOne();
+    }
+
+    void run();
+
+    QSGCanvasItem *canvasItem;
+
+    QMutex mutex;
+    QWaitCondition condition;
+    QList<Job> jobs;
+    bool notifyPending;
+    bool shouldExit;
+
+    // Guarded by the mutex
+    QImage front;
+    QRegion readyRegion;
+    QList<QSGContext2DCommandBuffer *> finishedBuffers;
+
+private:
+    static void resizeImage(QImage *image, const QSize &size);
+    void paint(const Job &job);
+
+    // Only touched by the painting thread
+    QImage back;
+};
+
 class QSGCanvasItemPrivate : public QSGPaintedItemPrivate
 {
 public:
     QSGCanvasItemPrivate();
     ~QSGCanvasItemPrivate();
     QSGContext2D* context;
+    QSGCanvasItemPainter *painter;
     QList<QRect> dirtyRegions;
     QRect unitedDirtyRegion;
     qreal canvasX;
@@ -71,6 +150,7 @@ public:
 QSGCanvasItemPrivate::QSGCanvasItemPrivate()
     : QSGPaintedItemPrivate()
     , context(0)
+    , painter(0)
     , unitedDirtyRegion()
     , canvasX(0.)
     , canvasY(0.)
@@ -81,6 +161,81 @@ QSGCanvasItemPrivate::~QSGCanvasItemPrivate()
 {
 }
 
+void QSGCanvasItemPainter::resizeImage(QImage *image, const QSize &size)
+{
+    if (image->size() == size)
+        return;
+
+    QImage resized(size, QImage::Format_ARGB32_Premultiplied);
+    resized.fill(0);
+    if (!image->isNull()) {
+        QPainter p(&resized);
+        p.setCompositionMode(QPainter::CompositionMode_Source);
+        p.drawImage(0, 0, *image);
+    }
+    *image = resized;
+}
+
+void QSGCanvasItemPainter::run()
+{
+    mutex.lock();
+    while (!shouldExit) {
+        if (jobs.isEmpty()) {
+            condition.wait(&mutex);
+            continue;
+        }
+
+        Job job = jobs.takeFirst();
+        mutex.unlock();
+
+        paint(job);
+
+        mutex.lock();
+        resizeImage(&front, job.size);
+        {
+            QPainter p(&front);
+            p.setClipRegion(job.region);
+            p.setCompositionMode(QPainter::CompositionMode_Source);
+            p.drawImage(0, 0, back);
+        }
+        readyRegion |= job.region;
+        finishedBuffers.append(job.buffer);
+
+        if (!notifyPending) {
+            notifyPending = true;
+            QMetaObject::invokeMethod(canvasItem, "paintingFinished", Qt::QueuedConnection);
+        }
+    }
+    mutex.unlock();
+}
+
+/*
+    Paints a job into the back image the same way QSGPainterNode and QSGCanvasItem::paint()
+    would have painted it on the render thread, clipped to the job's region.
+*/
+void QSGCanvasItemPainter::paint(const Job &job)
+{
+    resizeImage(&back, job.size);
+
+    QPainter p(&back);
+    if (job.antialiasing) {
+        p.setRenderHints(QPainter::Antialiasing | QPainter::HighQualityAntialiasing
+                         | QPainter::TextAntialiasing | QPainter::SmoothPixmapTransform);
+    }
+
+    p.setClipRegion(job.region);
+    p.setCompositionMode(QPainter::CompositionMode_Source);
+    p.fillRect(job.region.boundingRect(), job.fillColor);
+    p.setCompositionMode(QPainter::CompositionMode_SourceOver);
+
+    p.scale(job.contentsScale, job.contentsScale);
+    p.setWindow(-job.canvasPos.x(), -job.canvasPos.y(), job.itemSize.width(), job.itemSize.height());
+    p.setViewport(0, 0, job.itemSize.width(), job.itemSize.height());
+    p.scale(job.contentsScale, job.contentsScale);
+
+    job.buffer->replay(&p);
+}
+
 
 void QSGCanvasItem::setCanvasX(qreal x)
 {
@@ -128,11 +283,26 @@ QSGCanvasItem::QSGCanvasItem(QSGItem *parent)
 */
 QSGCanvasItem::~QSGCanvasItem()
 {
+    Q_D(QSGCanvasItem);
+    delete d->painter;
 }
 
 void QSGCanvasItem::paint(QPainter *painter)
 {
     Q_D(QSGCanvasItem);
+    if (d->painter) {
+        // The painting thread has already rasterized the contents, only copy them
+        QMutexLocker locker(&d->painter->mutex);
+        if (!d->painter->front.isNull()) {
+            painter->save();
+            painter->resetTransform();
+            painter->setCompositionMode(QPainter::CompositionMode_Source);
+            painter->drawImage(0, 0, d->painter->front);
+            painter->restore();
+        }
+        return;
+    }
+
     if (d->context && d->context->isDirty()) {
         painter->setWindow(-d->canvasX, -d->canvasY, d->width, d->height);
         painter->setViewport(0, 0, d->width, d->height);
@@ -167,6 +337,13 @@ void QSGCanvasItem::createContext()
 
     d->context = new QSGContext2D(this);
 
+    // Text is replayed too, so the painting thread is only used where fonts can be
+    // rendered outside the GUI thread.  Otherwise paint() replays the commands.
+    if (!d->painter && !qmlNoThreadedCanvas() && QFontDatabase::supportsThreadedFontRendering()) {
+        d->painter = new QSGCanvasItemPainter(this);
+        d->painter->start();
+    }
+
     QV8Engine *e = QDeclarativeEnginePrivate::getV8Engine(qmlEngine(this));
     d->context->setV8Engine(e);
 }
@@ -199,7 +376,9 @@ void QSGCanvasItem::requestPaint(const QRect& r)
     d->unitedDirtyRegion = d->unitedDirtyRegion.unite(region);
     d->dirtyRegions.append(region);
     polish();
-    update(d->unitedDirtyRegion);
+    // With a painting thread the item is updated once the region has been painted
+    if (!d->painter)
+        update(d->unitedDirtyRegion);
 }
 
 bool QSGCanvasItem::save(const QString &filename) const
@@ -223,16 +402,71 @@ void QSGCanvasItem::updatePolish()
    // d->context->setTileRect(QRectF(d->canvasX, d->canvasY, d->width, d->height).intersected(QRectF(0, 0, d->width, d->height)));
    // d->context->setTileRect(QRectF(d->canvasX, d->canvasY, d->width, d->height));
 
+    QRegion dirty;
     foreach (const QRect& region, d->dirtyRegions) {
         emit paint(context, region);
+        dirty |= region;
     }
     d->dirtyRegions.clear();
+    d->unitedDirtyRegion = QRect();
 
     d->context->setValid(false);
 
+    if (d->painter) {
+        QSGContext2DPrivate *contextPrivate = static_cast<QSGContext2DPrivate *>(QObjectPrivate::get(d->context));
+        if (!contextPrivate->commands.isEmpty() && !dirty.isEmpty()) {
+            QRectF br = contentsBoundingRect();
+
+            QSGCanvasItemPainter::Job job;
+            job.buffer = new QSGContext2DCommandBuffer;
+            contextPrivate->takeCommands(job.buffer);
+            job.region = dirty;
+            job.size = QSize(qRound(br.width()), qRound(br.height()));
+            job.fillColor = fillColor();
+            job.canvasPos = QPointF(d->canvasX, d->canvasY);
+            job.itemSize = QSizeF(d->width, d->height);
+            job.contentsScale = d->contentsScale;
+            job.antialiasing = antialiasing();
+            d->painter->submit(job);
+        }
+    }
+
     QSGPaintedItem::updatePolish();
 }
 
+/*
+    Called on the GUI thread when the painting thread has finished one or more jobs.
+*/
+void QSGCanvasItem::paintingFinished()
+{
+    Q_D(QSGCanvasItem);
+    if (!d->painter)
+        return;
+
+    QRegion region;
+    QList<QSGContext2DCommandBuffer *> buffers;
+    {
+        QMutexLocker locker(&d->painter->mutex);
+        region = d->painter->readyRegion;
+        d->painter->readyRegion = QRegion();
+        buffers = d->painter->finishedBuffers;
+        d->painter->finishedBuffers.clear();
+        d->painter->notifyPending = false;
+    }
+
+    if (d->context) {
+        QSGContext2DPrivate *contextPrivate = static_cast<QSGContext2DPrivate *>(QObjectPrivate::get(d->context));
+        foreach (QSGContext2DCommandBuffer *buffer, buffers)
+            contextPrivate->imageData << buffer->imageData;
+    }
+    qDeleteAll(buffers);
+
+    if (!region.isEmpty()) {
+        update(region.boundingRect());
+        emit painted();
+    }
+}
+
 QString QSGCanvasItem::toDataURL(const QString& mimeType) const
 {
     Q_D(const QSGCanvasItem);
@@ -89,6 +89,8 @@ protected:
     void updatePolish();
     void paint(QPainter *painter);
     virtual void componentComplete();
+private Q_SLOTS:
+    void paintingFinished();
 private:
     void createContext();
     Q_DECLARE_PRIVATE(QSGCanvasItem)
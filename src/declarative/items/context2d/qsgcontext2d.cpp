@@ -45,6 +45,7 @@
 #include "qsgcanvasitem_p.h"
 #include <QtOpenGL/qglframebufferobject.h>
 #include <QtCore/qdebug.h>
+#include <QtCore/qhash.h>
 #include "private/qsgcontext_p.h"
 
 #include <QtGui/qgraphicsitem.h>
@@ -1292,7 +1293,7 @@ static v8::Handle<v8::Value> ctx2d_putImageData(const v8::Arguments &args)
     return v8::Undefined();
 }
 
-bool QSGContext2DPrivate::hasShadow() const
+bool QSGContext2DCommandBuffer::hasShadow() const
 {
     return state.shadowColor.isValid()
         && state.shadowColor.alpha()
@@ -1307,10 +1308,10 @@ void QSGContext2DPrivate::clearShadow()
     state.shadowColor = QColor();
 }
 
-QImage QSGContext2DPrivate::makeShadowImage(const QPixmap& pix)
+QImage QSGContext2DCommandBuffer::makeShadowImage(const QImage& img)
 {
-    QImage shadowImg(pix.width() + state.shadowBlur * 2 + qAbs(state.shadowOffsetX),
-                     pix.height() + state.shadowBlur *2 + qAbs(state.shadowOffsetY),
+    QImage shadowImg(img.width() + state.shadowBlur * 2 + qAbs(state.shadowOffsetX),
+                     img.height() + state.shadowBlur *2 + qAbs(state.shadowOffsetY),
                      QImage::Format_ARGB32);
     shadowImg.fill(0);
     QPainter tmpPainter(&shadowImg);
@@ -1318,7 +1319,7 @@ QImage QSGContext2DPrivate::makeShadowImage(const QPixmap& pix)
     qreal shadowX = state.shadowOffsetX > 0? state.shadowOffsetX : 0;
     qreal shadowY = state.shadowOffsetY > 0? state.shadowOffsetY : 0;
 
-    tmpPainter.drawPixmap(shadowX, shadowY, pix);
+    tmpPainter.drawImage(QPointF(shadowX, shadowY), img);
     tmpPainter.end();
 
     // blur the alpha channel
@@ -1339,7 +1340,7 @@ QImage QSGContext2DPrivate::makeShadowImage(const QPixmap& pix)
     return shadowImg;
 }
 
-void QSGContext2DPrivate::fillRectShadow(QPainter* p, QRectF shadowRect)
+void QSGContext2DCommandBuffer::fillRectShadow(QPainter* p, QRectF shadowRect)
 {
     QRectF r = shadowRect;
     r.moveTo(0, 0);
@@ -1349,7 +1350,7 @@ void QSGContext2DPrivate::fillRectShadow(QPainter* p, QRectF shadowRect)
     tp.begin(&shadowImage);
     tp.fillRect(r, p->brush());
     tp.end();
-    shadowImage = makeShadowImage(QPixmap::fromImage(shadowImage));
+    shadowImage = makeShadowImage(shadowImage);
 
     qreal dx = shadowRect.left() + (state.shadowOffsetX < 0? state.shadowOffsetX:0);
     qreal dy = shadowRect.top() + (state.shadowOffsetY < 0? state.shadowOffsetY:0);
@@ -1358,7 +1359,7 @@ void QSGContext2DPrivate::fillRectShadow(QPainter* p, QRectF shadowRect)
     p->fillRect(shadowRect, p->brush());
 }
 
-void QSGContext2DPrivate::fillShadowPath(QPainter* p, const QPainterPath& path)
+void QSGContext2DCommandBuffer::fillShadowPath(QPainter* p, const QPainterPath& path)
 {
     QRectF r = path.boundingRect();
     QImage img(r.size().width() + r.left() + 1,
@@ -1369,7 +1370,7 @@ void QSGContext2DPrivate::fillShadowPath(QPainter* p, const QPainterPath& path)
     tp.fillPath(path.translated(0, 0), p->brush());
     tp.end();
 
-    QImage shadowImage = makeShadowImage(QPixmap::fromImage(img));
+    QImage shadowImage = makeShadowImage(img);
     qreal dx = r.left() + (state.shadowOffsetX < 0? state.shadowOffsetX:0);
     qreal dy = r.top() + (state.shadowOffsetY < 0? state.shadowOffsetY:0);
 
@@ -1377,7 +1378,7 @@ void QSGContext2DPrivate::fillShadowPath(QPainter* p, const QPainterPath& path)
     p->fillPath(path, p->brush());
 }
 
-void QSGContext2DPrivate::strokeShadowPath(QPainter* p, const QPainterPath& path)
+void QSGContext2DCommandBuffer::strokeShadowPath(QPainter* p, const QPainterPath& path)
 {
     QRectF r = path.boundingRect();
     QImage img(r.size().width() + r.left() + 1,
@@ -1388,7 +1389,7 @@ void QSGContext2DPrivate::strokeShadowPath(QPainter* p, const QPainterPath& path
     tp.strokePath(path, p->pen());
     tp.end();
 
-    QImage shadowImage = makeShadowImage(QPixmap::fromImage(img));
+    QImage shadowImage = makeShadowImage(img);
     qreal dx = r.left() + (state.shadowOffsetX < 0? state.shadowOffsetX:0);
     qreal dy = r.top() + (state.shadowOffsetY < 0? state.shadowOffsetY:0);
     p->drawImage(dx, dy, shadowImage);
@@ -1999,7 +2000,7 @@ void QSGContext2DPrivate::strokeText( const QString&  text, qreal x, qreal y)
 void QSGContext2DPrivate::drawImage(const QString& url, qreal dx, qreal dy)
 {
     commands.push_back(QSGContext2D::DrawImage1);
-    strings.push_back(url);
+    imageUrls.push_back(url);
     reals.push_back(dx);
     reals.push_back(dy);
 }
@@ -2007,7 +2008,7 @@ void QSGContext2DPrivate::drawImage(const QString& url, qreal dx, qreal dy)
 void QSGContext2DPrivate::drawImage(const QString& url, qreal dx, qreal dy, qreal dw, qreal dh)
 {
     commands.push_back(QSGContext2D::DrawImage2);
-    strings.push_back(url);
+    imageUrls.push_back(url);
     reals.push_back(dx);
     reals.push_back(dy);
     reals.push_back(dw);
@@ -2017,7 +2018,7 @@ void QSGContext2DPrivate::drawImage(const QString& url, qreal dx, qreal dy, qrea
 void QSGContext2DPrivate::drawImage(const QString& url, qreal sx, qreal sy, qreal sw, qreal sh, qreal dx, qreal dy, qreal dw, qreal dh)
 {
     commands.push_back(QSGContext2D::DrawImage3);
-    strings.push_back(url);
+    imageUrls.push_back(url);
     reals.push_back(sx);
     reals.push_back(sy);
     reals.push_back(sw);
@@ -2028,6 +2029,13 @@ void QSGContext2DPrivate::drawImage(const QString& url, qreal sx, qreal sy, qrea
     reals.push_back(dh);
 }
 
+/*
+    The pixels are only read when the GetImageData command is replayed, so the returned
+    list holds the data of requests that have already been painted. With a painting
+    thread they arrive once the canvas item has collected the finished buffers, rather
+    than during the next scene graph sync. A WorkerScript context still blocks in
+    QSGContext2D::event() until the data has been delivered.
+*/
 QList<int> QSGContext2DPrivate::getImageData(qreal sx, qreal sy, qreal sw, qreal sh)
 {
     Q_Q(QSGContext2D);
@@ -2463,6 +2471,44 @@ int QSGContext2DPrivate::textAlignOffset(QSGContext2D::TextAlignType value, cons
     return offset;
 }
 
+/*
+    Moves the recorded commands into \a buffer, leaving the context ready to record
+    the next batch. Must be called on the GUI thread, or while it is blocked in a
+    scene graph sync, because the drawImage() urls are resolved through the pixmap
+    cache here. The buffer only carries the resulting QImages.
+*/
+void QSGContext2DPrivate::takeCommands(QSGContext2DCommandBuffer *buffer)
+{
+    QDeclarativeEngine *engine = canvas ? qmlEngine(canvas) : 0;
+    QHash<QString, QImage> resolved;
+    buffer->drawImages.reserve(imageUrls.size());
+    foreach (const QString &url, imageUrls) {
+        QHash<QString, QImage>::const_iterator it = resolved.constFind(url);
+        if (it == resolved.constEnd()) {
+            QDeclarativePixmap px(engine, QUrl(url));
+            it = resolved.insert(url, px.isReady() ? px.pixmap().toImage() : QImage());
+        }
+        buffer->drawImages.append(*it);
+    }
+
+    qSwap(buffer->commands, commands);
+    qSwap(buffer->variants, variants);
+    qSwap(buffer->ints, ints);
+    qSwap(buffer->reals, reals);
+    qSwap(buffer->strings, strings);
+    qSwap(buffer->colors, colors);
+    qSwap(buffer->matrixes, matrixes);
+    qSwap(buffer->pens, pens);
+    qSwap(buffer->brushes, brushes);
+    qSwap(buffer->pathes, pathes);
+    qSwap(buffer->fonts, fonts);
+    qSwap(buffer->images, images);
+    qSwap(buffer->sizes, sizes);
+    clearCommands();
+
+    buffer->state = state;
+}
+
 void QSGContext2D::fillText(const QString &text, qreal x, qreal y)
 {
     Q_D(QSGContext2D);
@@ -3437,6 +3483,7 @@ bool QSGContext2D::event(QEvent *e)
         copy_vector<QPainterPath>(&origin_d->pathes, d->pathes);
         copy_vector<QFont>(&origin_d->fonts, d->fonts);
         copy_vector<QImage>(&origin_d->images, d->images);
+        copy_vector<QString>(&origin_d->imageUrls, d->imageUrls);
         origin_d->state = d->state;
         d->clearCommands();
 
@@ -3665,132 +3712,130 @@ void QSGContext2D::processCommand(const QJSValue& cmd)
     }
 }
 
-void QSGContext2D::paint(QPainter* p)
+void QSGContext2DCommandBuffer::replay(QPainter* p)
 {
-    Q_D(QSGContext2D);
-
     QMatrix originMatrix = p->matrix();
-    if (!d->commands.isEmpty()) {
+    if (!commands.isEmpty()) {
         int matrix_idx, real_idx, int_idx, variant_idx, string_idx,color_idx,cmd_idx,
-            pen_idx, brush_idx, font_idx, path_idx, image_idx, size_idx;
+            pen_idx, brush_idx, font_idx, path_idx, image_idx, size_idx, drawimage_idx;
 
         matrix_idx = real_idx = int_idx = variant_idx = string_idx =color_idx = cmd_idx
-         = pen_idx = brush_idx = font_idx = path_idx = image_idx = size_idx = 0;
+         = pen_idx = brush_idx = font_idx = path_idx = image_idx = size_idx = drawimage_idx = 0;
 
-        foreach(PaintCommand cmd, d->commands) {
+        foreach(QSGContext2D::PaintCommand cmd, commands) {
             switch (cmd) {
-            case UpdateMatrix:
+            case QSGContext2D::UpdateMatrix:
             {
-                d->state.matrix = d->matrixes[matrix_idx++];
-                p->setMatrix(d->state.matrix * originMatrix);
+                state.matrix = matrixes[matrix_idx++];
+                p->setMatrix(state.matrix * originMatrix);
                 break;
             }
-            case ClearRect:
+            case QSGContext2D::ClearRect:
             {
-                qreal x = d->reals[real_idx++];
-                qreal y = d->reals[real_idx++];
-                qreal w = d->reals[real_idx++];
-                qreal h = d->reals[real_idx++];
+                qreal x = reals[real_idx++];
+                qreal y = reals[real_idx++];
+                qreal w = reals[real_idx++];
+                qreal h = reals[real_idx++];
                 p->eraseRect(QRectF(x, y, w, h));
                 break;
             }
-            case FillRect:
+            case QSGContext2D::FillRect:
             {
-                qreal x = d->reals[real_idx++];
-                qreal y = d->reals[real_idx++];
-                qreal w = d->reals[real_idx++];
-                qreal h = d->reals[real_idx++];
-                if (d->hasShadow())
-                    d->fillRectShadow(p, QRectF(x, y, w, h));
+                qreal x = reals[real_idx++];
+                qreal y = reals[real_idx++];
+                qreal w = reals[real_idx++];
+                qreal h = reals[real_idx++];
+                if (hasShadow())
+                    fillRectShadow(p, QRectF(x, y, w, h));
                 else
                     p->fillRect(QRectF(x, y, w, h), p->brush());
                 break;
             }
-            case ShadowColor:
+            case QSGContext2D::ShadowColor:
             {
-                QColor c = d->colors[color_idx++];
-                d->state.shadowColor = c;
+                QColor c = colors[color_idx++];
+                state.shadowColor = c;
                 break;
             }
-            case ShadowBlur:
+            case QSGContext2D::ShadowBlur:
             {
-                qreal blur = d->reals[real_idx++];
-                d->state.shadowBlur = blur;
+                qreal blur = reals[real_idx++];
+                state.shadowBlur = blur;
                 break;
             }
-            case ShadowOffsetX:
+            case QSGContext2D::ShadowOffsetX:
             {
-                qreal x = d->reals[real_idx++];
-                d->state.shadowOffsetX = x;
+                qreal x = reals[real_idx++];
+                state.shadowOffsetX = x;
                 break;
             }
-            case ShadowOffsetY:
+            case QSGContext2D::ShadowOffsetY:
             {
-                qreal y = d->reals[real_idx++];
-                d->state.shadowOffsetY = y;
+                qreal y = reals[real_idx++];
+                state.shadowOffsetY = y;
                 break;
             }
-            case Fill:
+            case QSGContext2D::Fill:
             {
-                QPainterPath path = d->pathes[path_idx++];
+                QPainterPath path = pathes[path_idx++];
                 //qDebug() << "fill path:" << path.elementCount();
-                if (d->hasShadow())
-                    d->fillShadowPath(p,path);
+                if (hasShadow())
+                    fillShadowPath(p,path);
                 else
                     p->fillPath(path, p->brush());
                 break;
             }
-            case Stroke:
+            case QSGContext2D::Stroke:
             {
-                //p->setMatrix(d->state.matrix);
-                //QPainterPath path = d->state.matrix.inverted().map(d->pathes[path_idx++]);
+                //p->setMatrix(state.matrix);
+                //QPainterPath path = state.matrix.inverted().map(pathes[path_idx++]);
                 //qDebug() << "stroke path:" << path.elementCount();
-                QPainterPath path = d->pathes[path_idx++];
-                if (d->hasShadow())
-                    d->strokeShadowPath(p,path);
+                QPainterPath path = pathes[path_idx++];
+                if (hasShadow())
+                    strokeShadowPath(p,path);
                 else
                     p->strokePath(path, p->pen());
                 break;
             }
-            case Clip:
+            case QSGContext2D::Clip:
             {
-                QPainterPath clipPath = d->pathes[path_idx++];
+                QPainterPath clipPath = pathes[path_idx++];
                 p->setClipPath(clipPath);
                 p->setClipping(true);
                 break;
             }
-            case UpdateBrush:
+            case QSGContext2D::UpdateBrush:
             {
-                p->setBrush(d->brushes[brush_idx++]);
+                p->setBrush(brushes[brush_idx++]);
                 break;
             }
-            case UpdatePen:
+            case QSGContext2D::UpdatePen:
             {
-                p->setPen(d->pens[pen_idx++]);
+                p->setPen(pens[pen_idx++]);
                 break;
             }
-            case GlobalAlpha:
+            case QSGContext2D::GlobalAlpha:
             {
-                p->setOpacity(d->reals[real_idx++]);
+                p->setOpacity(reals[real_idx++]);
                 break;
             }
-            case GlobalCompositeOperation:
+            case QSGContext2D::GlobalCompositeOperation:
             {
-                p->setCompositionMode(static_cast<QPainter::CompositionMode>(d->ints[int_idx++]));
+                p->setCompositionMode(static_cast<QPainter::CompositionMode>(ints[int_idx++]));
                 break;
             }
-            case Font:
+            case QSGContext2D::Font:
             {
-                p->setFont(d->fonts[font_idx++]);
+                p->setFont(fonts[font_idx++]);
                 break;
             }
-            case StrokeText:
+            case QSGContext2D::StrokeText:
             {
-                QString text = d->strings[string_idx++];
-                qreal x = d->reals[real_idx++];
-                qreal y = d->reals[real_idx++];
-                int align = d->ints[int_idx++];
-                int baseline = d->ints[int_idx++];
+                QString text = strings[string_idx++];
+                qreal x = reals[real_idx++];
+                qreal y = reals[real_idx++];
+                int align = ints[int_idx++];
+                int baseline = ints[int_idx++];
 
                 QPen oldPen = p->pen();
                 p->setPen(QPen(p->brush(),0));
@@ -3802,11 +3847,11 @@ void QSGContext2D::paint(QPainter* p)
                 font.setStyleStrategy(QFont::ForceOutline);
                 p->setFont(font);
                 const QFontMetrics &metrics = p->fontMetrics();
-                int yoffset = d->baseLineOffset(static_cast<QSGContext2D::TextBaseLineType>(baseline), metrics);
-                int xoffset = d->textAlignOffset(static_cast<QSGContext2D::TextAlignType>(align), metrics, text);
+                int yoffset = QSGContext2DPrivate::baseLineOffset(static_cast<QSGContext2D::TextBaseLineType>(baseline), metrics);
+                int xoffset = QSGContext2DPrivate::textAlignOffset(static_cast<QSGContext2D::TextAlignType>(align), metrics, text);
                 textPath.addText(x - xoffset, y - yoffset+metrics.ascent(), font, text);
-                if (d->hasShadow())
-                    d->strokeShadowPath(p,textPath);
+                if (hasShadow())
+                    strokeShadowPath(p,textPath);
 
                 p->strokePath(textPath, QPen(p->brush(), p->pen().widthF()));
 
@@ -3815,125 +3860,122 @@ void QSGContext2D::paint(QPainter* p)
                 p->setPen(oldPen);
                 break;
             }
-            case FillText:
+            case QSGContext2D::FillText:
             {
-                QString text = d->strings[string_idx++];
-                qreal x = d->reals[real_idx++];
-                qreal y = d->reals[real_idx++];
-                int align = d->ints[int_idx++];
-                int baseline = d->ints[int_idx++];
+                QString text = strings[string_idx++];
+                qreal x = reals[real_idx++];
+                qreal y = reals[real_idx++];
+                int align = ints[int_idx++];
+                int baseline = ints[int_idx++];
 
                 QFont oldFont = p->font();
                 QPen oldPen = p->pen();
                 p->setPen(QPen(p->brush(), p->pen().widthF()));
                 //p->setMatrix(state.matrix, false);
                 //QFont font = p->font();
-                QFont font = d->state.font;
+                QFont font = state.font;
                 font.setBold(true);
 
                 p->setFont(font);
-                int yoffset = d->baseLineOffset(static_cast<QSGContext2D::TextBaseLineType>(baseline), p->fontMetrics());
-                int xoffset = d->textAlignOffset(static_cast<QSGContext2D::TextAlignType>(align), p->fontMetrics(), text);
+                int yoffset = QSGContext2DPrivate::baseLineOffset(static_cast<QSGContext2D::TextBaseLineType>(baseline), p->fontMetrics());
+                int xoffset = QSGContext2DPrivate::textAlignOffset(static_cast<QSGContext2D::TextAlignType>(align), p->fontMetrics(), text);
                 QTextOption opt; // Adjust baseLine etc
-                if (d->hasShadow()) {
+                if (hasShadow()) {
                     const QFontMetrics &metrics = p->fontMetrics();
                     QPainterPath textPath;
                     textPath.addText(x - xoffset, y - yoffset+metrics.ascent(), font, text);
-                    d->fillShadowPath(p,textPath);
+                    fillShadowPath(p,textPath);
                 }
                 //p->drawText(QRectF(x - xoffset, y - yoffset, QWIDGETSIZE_MAX, p->fontMetrics().height()), text, opt);
                 p->setFont(oldFont);
                 p->setPen(oldPen);
                 break;
             }
-            case DrawImage1:
+            case QSGContext2D::DrawImage1:
             {
-                QUrl url(d->strings[string_idx++]);
-                qreal x = d->reals[real_idx++];
-                qreal y = d->reals[real_idx++];
-                QDeclarativePixmap px(qmlEngine(d->canvas), url);
-                qDebug() << "draw image:" << url << px.pixmap().size();
-                if (px.isReady()) {
-                    QPixmap pixmap = px.pixmap();
-                    if (d->hasShadow()) {
-                        QImage shadow = d->makeShadowImage(pixmap);
-                        qreal dx = x + (d->state.shadowOffsetX < 0? d->state.shadowOffsetX:0);
-                        qreal dy = y + (d->state.shadowOffsetY < 0? d->state.shadowOffsetY:0);
+                QImage image = drawImages[drawimage_idx++];
+                qreal x = reals[real_idx++];
+                qreal y = reals[real_idx++];
+                if (!image.isNull()) {
+                    if (hasShadow()) {
+                        QImage shadow = makeShadowImage(image);
+                        qreal dx = x + (state.shadowOffsetX < 0? state.shadowOffsetX:0);
+                        qreal dy = y + (state.shadowOffsetY < 0? state.shadowOffsetY:0);
                         p->drawImage(QPointF(dx, dy), shadow);
                     }
-                    p->drawPixmap(QPointF(x, y), pixmap);
+                    p->drawImage(QPointF(x, y), image);
                 }
                 break;
             }
-            case DrawImage2:
+            case QSGContext2D::DrawImage2:
             {
-                qreal dx = d->reals[real_idx++];
-                qreal dy = d->reals[real_idx++];
-                qreal dw = d->reals[real_idx++];
-                qreal dh = d->reals[real_idx++];
-                QUrl url(d->strings[string_idx++]);
-                QDeclarativePixmap px(qmlEngine(d->canvas), url);
-                if (px.isReady()) {
-                    QPixmap pixmap = px.pixmap().scaled(dw, dh);
-                    if (d->hasShadow()) {
-                        QImage shadow = d->makeShadowImage(pixmap);
-                        qreal shadow_dx = dx + (d->state.shadowOffsetX < 0? d->state.shadowOffsetX:0);
-                        qreal shadow_dy = dy + (d->state.shadowOffsetY < 0? d->state.shadowOffsetY:0);
+                qreal dx = reals[real_idx++];
+                qreal dy = reals[real_idx++];
+                qreal dw = reals[real_idx++];
+                qreal dh = reals[real_idx++];
+                QImage image = drawImages[drawimage_idx++];
+                if (!image.isNull()) {
+                    image = image.scaled(dw, dh);
+                    if (hasShadow()) {
+                        QImage shadow = makeShadowImage(image);
+                        qreal shadow_dx = dx + (state.shadowOffsetX < 0? state.shadowOffsetX:0);
+                        qreal shadow_dy = dy + (state.shadowOffsetY < 0? state.shadowOffsetY:0);
                         p->drawImage(QPointF(shadow_dx, shadow_dy), shadow);
                     }
-                    p->drawPixmap(QPointF(dx, dy), pixmap);
+                    p->drawImage(QPointF(dx, dy), image);
                 }
                 break;
             }
-            case DrawImage3:
+            case QSGContext2D::DrawImage3:
             {
-                qreal sx = d->reals[real_idx++];
-                qreal sy = d->reals[real_idx++];
-                qreal sw = d->reals[real_idx++];
-                qreal sh = d->reals[real_idx++];
-                qreal dx = d->reals[real_idx++];
-                qreal dy = d->reals[real_idx++];
-                qreal dw = d->reals[real_idx++];
-                qreal dh = d->reals[real_idx++];
-                QUrl url(d->strings[string_idx++]);
-                QDeclarativePixmap px(qmlEngine(d->canvas), url);
-                if (px.isReady()) {
-                    QPixmap pixmap = px.pixmap().copy(sx, sy, sw, sh).scaled(dw, dh);
-                    if (d->hasShadow()) {
-                        QImage shadow = d->makeShadowImage(pixmap);
-                        qreal shadow_dx = dx + (d->state.shadowOffsetX < 0? d->state.shadowOffsetX:0);
-                        qreal shadow_dy = dy + (d->state.shadowOffsetY < 0? d->state.shadowOffsetY:0);
+                qreal sx = reals[real_idx++];
+                qreal sy = reals[real_idx++];
+                qreal sw = reals[real_idx++];
+                qreal sh = reals[real_idx++];
+                qreal dx = reals[real_idx++];
+                qreal dy = reals[real_idx++];
+                qreal dw = reals[real_idx++];
+                qreal dh = reals[real_idx++];
+                QImage image = drawImages[drawimage_idx++];
+                if (!image.isNull()) {
+                    image = image.copy(sx, sy, sw, sh).scaled(dw, dh);
+                    if (hasShadow()) {
+                        QImage shadow = makeShadowImage(image);
+                        qreal shadow_dx = dx + (state.shadowOffsetX < 0? state.shadowOffsetX:0);
+                        qreal shadow_dy = dy + (state.shadowOffsetY < 0? state.shadowOffsetY:0);
                         p->drawImage(QPointF(shadow_dx, shadow_dy), shadow);
                     }
-                    p->drawPixmap(QPointF(dx, dy), pixmap);
+                    p->drawImage(QPointF(dx, dy), image);
                 }
                 break;
             }
-            case GetImageData:
+            case QSGContext2D::GetImageData:
             {
-                qreal sx = d->reals[real_idx++];
-                qreal sy = d->reals[real_idx++];
-                qreal sw = d->reals[real_idx++];
-                qreal sh = d->reals[real_idx++];
-                QImage img = toImage().copy(sx, sy, sw, sh);
+                qreal sx = reals[real_idx++];
+                qreal sy = reals[real_idx++];
+                qreal sw = reals[real_idx++];
+                qreal sh = reals[real_idx++];
+                QImage img;
+                if (p->device()->devType() == QInternal::Image)
+                    img = static_cast<QImage *>(p->device())->copy(sx, sy, sw, sh);
                 const uchar* data = img.constBits();
                 int i = 0;
 
                 while(i< img.byteCount()) {
                     //the stored order in QImage:BGRA
-                    d->imageData << *(data+i+2);//R
-                    d->imageData << *(data+i+1);//G
-                    d->imageData << *(data+i);//B
-                    d->imageData << *(data+i+3);//A
+                    imageData << *(data+i+2);//R
+                    imageData << *(data+i+1);//G
+                    imageData << *(data+i);//B
+                    imageData << *(data+i+3);//A
                     i+=4;
                 }
                 break;
             }
-            case PutImageData:
+            case QSGContext2D::PutImageData:
             {
-                QImage image = d->images[image_idx++];
-                qreal x = d->reals[real_idx++];
-                qreal y = d->reals[real_idx++];
+                QImage image = images[image_idx++];
+                qreal x = reals[real_idx++];
+                qreal y = reals[real_idx++];
                 p->drawImage(QPointF(x, y), image);
                 break;
             }
@@ -3941,10 +3983,19 @@ void QSGContext2D::paint(QPainter* p)
                 break;
             }
         }
-        d->clearCommands();
     }
 }
 
+void QSGContext2D::paint(QPainter* p)
+{
+    Q_D(QSGContext2D);
+
+    QSGContext2DCommandBuffer buffer;
+    d->takeCommands(&buffer);
+    buffer.replay(p);
+    d->imageData << buffer.imageData;
+}
+
 QPaintDevice* QSGContext2D::paintDevice()
 {
     Q_D(QSGContext2D);
@@ -70,6 +70,49 @@ struct QSGContext2DWorkerAgent {
     QWaitCondition syncDone;
 };
 
+/*
+    A batch of recorded paint commands together with the state needed to replay
+    it. Buffers are taken from the context on the GUI thread and can then be
+    replayed on any thread, so they only hold QImages and never pixmaps.
+*/
+class QSGContext2DCommandBuffer
+{
+public:
+    QSGContext2DCommandBuffer() {}
+
+    bool isEmpty() const { return commands.isEmpty(); }
+    void replay(QPainter *p);
+
+    QVector<QSGContext2D::PaintCommand> commands;
+    QVector<QVariant> variants;
+    QVector<int> ints;
+    QVector<qreal> reals;
+    QVector<QString> strings;
+    QVector<QColor> colors;
+    QVector<QMatrix> matrixes;
+    QVector<QPen> pens;
+    QVector<QBrush> brushes;
+    QVector<QPainterPath> pathes;
+    QVector<QFont> fonts;
+    QVector<QImage> images;
+    QVector<QSize> sizes;
+
+    // The images of the DrawImage commands, resolved when the buffer was taken
+    QVector<QImage> drawImages;
+
+    // Filled by GetImageData commands during replay
+    QList<int> imageData;
+
+    QSGContext2D::State state;
+
+private:
+    bool hasShadow() const;
+    QImage makeShadowImage(const QImage& img);
+    void fillRectShadow(QPainter* p, QRectF shadowRect);
+    void fillShadowPath(QPainter* p, const QPainterPath& path);
+    void strokeShadowPath(QPainter* p, const QPainterPath& path);
+};
+
 class QSGContext2DPrivate : public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(QSGContext2D)
@@ -125,12 +168,7 @@ public:
     void setShadowBlur(qreal b);
     void setShadowColor(const QString &str);
 
-    bool hasShadow() const;
     void clearShadow();
-    QImage makeShadowImage(const QPixmap& pix);
-    void fillRectShadow(QPainter* p, QRectF shadowRect);
-    void fillShadowPath(QPainter* p, const QPainterPath& path);
-    void strokeShadowPath(QPainter* p, const QPainterPath& path);
     void save();
     void restore();
 
@@ -176,8 +214,10 @@ public:
     QList<int> getImageData(qreal sx, qreal sy, qreal sw, qreal sh);
     void putImageData(const QVariantList& imageData, qreal x, qreal y, qreal w, qreal h);
 
-    int baseLineOffset(QSGContext2D::TextBaseLineType value, const QFontMetrics &metrics);
-    int textAlignOffset(QSGContext2D::TextAlignType value, const QFontMetrics &metrics, const QString &string);
+    static int baseLineOffset(QSGContext2D::TextBaseLineType value, const QFontMetrics &metrics);
+    static int textAlignOffset(QSGContext2D::TextAlignType value, const QFontMetrics &metrics, const QString &string);
+
+    void takeCommands(QSGContext2DCommandBuffer *buffer);
 
     void clearCommands()
     {
@@ -195,6 +235,7 @@ public:
         fonts.remove(0, fonts.size());
         images.remove(0, images.size());
         sizes.remove(0, sizes.size());
+        imageUrls.remove(0, imageUrls.size());
     }
 
     //current context2d variables
@@ -217,6 +258,7 @@ public:
     QVector<QFont> fonts;
     QVector<QImage> images;
     QVector<QSize> sizes;
+    QVector<QString> imageUrls;
     QList<int> imageData;
 
     //workerscript agent
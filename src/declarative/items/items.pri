@@ -18,6 +18,7 @@ HEADERS += \
     $$PWD/qsgtext_p.h \
     $$PWD/qsgtext_p_p.h \
     $$PWD/qsgtextnode_p.h \
+    $$PWD/qsgtextlayoutcache_p.h \
     $$PWD/qsgtextinput_p.h \
     $$PWD/qsgtextinput_p_p.h \
     $$PWD/qsgtextedit_p.h \
@@ -77,6 +78,7 @@ SOURCES += \
     $$PWD/qsgpainteditem.cpp \
     $$PWD/qsgtext.cpp \
     $$PWD/qsgtextnode.cpp \
+    $$PWD/qsgtextlayoutcache.cpp \
     $$PWD/qsgtextinput.cpp \
     $$PWD/qsgtextedit.cpp \
     $$PWD/qsgimagebase.cpp \
@@ -58,13 +58,16 @@
 #include <QtGui/qinputcontext.h>
 #include <QtCore/qvarlengtharray.h>
 #include <QtCore/qabstractanimation.h>
+#include <QtCore/qelapsedtimer.h>
 
 #include <private/qdeclarativedebugtrace_p.h>
+#include <private/qdeclarativeengine_p.h>
 
 QT_BEGIN_NAMESPACE
 
 DEFINE_BOOL_CONFIG_OPTION(qmlNoThreadedRenderer, QML_NO_THREADED_RENDERER)
 DEFINE_BOOL_CONFIG_OPTION(qmlFixedAnimationStep, QML_FIXED_ANIMATION_STEP)
+DEFINE_BOOL_CONFIG_OPTION(qmlNoSubtreeBounds, QML_NO_SUBTREE_BOUNDS)
 
 extern Q_OPENGL_EXPORT QImage qt_gl_read_framebuffer(const QSize &size, bool alpha_format, bool include_alpha);
 
@@ -198,7 +201,12 @@ void QSGCanvas::paintEvent(QPaintEvent *)
         int makecurrentTime = frameTimer.elapsed();
 #endif
 
+        bool profileFrame = QDeclarativeDebugTrace::isEnabled();
+        QElapsedTimer profileTimer;
+        profileTimer.start();
+
         d->syncSceneGraph();
+        qint64 sceneGraphSyncTime = profileTimer.nsecsElapsed();
 
 #ifdef FRAME_TIMING
         int syncTime = frameTimer.elapsed();
@@ -206,7 +214,10 @@ void QSGCanvas::paintEvent(QPaintEvent *)
 
         d->renderSceneGraph(d->widgetSize);
 
+        profileTimer.restart();
         swapBuffers();
+        if (profileFrame)
+            d->sendSceneGraphFrame(sceneGraphSyncTime, profileTimer.nsecsElapsed());
 
 #ifdef FRAME_TIMING
         printf("FrameTimes, last=%d, animations=%d, polish=%d, makeCurrent=%d, sync=%d, sgrender=%d, readback=%d, total=%d\n",
@@ -374,18 +385,31 @@ void QSGCanvasPrivate::initializeSceneGraph()
 
 void QSGCanvasPrivate::polishItems()
 {
+    QElapsedTimer timer;
+    timer.start();
+
+    // Bindings updated before and while polishing may schedule further polishes
+    QDeclarativeEnginePrivate::flushAllDirtyBindings();
     while (!itemsToPolish.isEmpty()) {
         QSet<QSGItem *>::Iterator iter = itemsToPolish.begin();
         QSGItem *item = *iter;
         itemsToPolish.erase(iter);
         QSGItemPrivate::get(item)->polishScheduled = false;
         item->updatePolish();
+
+        if (itemsToPolish.isEmpty())
+            QDeclarativeEnginePrivate::flushAllDirtyBindings();
     }
+
+    polishTime = timer.nsecsElapsed();
 }
 
 
 void QSGCanvasPrivate::syncSceneGraph()
 {
+    // The GUI thread is blocked while syncing, so this is the one safe point to hand
+    // the polish time over to the render thread
+    syncedPolishTime = polishTime;
     updateDirtyNodes();
 }
 
@@ -409,6 +433,29 @@ void QSGCanvasPrivate::renderSceneGraph(const QSize &size)
 #endif
 }
 
+/*
+    Reports the timings of the frame which was just rendered to the debug trace, together
+    with the renderer's statistics. Called from the render thread when rendering is threaded.
+*/
+void QSGCanvasPrivate::sendSceneGraphFrame(qint64 syncTime, qint64 swapTime)
+{
+    const QSGRenderer::Statistics &stats = context->renderer()->statistics();
+
+    QVector<qint64> values(QDeclarativeDebugTrace::MaximumSceneGraphFrameValue);
+    values[QDeclarativeDebugTrace::SceneGraphPolishTime] = syncedPolishTime;
+    values[QDeclarativeDebugTrace::SceneGraphSyncTime] = syncTime;
+    values[QDeclarativeDebugTrace::SceneGraphPreprocessTime] = stats.preprocessTime;
+    values[QDeclarativeDebugTrace::SceneGraphUpdateTime] = stats.updateTime;
+    values[QDeclarativeDebugTrace::SceneGraphBuildListsTime] = stats.buildListsTime;
+    values[QDeclarativeDebugTrace::SceneGraphSortTime] = stats.sortTime;
+    values[QDeclarativeDebugTrace::SceneGraphDrawTime] = stats.renderTime - stats.buildListsTime - stats.sortTime;
+    values[QDeclarativeDebugTrace::SceneGraphSwapTime] = swapTime;
+    values[QDeclarativeDebugTrace::SceneGraphGeometryNodes] = stats.geometryNodes;
+    values[QDeclarativeDebugTrace::SceneGraphMaterialChanges] = stats.materialChanges;
+    values[QDeclarativeDebugTrace::SceneGraphDrawCalls] = stats.drawCalls;
+    QDeclarativeDebugTrace::sceneGraphFrame(values);
+}
+
 
 // ### Do we need this?
 void QSGCanvas::sceneGraphChanged()
@@ -423,17 +470,21 @@ QSGCanvasPrivate::QSGCanvasPrivate()
     , activeFocusItem(0)
     , mouseGrabberItem(0)
     , dirtyItemList(0)
+    , polishTime(0)
+    , syncedPolishTime(0)
     , context(0)
     , contextFailed(false)
     , threadedRendering(false)
     , animationRunning(false)
     , renderThreadAwakened(false)
     , vsyncAnimations(false)
+    , useSubtreeBounds(true)
     , thread(0)
     , animationDriver(0)
     , renderTarget(0)
 {
     threadedRendering = !qmlNoThreadedRenderer();
+    useSubtreeBounds = !qmlNoSubtreeBounds();
 }
 
 QSGCanvasPrivate::~QSGCanvasPrivate()
@@ -1049,6 +1100,18 @@ void QSGCanvas::inputMethodEvent(QInputMethodEvent *e)
         sendEvent(d->activeFocusItem, e);
 }
 
+/*
+    Returns false if no item in the subtree of \a child can contain \a pos, which is given in
+    the coordinates of the child's parent.
+*/
+static bool subtreeMayContain(QSGItem *child, const QPointF &pos)
+{
+    QSGItemPrivate *childPrivate = QSGItemPrivate::get(child);
+    QTransform t;
+    childPrivate->itemToParentTransform(t);
+    return t.mapRect(childPrivate->subtreeBoundingRect()).contains(pos);
+}
+
 bool QSGCanvasPrivate::deliverInitialMousePressEvent(QSGItem *item, QGraphicsSceneMouseEvent *event)
 {
     Q_Q(QSGCanvas);
@@ -1064,10 +1127,15 @@ bool QSGCanvasPrivate::deliverInitialMousePressEvent(QSGItem *item, QGraphicsSce
     }
 
     QList<QSGItem *> children = itemPrivate->paintOrderChildItems();
+    QPointF localPos;
+    if (useSubtreeBounds && !children.isEmpty())
+        localPos = item->mapFromScene(event->scenePos());
     for (int ii = children.count() - 1; ii >= 0; --ii) {
         QSGItem *child = children.at(ii);
         if (!child->isVisible() || !child->isEnabled())
             continue;
+        if (useSubtreeBounds && !subtreeMayContain(child, localPos))
+            continue;
         if (deliverInitialMousePressEvent(child, event))
             return true;
     }
@@ -1234,10 +1302,15 @@ bool QSGCanvasPrivate::deliverHoverEvent(QSGItem *item, const QPointF &scenePos,
     }
 
     QList<QSGItem *> children = itemPrivate->paintOrderChildItems();
+    QPointF localPos;
+    if (useSubtreeBounds && !children.isEmpty())
+        localPos = item->mapFromScene(scenePos);
     for (int ii = children.count() - 1; ii >= 0; --ii) {
         QSGItem *child = children.at(ii);
         if (!child->isEnabled())
             continue;
+        if (useSubtreeBounds && !subtreeMayContain(child, localPos))
+            continue;
         if (deliverHoverEvent(child, scenePos, lastScenePos, modifiers, accepted))
             return true;
     }
@@ -1304,10 +1377,15 @@ bool QSGCanvasPrivate::deliverWheelEvent(QSGItem *item, QWheelEvent *event)
     }
 
     QList<QSGItem *> children = itemPrivate->paintOrderChildItems();
+    QPointF localPos;
+    if (useSubtreeBounds && !children.isEmpty())
+        localPos = item->mapFromScene(event->pos());
     for (int ii = children.count() - 1; ii >= 0; --ii) {
         QSGItem *child = children.at(ii);
         if (!child->isEnabled())
             continue;
+        if (useSubtreeBounds && !subtreeMayContain(child, localPos))
+            continue;
         if (deliverWheelEvent(child, event))
             return true;
     }
@@ -1400,6 +1478,35 @@ bool QSGCanvasPrivate::deliverTouchEvent(QTouchEvent *event)
     return event->isAccepted();
 }
 
+/*
+    Returns false if the subtree of \a child neither contains any of the new touch points in
+    \a pos, given in the coordinates of the child's parent, nor any item with updated points.
+*/
+static bool touchSubtreeMayContain(QSGItem *child, const QVector<QPointF> &pos,
+                                   const QHash<QSGItem *, QList<QTouchEvent::TouchPoint> > &updatedPoints)
+{
+    for (QHash<QSGItem *, QList<QTouchEvent::TouchPoint> >::const_iterator it = updatedPoints.constBegin();
+         it != updatedPoints.constEnd(); ++it) {
+        for (QSGItem *item = it.key(); item; item = item->parentItem()) {
+            if (item == child)
+                return true;
+        }
+    }
+
+    if (pos.isEmpty())
+        return false;
+
+    QSGItemPrivate *childPrivate = QSGItemPrivate::get(child);
+    QTransform t;
+    childPrivate->itemToParentTransform(t);
+    QRectF bounds = t.mapRect(childPrivate->subtreeBoundingRect());
+    for (int i=0; i<pos.count(); i++) {
+        if (bounds.contains(pos.at(i)))
+            return true;
+    }
+    return false;
+}
+
 bool QSGCanvasPrivate::deliverTouchPoints(QSGItem *item, QTouchEvent *event, const QList<QTouchEvent::TouchPoint> &newPoints, QSet<int> *acceptedNewPoints, QHash<QSGItem *, QList<QTouchEvent::TouchPoint> > *updatedPoints)
 {
     Q_Q(QSGCanvas);
@@ -1418,10 +1525,19 @@ bool QSGCanvasPrivate::deliverTouchPoints(QSGItem *item, QTouchEvent *event, con
     }
 
     QList<QSGItem *> children = itemPrivate->paintOrderChildItems();
+    QVector<QPointF> localPoints;
+    if (useSubtreeBounds && !children.isEmpty()) {
+        for (int i=0; i<newPoints.count(); i++) {
+            if (!acceptedNewPoints->contains(newPoints[i].id()))
+                localPoints << item->mapFromScene(newPoints[i].scenePos());
+        }
+    }
     for (int ii = children.count() - 1; ii >= 0; --ii) {
         QSGItem *child = children.at(ii);
         if (!child->isEnabled())
             continue;
+        if (useSubtreeBounds && !touchSubtreeMayContain(child, localPoints, *updatedPoints))
+            continue;
         if (deliverTouchPoints(child, event, newPoints, acceptedNewPoints, updatedPoints))
             return true;
     }
@@ -1521,10 +1637,15 @@ bool QSGCanvasPrivate::deliverDragEvent(QSGItem *item, QSGDragEvent *event)
     }
 
     QList<QSGItem *> children = itemPrivate->paintOrderChildItems();
+    QPointF localPos;
+    if (useSubtreeBounds && !children.isEmpty())
+        localPos = item->mapFromScene(event->scenePosition());
     for (int ii = children.count() - 1; ii >= 0; --ii) {
         QSGItem *child = children.at(ii);
         if (!child->isVisible() || !child->isEnabled())
             continue;
+        if (useSubtreeBounds && !subtreeMayContain(child, localPos))
+            continue;
         if (deliverDragEvent(child, event))
             return true;
     }
@@ -2070,10 +2191,16 @@ void QSGCanvasRenderThread::run()
 #ifdef THREAD_DEBUG
         printf("                RenderThread: Doing locked sync\n");
 #endif
+        bool profileFrame = QDeclarativeDebugTrace::isEnabled();
+        QElapsedTimer profileTimer;
+        profileTimer.start();
+
         inSync = true;
         d->syncSceneGraph();
         inSync = false;
 
+        qint64 syncTime = profileTimer.nsecsElapsed();
+
         // Wake GUI after sync to let it continue animating and event processing.
         wake();
         unlock();
@@ -2103,7 +2230,10 @@ void QSGCanvasRenderThread::run()
         printf("                RenderThread: wait for swap...\n");
 #endif
 
+        profileTimer.restart();
         renderer->swapBuffers();
+        if (profileFrame)
+            d->sendSceneGraphFrame(syncTime, profileTimer.nsecsElapsed());
 
 #ifdef THREAD_DEBUG
         printf("                RenderThread: swap complete...\n");
@@ -140,6 +140,7 @@ public:
     void polishItems();
     void syncSceneGraph();
     void renderSceneGraph(const QSize &size);
+    void sendSceneGraphFrame(qint64 syncTime, qint64 swapTime);
 
     QSGItem::UpdatePaintNodeData updatePaintNodeData;
 
@@ -147,6 +148,8 @@ public:
     QList<QSGNode *> cleanupNodeList;
 
     QSet<QSGItem *> itemsToPolish;
+    qint64 polishTime;       // written by polishItems() in the GUI thread
+    qint64 syncedPolishTime; // copied during sync, read when the frame is reported
 
     void updateDirtyNodes();
     void cleanupNodes();
@@ -162,6 +165,7 @@ public:
     uint renderThreadAwakened : 1;
 
     uint vsyncAnimations : 1;
+    uint useSubtreeBounds : 1;
 
     QSGCanvasRenderThread *thread;
     QSize widgetSize;
@@ -1299,7 +1299,23 @@ void QSGGridView::setHighlightFollowsCurrentItem(bool autoHighlight)
     of additional memory usage.  It is not a substitute for creating efficient
     delegates; the fewer elements in a delegate, the faster a view may be
     scrolled.
+
+    Only the delegates in the visible area are created immediately.  Delegates
+    for the area covered by the cache buffer are created over the following
+    frames, a few at a time, so that exposing many new delegates at once does
+    not cause the view to skip frames.
+
+    \sa deferredItemCount
 */
+
+/*!
+    \qmlproperty int QtQuick2::GridView::deferredItemCount
+    This property holds the number of delegates that have been created for the
+    cache buffer area in a later frame than the one in which they were requested.
+
+    \sa cacheBuffer
+*/
+
 void QSGGridView::setHighlightMoveDuration(int duration)
 {
     Q_D(QSGGridView);
@@ -205,6 +205,9 @@ void QSGImageBase::load()
         d->pix.load(qmlEngine(this), d->url, d->explicitSourceSize ? sourceSize() : QSize(), options);
 
         if (d->pix.isLoading()) {
+            // Images that are visible are decoded before those that are not
+            d->pix.setPriority(isVisible() ? 1 : 0);
+
             d->progress = 0.0;
             d->status = Loading;
             emit progressChanged(d->progress);
@@ -228,6 +231,14 @@ void QSGImageBase::load()
     }
 }
 
+void QSGImageBase::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    Q_D(QSGImageBase);
+    if (change == ItemVisibleHasChanged && d->status == Loading)
+        d->pix.setPriority(isVisible() ? 1 : 0);
+    QSGImplicitSizeItem::itemChange(change, value);
+}
+
 void QSGImageBase::requestFinished()
 {
     Q_D(QSGImageBase);
@@ -99,6 +99,7 @@ protected:
     virtual void load();
     virtual void componentComplete();
     virtual void pixmapChange();
+    virtual void itemChange(ItemChange, const ItemChangeData &);
     QSGImageBase(QSGImageBasePrivate &dd, QSGItem *parent);
 
 private Q_SLOTS:
@@ -2129,6 +2129,43 @@ void QSGItemPrivate::itemToParentTransform(QTransform &t) const
     }
 }
 
+/*!
+Returns the bounding rect of this item and all of its descendants, in item coordinates.
+
+Invisible and transparent descendants are included, so the result is conservative for
+event delivery. The rect is cached until invalidateSubtreeBounds() is called.
+*/
+QRectF QSGItemPrivate::subtreeBoundingRect()
+{
+    if (!subtreeBoundsValid) {
+        QRectF bounds(0, 0, width, height);
+        for (int ii = 0; ii < childItems.count(); ++ii) {
+            QSGItemPrivate *child = QSGItemPrivate::get(childItems.at(ii));
+            QTransform t;
+            child->itemToParentTransform(t);
+            bounds |= t.mapRect(child->subtreeBoundingRect());
+        }
+        subtreeBounds = bounds;
+        subtreeBoundsValid = true;
+    }
+    return subtreeBounds;
+}
+
+/*!
+Invalidates the cached subtree bounds of this item and its ancestors.
+
+An item's bounds are only ever computed together with those of all its descendants,
+so we can stop at the first ancestor which is already invalid.
+*/
+void QSGItemPrivate::invalidateSubtreeBounds()
+{
+    QSGItemPrivate *d = this;
+    while (d && d->subtreeBoundsValid) {
+        d->subtreeBoundsValid = false;
+        d = d->parentItem ? QSGItemPrivate::get(d->parentItem) : 0;
+    }
+}
+
 
 /*!
     \qmlproperty real QtQuick2::Item::childrenRect.x
@@ -2193,6 +2230,7 @@ QSGItemPrivate::QSGItemPrivate()
   effectiveVisible(true), explicitEnable(true), effectiveEnable(true), polishScheduled(false),
   inheritedLayoutMirror(false), effectiveLayoutMirror(false), isMirrorImplicit(true),
   inheritMirrorFromParent(false), inheritMirrorFromItem(false), childrenDoNotOverlap(false),
+  subtreeBoundsValid(false),
 
   canvas(0), parentItem(0),
 
@@ -3824,6 +3862,9 @@ void QSGItemPrivate::dirty(DirtyType type)
     if (type & (TransformOrigin | Transform | BasicTransform | Position | Size))
         transformChanged();
 
+    if (type & (TransformOrigin | Transform | BasicTransform | Position | Size | ChildrenChanged))
+        invalidateSubtreeBounds();
+
     if (!(dirtyAttributes & type) || (canvas && !prevDirtyItem)) {
         dirtyAttributes |= type;
         if (canvas) {
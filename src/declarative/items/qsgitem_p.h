@@ -255,7 +255,7 @@ public:
     bool inheritMirrorFromParent:1;
     bool inheritMirrorFromItem:1;
     bool childrenDoNotOverlap:1;
-    quint32 dummy:1;
+    bool subtreeBoundsValid:1;
 
     QSGCanvas *canvas;
     QSGContext *sceneGraphContext() const { return static_cast<QSGCanvasPrivate *>(QObjectPrivate::get(canvas))->context; }
@@ -283,6 +283,12 @@ public:
     QTransform itemToCanvasTransform() const;
     void itemToParentTransform(QTransform &) const;
 
+    // Bounds of this item and all of its descendants in item coordinates, used by the
+    // canvas to skip subtrees which cannot contain an event's position
+    QRectF subtreeBoundingRect();
+    void invalidateSubtreeBounds();
+    QRectF subtreeBounds;
+
     qreal x;
     qreal y;
     qreal width;
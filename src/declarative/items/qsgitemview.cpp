@@ -41,6 +41,8 @@
 
 #include "qsgitemview_p_p.h"
 
+#include <QtCore/qelapsedtimer.h>
+
 QT_BEGIN_NAMESPACE
 
 
@@ -122,7 +124,9 @@ void QSGItemView::setModel(const QVariant &model)
         d->model = vim;
     } else {
         if (!d->ownModel) {
-            d->model = new QSGVisualDataModel(qmlContext(this), this);
+            QSGVisualDataModel *dataModel = new QSGVisualDataModel(qmlContext(this), this);
+            dataModel->setReuseItems(d->reuseItems);
+            d->model = dataModel;
             d->ownModel = true;
         } else {
             d->model = oldModel;
@@ -179,7 +183,9 @@ void QSGItemView::setDelegate(QDeclarativeComponent *delegate)
     if (delegate == this->delegate())
         return;
     if (!d->ownModel) {
-        d->model = new QSGVisualDataModel(qmlContext(this));
+        QSGVisualDataModel *dataModel = new QSGVisualDataModel(qmlContext(this));
+        dataModel->setReuseItems(d->reuseItems);
+        d->model = dataModel;
         d->ownModel = true;
     }
     if (QSGVisualDataModel *dataModel = qobject_cast<QSGVisualDataModel*>(d->model)) {
@@ -276,6 +282,62 @@ void QSGItemView::setCacheBuffer(int b)
     }
 }
 
+/*!
+    \qmlproperty bool QtQuick2::ListView::reuseItems
+    This property holds whether delegates that move out of the view are reused.
+
+    When true, a delegate that is no longer needed is hidden and kept, rather than
+    destroyed, and is rebound to the next index that the view requests.  This avoids
+    creating a new delegate for every item that is scrolled into view.  The \c index
+    and model role properties of a reused delegate change to those of its new index,
+    and \c model.reused() is emitted.
+
+    Only delegates created by the view for a \l ListModel or QAbstractItemModel model
+    are reused.  The default value is false.
+
+    \sa VisualDataModel::reuseItems
+*/
+
+/*!
+    \qmlproperty bool QtQuick2::GridView::reuseItems
+    This property holds whether delegates that move out of the view are reused.
+
+    When true, a delegate that is no longer needed is hidden and kept, rather than
+    destroyed, and is rebound to the next index that the view requests.  This avoids
+    creating a new delegate for every item that is scrolled into view.  The \c index
+    and model role properties of a reused delegate change to those of its new index,
+    and \c model.reused() is emitted.
+
+    Only delegates created by the view for a \l ListModel or QAbstractItemModel model
+    are reused.  The default value is false.
+
+    \sa VisualDataModel::reuseItems
+*/
+bool QSGItemView::reuseItems() const
+{
+    Q_D(const QSGItemView);
+    return d->reuseItems;
+}
+
+void QSGItemView::setReuseItems(bool reuse)
+{
+    Q_D(QSGItemView);
+    if (d->reuseItems != reuse) {
+        d->reuseItems = reuse;
+        if (d->ownModel) {
+            if (QSGVisualDataModel *dataModel = qobject_cast<QSGVisualDataModel*>(d->model))
+                dataModel->setReuseItems(reuse);
+        }
+        emit reuseItemsChanged();
+    }
+}
+
+int QSGItemView::deferredItemCount() const
+{
+    Q_D(const QSGItemView);
+    return d->deferredItemCount;
+}
+
 
 Qt::LayoutDirection QSGItemView::layoutDirection() const
 {
@@ -970,7 +1032,28 @@ void QSGItemView::updatePolish()
 {
     Q_D(QSGItemView);
     QSGFlickable::updatePolish();
-    d->layout();
+    // A polish requested only to continue filling the cache buffer
+    // should not cause the whole view to be laid out again, and the
+    // cache buffer is never filled in the frame that did the layout.
+    if (d->layoutScheduled || !d->bufferPending) {
+        d->layout();
+        if (d->bufferPending)
+            d->scheduleBufferFill();
+    } else {
+        d->fillBuffer();
+    }
+}
+
+void QSGItemView::timerEvent(QTimerEvent *event)
+{
+    Q_D(QSGItemView);
+    if (event->timerId() == d->bufferTimer.timerId()) {
+        d->bufferTimer.stop();
+        if (d->bufferPending)
+            polish();
+        return;
+    }
+    QSGFlickable::timerEvent(event);
 }
 
 void QSGItemView::componentComplete()
@@ -1004,7 +1087,7 @@ void QSGItemView::componentComplete()
 
 QSGItemViewPrivate::QSGItemViewPrivate()
     : itemCount(0)
-    , buffer(0), bufferMode(BufferBefore | BufferAfter)
+    , buffer(0), bufferMode(BufferBefore | BufferAfter), deferredItemCount(0)
     , layoutDirection(Qt::LeftToRight)
     , moveReason(Other)
     , visibleIndex(0)
@@ -1017,9 +1100,9 @@ QSGItemViewPrivate::QSGItemViewPrivate()
     , headerComponent(0), header(0), footerComponent(0), footer(0)
     , minExtent(0), maxExtent(0)
     , ownModel(false), wrap(false), lazyRelease(false), deferredRelease(false)
-    , layoutScheduled(false), inViewportMoved(false), currentIndexCleared(false)
+    , layoutScheduled(false), bufferPending(false), inViewportMoved(false), currentIndexCleared(false)
     , haveHighlightRange(false), autoHighlight(true), highlightRangeStartValid(false), highlightRangeEndValid(false)
-    , minExtentDirty(true), maxExtentDirty(true)
+    , minExtentDirty(true), maxExtentDirty(true), reuseItems(false)
 {
 }
 
@@ -1201,11 +1284,11 @@ void QSGItemViewPrivate::refill()
         refill(position(), position()+size());
 }
 
-void QSGItemViewPrivate::refill(qreal from, qreal to, bool doBuffer)
+bool QSGItemViewPrivate::refill(qreal from, qreal to, bool doBuffer)
 {
     Q_Q(QSGItemView);
     if (!isValid() || !q->isComponentComplete())
-        return;
+        return false;
 
     itemCount = model->count();
     qreal bufferFrom = from - buffer;
@@ -1219,9 +1302,16 @@ void QSGItemViewPrivate::refill(qreal from, qreal to, bool doBuffer)
 
     // Item creation and release is staggered in order to avoid
     // creating/releasing multiple items in one frame
-    // while flicking (as much as possible).
+    // while flicking (as much as possible).  Only the visible
+    // area is filled synchronously, the cache buffer is filled
+    // by fillBuffer() over the following frames.
 
+    int count = visibleItems.count();
     bool changed = addVisibleItems(fillFrom, fillTo, doBuffer);
+    if (doBuffer && visibleItems.count() > count) {
+        deferredItemCount += visibleItems.count() - count;
+        emit q->deferredItemCountChanged();
+    }
 
     if (!lazyRelease || !changed || deferredRelease) { // avoid destroying items in the same frame that we create
         if (removeNonVisibleItems(bufferFrom, bufferTo))
@@ -1235,11 +1325,12 @@ void QSGItemViewPrivate::refill(qreal from, qreal to, bool doBuffer)
         minExtentDirty = true;
         maxExtentDirty = true;
         visibleItemsChanged();
-    } else if (!doBuffer && buffer && bufferMode != NoBuffer) {
-        refill(from, to, true);
     }
+    if (!doBuffer && buffer && bufferMode != NoBuffer)
+        scheduleBufferFill();
 
     lazyRelease = false;
+    return changed;
 }
 
 void QSGItemViewPrivate::regenerate()
@@ -1269,6 +1360,40 @@ void QSGItemViewPrivate::scheduleLayout()
     }
 }
 
+void QSGItemViewPrivate::scheduleBufferFill()
+{
+    Q_Q(QSGItemView);
+    bufferPending = true;
+    if (!bufferTimer.isActive())
+        bufferTimer.start(0, q);
+}
+
+// The maximum time in ms spent creating cache buffer items in one frame
+static const int bufferFillBudget = 4;
+
+void QSGItemViewPrivate::fillBuffer()
+{
+    if (!bufferPending)
+        return;
+    bufferPending = false;
+    bufferTimer.stop();
+
+    qreal from = isContentFlowReversed() ? -position()-size() : position();
+    qreal to = from + size();
+
+    // Each pass creates at most one item at either end of the buffer.
+    // Keep going until the buffer is full or the budget for this frame
+    // is used up, then continue in the next frame.
+    QElapsedTimer timer;
+    timer.start();
+    while (refill(from, to, true)) {
+        if (timer.elapsed() >= bufferFillBudget) {
+            scheduleBufferFill();
+            break;
+        }
+    }
+}
+
 void QSGItemViewPrivate::updateViewport()
 {
     Q_Q(QSGItemView);
@@ -66,6 +66,8 @@ class Q_AUTOTEST_EXPORT QSGItemView : public QSGFlickable
 
     Q_PROPERTY(bool keyNavigationWraps READ isWrapEnabled WRITE setWrapEnabled NOTIFY keyNavigationWrapsChanged)
     Q_PROPERTY(int cacheBuffer READ cacheBuffer WRITE setCacheBuffer NOTIFY cacheBufferChanged)
+    Q_PROPERTY(bool reuseItems READ reuseItems WRITE setReuseItems NOTIFY reuseItemsChanged)
+    Q_PROPERTY(int deferredItemCount READ deferredItemCount NOTIFY deferredItemCountChanged)
 
     Q_PROPERTY(Qt::LayoutDirection layoutDirection READ layoutDirection WRITE setLayoutDirection NOTIFY layoutDirectionChanged)
     Q_PROPERTY(Qt::LayoutDirection effectiveLayoutDirection READ effectiveLayoutDirection NOTIFY effectiveLayoutDirectionChanged)
@@ -109,6 +111,11 @@ public:
     int cacheBuffer() const;
     void setCacheBuffer(int);
 
+    bool reuseItems() const;
+    void setReuseItems(bool);
+
+    int deferredItemCount() const;
+
     Qt::LayoutDirection layoutDirection() const;
     void setLayoutDirection(Qt::LayoutDirection);
     Qt::LayoutDirection effectiveLayoutDirection() const;
@@ -162,6 +169,8 @@ signals:
 
     void keyNavigationWrapsChanged();
     void cacheBufferChanged();
+    void reuseItemsChanged();
+    void deferredItemCountChanged();
 
     void layoutDirectionChanged();
     void effectiveLayoutDirectionChanged();
@@ -182,6 +191,7 @@ signals:
 protected:
     virtual void updatePolish();
     virtual void componentComplete();
+    virtual void timerEvent(QTimerEvent *event);
     virtual void geometryChanged(const QRectF &newGeometry, const QRectF &oldGeometry);
     virtual qreal minYExtent() const;
     virtual qreal maxYExtent() const;
@@ -46,6 +46,8 @@
 #include "qsgflickable_p_p.h"
 #include "qsgvisualitemmodel_p.h"
 
+#include <QtCore/qbasictimer.h>
+
 
 QT_BEGIN_HEADER
 
@@ -101,8 +103,10 @@ public:
     void regenerate();
     void layout();
     void refill();
-    void refill(qreal from, qreal to, bool doBuffer = false);
+    bool refill(qreal from, qreal to, bool doBuffer = false);
     void scheduleLayout();
+    void scheduleBufferFill();
+    void fillBuffer();
     void mirrorChange();
 
     FxViewItem *createItem(int modelIndex);
@@ -124,6 +128,8 @@ public:
     int itemCount;
     int buffer;
     int bufferMode;
+    int deferredItemCount;
+    QBasicTimer bufferTimer;
     Qt::LayoutDirection layoutDirection;
 
     MovementReason moveReason;
@@ -157,6 +163,7 @@ public:
     bool lazyRelease : 1;
     bool deferredRelease : 1;
     bool layoutScheduled : 1;
+    bool bufferPending : 1;
     bool inViewportMoved : 1;
     bool currentIndexCleared : 1;
     bool haveHighlightRange : 1;
@@ -165,6 +172,7 @@ public:
     bool highlightRangeEndValid : 1;
     mutable bool minExtentDirty : 1;
     mutable bool maxExtentDirty : 1;
+    bool reuseItems : 1;
 
 protected:
     virtual Qt::Orientation layoutOrientation() const = 0;
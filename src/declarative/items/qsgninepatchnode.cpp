@@ -50,6 +50,8 @@ QSGNinePatchNode::QSGNinePatchNode()
     , m_dirtyGeometry(false)
     , m_mirror(false)
 {
+    m_material.setFlag(QSGMaterial::CanBeBatched);
+    m_materialO.setFlag(QSGMaterial::CanBeBatched);
     setOpaqueMaterial(&m_material);
     setMaterial(&m_materialO);
     setGeometry(&m_geometry);
@@ -144,7 +144,8 @@ void QSGPathViewPrivate::releaseItem(QSGItem *item)
         return;
     QSGItemPrivate *itemPrivate = QSGItemPrivate::get(item);
     itemPrivate->removeItemChangeListener(this, QSGItemPrivate::Geometry);
-    if (model->release(item) == 0) {
+    QSGVisualModel::ReleaseFlags flags = model->release(item);
+    if (flags == 0 || flags & QSGVisualModel::Pooled) {
         // item was not destroyed, and we no longer reference it.
         if (QSGPathViewAttached *att = attached(item))
             att->setOnPath(false);
@@ -515,7 +516,9 @@ void QSGPathView::setModel(const QVariant &model)
         d->model = vim;
     } else {
         if (!d->ownModel) {
-            d->model = new QSGVisualDataModel(qmlContext(this));
+            QSGVisualDataModel *dataModel = new QSGVisualDataModel(qmlContext(this));
+            dataModel->setReuseItems(d->reuseItems);
+            d->model = dataModel;
             d->ownModel = true;
         }
         if (QSGVisualDataModel *dataModel = qobject_cast<QSGVisualDataModel*>(d->model))
@@ -1033,7 +1036,9 @@ void QSGPathView::setDelegate(QDeclarativeComponent *delegate)
     if (delegate == this->delegate())
         return;
     if (!d->ownModel) {
-        d->model = new QSGVisualDataModel(qmlContext(this));
+        QSGVisualDataModel *dataModel = new QSGVisualDataModel(qmlContext(this));
+        dataModel->setReuseItems(d->reuseItems);
+        d->model = dataModel;
         d->ownModel = true;
     }
     if (QSGVisualDataModel *dataModel = qobject_cast<QSGVisualDataModel*>(d->model)) {
@@ -1072,6 +1077,40 @@ void QSGPathView::setPathItemCount(int i)
     emit pathItemCountChanged();
 }
 
+/*!
+  \qmlproperty bool QtQuick2::PathView::reuseItems
+  This property holds whether delegates that move off the path are reused.
+
+  When true, a delegate that is no longer needed is hidden and kept, rather than destroyed,
+  and is rebound to the next index that the view requests.  This is useful when
+  \l pathItemCount is less than the number of items in the model.  The \c index and model
+  role properties of a reused delegate change to those of its new index, and
+  \c model.reused() is emitted.
+
+  Only delegates created by the view for a \l ListModel or QAbstractItemModel model
+  are reused.  The default value is false.
+
+  \sa VisualDataModel::reuseItems
+*/
+bool QSGPathView::reuseItems() const
+{
+    Q_D(const QSGPathView);
+    return d->reuseItems;
+}
+
+void QSGPathView::setReuseItems(bool reuse)
+{
+    Q_D(QSGPathView);
+    if (d->reuseItems == reuse)
+        return;
+    d->reuseItems = reuse;
+    if (d->ownModel) {
+        if (QSGVisualDataModel *dataModel = qobject_cast<QSGVisualDataModel*>(d->model))
+            dataModel->setReuseItems(reuse);
+    }
+    emit reuseItemsChanged();
+}
+
 QPointF QSGPathViewPrivate::pointNear(const QPointF &point, qreal *nearPercent) const
 {
     //XXX maybe do recursively at increasing resolution.
@@ -83,6 +83,7 @@ class Q_AUTOTEST_EXPORT QSGPathView : public QSGItem
     Q_PROPERTY(int count READ count NOTIFY countChanged)
     Q_PROPERTY(QDeclarativeComponent *delegate READ delegate WRITE setDelegate NOTIFY delegateChanged)
     Q_PROPERTY(int pathItemCount READ pathItemCount WRITE setPathItemCount NOTIFY pathItemCountChanged)
+    Q_PROPERTY(bool reuseItems READ reuseItems WRITE setReuseItems NOTIFY reuseItemsChanged)
 
     Q_ENUMS(HighlightRangeMode)
 
@@ -141,6 +142,9 @@ public:
     int pathItemCount() const;
     void setPathItemCount(int);
 
+    bool reuseItems() const;
+    void setReuseItems(bool);
+
     static QSGPathViewAttached *qmlAttachedProperties(QObject *);
 
 public Q_SLOTS:
@@ -160,6 +164,7 @@ Q_SIGNALS:
     void snapPositionChanged();
     void delegateChanged();
     void pathItemCountChanged();
+    void reuseItemsChanged();
     void flickDecelerationChanged();
     void interactiveChanged();
     void movingChanged();
@@ -79,7 +79,7 @@ public:
         , lastElapsed(0), offset(0.0), offsetAdj(0.0), mappedRange(1.0)
         , stealMouse(false), ownModel(false), interactive(true), haveHighlightRange(true)
         , autoHighlight(true), highlightUp(false), layoutScheduled(false)
-        , moving(false), flicking(false)
+        , moving(false), flicking(false), reuseItems(false)
         , dragMargin(0), deceleration(100)
         , moveOffset(this, &QSGPathViewPrivate::setAdjustedOffset)
         , firstIndex(-1), pathItems(-1), requestedIndex(-1)
@@ -159,6 +159,7 @@ public:
     bool layoutScheduled : 1;
     bool moving : 1;
     bool flicking : 1;
+    bool reuseItems : 1;
     QElapsedTimer lastPosTime;
     QPointF lastPos;
     qreal dragMargin;
@@ -47,6 +47,8 @@
 #include <QtCore/qmath.h>
 #include <QtCore/qcoreapplication.h>
 
+#include <limits.h>
+
 #include <private/qdeclarativestate_p.h>
 #include <private/qdeclarativestategroup_p.h>
 #include <private/qdeclarativestateoperations_p.h>
@@ -169,7 +171,8 @@ void QSGBasePositioner::itemChange(ItemChange change, const ItemChangeData &valu
 {
     Q_D(QSGBasePositioner);
     if (change == ItemChildAddedChange){
-        prePositioning();
+        d->itemsDirty = true;
+        d->schedulePositioning();
     } else if (change == ItemChildRemovedChange) {
         QSGItem *child = value.item;
         QSGBasePositioner::PositionedItem posItem(child);
@@ -177,65 +180,139 @@ void QSGBasePositioner::itemChange(ItemChange change, const ItemChangeData &valu
         if (idx >= 0) {
             d->unwatchChanges(child);
             positionedItems.remove(idx);
+            if (idx < d->dirtyIndex)
+                d->dirtyIndex = idx;
         }
-        prePositioning();
+        d->schedulePositioning();
     }
 
     QSGItem::itemChange(change, value);
 }
 
+void QSGBasePositioner::updatePolish()
+{
+    Q_D(QSGBasePositioner);
+    QSGImplicitSizeItem::updatePolish();
+    if (d->queuedPositioning)
+        d->positionItems();
+}
+
+void QSGBasePositioner::timerEvent(QTimerEvent *event)
+{
+    Q_D(QSGBasePositioner);
+    if (event->timerId() == d->positioningTimer.timerId()) {
+        d->positioningTimer.stop();
+        if (d->queuedPositioning)
+            d->positionItems();
+        return;
+    }
+    QSGImplicitSizeItem::timerEvent(event);
+}
+
+/*!
+    Positions all children immediately.  This is used when a property of the positioner
+    itself changes, which may move any of them.
+*/
 void QSGBasePositioner::prePositioning()
 {
     Q_D(QSGBasePositioner);
-    if (!isComponentComplete())
+    d->itemsDirty = true;
+    d->dirtyIndex = 0;
+    d->positionItems();
+}
+
+bool QSGBasePositionerPrivate::isPositioned(QSGItem *child)
+{
+    // Items are only omitted from positioning if they are explicitly hidden
+    // i.e. their positioning is not affected if an ancestor is hidden.
+    return QSGItemPrivate::get(child)->explicitVisible && child->width() && child->height();
+}
+
+void QSGBasePositionerPrivate::updatePositionedState(QSGBasePositioner::PositionedItem *item)
+{
+    if (!isPositioned(item->item)) {
+        item->isVisible = false;
+    } else if (!item->isVisible) {
+        item->isVisible = true;
+        item->isNew = true;
+    } else {
+        item->isNew = false;
+    }
+}
+
+/*
+    Positions the children changed since the last positioning pass.  Only the items from
+    dirtyIndex on are updated; subclasses that can continue from the layout state recorded
+    in each PositionedItem only reposition those.
+*/
+void QSGBasePositionerPrivate::positionItems()
+{
+    Q_Q(QSGBasePositioner);
+    if (!q->isComponentComplete())
         return;
 
-    if (d->doingPositioning)
+    if (doingPositioning)
         return;
 
-    d->queuedPositioning = false;
-    d->doingPositioning = true;
-    //Need to order children by creation order modified by stacking order
-    QList<QSGItem *> children = childItems();
-
-    QPODVector<PositionedItem,8> oldItems;
-    positionedItems.copyAndClear(oldItems);
-    for (int ii = 0; ii < children.count(); ++ii) {
-        QSGItem *child = children.at(ii);
-        QSGItemPrivate *childPrivate = QSGItemPrivate::get(child);
-        PositionedItem *item = 0;
-        PositionedItem posItem(child);
-        int wIdx = oldItems.find(posItem);
-        if (wIdx < 0) {
-            d->watchChanges(child);
-            positionedItems.append(posItem);
-            item = &positionedItems[positionedItems.count()-1];
-            item->isNew = true;
-            if (!childPrivate->explicitVisible || !child->width() || !child->height())
-                item->isVisible = false;
-        } else {
-            item = &oldItems[wIdx];
-            // Items are only omitted from positioning if they are explicitly hidden
-            // i.e. their positioning is not affected if an ancestor is hidden.
-            if (!childPrivate->explicitVisible || !child->width() || !child->height()) {
-                item->isVisible = false;
-            } else if (!item->isVisible) {
-                item->isVisible = true;
-                item->isNew = true;
+    queuedPositioning = false;
+    positioningTimer.stop();
+    doingPositioning = true;
+
+    QPODVector<QSGBasePositioner::PositionedItem,8> &positionedItems = q->positionedItems;
+    if (itemsDirty) {
+        itemsDirty = false;
+
+        //Need to order children by creation order modified by stacking order
+        QList<QSGItem *> children = q->childItems();
+
+        QPODVector<QSGBasePositioner::PositionedItem,8> oldItems;
+        positionedItems.copyAndClear(oldItems);
+        int oldIdx = 0;
+        for (int ii = 0; ii < children.count(); ++ii) {
+            QSGItem *child = children.at(ii);
+            QSGBasePositioner::PositionedItem posItem(child);
+            // Children are usually in the same order as before, so check the next old item first
+            int wIdx = -1;
+            if (oldIdx < oldItems.count() && oldItems.at(oldIdx).item == child)
+                wIdx = oldIdx;
+            else
+                wIdx = oldItems.find(posItem);
+
+            if (wIdx != ii && ii < dirtyIndex)
+                dirtyIndex = ii;
+
+            if (wIdx < 0) {
+                watchChanges(child);
+                posItem.isNew = true;
+                posItem.isVisible = isPositioned(child);
+                positionedItems.append(posItem);
             } else {
-                item->isNew = false;
+                oldIdx = wIdx + 1;
+                QSGBasePositioner::PositionedItem *item = &oldItems[wIdx];
+                updatePositionedState(item);
+                positionedItems.append(*item);
             }
-            positionedItems.append(*item);
+        }
+        if (positionedItems.count() != oldItems.count() && positionedItems.count() < dirtyIndex)
+            dirtyIndex = positionedItems.count();
+    } else {
+        for (int ii = 0; ii < positionedItems.count(); ++ii) {
+            if (ii < dirtyIndex)
+                positionedItems[ii].isNew = false;
+            else
+                updatePositionedState(&positionedItems[ii]);
         }
     }
+
     QSizeF contentSize(0,0);
-    doPositioning(&contentSize);
-    if (!d->addActions.isEmpty() || !d->moveActions.isEmpty())
-        finishApplyTransitions();
-    d->doingPositioning = false;
+    q->doPositioning(&contentSize);
+    dirtyIndex = INT_MAX;
+    if (!addActions.isEmpty() || !moveActions.isEmpty())
+        q->finishApplyTransitions();
+    doingPositioning = false;
     //Set implicit size to the size of its children
-    setImplicitHeight(contentSize.height());
-    setImplicitWidth(contentSize.width());
+    q->setImplicitHeight(contentSize.height());
+    q->setImplicitWidth(contentSize.width());
 }
 
 void QSGBasePositioner::positionX(int x, const PositionedItem &target)
@@ -406,10 +483,21 @@ QSGColumn::QSGColumn(QSGItem *parent)
 
 void QSGColumn::doPositioning(QSizeF *contentSize)
 {
+    QSGBasePositionerPrivate *d = static_cast<QSGBasePositionerPrivate* >(QSGBasePositionerPrivate::get(this));
     int voffset = 0;
 
-    for (int ii = 0; ii < positionedItems.count(); ++ii) {
-        const PositionedItem &child = positionedItems.at(ii);
+    // Items before the first changed one keep their positions; continue from the one before
+    // it, as the spacing after it depends on whether it is the last item.
+    int start = qMax(0, qMin(d->dirtyIndex, positionedItems.count()) - 1);
+    if (start > 0) {
+        voffset = positionedItems.at(start).offset;
+        contentSize->setWidth(positionedItems.at(start).extent);
+    }
+
+    for (int ii = start; ii < positionedItems.count(); ++ii) {
+        PositionedItem &child = positionedItems[ii];
+        child.offset = voffset;
+        child.extent = contentSize->width();
         if (!child.item || !child.isVisible)
             continue;
 
@@ -604,9 +692,22 @@ void QSGRow::doPositioning(QSizeF *contentSize)
     QSGBasePositionerPrivate *d = static_cast<QSGBasePositionerPrivate* >(QSGBasePositionerPrivate::get(this));
     int hoffset = 0;
 
+    // Left to right, items before the first changed one keep their positions; continue from
+    // the one before it, as the spacing after it depends on whether it is the last item.
+    int start = 0;
+    if (d->isLeftToRight()) {
+        start = qMax(0, qMin(d->dirtyIndex, positionedItems.count()) - 1);
+        if (start > 0) {
+            hoffset = positionedItems.at(start).offset;
+            contentSize->setHeight(positionedItems.at(start).extent);
+        }
+    }
+
     QList<int> hoffsets;
-    for (int ii = 0; ii < positionedItems.count(); ++ii) {
-        const PositionedItem &child = positionedItems.at(ii);
+    for (int ii = start; ii < positionedItems.count(); ++ii) {
+        PositionedItem &child = positionedItems[ii];
+        child.offset = hoffset;
+        child.extent = contentSize->height();
         if (!child.item || !child.isVisible)
             continue;
 
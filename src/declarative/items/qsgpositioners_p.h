@@ -84,6 +84,8 @@ protected:
     QSGBasePositioner(QSGBasePositionerPrivate &dd, PositionerType at, QSGItem *parent);
     virtual void componentComplete();
     virtual void itemChange(ItemChange, const ItemChangeData &);
+    virtual void updatePolish();
+    virtual void timerEvent(QTimerEvent *);
     void finishApplyTransitions();
 
 Q_SIGNALS:
@@ -99,11 +101,15 @@ protected:
     virtual void reportConflictingAnchors()=0;
     class PositionedItem {
     public :
-        PositionedItem(QSGItem *i) : item(i), isNew(false), isVisible(true) {}
+        PositionedItem(QSGItem *i) : item(i), isNew(false), isVisible(true), offset(0), extent(0) {}
         bool operator==(const PositionedItem &other) const { return other.item == item; }
         QSGItem *item;
         bool isNew;
         bool isVisible;
+        // Layout state before this item in the last positioning pass, used by Column and Row
+        // to continue positioning from here.
+        int offset;    // offset along the positioning direction
+        qreal extent;  // largest size across the positioning direction
     };
 
     QPODVector<PositionedItem,8> positionedItems;
@@ -63,7 +63,7 @@
 
 #include <QtCore/qobject.h>
 #include <QtCore/qstring.h>
-#include <QtCore/qtimer.h>
+#include <QtCore/qbasictimer.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -75,7 +75,8 @@ public:
     QSGBasePositionerPrivate()
         : spacing(0), type(QSGBasePositioner::None)
         , moveTransition(0), addTransition(0), queuedPositioning(false)
-        , doingPositioning(false), anchorConflict(false), layoutDirection(Qt::LeftToRight)
+        , doingPositioning(false), anchorConflict(false), itemsDirty(true), dirtyIndex(0)
+        , layoutDirection(Qt::LeftToRight)
     {
     }
 
@@ -100,18 +101,40 @@ public:
     bool queuedPositioning : 1;
     bool doingPositioning : 1;
     bool anchorConflict : 1;
+    bool itemsDirty : 1;  // children were added, removed or reordered
+
+    // Index of the first positioned item whose position may have changed since the
+    // last positioning pass, or INT_MAX if none may have
+    int dirtyIndex;
+    QBasicTimer positioningTimer;
 
     Qt::LayoutDirection layoutDirection;
 
+    void positionItems();
+    static bool isPositioned(QSGItem *child);
+    static void updatePositionedState(QSGBasePositioner::PositionedItem *item);
+
+    // Changes to the children are collected and applied in a single positioning pass,
+    // either before the next frame is polished or when control returns to the event loop.
     void schedulePositioning()
     {
         Q_Q(QSGBasePositioner);
         if(!queuedPositioning){
-            QTimer::singleShot(0,q,SLOT(prePositioning()));
+            positioningTimer.start(0, q);
+            q->polish();
             queuedPositioning = true;
         }
     }
 
+    void itemChanged(QSGItem *item)
+    {
+        Q_Q(QSGBasePositioner);
+        int idx = q->positionedItems.find(QSGBasePositioner::PositionedItem(item));
+        if (idx >= 0 && idx < dirtyIndex)
+            dirtyIndex = idx;
+        schedulePositioning();
+    }
+
     void mirrorChange() {
         Q_Q(QSGBasePositioner);
         if (type != QSGBasePositioner::Vertical)
@@ -129,30 +152,34 @@ public:
         Q_UNUSED(other);
         //Delay is due to many children often being reordered at once
         //And we only want to reposition them all once
+        itemsDirty = true;
         schedulePositioning();
     }
 
-    void itemGeometryChanged(QSGItem *, const QRectF &newGeometry, const QRectF &oldGeometry)
+    void itemGeometryChanged(QSGItem *item, const QRectF &newGeometry, const QRectF &oldGeometry)
     {
-        Q_Q(QSGBasePositioner);
         if (newGeometry.size() != oldGeometry.size())
-            q->prePositioning();
+            itemChanged(item);
     }
 
-    virtual void itemVisibilityChanged(QSGItem *)
+    virtual void itemVisibilityChanged(QSGItem *item)
     {
-        schedulePositioning();
+        itemChanged(item);
     }
-    virtual void itemOpacityChanged(QSGItem *)
+    virtual void itemOpacityChanged(QSGItem *item)
     {
-        Q_Q(QSGBasePositioner);
-        q->prePositioning();
+        itemChanged(item);
     }
 
     void itemDestroyed(QSGItem *item)
     {
         Q_Q(QSGBasePositioner);
-        q->positionedItems.removeOne(QSGBasePositioner::PositionedItem(item));
+        int idx = q->positionedItems.find(QSGBasePositioner::PositionedItem(item));
+        if (idx >= 0) {
+            q->positionedItems.remove(idx);
+            if (idx < dirtyIndex)
+                dirtyIndex = idx;
+        }
     }
 
     static Qt::LayoutDirection getLayoutDirection(const QSGBasePositioner *positioner)
@@ -106,8 +106,9 @@ QSGTextPrivate::QSGTextPrivate()
   imageCacheDirty(false), updateOnComponentComplete(true),
   richText(false), singleline(false), cacheAllTextAsImage(true), internalWidthUpdate(false),
   requireImplicitWidth(false), truncated(false), hAlignImplicit(true), rightToLeftText(false),
-  layoutTextElided(false), richTextAsImage(false), textureImageCacheDirty(false), naturalWidth(0),
-  doc(0), layoutThread(0), nodeType(NodeIsNull)
+  richTextAsImage(false), textureImageCacheDirty(false), asynchronous(false),
+  layoutRequested(false), naturalWidth(0), doc(0), layoutSerial(0), layoutThread(0),
+  nodeType(NodeIsNull)
 {
     cacheAllTextAsImage = enableImageCache();
 }
@@ -220,32 +221,12 @@ void QSGTextPrivate::updateLayout()
         return;
     }
 
-    layoutTextElided = false;
-    // Setup instance of QTextLayout for all cases other than richtext
+    // The QTextLayout for all cases other than richtext is set up by updateSize()
     if (!richText) {
-        layout.clearLayout();
-        layout.setFont(font);
-        if (format != QSGText::StyledText) {
-            QString tmp = text;
-            tmp.replace(QLatin1Char('\n'), QChar::LineSeparator);
-            singleline = !tmp.contains(QChar::LineSeparator);
-            if (singleline && !maximumLineCountValid && elideMode != QSGText::ElideNone && q->widthValid()) {
-                QFontMetrics fm(font);
-                tmp = fm.elidedText(tmp,(Qt::TextElideMode)elideMode,q->width());
-                if (tmp != text) {
-                    layoutTextElided = true;
-                    if (!truncated) {
-                        truncated = true;
-                        emit q->truncatedChanged();
-                    }
-                }
-            }
-            layout.setText(tmp);
-        } else {
-            singleline = false;
-            QDeclarativeStyledText::parse(text, layout);
-        }
+        singleline = format != QSGText::StyledText
+                     && !text.contains(QLatin1Char('\n')) && !text.contains(QChar::LineSeparator);
     } else {
+        layout.clear();
         ensureDoc();
         QTextBlockFormat::LineHeightTypes type;
         type = lineHeightMode == QSGText::FixedHeight ? QTextBlockFormat::FixedHeight : QTextBlockFormat::ProportionalHeight;
@@ -276,6 +257,9 @@ void QSGTextPrivate::updateSize()
             return;
     }
 
+    // Any result of an earlier asynchronous layout is now out of date
+    ++layoutSerial;
+
     invalidateImageCache();
 
     QFontMetrics fm(font);
@@ -288,18 +272,22 @@ void QSGTextPrivate::updateSize()
         return;
     }
 
-    int dy = q->height();
-    QSize size(0, 0);
-
-    layoutThread = QThread::currentThread();
-
     //setup instance of QTextLayout for all cases other than richtext
     if (!richText) {
-        QRect textRect = setupTextLayout();
-        layedOutTextRect = textRect;
-        size = textRect.size();
-        dy -= size.height();
+        if (asynchronous && QThread::currentThread() == q->thread()) {
+            // The size is updated by applyAsynchronousLayout() once the text is laid out
+            layoutRequested = true;
+            QSGTextLayoutCache::requestLayout(q, textLayoutKey(), layoutSerial);
+            return;
+        }
+
+        layoutThread = QThread::currentThread();
+        layoutKey = textLayoutKey();
+        layout = QSGTextLayoutCache::layout(layoutKey);
+        layedOutTextRect = applyTextLayout();
+        updateImplicitSize(layedOutTextRect.size(), layedOutTextRect.height());
     } else {
+        layoutThread = QThread::currentThread();
         singleline = false; // richtext can't elide or be optimized for single-line case
         ensureDoc();
         doc->setDefaultFont(font);
@@ -322,11 +310,22 @@ void QSGTextPrivate::updateSize()
             doc->setTextWidth(q->width());
         else
             doc->setTextWidth(doc->idealWidth()); // ### Text does not align if width is not set (QTextDoc bug)
-        dy -= (int)doc->size().height();
         QSize dsize = doc->size().toSize();
         layedOutTextRect = QRect(QPoint(0,0), dsize);
-        size = QSize(int(doc->idealWidth()),dsize.height());
+        updateImplicitSize(QSize(int(doc->idealWidth()),dsize.height()), (int)doc->size().height());
     }
+}
+
+/*!
+    Updates the implicit and painted size of the item to \a size once the text has been laid
+    out.  \a textHeight is the height used to align the text vertically.
+*/
+void QSGTextPrivate::updateImplicitSize(const QSize &size, int textHeight)
+{
+    Q_Q(QSGText);
+
+    QFontMetrics fm(font);
+    int dy = q->height() - textHeight;
     int yoff = 0;
 
     if (q->heightValid()) {
@@ -354,140 +353,86 @@ void QSGTextPrivate::updateSize()
 }
 
 /*!
-    Lays out the QSGTextPrivate::layout QTextLayout in the constraints of the QSGText.
+    Returns the key describing the text in the constraints of the QSGText.  Text laid out
+    with the same key is shared with any other text laid out the same way.
+*/
+QSGTextLayoutCache::Key QSGTextPrivate::textLayoutKey() const
+{
+    Q_Q(const QSGText);
+
+    QSGTextLayoutCache::Key key;
+    key.text = text;
+    key.font = font;
+    key.format = format;
+    key.wrapMode = wrapMode;
+    key.elideMode = elideMode;
+    key.hAlign = q->effectiveHAlign();
+    key.lineHeightMode = lineHeightMode;
+    key.lineHeight = lineHeight;
+    key.widthValid = q->widthValid();
+    key.width = key.widthValid ? q->width() : 0;
+    key.maximumLineCount = maximumLineCountValid ? maximumLineCount : -1;
+    key.requireImplicitWidth = requireImplicitWidth;
+    return key;
+}
+
+/*!
+    Updates the properties of the QSGText derived from the current layout.
 
     Returns the size of the final text.  This can be used to position the text vertically (the text is
     already absolutely positioned horizontally).
 */
-QRect QSGTextPrivate::setupTextLayout()
+QRect QSGTextPrivate::applyTextLayout()
 {
-    // ### text layout handling should be profiled and optimized as needed
-    // what about QStackTextEngine engine(tmp, d->font.font()); QTextLayout textLayout(&engine);
     Q_Q(QSGText);
-    layout.setCacheEnabled(true);
-
-    qreal lineWidth = 0;
-    int visibleCount = 0;
-
-    //set manual width
-    if (q->widthValid())
-        lineWidth = q->width();
-
-    QTextOption textOption = layout.textOption();
-    textOption.setAlignment(Qt::Alignment(q->effectiveHAlign()));
-    textOption.setWrapMode(QTextOption::WrapMode(wrapMode));
-    layout.setTextOption(textOption);
-
-    bool elideText = false;
-    bool truncate = false;
-
-    QFontMetrics fm(layout.font());
-    elidePos = QPointF();
-
-    if (requireImplicitWidth && q->widthValid()) {
-        // requires an extra layout
-        QString elidedText;
-        if (layoutTextElided) {
-            // We have provided elided text to the layout, but we must calculate unelided width.
-            elidedText = layout.text();
-            layout.setText(text);
-        }
-        layout.beginLayout();
-        forever {
-            QTextLine line = layout.createLine();
-            if (!line.isValid())
-                break;
-        }
-        layout.endLayout();
-        QRectF br;
-        for (int i = 0; i < layout.lineCount(); ++i) {
-            QTextLine line = layout.lineAt(i);
-            br = br.united(line.naturalTextRect());
-        }
-        naturalWidth = br.width();
-        if (layoutTextElided)
-            layout.setText(elidedText);
-    }
-
-    if (maximumLineCountValid) {
-        layout.beginLayout();
-        if (!lineWidth)
-            lineWidth = INT_MAX;
-        int linesLeft = maximumLineCount;
-        int visibleTextLength = 0;
-        while (linesLeft > 0) {
-            QTextLine line = layout.createLine();
-            if (!line.isValid())
-                break;
-
-            visibleCount++;
-            if (lineWidth)
-                line.setLineWidth(lineWidth);
-            visibleTextLength += line.textLength();
-
-            if (--linesLeft == 0) {
-                if (visibleTextLength < text.length()) {
-                    truncate = true;
-                    if (elideMode==QSGText::ElideRight && q->widthValid()) {
-                        qreal elideWidth = fm.width(elideChar);
-                        // Need to correct for alignment
-                        line.setLineWidth(lineWidth-elideWidth);
-                        if (layout.text().mid(line.textStart(), line.textLength()).isRightToLeft()) {
-                            line.setPosition(QPointF(line.position().x() + elideWidth, line.position().y()));
-                            elidePos.setX(line.naturalTextRect().left() - elideWidth);
-                        } else {
-                            elidePos.setX(line.naturalTextRect().right());
-                        }
-                        elideText = true;
-                    }
-                }
-            }
-        }
-        layout.endLayout();
 
-        //Update truncated
-        if (truncated != truncate) {
-            truncated = truncate;
-            emit q->truncatedChanged();
-        }
-    } else {
-        layout.beginLayout();
-        forever {
-            QTextLine line = layout.createLine();
-            if (!line.isValid())
-                break;
-            visibleCount++;
-            if (lineWidth)
-                line.setLineWidth(lineWidth);
-        }
-        layout.endLayout();
+    //Update truncated
+    if (layout->elided && !truncated) {
+        truncated = true;
+        emit q->truncatedChanged();
     }
-
-    qreal height = 0;
-    QRectF br;
-    for (int i = 0; i < layout.lineCount(); ++i) {
-        QTextLine line = layout.lineAt(i);
-        // set line spacing
-        line.setPosition(QPointF(line.position().x(), height));
-        if (elideText && i == layout.lineCount()-1) {
-            elidePos.setY(height + fm.ascent());
-            br = br.united(QRectF(elidePos, QSizeF(fm.width(elideChar), fm.ascent())));
-        }
-        br = br.united(line.naturalTextRect());
-        height += (lineHeightMode == QSGText::FixedHeight) ? lineHeight : line.height() * lineHeight;
+    if (maximumLineCountValid && truncated != layout->truncated) {
+        truncated = layout->truncated;
+        emit q->truncatedChanged();
     }
-    br.setHeight(height);
 
-    if (!q->widthValid())
-        naturalWidth = br.width();
+    elidePos = layout->elidePos;
+    if (layout->naturalWidthValid)
+        naturalWidth = layout->naturalWidth;
 
     //Update the number of visible lines
-    if (lineCount != visibleCount) {
-        lineCount = visibleCount;
+    if (lineCount != layout->lineCount) {
+        lineCount = layout->lineCount;
         emit q->lineCountChanged();
     }
 
-    return QRect(qRound(br.x()), qRound(br.y()), qCeil(br.width()), qCeil(br.height()));
+    return layout->rect;
+}
+
+/*!
+    Sizes the item for the text laid out by the layout thread as \a key.  The glyph runs of
+    the layout are drawn as they are, so the text is not laid out again in the painting thread.
+*/
+void QSGTextPrivate::applyAsynchronousLayout(const QSGTextLayoutCache::Key &key,
+                                             const QSGTextLayoutCache::LayoutPointer &newLayout)
+{
+    layoutThread = 0;
+    layoutKey = key;
+    layout = newLayout;
+    invalidateImageCache();
+    layedOutTextRect = applyTextLayout();
+    updateImplicitSize(layedOutTextRect.size(), layedOutTextRect.height());
+}
+
+/*!
+    Ensures the QSGTextPrivate::layout QTextLayout was shaped by the fonts of the current
+    thread, as those laid out by the layout thread are not.  This is only needed to paint
+    the layout with QPainter; the glyph runs can be drawn from any thread.
+*/
+void QSGTextPrivate::ensureLocalLayout()
+{
+    if (layout && layout->thread != QThread::currentThread())
+        layout = QSGTextLayoutCache::layout(layoutKey);
 }
 
 /*!
@@ -526,7 +471,9 @@ void QSGTextPrivate::drawTextLayout(QPainter *painter, const QPointF &pos, bool
     else
         painter->setPen(color);
     painter->setFont(font);
-    layout.draw(painter, pos);
+    ensureLocalLayout();
+    if (layout)
+        layout->layout.draw(painter, pos);
     if (!elidePos.isNull())
         painter->drawText(pos + elidePos, elideChar);
 }
@@ -747,6 +694,9 @@ QSGText::QSGText(QSGItem *parent)
 
 QSGText::~QSGText()
 {
+    Q_D(QSGText);
+    if (d->layoutRequested)
+        QSGTextLayoutCache::cancelLayouts(this);
 }
 
 /*!
@@ -1479,8 +1429,9 @@ QSGNode *QSGText::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data)
 
     QRectF bounds = boundingRect();
 
-    // We need to make sure the layout is done in the current thread
-    if (d->layoutThread != QThread::currentThread())
+    // We need to make sure the layout is done in the current thread.  There is no layout
+    // thread for text laid out asynchronously, as its glyph runs can be drawn from any thread.
+    if (d->layoutThread && d->layoutThread != QThread::currentThread())
         d->updateLayout();
 
     // XXX todo - some styled text can be done by the QSGTextNode
@@ -1538,8 +1489,9 @@ QSGNode *QSGText::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data)
             d->ensureDoc();
             node->addTextDocument(bounds.topLeft(), d->doc, QColor(), d->style, d->styleColor);
 
-        } else {
-            node->addTextLayout(QPoint(0, bounds.y()), &d->layout, d->color, d->style, d->styleColor);
+        } else if (d->layout) {
+            node->addGlyphRuns(QPoint(0, bounds.y()), d->layout->glyphRuns(), d->layout->layout.font(),
+                               d->layout->layout.boundingRect().width(), d->color, d->style, d->styleColor);
         }
 
         return node;
@@ -1552,6 +1504,11 @@ bool QSGText::event(QEvent *e)
     if (e->type() == QEvent::User) {
         d->checkImageCache();
         return true;
+    } else if (e->type() == QSGTextLayoutEvent::layoutEventType()) {
+        QSGTextLayoutEvent *layoutEvent = static_cast<QSGTextLayoutEvent *>(e);
+        if (layoutEvent->serial == d->layoutSerial)
+            d->applyAsynchronousLayout(layoutEvent->key, layoutEvent->layout);
+        return true;
     } else {
         return QSGImplicitSizeItem::event(e);
     }
@@ -1638,6 +1595,35 @@ void QSGText::setLineHeightMode(LineHeightMode mode)
     emit lineHeightModeChanged(mode);
 }
 
+/*!
+    \qmlproperty bool QtQuick2::Text::asynchronous
+
+    Specifies that plain and styled text should be laid out asynchronously in a separate
+    thread.  The default value is false, causing the user interface thread to block while
+    the text is laid out.  Setting \a asynchronous to true is useful where large amounts of
+    text are created at once, for example when filling a view with long paragraphs, and
+    maintaining a responsive user interface is more desirable than having the text
+    immediately sized and visible.
+
+    Until the text has been laid out the item keeps the size and contents of its previous
+    text.  Rich text is always laid out synchronously.
+*/
+bool QSGText::asynchronous() const
+{
+    Q_D(const QSGText);
+    return d->asynchronous;
+}
+
+void QSGText::setAsynchronous(bool asynchronous)
+{
+    Q_D(QSGText);
+    if (asynchronous == d->asynchronous)
+        return;
+
+    d->asynchronous = asynchronous;
+    emit asynchronousChanged();
+}
+
 /*!
     Returns the number of resources (images) that are being loaded asynchronously.
 */
@@ -85,6 +85,7 @@ class Q_DECLARATIVE_PRIVATE_EXPORT QSGText : public QSGImplicitSizeItem
     Q_PROPERTY(qreal paintedHeight READ paintedHeight NOTIFY paintedSizeChanged)
     Q_PROPERTY(qreal lineHeight READ lineHeight WRITE setLineHeight NOTIFY lineHeightChanged)
     Q_PROPERTY(LineHeightMode lineHeightMode READ lineHeightMode WRITE setLineHeightMode NOTIFY lineHeightModeChanged)
+    Q_PROPERTY(bool asynchronous READ asynchronous WRITE setAsynchronous NOTIFY asynchronousChanged)
 
 public:
     QSGText(QSGItem *parent=0);
@@ -164,6 +165,9 @@ public:
     LineHeightMode lineHeightMode() const;
     void setLineHeightMode(LineHeightMode);
 
+    bool asynchronous() const;
+    void setAsynchronous(bool);
+
     virtual void componentComplete();
 
     int resourcesLoading() const; // mainly for testing
@@ -192,6 +196,7 @@ Q_SIGNALS:
     void lineHeightChanged(qreal lineHeight);
     void lineHeightModeChanged(LineHeightMode mode);
     void effectiveHorizontalAlignmentChanged();
+    void asynchronousChanged();
 
 protected:
     void mousePressEvent(QGraphicsSceneMouseEvent *event);
@@ -56,6 +56,7 @@
 
 #include "qsgitem.h"
 #include "qsgimplicitsizeitem_p_p.h"
+#include "qsgtextlayoutcache_p.h"
 
 #include <QtDeclarative/qdeclarative.h>
 #include <QtGui/qtextlayout.h>
@@ -117,9 +118,10 @@ public:
     bool truncated:1;
     bool hAlignImplicit:1;
     bool rightToLeftText:1;
-    bool layoutTextElided:1;
     bool richTextAsImage:1;
     bool textureImageCacheDirty:1;
+    bool asynchronous:1;
+    bool layoutRequested:1;
 
     QRect layedOutTextRect;
     QSize paintedSize;
@@ -130,11 +132,17 @@ public:
     QPixmap textDocumentImage(bool drawStyle);
     QSGTextDocumentWithImageResources *doc;
 
-    QRect setupTextLayout();
+    QSGTextLayoutCache::Key textLayoutKey() const;
+    QRect applyTextLayout();
+    void applyAsynchronousLayout(const QSGTextLayoutCache::Key &, const QSGTextLayoutCache::LayoutPointer &);
+    void ensureLocalLayout();
+    void updateImplicitSize(const QSize &size, int textHeight);
     QPixmap textLayoutImage(bool drawStyle);
     void drawTextLayout(QPainter *p, const QPointF &pos, bool drawStyle);
-    QTextLayout layout;
-    QThread *layoutThread;
+    QSGTextLayoutCache::LayoutPointer layout;
+    QSGTextLayoutCache::Key layoutKey;   // the key of layout
+    int layoutSerial;                    // identifies the latest asynchronous layout request
+    QThread *layoutThread;               // 0 if laid out by the layout thread
 
     static QPixmap drawOutline(const QPixmap &source, const QPixmap &styleSource);
     static QPixmap drawOutline(const QPixmap &source, const QPixmap &styleSource, int yOffset);
@@ -0,0 +1,461 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the QtDeclarative module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qsgtextlayoutcache_p.h"
+#include "qsgtext_p_p.h"
+
+#include <private/qdeclarativestyledtext_p.h>
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadstorage.h>
+#include <QtCore/qwaitcondition.h>
+#include <QtGui/qfontmetrics.h>
+
+#include <qmath.h>
+#include <limits.h>
+
+QT_BEGIN_NAMESPACE
+
+// The cache limit is the number of characters of text each thread keeps laid out.
+static int layoutCacheLimit = 64 * 1024;
+static QThreadStorage<QSGTextLayoutCache *> layoutCaches;
+
+// Lays out the text of asynchronous text items, one request at a time.  Results are posted
+// back to the requesting item as a QSGTextLayoutEvent.
+class QSGTextLayoutThread : public QThread
+{
+public:
+    QSGTextLayoutThread();
+    ~QSGTextLayoutThread();
+
+    void request(QSGText *, const QSGTextLayoutCache::Key &, int serial);
+    void cancel(QSGText *);
+
+protected:
+    virtual void run();
+
+private:
+    struct Job {
+        QSGTextLayoutCache::Key key;
+        int serial;
+    };
+
+    QHash<QSGText *, Job> jobs;  // the pending request of each item
+    QList<QSGText *> queue;      // items in the order they requested, may hold cancelled items
+    QSGText *current;  // the item whose job is being laid out, 0 if it was cancelled
+    bool quit;
+    QMutex mutex;
+    QWaitCondition waitCondition;
+};
+
+Q_GLOBAL_STATIC(QSGTextLayoutThread, textLayoutThread)
+
+QSGTextLayoutThread::QSGTextLayoutThread()
+: current(0), quit(false)
+{
+    // Register the event type before there is a thread that could race to do it
+    QSGTextLayoutEvent::layoutEventType();
+}
+
+QSGTextLayoutThread::~QSGTextLayoutThread()
+{
+    mutex.lock();
+    quit = true;
+    jobs.clear();
+    queue.clear();
+    waitCondition.wakeAll();
+    mutex.unlock();
+    wait();
+}
+
+void QSGTextLayoutThread::request(QSGText *item, const QSGTextLayoutCache::Key &key, int serial)
+{
+    QMutexLocker locker(&mutex);
+
+    // A newer request replaces one that has not been started yet
+    QHash<QSGText *, Job>::iterator it = jobs.find(item);
+    if (it != jobs.end()) {
+        it->key = key;
+        it->serial = serial;
+        return;
+    }
+
+    Job job;
+    job.key = key;
+    job.serial = serial;
+    jobs.insert(item, job);
+    queue.append(item);
+
+    if (!isRunning())
+        start(QThread::LowPriority);
+    waitCondition.wakeOne();
+}
+
+void QSGTextLayoutThread::cancel(QSGText *item)
+{
+    QMutexLocker locker(&mutex);
+    // The item is skipped when it reaches the front of the queue
+    jobs.remove(item);
+    if (jobs.isEmpty())
+        queue.clear();
+    if (current == item)
+        current = 0;
+}
+
+void QSGTextLayoutThread::run()
+{
+    QMutexLocker locker(&mutex);
+    forever {
+        while (!quit && jobs.isEmpty())
+            waitCondition.wait(&mutex);
+        if (quit)
+            return;
+
+        QSGText *item = queue.takeFirst();
+        QHash<QSGText *, Job>::iterator it = jobs.find(item);
+        if (it == jobs.end())
+            continue;
+        Job job = *it;
+        jobs.erase(it);
+        current = item;
+
+        locker.unlock();
+        QSGTextLayoutCache::LayoutPointer layout = QSGTextLayoutCache::layout(job.key);
+        // The glyph runs are extracted here so that the item can draw them without shaping
+        // the text again, and so that they are never written once the layout is shared.
+        layout->glyphRuns();
+        locker.relock();
+
+        // The item is only posted to while it is known to be alive; cancel() must take the mutex
+        if (current == item)
+            QCoreApplication::postEvent(item, new QSGTextLayoutEvent(job.serial, job.key, layout));
+        current = 0;
+    }
+}
+
+QSGTextLayoutEvent::QSGTextLayoutEvent(int serial, const QSGTextLayoutCache::Key &key,
+                                       const QSGTextLayoutCache::LayoutPointer &layout)
+: QEvent(layoutEventType()), serial(serial), key(key), layout(layout)
+{
+}
+
+QEvent::Type QSGTextLayoutEvent::layoutEventType()
+{
+    static int type = QEvent::registerEventType();
+    return QEvent::Type(type);
+}
+
+QSGTextLayoutCache::Key::Key()
+: format(QSGText::AutoText), wrapMode(QSGText::NoWrap), elideMode(QSGText::ElideNone),
+  hAlign(QSGText::AlignLeft), lineHeightMode(QSGText::ProportionalHeight), lineHeight(1),
+  width(0), maximumLineCount(-1), widthValid(false), requireImplicitWidth(false)
+{
+}
+
+bool QSGTextLayoutCache::Key::operator==(const Key &other) const
+{
+    return text == other.text && font == other.font && format == other.format &&
+           wrapMode == other.wrapMode && elideMode == other.elideMode && hAlign == other.hAlign &&
+           lineHeightMode == other.lineHeightMode && lineHeight == other.lineHeight &&
+           width == other.width && maximumLineCount == other.maximumLineCount &&
+           widthValid == other.widthValid && requireImplicitWidth == other.requireImplicitWidth;
+}
+
+uint qHash(const QSGTextLayoutCache::Key &key)
+{
+    return qHash(key.text) ^ qHash(key.font.key()) ^ uint(key.width) ^ 
+           (uint(key.format) << 8) ^ (uint(key.wrapMode) << 12) ^ (uint(key.elideMode) << 16) ^ 
+           (uint(key.hAlign) << 20) ^ (uint(key.maximumLineCount) << 24);
+}
+
+QSGTextLayoutCache::QSGTextLayoutCache()
+: m_layouts(layoutCacheLimit)
+{
+}
+
+QSGTextLayoutCache *QSGTextLayoutCache::instance()
+{
+    if (!layoutCaches.hasLocalData())
+        layoutCaches.setLocalData(new QSGTextLayoutCache);
+    QSGTextLayoutCache *cache = layoutCaches.localData();
+    if (cache->m_layouts.maxCost() != layoutCacheLimit)
+        cache->m_layouts.setMaxCost(layoutCacheLimit);
+    return cache;
+}
+
+/*!
+Returns the text laid out as described by \a key, from the cache of the current thread if
+possible.
+*/
+QSGTextLayoutCache::LayoutPointer QSGTextLayoutCache::layout(const Key &key)
+{
+    QSGTextLayoutCache *cache = instance();
+
+    if (LayoutPointer *cached = cache->m_layouts.object(key)) {
+        ++cache->m_statistics.hits;
+        return *cached;
+    }
+
+    ++cache->m_statistics.misses;
+    LayoutPointer layout(new Layout);
+    setupLayout(key, layout.data());
+    cache->m_layouts.insert(key, new LayoutPointer(layout), layoutCost(key));
+    return layout;
+}
+
+/*
+Returns the cost of caching the layout of \a key.  The glyphs, lines and formats of a layout
+grow with the length of its text, so a layout is costed by that length.
+*/
+int QSGTextLayoutCache::layoutCost(const Key &key)
+{
+    return qMax(1, key.text.length());
+}
+
+/*!
+Lays out the text described by \a key in the layout thread.  Once laid out, a
+QSGTextLayoutEvent carrying \a serial and the layout is posted to \a item.
+
+The glyph runs of the layout are extracted in the layout thread and can be drawn from any
+thread; they keep the font engines of the layout thread alive.  The QTextLayout itself is
+bound to the fonts of the layout thread, so painting it with QPainter requires the text to
+be laid out again with layout() in the painting thread.
+*/
+void QSGTextLayoutCache::requestLayout(QSGText *item, const Key &key, int serial)
+{
+    if (QSGTextLayoutThread *thread = textLayoutThread())
+        thread->request(item, key, serial);
+}
+
+/*!
+Cancels all layouts requested for \a item.  No QSGTextLayoutEvent will be posted to
+\a item once this returns.
+*/
+void QSGTextLayoutCache::cancelLayouts(QSGText *item)
+{
+    if (QSGTextLayoutThread *thread = textLayoutThread())
+        thread->cancel(item);
+}
+
+/*!
+Sets the maximum number of characters of text cached by each thread to \a limit.  A text
+longer than \a limit is never cached, and a \a limit of 0 disables caching.
+*/
+void QSGTextLayoutCache::setCacheLimit(int limit)
+{
+    layoutCacheLimit = limit;
+    instance();
+}
+
+int QSGTextLayoutCache::cacheLimit()
+{
+    return layoutCacheLimit;
+}
+
+/*!
+Returns the statistics of the cache of the current thread.
+*/
+QSGTextLayoutCache::CacheStatistics QSGTextLayoutCache::cacheStatistics()
+{
+    QSGTextLayoutCache *cache = instance();
+    CacheStatistics statistics = cache->m_statistics;
+    statistics.count = cache->m_layouts.count();
+    statistics.cost = cache->m_layouts.totalCost();
+    return statistics;
+}
+
+void QSGTextLayoutCache::resetCacheStatistics()
+{
+    instance()->m_statistics = CacheStatistics();
+}
+
+/*
+Lays out the text described by \a key into \a l, eliding it if necessary.  The 
+position of each line is set and the size of the final text stored.
+*/
+void QSGTextLayoutCache::setupLayout(const Key &key, Layout *l)
+{
+    QTextLayout &layout = l->layout;
+    layout.setCacheEnabled(true);
+    layout.setFont(key.font);
+
+    l->naturalWidth = 0;
+    l->lineCount = 0;
+    l->naturalWidthValid = false;
+    l->elided = false;
+    l->truncated = false;
+    l->glyphRunsValid = false;
+    l->thread = QThread::currentThread();
+
+    QFontMetrics fm(key.font);
+    bool maximumLineCountValid = key.maximumLineCount != -1;
+
+    if (key.format != QSGText::StyledText) {
+        QString tmp = key.text;
+        tmp.replace(QLatin1Char('\n'), QChar::LineSeparator);
+        bool singleline = !tmp.contains(QChar::LineSeparator);
+        if (singleline && !maximumLineCountValid && key.elideMode != QSGText::ElideNone && key.widthValid) {
+            tmp = fm.elidedText(tmp,(Qt::TextElideMode)key.elideMode,key.width);
+            l->elided = tmp != key.text;
+        }
+        layout.setText(tmp);
+    } else {
+        QDeclarativeStyledText::parse(key.text, layout);
+    }
+
+    qreal lineWidth = 0;
+    int visibleCount = 0;
+
+    //set manual width
+    if (key.widthValid)
+        lineWidth = key.width;
+
+    QTextOption textOption = layout.textOption();
+    textOption.setAlignment(Qt::Alignment(key.hAlign));
+    textOption.setWrapMode(QTextOption::WrapMode(key.wrapMode));
+    layout.setTextOption(textOption);
+
+    bool elideText = false;
+    const QString &elideChar = QSGTextPrivate::elideChar;
+
+    if (key.requireImplicitWidth && key.widthValid) {
+        // requires an extra layout
+        QString elidedText;
+        if (l->elided) {
+            // We have provided elided text to the layout, but we must calculate unelided width.
+            elidedText = layout.text();
+            layout.setText(key.text);
+        }
+        layout.beginLayout();
+        forever {
+            QTextLine line = layout.createLine();
+            if (!line.isValid())
+                break;
+        }
+        layout.endLayout();
+        QRectF br;
+        for (int i = 0; i < layout.lineCount(); ++i) {
+            QTextLine line = layout.lineAt(i);
+            br = br.united(line.naturalTextRect());
+        }
+        l->naturalWidth = br.width();
+        l->naturalWidthValid = true;
+        if (l->elided)
+            layout.setText(elidedText);
+    }
+
+    if (maximumLineCountValid) {
+        layout.beginLayout();
+        if (!lineWidth)
+            lineWidth = INT_MAX;
+        int linesLeft = key.maximumLineCount;
+        int visibleTextLength = 0;
+        while (linesLeft > 0) {
+            QTextLine line = layout.createLine();
+            if (!line.isValid())
+                break;
+
+            visibleCount++;
+            if (lineWidth)
+                line.setLineWidth(lineWidth);
+            visibleTextLength += line.textLength();
+
+            if (--linesLeft == 0) {
+                if (visibleTextLength < key.text.length()) {
+                    l->truncated = true;
+                    if (key.elideMode==QSGText::ElideRight && key.widthValid) {
+                        qreal elideWidth = fm.width(elideChar);
+                        // Need to correct for alignment
+                        line.setLineWidth(lineWidth-elideWidth);
+                        if (layout.text().mid(line.textStart(), line.textLength()).isRightToLeft()) {
+                            line.setPosition(QPointF(line.position().x() + elideWidth, line.position().y()));
+                            l->elidePos.setX(line.naturalTextRect().left() - elideWidth);
+                        } else {
+                            l->elidePos.setX(line.naturalTextRect().right());
+                        }
+                        elideText = true;
+                    }
+                }
+            }
+        }
+        layout.endLayout();
+    } else {
+        layout.beginLayout();
+        forever {
+            QTextLine line = layout.createLine();
+            if (!line.isValid())
+                break;
+            visibleCount++;
+            if (lineWidth)
+                line.setLineWidth(lineWidth);
+        }
+        layout.endLayout();
+    }
+
+    qreal height = 0;
+    QRectF br;
+    for (int i = 0; i < layout.lineCount(); ++i) {
+        QTextLine line = layout.lineAt(i);
+        // set line spacing
+        line.setPosition(QPointF(line.position().x(), height));
+        if (elideText && i == layout.lineCount()-1) {
+            l->elidePos.setY(height + fm.ascent());
+            br = br.united(QRectF(l->elidePos, QSizeF(fm.width(elideChar), fm.ascent())));
+        }
+        br = br.united(line.naturalTextRect());
+        height += (key.lineHeightMode == QSGText::FixedHeight) ? key.lineHeight : line.height() * key.lineHeight;
+    }
+    br.setHeight(height);
+
+    if (!key.widthValid) {
+        l->naturalWidth = br.width();
+        l->naturalWidthValid = true;
+    }
+
+    l->lineCount = visibleCount;
+    l->rect = QRect(qRound(br.x()), qRound(br.y()), qCeil(br.width()), qCeil(br.height()));
+}
+
+QT_END_NAMESPACE
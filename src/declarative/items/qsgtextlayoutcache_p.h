@@ -0,0 +1,173 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the QtDeclarative module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSGTEXTLAYOUTCACHE_P_H
+#define QSGTEXTLAYOUTCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qsgtext_p.h"
+
+#include <QtCore/qcache.h>
+#include <QtCore/qcoreevent.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtGui/qfont.h>
+#include <QtGui/qglyphrun.h>
+#include <QtGui/qtextlayout.h>
+
+QT_BEGIN_NAMESPACE
+
+class QThread;
+
+// Lays out plain and styled text for QSGText.  Layouts are shared by all text items with the
+// same text and layout constraints, so repeated labels are only laid out once.  Laid out text
+// is bound to the fonts of the thread that laid it out, so each thread has its own cache.
+// Cached layouts are costed by the length of their text, so a few long texts cannot pin
+// more memory than many short labels.
+class Q_DECLARATIVE_PRIVATE_EXPORT QSGTextLayoutCache
+{
+public:
+    struct Key {
+        Key();
+        bool operator==(const Key &) const;
+
+        QString text;
+        QFont font;
+        QSGText::TextFormat format;
+        QSGText::WrapMode wrapMode;
+        QSGText::TextElideMode elideMode;
+        QSGText::HAlignment hAlign;       // effective alignment
+        QSGText::LineHeightMode lineHeightMode;
+        qreal lineHeight;
+        qreal width;
+        int maximumLineCount;             // -1 if not valid
+        bool widthValid;
+        bool requireImplicitWidth;
+    };
+
+    struct Layout {
+        // Extracted on first use; always valid for layouts from the layout thread
+        inline const QList<QGlyphRun> &glyphRuns();
+
+        QTextLayout layout;
+        QRect rect;
+        QPointF elidePos;
+        qreal naturalWidth;
+        int lineCount;
+        bool naturalWidthValid:1;
+        bool elided:1;     // the text was elided to fit a single line
+        bool truncated:1;  // the text exceeds the maximum line count
+        bool glyphRunsValid:1;
+        QThread *thread;   // the thread whose fonts shaped the text
+
+    private:
+        QList<QGlyphRun> m_glyphRuns;
+    };
+    typedef QSharedPointer<Layout> LayoutPointer;
+
+    static LayoutPointer layout(const Key &);
+
+    static void requestLayout(QSGText *, const Key &, int serial);
+    static void cancelLayouts(QSGText *);
+
+    struct CacheStatistics {
+        CacheStatistics() : hits(0), misses(0), count(0), cost(0) {}
+
+        int hits;
+        int misses;
+        int count;  // layouts currently cached
+        int cost;   // characters currently cached
+    };
+
+    static void setCacheLimit(int);
+    static int cacheLimit();
+    static CacheStatistics cacheStatistics();
+    static void resetCacheStatistics();
+
+private:
+    QSGTextLayoutCache();
+
+    static QSGTextLayoutCache *instance();
+    static void setupLayout(const Key &, Layout *);
+    static int layoutCost(const Key &);
+
+    QCache<Key, LayoutPointer> m_layouts;
+    CacheStatistics m_statistics;
+};
+
+uint qHash(const QSGTextLayoutCache::Key &);
+
+// Posted to a text item when a layout it requested with QSGTextLayoutCache::requestLayout()
+// has been laid out by the layout thread.
+class QSGTextLayoutEvent : public QEvent
+{
+public:
+    QSGTextLayoutEvent(int serial, const QSGTextLayoutCache::Key &,
+                       const QSGTextLayoutCache::LayoutPointer &);
+
+    static QEvent::Type layoutEventType();
+
+    int serial;
+    QSGTextLayoutCache::Key key;
+    QSGTextLayoutCache::LayoutPointer layout;
+};
+
+const QList<QGlyphRun> &QSGTextLayoutCache::Layout::glyphRuns()
+{
+    if (!glyphRunsValid) {
+        m_glyphRuns = layout.glyphRuns();
+        glyphRunsValid = true;
+    }
+    return m_glyphRuns;
+}
+
+QT_END_NAMESPACE
+
+#endif // QSGTEXTLAYOUTCACHE_P_H
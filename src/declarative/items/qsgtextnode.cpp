@@ -186,11 +186,20 @@ void QSGTextNode::addTextDocument(const QPointF &position, QTextDocument *textDo
 void QSGTextNode::addTextLayout(const QPointF &position, QTextLayout *textLayout, const QColor &color,
                                 QSGText::TextStyle style, const QColor &styleColor)
 {
-    QList<QGlyphRun> glyphsList(textLayout->glyphRuns());
+    addGlyphRuns(position, textLayout->glyphRuns(), textLayout->font(), textLayout->boundingRect().width(),
+                 color, style, styleColor);
+}
 
+/*!
+  Adds the glyphs of \a glyphsList, laid out with \a font.  \a width is the width of any
+  decorations of the font.
+*/
+void QSGTextNode::addGlyphRuns(const QPointF &position, const QList<QGlyphRun> &glyphsList,
+                               const QFont &font, qreal width, const QColor &color,
+                               QSGText::TextStyle style, const QColor &styleColor)
+{
     QSGGlyphNode *prevNode = 0;
 
-    QFont font = textLayout->font();
     qreal underlinePosition, ascent, lineThickness;
     int decorations = NoDecoration;
     decorations |= (font.underline() ? Underline : 0);
@@ -227,8 +236,7 @@ void QSGTextNode::addTextLayout(const QPointF &position, QTextLayout *textLayout
 
     if (decorations) {
         addTextDecorations(Decoration(decorations), position + QPointF(0, ascent), color,
-                           textLayout->boundingRect().width(),
-                           lineThickness, underlinePosition, ascent);
+                           width, lineThickness, underlinePosition, ascent);
     }
 }
 
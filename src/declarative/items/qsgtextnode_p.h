@@ -45,6 +45,8 @@
 #include <qsgnode.h>
 #include <qsgtext_p.h>
 
+#include <QtGui/qglyphrun.h>
+
 QT_BEGIN_NAMESPACE
 
 class QTextLayout;
@@ -54,6 +56,7 @@ class QColor;
 class QTextDocument;
 class QSGContext;
 class QRawFont;
+class QFont;
 
 class QSGTextNode : public QSGTransformNode
 {
@@ -66,6 +69,9 @@ public:
     void deleteContent();
     void addTextLayout(const QPointF &position, QTextLayout *textLayout, const QColor &color = QColor(),
                        QSGText::TextStyle style = QSGText::Normal, const QColor &styleColor = QColor());
+    void addGlyphRuns(const QPointF &position, const QList<QGlyphRun> &glyphRuns, const QFont &font,
+                      qreal width, const QColor &color = QColor(),
+                      QSGText::TextStyle style = QSGText::Normal, const QColor &styleColor = QColor());
     void addTextDocument(const QPointF &position, QTextDocument *textDocument, const QColor &color = QColor(),
                          QSGText::TextStyle style = QSGText::Normal, const QColor &styleColor = QColor());
 
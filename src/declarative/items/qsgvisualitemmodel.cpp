@@ -390,8 +390,21 @@ public:
         return 0;
     }
 
+    struct PooledItem {
+        PooledItem(QSGItem *i = 0, bool v = true) : item(i), visible(v) {}
+        QDeclarativeGuard<QSGItem> item;
+        bool visible;
+    };
+
+    bool canPool(QObject *obj);
+    QObject *takePooledItem(int index);
+    void destroyItem(QObject *obj);
+    void clearPool();
+
     Cache m_cache;
     QHash<QObject *, QDeclarativePackage*> m_packaged;
+    QList<PooledItem> m_pool;
+    int m_poolGeneration;
 
     QSGVisualDataModelParts *m_parts;
     friend class QSGVisualItemParts;
@@ -403,6 +416,7 @@ public:
     bool m_delegateValidated : 1;
     bool m_completePending : 1;
     bool m_objectList : 1;
+    bool m_reuseItems : 1;
 
     QSGVisualDataModelData *data(QObject *item);
 
@@ -429,9 +443,11 @@ public:
 
 Q_SIGNALS:
     void indexChanged();
+    void reused();
 
 public:
     int m_index;
+    int m_poolGeneration;
     QDeclarativeGuard<QSGVisualDataModel> m_model;
 };
 
@@ -478,7 +494,7 @@ public:
 class QSGVDMAbstractItemModelData : public QSGVisualDataModelData
 {
     Q_OBJECT
-    Q_PROPERTY(bool hasModelChildren READ hasModelChildren CONSTANT)
+    Q_PROPERTY(bool hasModelChildren READ hasModelChildren NOTIFY indexChanged)
 public:
     bool hasModelChildren() const
     {
@@ -715,6 +731,7 @@ QSGVisualDataModelData *QSGVisualDataModelPrivate::createMetaObject(int index, Q
 
 QSGVisualDataModelData::QSGVisualDataModelData(int index, QSGVisualDataModel *model)
     : m_index(index)
+    , m_poolGeneration(-1)
     , m_model(model)
 {
 }
@@ -783,8 +800,84 @@ QSGVisualDataModelParts::QSGVisualDataModelParts(QSGVisualDataModel *parent)
 QSGVisualDataModelPrivate::QSGVisualDataModelPrivate(QDeclarativeContext *ctxt)
 : m_listModelInterface(0), m_abstractItemModel(0), m_visualItemModel(0), m_delegate(0)
 , m_context(ctxt), m_parts(0), m_delegateDataType(0), createModelData(&initializeModelData)
-, m_delegateValidated(false), m_completePending(false), m_objectList(false), m_listAccessor(0)
+, m_poolGeneration(0), m_delegateValidated(false), m_completePending(false), m_objectList(false)
+, m_reuseItems(false), m_listAccessor(0)
+{
+}
+
+/*
+  Released items can be reused if they were created by the current delegate for the current
+  model, and the model's data is exposed through role properties that can be refreshed for a
+  new index.  Object lists and plain lists expose constant data, and packages are shared
+  between views, so their items are always destroyed.
+*/
+bool QSGVisualDataModelPrivate::canPool(QObject *obj)
+{
+    if (!m_reuseItems || (!m_listModelInterface && !m_abstractItemModel))
+        return false;
+    if (!qobject_cast<QSGItem *>(obj))
+        return false;
+    QSGVisualDataModelData *data = obj->findChild<QSGVisualDataModelData *>();
+    return data && data->m_poolGeneration == m_poolGeneration;
+}
+
+/*
+  Rebinds a pooled item to \a index and returns it, or returns 0 if the pool is empty.
+*/
+QObject *QSGVisualDataModelPrivate::takePooledItem(int index)
+{
+    while (!m_pool.isEmpty()) {
+        PooledItem pooled = m_pool.takeLast();
+        QSGItem *item = pooled.item;
+        if (!item)
+            continue; // destroyed while in the pool
+
+        m_cache.insertItem(index, item);
+        item->setVisible(pooled.visible);
+
+        QSGVisualDataModelData *modelData = data(item);
+        modelData->setIndex(index);
+        for (int propertyId = 0; propertyId < m_propertyData.count(); ++propertyId)
+            QMetaObject::activate(modelData, propertyId + m_delegateDataType->signalOffset, 0);
+        emit modelData->reused();
+
+        return item;
+    }
+    return 0;
+}
+
+void QSGVisualDataModelPrivate::destroyItem(QObject *obj)
+{
+    Q_Q(QSGVisualDataModel);
+
+    // Remove any bindings to avoid warnings due to parent change.
+    QObjectPrivate *p = QObjectPrivate::get(obj);
+    Q_ASSERT(p->declarativeData);
+    QDeclarativeData *d = static_cast<QDeclarativeData*>(p->declarativeData);
+    if (d->ownContext && d->context)
+        d->context->clearContext();
+
+    if (QDeclarativePackage *package = qobject_cast<QDeclarativePackage *>(obj)) {
+        emit q->destroyingPackage(package);
+    } else if (QSGItem *item = qobject_cast<QSGItem *>(obj)) {
+        // XXX todo - the original did item->scene()->removeItem().  Why?
+        item->setParentItem(0);
+    }
+    obj->deleteLater();
+}
+
+/*
+  Destroys all pooled items.  Items released afterwards by the previous delegate or model are
+  not pooled.
+*/
+void QSGVisualDataModelPrivate::clearPool()
 {
+    for (int ii = 0; ii < m_pool.count(); ++ii) {
+        if (QSGItem *item = m_pool.at(ii).item)
+            destroyItem(item);
+    }
+    m_pool.clear();
+    ++m_poolGeneration;
 }
 
 QSGVisualDataModelData *QSGVisualDataModelPrivate::data(QObject *item)
@@ -830,6 +923,7 @@ QSGVisualDataModel::QSGVisualDataModel(QDeclarativeContext *ctxt, QObject *paren
 QSGVisualDataModel::~QSGVisualDataModel()
 {
     Q_D(QSGVisualDataModel);
+    d->clearPool();
     if (d->m_listAccessor)
         delete d->m_listAccessor;
     if (d->m_delegateDataType)
@@ -859,6 +953,7 @@ QVariant QSGVisualDataModel::model() const
 void QSGVisualDataModel::setModel(const QVariant &model)
 {
     Q_D(QSGVisualDataModel);
+    d->clearPool();
     delete d->m_listAccessor;
     d->m_listAccessor = 0;
     d->m_modelVariant = model;
@@ -977,6 +1072,8 @@ void QSGVisualDataModel::setDelegate(QDeclarativeComponent *delegate)
 {
     Q_D(QSGVisualDataModel);
     bool wasValid = d->m_delegate != 0;
+    if (d->m_delegate != delegate)
+        d->clearPool();
     d->m_delegate = delegate;
     d->m_delegateValidated = false;
     if (!wasValid && d->modelCount() && d->m_delegate) {
@@ -1044,6 +1141,39 @@ void QSGVisualDataModel::setRootIndex(const QVariant &root)
     }
 }
 
+/*!
+    \qmlproperty bool QtQuick2::VisualDataModel::reuseItems
+
+    This property holds whether delegate items are reused.
+
+    By default a delegate item is destroyed when a view no longer needs it, and a new item
+    is created for the next index that scrolls into view.  When \c reuseItems is true,
+    released items are instead kept in a pool and rebound to the next index requested.
+    The \c index and role properties of a reused item change to those of its new index,
+    and the \c reused() signal of its \c model object is emitted.
+
+    Reuse is only available for \l ListModel and QAbstractItemModel models.  Delegates
+    that are reused should not hold state that does not derive from the model.
+
+    The default value is false.
+*/
+bool QSGVisualDataModel::reuseItems() const
+{
+    Q_D(const QSGVisualDataModel);
+    return d->m_reuseItems;
+}
+
+void QSGVisualDataModel::setReuseItems(bool reuse)
+{
+    Q_D(QSGVisualDataModel);
+    if (d->m_reuseItems != reuse) {
+        d->m_reuseItems = reuse;
+        if (!reuse)
+            d->clearPool();
+        emit reuseItemsChanged();
+    }
+}
+
 /*!
     \qmlmethod QModelIndex QtQuick2::VisualDataModel::modelIndex(int index)
 
@@ -1165,21 +1295,15 @@ QSGVisualDataModel::ReleaseFlags QSGVisualDataModel::release(QSGItem *item)
     }
 
     if (d->m_cache.releaseItem(obj)) {
-        // Remove any bindings to avoid warnings due to parent change.
-        QObjectPrivate *p = QObjectPrivate::get(obj);
-        Q_ASSERT(p->declarativeData);
-        QDeclarativeData *d = static_cast<QDeclarativeData*>(p->declarativeData);
-        if (d->ownContext && d->context)
-            d->context->clearContext();
-
-        if (inPackage) {
-            emit destroyingPackage(qobject_cast<QDeclarativePackage*>(obj));
-        } else {
-            // XXX todo - the original did item->scene()->removeItem().  Why?
-            item->setParentItem(0);
+        if (!inPackage && d->canPool(obj)) {
+            // Keep the item, its bindings and its parent; it is only hidden until reused.
+            d->m_pool.append(QSGVisualDataModelPrivate::PooledItem(item, item->isVisible()));
+            item->setVisible(false);
+            return stat | Pooled;
         }
+
+        d->destroyItem(obj);
         stat |= Destroyed;
-        obj->deleteLater();
     } else if (!inPackage) {
         stat |= Referenced;
     }
@@ -1205,6 +1329,10 @@ QSGItem *QSGVisualDataModel::item(int index, const QByteArray &viewId, bool comp
         return 0;
     QObject *nobj = d->m_cache.getItem(index);
     bool needComplete = false;
+    if (!nobj && !d->m_pool.isEmpty()) {
+        d->m_completePending = false;
+        nobj = d->takePooledItem(index);
+    }
     if (!nobj) {
         QDeclarativeContext *ccontext = d->m_context;
         if (!ccontext) ccontext = qmlContext(this);
@@ -1214,6 +1342,7 @@ QSGItem *QSGVisualDataModel::item(int index, const QByteArray &viewId, bool comp
             ctxt = new QDeclarativeContext(ctxt);
         }
         QSGVisualDataModelData *data = d->createModelData(index, this);
+        data->m_poolGeneration = d->m_poolGeneration;
         ctxt->setContextProperty(QLatin1String("model"), data);
         ctxt->setContextObject(data);
         d->m_completePending = false;
@@ -69,7 +69,7 @@ class Q_DECLARATIVE_EXPORT QSGVisualModel : public QObject
 public:
     virtual ~QSGVisualModel() {}
 
-    enum ReleaseFlag { Referenced = 0x01, Destroyed = 0x02 };
+    enum ReleaseFlag { Referenced = 0x01, Destroyed = 0x02, Pooled = 0x04 };
     Q_DECLARE_FLAGS(ReleaseFlags, ReleaseFlag)
 
     virtual int count() const = 0;
@@ -148,6 +148,7 @@ class Q_DECLARATIVE_EXPORT QSGVisualDataModel : public QSGVisualModel
     Q_PROPERTY(QString part READ part WRITE setPart)
     Q_PROPERTY(QObject *parts READ parts CONSTANT)
     Q_PROPERTY(QVariant rootIndex READ rootIndex WRITE setRootIndex NOTIFY rootIndexChanged)
+    Q_PROPERTY(bool reuseItems READ reuseItems WRITE setReuseItems NOTIFY reuseItemsChanged)
     Q_CLASSINFO("DefaultProperty", "delegate")
 public:
     QSGVisualDataModel();
@@ -163,6 +164,9 @@ public:
     QVariant rootIndex() const;
     void setRootIndex(const QVariant &root);
 
+    bool reuseItems() const;
+    void setReuseItems(bool);
+
     Q_INVOKABLE QVariant modelIndex(int idx) const;
     Q_INVOKABLE QVariant parentModelIndex() const;
 
@@ -187,6 +191,7 @@ Q_SIGNALS:
     void createdPackage(int index, QDeclarativePackage *package);
     void destroyingPackage(QDeclarativePackage *package);
     void rootIndexChanged();
+    void reuseItemsChanged();
 
 private Q_SLOTS:
     void _q_itemsChanged(int, int, const QList<int> &);
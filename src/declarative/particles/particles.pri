@@ -17,6 +17,8 @@ HEADERS += \
     $$PWD/qsgparticleemitter_p.h \
     $$PWD/qsgparticleextruder_p.h \
     $$PWD/qsgparticlepainter_p.h \
+    $$PWD/qsgparticlestore_p.h \
+    $$PWD/qsgparticleworkerpool_p.h \
     $$PWD/qsgparticlesmodule_p.h \
     $$PWD/qsgparticlesystem_p.h \
     $$PWD/qsgpointattractor_p.h \
@@ -49,6 +51,8 @@ SOURCES += \
     $$PWD/qsgparticleemitter.cpp \
     $$PWD/qsgparticleextruder.cpp \
     $$PWD/qsgparticlepainter.cpp \
+    $$PWD/qsgparticlestore.cpp \
+    $$PWD/qsgparticleworkerpool.cpp \
     $$PWD/qsgparticlesmodule.cpp \
     $$PWD/qsgparticlesystem.cpp \
     $$PWD/qsgpointattractor.cpp \
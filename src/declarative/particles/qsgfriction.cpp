@@ -56,6 +56,7 @@ QT_BEGIN_NAMESPACE
 QSGFrictionAffector::QSGFrictionAffector(QSGItem *parent) :
     QSGParticleAffector(parent), m_factor(0.0)
 {
+    m_affectsStore = true;
 }
 
 bool QSGFrictionAffector::affectParticle(QSGParticleData *d, qreal dt)
@@ -68,4 +69,11 @@ bool QSGFrictionAffector::affectParticle(QSGParticleData *d, qreal dt)
     d->setInstantaneousVY(curVY + (curVY * m_factor * -1 * dt));
     return true;
 }
+
+void QSGFrictionAffector::affectParticles(QSGParticleStore *store, int begin, int end, qreal dt)
+{
+    if (!m_factor)
+        return;
+    store->applyFriction(begin, end, m_factor, dt);
+}
 QT_END_NAMESPACE
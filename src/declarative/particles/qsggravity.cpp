@@ -64,6 +64,7 @@ const qreal CONV = 0.017453292520444443;
 QSGGravityAffector::QSGGravityAffector(QSGItem *parent) :
     QSGParticleAffector(parent), m_acceleration(-10), m_angle(90), m_xAcc(0), m_yAcc(0)
 {
+    m_affectsStore = true;
     connect(this, SIGNAL(accelerationChanged(qreal)),
             this, SLOT(recalc()));
     connect(this, SIGNAL(angleChanged(qreal)),
@@ -92,4 +93,10 @@ bool QSGGravityAffector::affectParticle(QSGParticleData *d, qreal dt)
     }
     return changed;
 }
+
+void QSGGravityAffector::affectParticles(QSGParticleStore *store, int begin, int end, qreal dt)
+{
+    Q_UNUSED(dt);
+    store->accelerate(begin, end, m_xAcc, m_yAcc);
+}
 QT_END_NAMESPACE
@@ -68,6 +68,7 @@ public:
     }
 protected:
     virtual bool affectParticle(QSGParticleData *d, qreal dt);
+    virtual void affectParticles(QSGParticleStore *store, int begin, int end, qreal dt);
 signals:
 
     void accelerationChanged(qreal arg);
@@ -377,6 +377,7 @@ QSGImageParticle::QSGImageParticle(QSGItem* parent)
     , m_lastLevel(Unknown)
 {
     setFlag(ItemHasContents);
+    m_threadedCommits = true;
 }
 
 QDeclarativeListProperty<QSGSprite> QSGImageParticle::sprites()
@@ -962,12 +963,12 @@ void QSGImageParticle::commit(int gIdx, int pIdx)
 {
     if (m_pleaseReset)
         return;
-    QSGGeometryNode *node = m_nodes[gIdx];
+    //May run on several threads at once, so only const lookups here
+    QSGGeometryNode *node = m_nodes.value(gIdx);
     if (!node)
         return;
-    QSGParticleData* datum = m_system->m_groupData[gIdx]->data[pIdx];
+    const QSGParticleData* datum = m_system->m_groupData.value(gIdx)->data.at(pIdx);
 
-    node->setFlag(QSGNode::OwnsGeometry, false);
     UltraVertex *ultraVertices = (UltraVertex *) node->geometry()->vertexData();
     SimpleVertex *simpleVertices = (SimpleVertex *) node->geometry()->vertexData();
     switch (perfLevel){
@@ -1022,8 +1023,6 @@ void QSGImageParticle::commit(int gIdx, int pIdx)
     default:
         break;
     }
-
-    node->setFlag(QSGNode::OwnsGeometry, true);
 }
 
 
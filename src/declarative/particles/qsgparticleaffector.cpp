@@ -100,8 +100,8 @@ QT_BEGIN_NAMESPACE
 */
 
 QSGParticleAffector::QSGParticleAffector(QSGItem *parent) :
-    QSGItem(parent), m_needsReset(false), m_system(0), m_active(true)
-  , m_updateIntSet(false), m_shape(new QSGParticleExtruder(this)), m_signal(false)
+    QSGItem(parent), m_affectsStore(false), m_needsReset(false), m_system(0), m_active(true)
+  , m_updateIntSet(false), m_onceOff(false), m_shape(new QSGParticleExtruder(this)), m_signal(false)
 {
     connect(this, SIGNAL(systemChanged(QSGParticleSystem*)),
             this, SLOT(updateOffsets()));
@@ -132,6 +132,16 @@ void QSGParticleAffector::affectSystem(qreal dt)
             m_groups << m_system->m_groupIds[p];//###Can this occur before group ids are properly assigned?
         m_updateIntSet = false;
     }
+    if (affectsParticleStore()){
+        QSGParticleStore* store = m_system->particleStore();
+        if (m_groups.isEmpty()){
+            affectParticles(store, 0, store->count(), dt);
+        }else{
+            foreach (int g, m_groups)
+                affectParticles(store, store->groupBegin(g), store->groupEnd(g), dt);
+        }
+        return;
+    }
     foreach (QSGParticleGroupData* gd, m_system->m_groupData){
         foreach (QSGParticleData* d, gd->data){
             if (!d)
@@ -166,6 +176,21 @@ bool QSGParticleAffector::affectParticle(QSGParticleData *d, qreal dt)
     return m_signal;//If signalling, then we always 'null affect' it.
 }
 
+void QSGParticleAffector::affectParticles(QSGParticleStore *store, int begin, int end, qreal dt)
+{
+    Q_UNUSED(store);
+    Q_UNUSED(begin);
+    Q_UNUSED(end);
+    Q_UNUSED(dt);
+}
+
+bool QSGParticleAffector::affectsParticleStore() const
+{
+    //Anything needing to look at individual particles before affecting them takes the slow path
+    return m_affectsStore && !m_onceOff && !m_signal && m_collisionParticles.isEmpty()
+            && (width() == 0 || height() == 0);
+}
+
 void QSGParticleAffector::reset(QSGParticleData* pd)
 {//TODO: This, among other ones, should be restructured so they don't all need to remember to call the superclass
     if (m_onceOff)
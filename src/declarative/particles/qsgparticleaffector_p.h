@@ -45,6 +45,7 @@
 #include <QObject>
 #include "qsgparticlesystem_p.h"
 #include "qsgparticleextruder_p.h"
+#include "qsgparticlestore_p.h"
 
 QT_BEGIN_HEADER
 
@@ -67,6 +68,7 @@ public:
     explicit QSGParticleAffector(QSGItem *parent = 0);
     virtual void affectSystem(qreal dt);
     virtual void reset(QSGParticleData*);//As some store their own data per particle?
+    bool affectsParticleStore() const;
     QSGParticleSystem* system() const
     {
         return m_system;
@@ -182,6 +184,9 @@ void setCollisionParticles(QStringList arg)
 protected:
     friend class QSGParticleSystem;
     virtual bool affectParticle(QSGParticleData *d, qreal dt);
+    //Used instead of affectParticle when m_affectsStore is set and nothing needs per particle checks
+    virtual void affectParticles(QSGParticleStore *store, int begin, int end, qreal dt);
+    bool m_affectsStore;
     bool m_needsReset;//### What is this really saving?
     QSGParticleSystem* m_system;
     QStringList m_particles;
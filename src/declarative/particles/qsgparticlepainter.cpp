@@ -40,6 +40,7 @@
 ****************************************************************************/
 
 #include "qsgparticlepainter_p.h"
+#include "qsgparticleworkerpool_p.h"
 #include <QDebug>
 QT_BEGIN_NAMESPACE
 /*!
@@ -65,7 +66,7 @@ QT_BEGIN_NAMESPACE
 */
 QSGParticlePainter::QSGParticlePainter(QSGItem *parent) :
     QSGItem(parent),
-    m_system(0), m_count(0), m_sentinel(new QSGParticleData(0))
+    m_system(0), m_threadedCommits(false), m_count(0), m_sentinel(new QSGParticleData(0))
 {
     connect(this, SIGNAL(parentChanged(QSGItem*)),
             this, SLOT(calcSystemOffset()));
@@ -148,10 +149,39 @@ void QSGParticlePainter::calcSystemOffset(bool resetPending)
     }
 }
 typedef QPair<int,int> intPair;
+
+class QSGParticleCommitJob : public QSGParticleJob
+{
+public:
+    QSGParticleCommitJob(QSGParticlePainter *painter, const QVector<intPair> &commits)
+        : m_painter(painter), m_commits(commits) {}
+
+    virtual void run(int begin, int end)
+    {
+        for (int i = begin; i < end; i++)
+            m_painter->commit(m_commits.at(i).first, m_commits.at(i).second);
+    }
+
+private:
+    QSGParticlePainter *m_painter;
+    const QVector<intPair> &m_commits;
+};
+
 void QSGParticlePainter::performPendingCommits()
 {
-    foreach (intPair p, m_pendingCommits)
-        commit(p.first, p.second);
+    QSGParticleWorkerPool* pool = m_system ? m_system->workerPool() : 0;
+    if (pool && m_threadedCommits){
+        //Each commit writes only its own particle's vertices, so any split gives the same result
+        QVector<intPair> commits;
+        commits.reserve(m_pendingCommits.count());
+        foreach (intPair p, m_pendingCommits)
+            commits << p;
+        QSGParticleCommitJob job(this, commits);
+        pool->run(&job, commits.count(), 256);
+    }else{
+        foreach (intPair p, m_pendingCommits)
+            commit(p.first, p.second);
+    }
     m_pendingCommits.clear();
 }
 
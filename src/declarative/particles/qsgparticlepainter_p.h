@@ -119,6 +119,9 @@ protected:
 
     QSGParticleSystem* m_system;
     friend class QSGParticleSystem;
+    friend class QSGParticleCommitJob;
+    //Set if commit() only writes data belonging to that particle, so commits can run on the system's workers
+    bool m_threadedCommits;
     int m_count;
     bool m_pleaseReset;
     QStringList m_particles;
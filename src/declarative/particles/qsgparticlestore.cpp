@@ -0,0 +1,632 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Declarative module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsgparticlestore_p.h"
+#include "qsgparticlesystem_p.h"
+#include "qsgparticleworkerpool_p.h"
+#include <private/qsimd_p.h>
+#include <qmath.h>
+
+#if defined(QT_HAVE_SSE2) && defined(__SSE2__)
+#  include <emmintrin.h>
+#  define QSG_PARTICLESTORE_SSE2
+#endif
+
+QT_BEGIN_NAMESPACE
+
+/*
+    The kernels below are written against the birth-relative representation used by
+    QSGParticleData, where the current position is x + vx*age + 0.5*ax*age*age.
+    Changing the velocity or acceleration "instantaneously" therefore has to shift the
+    stored base values as well, exactly as QSGParticleData::setInstantaneousVX and
+    friends do. With dv the change to the base velocity and da the change to the
+    acceleration (at equal current values), the base position moves by
+    -age*dv - 0.5*age*age*da.
+
+    Every kernel has an SSE2 path handling four particles at a time and a scalar path
+    for the remainder, and for platforms without SSE2. Only particles which are still
+    alive are touched, and those that are get flagged as dirty so that flush() can
+    write them back.
+
+    Kernels only ever write to the particles in the range they are given, so with a
+    worker pool the ranges can be run concurrently and still give the same results.
+*/
+
+static const float EPSILON = 0.001f;//Must match QSGParticleData::stillAlive
+
+#ifdef QSG_PARTICLESTORE_SSE2
+static inline __m128 loadMask(const quint32 *p)
+{
+    return _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+}
+
+static inline void storeMask(quint32 *p, __m128 mask)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), _mm_castps_si128(mask));
+}
+
+static inline __m128 select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline __m128 absolute(__m128 v)
+{
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+}
+#endif
+
+class QSGParticleStoreJob : public QSGParticleJob
+{
+public:
+    QSGParticleStoreJob(QSGParticleStore *store, QSGParticleStore::Kernel kernel, int offset)
+        : m_store(store), m_kernel(kernel), m_offset(offset) {}
+
+    virtual void run(int begin, int end)
+    {
+        (m_store->*m_kernel)(m_offset + begin, m_offset + end);
+    }
+
+private:
+    QSGParticleStore *m_store;
+    QSGParticleStore::Kernel m_kernel;
+    int m_offset;
+};
+
+QSGParticleStore::QSGParticleStore(QSGParticleSystem* system)
+    : m_system(system), m_pool(0), m_valid(false)
+{
+}
+
+void QSGParticleStore::run(Kernel kernel, int begin, int end)
+{
+    if (m_pool){
+        QSGParticleStoreJob job(this, kernel, begin);
+        m_pool->run(&job, end - begin);
+    }else{
+        (this->*kernel)(begin, end);
+    }
+}
+
+void QSGParticleStore::sync()
+{
+    m_data.clear();
+    m_groupEnd.clear();
+    for (int g = 0; g < m_system->m_groupData.count(); g++){
+        foreach (QSGParticleData* d, m_system->m_groupData[g]->data)
+            if (d)
+                m_data << d;
+        m_groupEnd << m_data.count();
+    }
+
+    int n = m_data.count();
+    m_x.resize(n);
+    m_y.resize(n);
+    m_vx.resize(n);
+    m_vy.resize(n);
+    m_ax.resize(n);
+    m_ay.resize(n);
+    m_t.resize(n);
+    m_lifeSpan.resize(n);
+    m_age.resize(n);
+    m_alive.resize(n);
+    m_dirty.fill(0, n);
+    m_random.resize(2 * n);
+
+    run(&QSGParticleStore::loadRange, 0, n);
+    m_args.time = m_system->m_timeInt / 1000.0;
+    run(&QSGParticleStore::cullRange, 0, n);
+    m_valid = true;
+}
+
+void QSGParticleStore::loadRange(int begin, int end)
+{
+    float* x = m_x.data();
+    float* y = m_y.data();
+    float* vx = m_vx.data();
+    float* vy = m_vy.data();
+    float* ax = m_ax.data();
+    float* ay = m_ay.data();
+    float* t = m_t.data();
+    float* lifeSpan = m_lifeSpan.data();
+    for (int i = begin; i < end; i++){
+        const QSGParticleData* d = m_data.at(i);
+        x[i] = d->x;
+        y[i] = d->y;
+        vx[i] = d->vx;
+        vy[i] = d->vy;
+        ax[i] = d->ax;
+        ay[i] = d->ay;
+        t[i] = d->t;
+        lifeSpan[i] = d->lifeSpan;
+    }
+}
+
+void QSGParticleStore::flush()
+{
+    if (!m_valid)
+        return;
+    run(&QSGParticleStore::storeRange, 0, m_data.count());
+    const quint32* dirty = m_dirty.constData();
+    for (int i = 0; i < m_data.count(); i++)
+        if (dirty[i])
+            m_system->m_needsReset << m_data.at(i);
+    m_valid = false;
+}
+
+void QSGParticleStore::storeRange(int begin, int end)
+{
+    const quint32* dirty = m_dirty.constData();
+    for (int i = begin; i < end; i++){
+        if (!dirty[i])
+            continue;
+        QSGParticleData* d = m_data.at(i);
+        d->x = m_x.at(i);
+        d->y = m_y.at(i);
+        d->vx = m_vx.at(i);
+        d->vy = m_vy.at(i);
+        d->ax = m_ax.at(i);
+        d->ay = m_ay.at(i);
+    }
+}
+
+void QSGParticleStore::cullRange(int begin, int end)
+{
+    const float* t = m_t.constData();
+    const float* lifeSpan = m_lifeSpan.constData();
+    float* age = m_age.data();
+    quint32* alive = m_alive.data();
+    const float time = m_args.time;
+    int i = begin;
+#ifdef QSG_PARTICLESTORE_SSE2
+    const __m128 now = _mm_set1_ps(time);
+    const __m128 epsilon = _mm_set1_ps(EPSILON);
+    for (; i + 4 <= end; i += 4){
+        __m128 vt = _mm_loadu_ps(t + i);
+        __m128 death = _mm_sub_ps(_mm_add_ps(vt, _mm_loadu_ps(lifeSpan + i)), epsilon);
+        storeMask(alive + i, _mm_cmpgt_ps(death, now));
+        _mm_storeu_ps(age + i, _mm_sub_ps(now, vt));
+    }
+#endif
+    for (; i < end; i++){
+        alive[i] = (t[i] + lifeSpan[i] - EPSILON) > time ? ~0u : 0u;
+        age[i] = time - t[i];
+    }
+}
+
+//Gravity: sets the acceleration of every live particle, keeping position and velocity
+void QSGParticleStore::accelerate(int begin, int end, float ax, float ay)
+{
+    m_args.x = ax;
+    m_args.y = ay;
+    run(&QSGParticleStore::accelerateRange, begin, end);
+}
+
+void QSGParticleStore::accelerateRange(int begin, int end)
+{
+    const float newAx = m_args.x;
+    const float newAy = m_args.y;
+    float* x = m_x.data();
+    float* y = m_y.data();
+    float* vx = m_vx.data();
+    float* vy = m_vy.data();
+    float* ax = m_ax.data();
+    float* ay = m_ay.data();
+    const float* age = m_age.constData();
+    const quint32* alive = m_alive.constData();
+    quint32* dirty = m_dirty.data();
+    int i = begin;
+#ifdef QSG_PARTICLESTORE_SSE2
+    const __m128 targetX = _mm_set1_ps(newAx);
+    const __m128 targetY = _mm_set1_ps(newAy);
+    const __m128 half = _mm_set1_ps(0.5f);
+    for (; i + 4 <= end; i += 4){
+        __m128 live = loadMask(alive + i);
+        __m128 a = _mm_loadu_ps(age + i);
+        __m128 halfAgeSq = _mm_mul_ps(half, _mm_mul_ps(a, a));
+
+        __m128 curAx = _mm_loadu_ps(ax + i);
+        __m128 changeX = _mm_and_ps(live, _mm_cmpneq_ps(curAx, targetX));
+        __m128 dx = _mm_and_ps(changeX, _mm_sub_ps(curAx, targetX));
+        _mm_storeu_ps(vx + i, _mm_add_ps(_mm_loadu_ps(vx + i), _mm_mul_ps(a, dx)));
+        _mm_storeu_ps(x + i, _mm_sub_ps(_mm_loadu_ps(x + i), _mm_mul_ps(halfAgeSq, dx)));
+        _mm_storeu_ps(ax + i, select(changeX, targetX, curAx));
+
+        __m128 curAy = _mm_loadu_ps(ay + i);
+        __m128 changeY = _mm_and_ps(live, _mm_cmpneq_ps(curAy, targetY));
+        __m128 dy = _mm_and_ps(changeY, _mm_sub_ps(curAy, targetY));
+        _mm_storeu_ps(vy + i, _mm_add_ps(_mm_loadu_ps(vy + i), _mm_mul_ps(a, dy)));
+        _mm_storeu_ps(y + i, _mm_sub_ps(_mm_loadu_ps(y + i), _mm_mul_ps(halfAgeSq, dy)));
+        _mm_storeu_ps(ay + i, select(changeY, targetY, curAy));
+
+        storeMask(dirty + i, _mm_or_ps(loadMask(dirty + i), _mm_or_ps(changeX, changeY)));
+    }
+#endif
+    for (; i < end; i++){
+        if (!alive[i])
+            continue;
+        float a = age[i];
+        if (ax[i] != newAx){
+            float dx = ax[i] - newAx;
+            vx[i] += a * dx;
+            x[i] -= 0.5f * a * a * dx;
+            ax[i] = newAx;
+            dirty[i] = ~0u;
+        }
+        if (ay[i] != newAy){
+            float dy = ay[i] - newAy;
+            vy[i] += a * dy;
+            y[i] -= 0.5f * a * a * dy;
+            ay[i] = newAy;
+            dirty[i] = ~0u;
+        }
+    }
+}
+
+//Friction: reduces the current velocity of every live particle proportionally
+void QSGParticleStore::applyFriction(int begin, int end, float factor, float dt)
+{
+    m_args.strength = -factor * dt;
+    run(&QSGParticleStore::frictionRange, begin, end);
+}
+
+void QSGParticleStore::frictionRange(int begin, int end)
+{
+    float* x = m_x.data();
+    float* y = m_y.data();
+    float* vx = m_vx.data();
+    float* vy = m_vy.data();
+    const float* ax = m_ax.constData();
+    const float* ay = m_ay.constData();
+    const float* age = m_age.constData();
+    const quint32* alive = m_alive.constData();
+    quint32* dirty = m_dirty.data();
+    const float k = m_args.strength;
+    int i = begin;
+#ifdef QSG_PARTICLESTORE_SSE2
+    const __m128 vk = _mm_set1_ps(k);
+    for (; i + 4 <= end; i += 4){
+        __m128 live = loadMask(alive + i);
+        __m128 a = _mm_loadu_ps(age + i);
+
+        __m128 bvx = _mm_loadu_ps(vx + i);
+        __m128 dvx = _mm_and_ps(live, _mm_mul_ps(vk, _mm_add_ps(bvx, _mm_mul_ps(a, _mm_loadu_ps(ax + i)))));
+        _mm_storeu_ps(vx + i, _mm_add_ps(bvx, dvx));
+        _mm_storeu_ps(x + i, _mm_sub_ps(_mm_loadu_ps(x + i), _mm_mul_ps(a, dvx)));
+
+        __m128 bvy = _mm_loadu_ps(vy + i);
+        __m128 dvy = _mm_and_ps(live, _mm_mul_ps(vk, _mm_add_ps(bvy, _mm_mul_ps(a, _mm_loadu_ps(ay + i)))));
+        _mm_storeu_ps(vy + i, _mm_add_ps(bvy, dvy));
+        _mm_storeu_ps(y + i, _mm_sub_ps(_mm_loadu_ps(y + i), _mm_mul_ps(a, dvy)));
+
+        storeMask(dirty + i, _mm_or_ps(loadMask(dirty + i), live));
+    }
+#endif
+    for (; i < end; i++){
+        if (!alive[i])
+            continue;
+        float a = age[i];
+        float dvx = k * (vx[i] + a * ax[i]);
+        vx[i] += dvx;
+        x[i] -= a * dvx;
+        float dvy = k * (vy[i] + a * ay[i]);
+        vy[i] += dvy;
+        y[i] -= a * dvy;
+        dirty[i] = ~0u;
+    }
+}
+
+//Wander: random walk in position, velocity or acceleration, bounded by the variances
+void QSGParticleStore::wander(int begin, int end, PhysicsAffects physics, float pace, float xVariance, float yVariance, float dt)
+{
+    //qrand() is neither vectorizable nor thread safe, so draw the numbers up front
+    //(in particle order, as before). This also keeps threaded results deterministic.
+    const quint32* alive = m_alive.constData();
+    float* rx = m_random.data();
+    float* ry = rx + m_data.count();
+    const float scale = dt * pace;
+    for (int i = begin; i < end; i++){
+        if (alive[i]){
+            rx[i] = scale * (2 * float(qrand()) / RAND_MAX - 1);
+            ry[i] = scale * (2 * float(qrand()) / RAND_MAX - 1);
+        }else{
+            rx[i] = 0;
+            ry[i] = 0;
+        }
+    }
+
+    m_args.physics = physics;
+    m_args.xVariance = xVariance;
+    m_args.yVariance = yVariance;
+    run(&QSGParticleStore::wanderRange, begin, end);
+}
+
+void QSGParticleStore::wanderRange(int begin, int end)
+{
+    float* x = m_x.data();
+    float* y = m_y.data();
+    float* vx = m_vx.data();
+    float* vy = m_vy.data();
+    float* ax = m_ax.data();
+    float* ay = m_ay.data();
+    const float* age = m_age.constData();
+    const quint32* alive = m_alive.constData();
+    quint32* dirty = m_dirty.data();
+    const float* rx = m_random.constData();
+    const float* ry = rx + m_data.count();
+    const PhysicsAffects physics = m_args.physics;
+    const float xVariance = m_args.xVariance;
+    const float yVariance = m_args.yVariance;
+
+    int i = begin;
+#ifdef QSG_PARTICLESTORE_SSE2
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 varX = _mm_set1_ps(xVariance);
+    const __m128 varY = _mm_set1_ps(yVariance);
+    for (; i + 4 <= end; i += 4){
+        __m128 live = loadMask(alive + i);
+        __m128 a = _mm_loadu_ps(age + i);
+        __m128 dx = _mm_loadu_ps(rx + i);
+        __m128 dy = _mm_loadu_ps(ry + i);
+        __m128 bx = _mm_loadu_ps(x + i);
+        __m128 by = _mm_loadu_ps(y + i);
+        __m128 bvx = _mm_loadu_ps(vx + i);
+        __m128 bvy = _mm_loadu_ps(vy + i);
+        __m128 bax = _mm_loadu_ps(ax + i);
+        __m128 bay = _mm_loadu_ps(ay + i);
+        __m128 mx, my;
+        switch (physics){
+        case Position: {
+            __m128 halfAgeSq = _mm_mul_ps(half, _mm_mul_ps(a, a));
+            __m128 curX = _mm_add_ps(bx, _mm_add_ps(_mm_mul_ps(bvx, a), _mm_mul_ps(bax, halfAgeSq)));
+            __m128 curY = _mm_add_ps(by, _mm_add_ps(_mm_mul_ps(bvy, a), _mm_mul_ps(bay, halfAgeSq)));
+            mx = _mm_and_ps(live, _mm_cmpgt_ps(varX, absolute(_mm_add_ps(curX, dx))));
+            my = _mm_and_ps(live, _mm_cmpgt_ps(varY, absolute(_mm_add_ps(curY, dy))));
+            _mm_storeu_ps(x + i, _mm_add_ps(bx, _mm_and_ps(mx, dx)));
+            _mm_storeu_ps(y + i, _mm_add_ps(by, _mm_and_ps(my, dy)));
+            break;
+        }
+        case Acceleration: {
+            __m128 halfAgeSq = _mm_mul_ps(half, _mm_mul_ps(a, a));
+            mx = _mm_and_ps(live, _mm_cmpgt_ps(varX, absolute(_mm_add_ps(bax, dx))));
+            my = _mm_and_ps(live, _mm_cmpgt_ps(varY, absolute(_mm_add_ps(bay, dy))));
+            dx = _mm_and_ps(mx, dx);
+            dy = _mm_and_ps(my, dy);
+            _mm_storeu_ps(ax + i, _mm_add_ps(bax, dx));
+            _mm_storeu_ps(ay + i, _mm_add_ps(bay, dy));
+            _mm_storeu_ps(vx + i, _mm_sub_ps(bvx, _mm_mul_ps(a, dx)));
+            _mm_storeu_ps(vy + i, _mm_sub_ps(bvy, _mm_mul_ps(a, dy)));
+            _mm_storeu_ps(x + i, _mm_add_ps(bx, _mm_mul_ps(halfAgeSq, dx)));
+            _mm_storeu_ps(y + i, _mm_add_ps(by, _mm_mul_ps(halfAgeSq, dy)));
+            break;
+        }
+        case Velocity:
+        default: {
+            __m128 curVX = _mm_add_ps(bvx, _mm_mul_ps(a, bax));
+            __m128 curVY = _mm_add_ps(bvy, _mm_mul_ps(a, bay));
+            mx = _mm_and_ps(live, _mm_cmpgt_ps(varX, absolute(_mm_add_ps(curVX, dx))));
+            my = _mm_and_ps(live, _mm_cmpgt_ps(varY, absolute(_mm_add_ps(curVY, dy))));
+            dx = _mm_and_ps(mx, dx);
+            dy = _mm_and_ps(my, dy);
+            _mm_storeu_ps(vx + i, _mm_add_ps(bvx, dx));
+            _mm_storeu_ps(vy + i, _mm_add_ps(bvy, dy));
+            _mm_storeu_ps(x + i, _mm_sub_ps(bx, _mm_mul_ps(a, dx)));
+            _mm_storeu_ps(y + i, _mm_sub_ps(by, _mm_mul_ps(a, dy)));
+            break;
+        }
+        }
+        storeMask(dirty + i, _mm_or_ps(loadMask(dirty + i), live));
+    }
+#endif
+    for (; i < end; i++){
+        if (!alive[i])
+            continue;
+        float a = age[i];
+        float dx = rx[i];
+        float dy = ry[i];
+        switch (physics){
+        case Position:
+            if (xVariance > qAbs(x[i] + vx[i] * a + 0.5f * ax[i] * a * a + dx))
+                x[i] += dx;
+            if (yVariance > qAbs(y[i] + vy[i] * a + 0.5f * ay[i] * a * a + dy))
+                y[i] += dy;
+            break;
+        case Acceleration:
+            if (xVariance > qAbs(ax[i] + dx)){
+                ax[i] += dx;
+                vx[i] -= a * dx;
+                x[i] += 0.5f * a * a * dx;
+            }
+            if (yVariance > qAbs(ay[i] + dy)){
+                ay[i] += dy;
+                vy[i] -= a * dy;
+                y[i] += 0.5f * a * a * dy;
+            }
+            break;
+        case Velocity:
+        default:
+            if (xVariance > qAbs(vx[i] + a * ax[i] + dx)){
+                vx[i] += dx;
+                x[i] -= a * dx;
+            }
+            if (yVariance > qAbs(vy[i] + a * ay[i] + dy)){
+                vy[i] += dy;
+                y[i] -= a * dy;
+            }
+            break;
+        }
+        dirty[i] = ~0u;
+    }
+}
+
+//PointAttractor: pulls live particles towards (targetX, targetY)
+void QSGParticleStore::attract(int begin, int end, PhysicsAffects physics, float x, float y,
+                               float strength, bool quadratic, float dt)
+{
+    m_args.physics = physics;
+    m_args.x = x;
+    m_args.y = y;
+    m_args.strength = strength * dt;
+    m_args.quadratic = quadratic;
+    run(&QSGParticleStore::attractRange, begin, end);
+}
+
+void QSGParticleStore::attractRange(int begin, int end)
+{
+    const PhysicsAffects physics = m_args.physics;
+    const float targetX = m_args.x;
+    const float targetY = m_args.y;
+    const bool quadratic = m_args.quadratic;
+    float* x = m_x.data();
+    float* y = m_y.data();
+    float* vx = m_vx.data();
+    float* vy = m_vy.data();
+    float* ax = m_ax.data();
+    float* ay = m_ay.data();
+    const float* age = m_age.constData();
+    const quint32* alive = m_alive.constData();
+    quint32* dirty = m_dirty.data();
+    const float k = m_args.strength;
+    int i = begin;
+#ifdef QSG_PARTICLESTORE_SSE2
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 vk = _mm_set1_ps(k);
+    const __m128 tx = _mm_set1_ps(targetX);
+    const __m128 ty = _mm_set1_ps(targetY);
+    for (; i + 4 <= end; i += 4){
+        __m128 live = loadMask(alive + i);
+        __m128 a = _mm_loadu_ps(age + i);
+        __m128 halfAgeSq = _mm_mul_ps(half, _mm_mul_ps(a, a));
+        __m128 bx = _mm_loadu_ps(x + i);
+        __m128 by = _mm_loadu_ps(y + i);
+        __m128 bvx = _mm_loadu_ps(vx + i);
+        __m128 bvy = _mm_loadu_ps(vy + i);
+        __m128 bax = _mm_loadu_ps(ax + i);
+        __m128 bay = _mm_loadu_ps(ay + i);
+
+        __m128 dx = _mm_sub_ps(tx, _mm_add_ps(bx, _mm_add_ps(_mm_mul_ps(bvx, a), _mm_mul_ps(bax, halfAgeSq))));
+        __m128 dy = _mm_sub_ps(ty, _mm_add_ps(by, _mm_add_ps(_mm_mul_ps(bvy, a), _mm_mul_ps(bay, halfAgeSq))));
+        __m128 rSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 r = _mm_sqrt_ps(rSq);
+        __m128 ds = _mm_div_ps(vk, _mm_max_ps(one, quadratic ? rSq : r));
+        //Unit vector towards the target, (1, 0) when already there (as atan2(0, 0) is 0)
+        __m128 atTarget = _mm_cmpeq_ps(r, zero);
+        __m128 safeR = select(atTarget, one, r);
+        __m128 ux = select(atTarget, one, _mm_div_ps(dx, safeR));
+        __m128 uy = _mm_andnot_ps(atTarget, _mm_div_ps(dy, safeR));
+        dx = _mm_and_ps(live, _mm_mul_ps(ds, ux));
+        dy = _mm_and_ps(live, _mm_mul_ps(ds, uy));
+
+        switch (physics){
+        case Position:
+            _mm_storeu_ps(x + i, _mm_add_ps(bx, dx));
+            _mm_storeu_ps(y + i, _mm_add_ps(by, dy));
+            break;
+        case Acceleration:
+            _mm_storeu_ps(ax + i, _mm_add_ps(bax, dx));
+            _mm_storeu_ps(ay + i, _mm_add_ps(bay, dy));
+            _mm_storeu_ps(vx + i, _mm_sub_ps(bvx, _mm_mul_ps(a, dx)));
+            _mm_storeu_ps(vy + i, _mm_sub_ps(bvy, _mm_mul_ps(a, dy)));
+            _mm_storeu_ps(x + i, _mm_add_ps(bx, _mm_mul_ps(halfAgeSq, dx)));
+            _mm_storeu_ps(y + i, _mm_add_ps(by, _mm_mul_ps(halfAgeSq, dy)));
+            break;
+        case Velocity:
+        default: {
+            //New current velocity is the old base velocity plus the pull
+            __m128 dvx = _mm_and_ps(live, _mm_sub_ps(dx, _mm_mul_ps(a, bax)));
+            __m128 dvy = _mm_and_ps(live, _mm_sub_ps(dy, _mm_mul_ps(a, bay)));
+            _mm_storeu_ps(vx + i, _mm_add_ps(bvx, dvx));
+            _mm_storeu_ps(vy + i, _mm_add_ps(bvy, dvy));
+            _mm_storeu_ps(x + i, _mm_sub_ps(bx, _mm_mul_ps(a, dvx)));
+            _mm_storeu_ps(y + i, _mm_sub_ps(by, _mm_mul_ps(a, dvy)));
+            break;
+        }
+        }
+        storeMask(dirty + i, _mm_or_ps(loadMask(dirty + i), live));
+    }
+#endif
+    for (; i < end; i++){
+        if (!alive[i])
+            continue;
+        float a = age[i];
+        float dx = targetX - (x[i] + vx[i] * a + 0.5f * ax[i] * a * a);
+        float dy = targetY - (y[i] + vy[i] * a + 0.5f * ay[i] * a * a);
+        float rSq = dx * dx + dy * dy;
+        float r = qSqrt(rSq);
+        float ds = k / qMax(1.0f, quadratic ? rSq : r);
+        if (r == 0){
+            dx = ds;
+            dy = 0;
+        }else{
+            dx = ds * (dx / r);
+            dy = ds * (dy / r);
+        }
+        switch (physics){
+        case Position:
+            x[i] += dx;
+            y[i] += dy;
+            break;
+        case Acceleration:
+            ax[i] += dx;
+            ay[i] += dy;
+            vx[i] -= a * dx;
+            vy[i] -= a * dy;
+            x[i] += 0.5f * a * a * dx;
+            y[i] += 0.5f * a * a * dy;
+            break;
+        case Velocity:
+        default: {
+            float dvx = dx - a * ax[i];
+            float dvy = dy - a * ay[i];
+            vx[i] += dvx;
+            vy[i] += dvy;
+            x[i] -= a * dvx;
+            y[i] -= a * dvy;
+            break;
+        }
+        }
+        dirty[i] = ~0u;
+    }
+}
+
+QT_END_NAMESPACE
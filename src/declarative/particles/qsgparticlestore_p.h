@@ -0,0 +1,138 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Declarative module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef PARTICLESTORE_H
+#define PARTICLESTORE_H
+
+#include <QVector>
+
+QT_BEGIN_HEADER
+
+QT_BEGIN_NAMESPACE
+
+QT_MODULE(Declarative)
+
+class QSGParticleSystem;
+class QSGParticleData;
+class QSGParticleWorkerPool;
+
+//Structure-of-arrays copy of the kinematic state of every particle in a system.
+//Synced lazily once per frame when the first batch capable affector runs, and
+//flushed back into the QSGParticleData objects before anything else reads them.
+class QSGParticleStore
+{
+public:
+    enum PhysicsAffects {//Same order as in the affectors
+        Position,
+        Velocity,
+        Acceleration
+    };
+
+    QSGParticleStore(QSGParticleSystem* system);
+
+    //If set, syncing, flushing and the kernels are split across the pool's threads
+    void setWorkerPool(QSGParticleWorkerPool* pool) { m_pool = pool; }
+
+    bool isValid() const { return m_valid; }
+    void sync();
+    void flush();
+
+    int count() const { return m_data.count(); }
+    int groupBegin(int group) const { return group < m_groupEnd.count() ? (group ? m_groupEnd[group - 1] : 0) : 0; }
+    int groupEnd(int group) const { return group < m_groupEnd.count() ? m_groupEnd[group] : 0; }
+
+    //Kernels, each operating on the particles in [begin, end) which are still alive
+    void accelerate(int begin, int end, float ax, float ay);
+    void applyFriction(int begin, int end, float factor, float dt);
+    void wander(int begin, int end, PhysicsAffects physics, float pace, float xVariance, float yVariance, float dt);
+    void attract(int begin, int end, PhysicsAffects physics, float x, float y, float strength, bool quadratic, float dt);
+
+private:
+    typedef void (QSGParticleStore::*Kernel)(int begin, int end);
+    friend class QSGParticleStoreJob;
+    void run(Kernel kernel, int begin, int end);
+
+    void loadRange(int begin, int end);
+    void storeRange(int begin, int end);
+    void cullRange(int begin, int end);
+    void accelerateRange(int begin, int end);
+    void frictionRange(int begin, int end);
+    void wanderRange(int begin, int end);
+    void attractRange(int begin, int end);
+
+    QSGParticleSystem* m_system;
+    QSGParticleWorkerPool* m_pool;
+    bool m_valid;
+
+    struct {//Parameters of the kernel being run
+        PhysicsAffects physics;
+        float time;
+        float dt;
+        float x;
+        float y;
+        float strength;
+        float xVariance;
+        float yVariance;
+        bool quadratic;
+    } m_args;
+
+    QVector<QSGParticleData*> m_data;
+    QVector<int> m_groupEnd;
+
+    QVector<float> m_x;
+    QVector<float> m_y;
+    QVector<float> m_vx;
+    QVector<float> m_vy;
+    QVector<float> m_ax;
+    QVector<float> m_ay;
+    QVector<float> m_t;
+    QVector<float> m_lifeSpan;
+    QVector<float> m_age;//Time since t, only valid for live particles
+    QVector<quint32> m_alive;//All bits set if alive, for masking
+    QVector<quint32> m_dirty;//All bits set if changed since sync
+    QVector<float> m_random;
+};
+
+QT_END_NAMESPACE
+
+QT_END_HEADER
+
+#endif // PARTICLESTORE_H
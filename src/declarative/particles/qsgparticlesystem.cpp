@@ -44,6 +44,8 @@
 #include "qsgparticleemitter_p.h"
 #include "qsgparticleaffector_p.h"
 #include "qsgparticlepainter_p.h"
+#include "qsgparticlestore_p.h"
+#include "qsgparticleworkerpool_p.h"
 #include "qsgspriteengine_p.h"
 #include "qsgsprite_p.h"
 #include "qsgv8particledata_p.h"
@@ -73,6 +75,18 @@ QT_BEGIN_NAMESPACE
     before the system starts playing. This allows you to appear to start with a
     fully populated particle system, instead of starting with no particles visible.
 */
+/*!
+    \qmlproperty int QtQuick.Particles2::ParticleSystem::workerThreads
+
+    If set to more than 0, this many additional threads are used to apply affectors
+    and to update the vertex data of ImageParticles. Emission still happens on the
+    main thread.
+
+    The simulation gives the same results whatever the number of threads, so a run
+    with a fixed random seed can be reproduced.
+
+    Default value is 0.
+*/
 /*!
     \qmlproperty list<Sprite> QtQuick.Particles2::ParticleSystem::particleStates
 
@@ -490,6 +504,7 @@ float QSGParticleData::lifeLeft()
 QSGParticleSystem::QSGParticleSystem(QSGItem *parent) :
     QSGItem(parent), m_particle_count(0), m_running(true)
   , m_startTime(0), m_nextIndex(0), m_componentComplete(false), m_spriteEngine(0)
+  , m_store(new QSGParticleStore(this)), m_workerThreads(0), m_workerPool(0)
 {
     QSGParticleGroupData* gd = new QSGParticleGroupData(0, this);//Default group
     m_groupData.insert(0,gd);
@@ -504,6 +519,8 @@ QSGParticleSystem::~QSGParticleSystem()
 {
     foreach (QSGParticleGroupData* gd, m_groupData)
         delete gd;
+    delete m_store;
+    delete m_workerPool;
 }
 
 QDeclarativeListProperty<QSGSprite> QSGParticleSystem::particleStates()
@@ -628,6 +645,18 @@ void QSGParticleSystem::setRunning(bool arg)
     }
 }
 
+void QSGParticleSystem::setWorkerThreads(int arg)
+{
+    arg = qMax(0, arg);
+    if (m_workerThreads == arg)
+        return;
+    m_workerThreads = arg;
+    delete m_workerPool;
+    m_workerPool = arg ? new QSGParticleWorkerPool(arg) : 0;
+    m_store->setWorkerPool(m_workerPool);
+    emit workerThreadsChanged(arg);
+}
+
 void QSGParticleSystem::stateRedirect(QDeclarativeListProperty<QObject> *prop, QObject *value)
 {
     //Hooks up automatic state-associated stuff
@@ -861,15 +890,27 @@ void QSGParticleSystem::updateCurrentTime( int currentTime )
     foreach (QSGParticleEmitter* emitter, m_emitters)
         if (emitter)
             emitter->emitWindow(m_timeInt);
-    foreach (QSGParticleAffector* a, m_affectors)
-        if (a)
-            a->affectSystem(dt);
+    foreach (QSGParticleAffector* a, m_affectors){
+        if (!a)
+            continue;
+        if (!a->affectsParticleStore())
+            m_store->flush();//Affector works on QSGParticleData directly
+        a->affectSystem(dt);
+    }
+    m_store->flush();
     foreach (QSGParticleData* d, m_needsReset)
         foreach (QSGParticlePainter* p, m_groupData[d->group]->painters)
             if (p && d)
                 p->reload(d);
 }
 
+QSGParticleStore* QSGParticleSystem::particleStore()
+{
+    if (!m_store->isValid())
+        m_store->sync();
+    return m_store;
+}
+
 int QSGParticleSystem::systemSync(QSGParticlePainter* p)
 {
     if (!m_running)
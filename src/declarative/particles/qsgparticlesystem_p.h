@@ -68,6 +68,8 @@ class QSGParticleSystemAnimation;
 class QSGSpriteEngine;
 class QSGSprite;
 class QSGV8ParticleData;
+class QSGParticleStore;
+class QSGParticleWorkerPool;
 
 struct QSGParticleDataHeapNode{
     int time;//in ms
@@ -218,6 +220,7 @@ class QSGParticleSystem : public QSGItem
     Q_OBJECT
     Q_PROPERTY(bool running READ isRunning WRITE setRunning NOTIFY runningChanged)
     Q_PROPERTY(int startTime READ startTime WRITE setStartTime NOTIFY startTimeChanged)
+    Q_PROPERTY(int workerThreads READ workerThreads WRITE setWorkerThreads NOTIFY workerThreadsChanged)
     Q_PROPERTY(QDeclarativeListProperty<QSGSprite> particleStates READ particleStates)
 
 public:
@@ -238,6 +241,11 @@ public:
 
     int count(){ return m_particle_count; }
 
+    int workerThreads() const
+    {
+        return m_workerThreads;
+    }
+
 signals:
 
     void systemInitialized();
@@ -245,6 +253,8 @@ signals:
 
     void startTimeChanged(int arg);
 
+    void workerThreadsChanged(int arg);
+
 
 public slots:
     void reset();
@@ -261,6 +271,8 @@ public slots:
         m_startTime += ms;
     }
 
+    void setWorkerThreads(int arg);
+
     virtual int duration() const { return -1; }
 
 protected:
@@ -284,6 +296,10 @@ public://###but only really for related class usage. Perhaps we should all be fr
     //This one only once per painter per frame
     int systemSync(QSGParticlePainter* p);
 
+    //Synced on first use each frame, for affectors which work on all particles at once
+    QSGParticleStore* particleStore();
+    QSGParticleWorkerPool* workerPool() { return m_workerPool; }
+
     QSet<QSGParticleData*> m_needsReset;
     QVector<QSGParticleData*> m_bySysIdx; //Another reference to the data (data owned by group), but by sysIdx
     QHash<QString, int> m_groupIds;
@@ -318,6 +334,9 @@ private:
     friend class QSGParticleSystemAnimation;
     void updateCurrentTime( int currentTime );
     QSGParticleSystemAnimation* m_animation;
+    QSGParticleStore* m_store;
+    int m_workerThreads;
+    QSGParticleWorkerPool* m_workerPool;
 };
 
 // Internally, this animation drives all the timing. Painters sync up in their updatePaintNode
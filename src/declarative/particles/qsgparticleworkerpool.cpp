@@ -0,0 +1,164 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Declarative module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsgparticleworkerpool_p.h"
+#include <QThread>
+
+QT_BEGIN_NAMESPACE
+
+class QSGParticleWorker : public QThread
+{
+public:
+    QSGParticleWorker(QSGParticleWorkerPool *pool) : m_pool(pool) {}
+
+protected:
+    virtual void run() { m_pool->workerLoop(); }
+
+private:
+    QSGParticleWorkerPool *m_pool;
+};
+
+QSGParticleWorkerPool::QSGParticleWorkerPool(int threadCount)
+    : m_job(0), m_count(0), m_chunk(1), m_next(0), m_remaining(0), m_generation(0), m_quit(false)
+{
+    for (int i = 0; i < threadCount; i++){
+        QSGParticleWorker* worker = new QSGParticleWorker(this);
+        worker->start();
+        m_workers << worker;
+    }
+}
+
+QSGParticleWorkerPool::~QSGParticleWorkerPool()
+{
+    m_mutex.lock();
+    m_quit = true;
+    m_workAvailable.wakeAll();
+    m_mutex.unlock();
+
+    foreach (QSGParticleWorker* worker, m_workers)
+        worker->wait();
+    qDeleteAll(m_workers);
+}
+
+void QSGParticleWorkerPool::run(QSGParticleJob *job, int count, int minChunk)
+{
+    if (count <= 0)
+        return;
+    //Not worth waking anyone up for
+    if (m_workers.isEmpty() || count < 2 * minChunk){
+        job->run(0, count);
+        return;
+    }
+
+    QMutexLocker runLocker(&m_runMutex);
+
+    //A few chunks per thread, so that uneven ranges still balance out
+    int chunks = 4 * (m_workers.count() + 1);
+    m_mutex.lock();
+    m_job = job;
+    m_count = count;
+    //Chunks are a multiple of minChunk, so that splitting does not change which
+    //elements a vectorized job handles in its scalar tail
+    m_chunk = qMax(minChunk, (count + chunks - 1) / chunks);
+    m_chunk = (m_chunk + minChunk - 1) / minChunk * minChunk;
+    m_next = 0;
+    m_remaining = (count + m_chunk - 1) / m_chunk;
+    m_generation++;
+    m_workAvailable.wakeAll();
+    m_mutex.unlock();
+
+    int begin, end;
+    while (takeChunk(&job, &begin, &end)){
+        job->run(begin, end);
+        finishChunk();
+    }
+
+    m_mutex.lock();
+    while (m_remaining)
+        m_workDone.wait(&m_mutex);
+    m_job = 0;
+    m_mutex.unlock();
+}
+
+bool QSGParticleWorkerPool::takeChunk(QSGParticleJob **job, int *begin, int *end)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_job || m_next >= m_count)
+        return false;
+    *job = m_job;
+    *begin = m_next;
+    *end = qMin(m_count, m_next + m_chunk);
+    m_next = *end;
+    return true;
+}
+
+void QSGParticleWorkerPool::finishChunk()
+{
+    QMutexLocker locker(&m_mutex);
+    if (--m_remaining == 0)
+        m_workDone.wakeAll();
+}
+
+void QSGParticleWorkerPool::workerLoop()
+{
+    int generation = 0;
+    forever {
+        m_mutex.lock();
+        while (!m_quit && generation == m_generation)
+            m_workAvailable.wait(&m_mutex);
+        if (m_quit){
+            m_mutex.unlock();
+            return;
+        }
+        generation = m_generation;
+        m_mutex.unlock();
+
+        //The job is fetched with each chunk, as a later run() may already have replaced it
+        QSGParticleJob* job;
+        int begin, end;
+        while (takeChunk(&job, &begin, &end)){
+            job->run(begin, end);
+            finishChunk();
+        }
+    }
+}
+
+QT_END_NAMESPACE
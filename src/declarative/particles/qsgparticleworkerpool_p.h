@@ -0,0 +1,102 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Declarative module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef PARTICLEWORKERPOOL_H
+#define PARTICLEWORKERPOOL_H
+
+#include <QList>
+#include <QMutex>
+#include <QWaitCondition>
+
+QT_BEGIN_HEADER
+
+QT_BEGIN_NAMESPACE
+
+QT_MODULE(Declarative)
+
+class QSGParticleWorker;
+
+class QSGParticleJob
+{
+public:
+    virtual ~QSGParticleJob() {}
+    //Called concurrently with disjoint ranges, must only write to state owned by that range
+    virtual void run(int begin, int end) = 0;
+};
+
+//Fork/join pool used by the particle system when workerThreads is set.
+//run() splits [0, count) into chunks of a multiple of minChunk elements, which are
+//processed by the workers and the calling thread, and returns once all are done.
+class QSGParticleWorkerPool
+{
+public:
+    QSGParticleWorkerPool(int threadCount);
+    ~QSGParticleWorkerPool();
+
+    int threadCount() const { return m_workers.count(); }
+    void run(QSGParticleJob *job, int count, int minChunk = 1024);
+
+private:
+    friend class QSGParticleWorker;
+    bool takeChunk(QSGParticleJob **job, int *begin, int *end);
+    void finishChunk();
+    void workerLoop();
+
+    QList<QSGParticleWorker*> m_workers;
+
+    QMutex m_runMutex;//Serializes callers of run()
+    QMutex m_mutex;
+    QWaitCondition m_workAvailable;
+    QWaitCondition m_workDone;
+    QSGParticleJob *m_job;
+    int m_count;
+    int m_chunk;
+    int m_next;
+    int m_remaining;
+    int m_generation;
+    bool m_quit;
+};
+
+QT_END_NAMESPACE
+
+QT_END_HEADER
+
+#endif // PARTICLEWORKERPOOL_H
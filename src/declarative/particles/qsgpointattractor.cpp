@@ -59,6 +59,7 @@ QSGPointAttractorAffector::QSGPointAttractorAffector(QSGItem *parent) :
     QSGParticleAffector(parent), m_strength(0.0), m_x(0), m_y(0)
   , m_physics(Velocity), m_proportionalToDistance(Linear)
 {
+    m_affectsStore = true;
 }
 
 bool QSGPointAttractorAffector::affectParticle(QSGParticleData *d, qreal dt)
@@ -97,4 +98,14 @@ bool QSGPointAttractorAffector::affectParticle(QSGParticleData *d, qreal dt)
 
     return true;
 }
+
+void QSGPointAttractorAffector::affectParticles(QSGParticleStore *store, int begin, int end, qreal dt)
+{
+    if (m_strength == 0.0)
+        return;
+    //x and y are crossed over, as in affectParticle
+    store->attract(begin, end, QSGParticleStore::PhysicsAffects(m_physics), m_y, m_x,
+                   m_strength, m_proportionalToDistance == Quadratic, dt);
+}
+
 QT_END_NAMESPACE
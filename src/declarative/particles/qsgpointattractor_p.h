@@ -155,6 +155,7 @@ void setProportionalToDistance(Proportion arg)
 
 protected:
     virtual bool affectParticle(QSGParticleData *d, qreal dt);
+    virtual void affectParticles(QSGParticleStore *store, int begin, int end, qreal dt);
 private:
 qreal m_strength;
 qreal m_x;
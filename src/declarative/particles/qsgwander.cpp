@@ -55,6 +55,7 @@ QSGWanderAffector::QSGWanderAffector(QSGItem *parent) :
     , m_physics(Velocity)
 {
     m_needsReset = true;
+    m_affectsStore = true;
 }
 
 QSGWanderAffector::~QSGWanderAffector()
@@ -148,4 +149,11 @@ bool QSGWanderAffector::affectParticle(QSGParticleData* data, qreal dt)
     }
     return true;
 }
+
+void QSGWanderAffector::affectParticles(QSGParticleStore *store, int begin, int end, qreal dt)
+{
+    store->wander(begin, end, QSGParticleStore::PhysicsAffects(m_physics),
+                  m_pace, m_xVariance, m_yVariance, dt);
+}
+
 QT_END_NAMESPACE
@@ -413,7 +413,9 @@ void QDeclarativeBindingPrivate::printBindingLoopError(QDeclarativeProperty &pro
 void QDeclarativeBindingPrivate::emitValueChanged()
 {
     Q_Q(QDeclarativeBinding);
-    q->update();
+    QDeclarativeEnginePrivate *ep = QDeclarativeEnginePrivate::get(context());
+    if (!ep || !ep->scheduleBindingUpdate(q))
+        q->update();
 }
 
 void QDeclarativeBinding::setEnabled(bool e, QDeclarativePropertyPrivate::WriteFlags flags)
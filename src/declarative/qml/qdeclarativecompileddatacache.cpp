@@ -0,0 +1,558 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the QtDeclarative module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "private/qdeclarativecompileddatacache_p.h"
+
+#include "private/qdeclarativecompiler_p.h"
+#include "private/qdeclarativeengine_p.h"
+#include "private/qdeclarativevmemetaobject_p.h"
+#include "private/qmetaobjectbuilder_p.h"
+#include "private/qdeclarativev4compiler_p.h"
+#include "private/qdeclarativev4instruction_p.h"
+
+#include <QtDeclarative/qdeclarativecomponent.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+\class QDeclarativeCompiledDataCache
+\brief The QDeclarativeCompiledDataCache class persists QDeclarativeCompiledData between runs.
+\internal
+
+A cache file stores the products of parsing a QML document that the type loader needs to
+resolve its dependencies (the imports and referenced type names), along with the
+instruction stream and data tables produced by QDeclarativeCompiler.  When the
+document's source is unchanged, the QDeclarativeTypeData restores its compiled data from
+the cache instead of parsing and compiling the document.
+
+Everything in the instruction stream that is only meaningful inside the process that
+compiled it is stored symbolically and fixed up by restore():
+
+\list
+\o CreateSimpleObject create functions are resolved from the referenced QDeclarativeType.
+\o Meta type ids are stored by name and looked up again.
+\o Synthesized meta objects are given new, process unique, class names.
+\o Property caches are rebuilt from the synthesized meta objects.
+\o V4 programs are re-threaded for the current process.
+\endlist
+
+The referenced types are fingerprinted when the cache is written, and restore() fails if
+any of them has changed since.  QML types are fingerprinted by their typeHash(), which
+covers their own source and, transitively, that of all the types they depend on.
+Documents that declare properties of QML defined object types are not cached, as the
+class names of such types are not stable between runs.
+*/
+
+static const quint32 QmlCacheMagic = 0x514d4c43; // "QMLC"
+static const quint32 QmlCacheVersion = 3;
+
+static QByteArray buildKey()
+{
+    QByteArray key(QT_VERSION_STR);
+    key += '-' + QByteArray::number(QSysInfo::WordSize);
+    key += '-' + QByteArray::number(QSysInfo::ByteOrder);
+    key += '-' + QByteArray::number(int(sizeof(QDeclarativeInstruction)));
+#ifdef QML_THREADED_INTERPRETER
+    key += "-threaded";
+#endif
+    return key;
+}
+
+// Returns true if the type name refers to a class synthesized by QDeclarativeCompiler
+static bool isSynthesizedType(const QByteArray &typeName)
+{
+    return typeName.contains("_QML");
+}
+
+QDeclarativeCompiledDataCache::QDeclarativeCompiledDataCache()
+: m_v8bindings(0), m_rootType(-1), m_rootMetaData(-1)
+{
+}
+
+/*!
+Returns the hash identifying \a source.
+*/
+QByteArray QDeclarativeCompiledDataCache::sourceHash(const QByteArray &source)
+{
+    return QCryptographicHash::hash(source, QCryptographicHash::Sha1);
+}
+
+/*!
+Returns the hash identifying a document with \a sourceHash that references \a types.  An
+empty hash is returned if any of the types cannot be fingerprinted, in which case the
+document cannot be cached.
+*/
+QByteArray QDeclarativeCompiledDataCache::typeHash(const QByteArray &sourceHash,
+                                                   const QList<QDeclarativeTypeData::TypeReference> &types)
+{
+    if (sourceHash.isEmpty())
+        return QByteArray();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(sourceHash);
+    for (int ii = 0; ii < types.count(); ++ii) {
+        QByteArray print = fingerprint(types.at(ii));
+        if (print.isEmpty())
+            return QByteArray();
+        hash.addData(print);
+    }
+    return hash.result();
+}
+
+QByteArray QDeclarativeCompiledDataCache::fingerprint(const QDeclarativeTypeData::TypeReference &type)
+{
+    if (type.typeData)
+        return type.typeData->typeHash();
+
+    Q_ASSERT(type.type);
+    const QMetaObject *mo = type.type->metaObject();
+    QByteArray rv(mo->className());
+    rv += ' ' + QByteArray::number(type.majorVersion) + '.' + QByteArray::number(type.minorVersion);
+    rv += ' ' + QByteArray::number(mo->propertyCount());
+    rv += ' ' + QByteArray::number(mo->methodCount());
+    rv += ' ' + QByteArray::number(mo->enumeratorCount());
+    return rv;
+}
+
+/*!
+Reads the cache \a fileName.  Returns false if the file does not exist, was written by an
+incompatible build, or was compiled from a source other than the one identified by
+\a sourceHash.
+*/
+bool QDeclarativeCompiledDataCache::load(const QString &fileName, const QByteArray &sourceHash)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_4_7);
+
+    quint32 magic, version;
+    QByteArray key, hash;
+    in >> magic >> version >> key >> hash;
+    if (in.status() != QDataStream::Ok || magic != QmlCacheMagic || version != QmlCacheVersion ||
+        key != buildKey() || hash != sourceHash)
+        return false;
+
+    quint32 importCount;
+    in >> importCount;
+    for (quint32 ii = 0; in.status() == QDataStream::Ok && ii < importCount; ++ii) {
+        QDeclarativeScriptParser::Import import;
+        qint32 type;
+        qint32 line, column;
+        in >> type >> import.uri >> import.qualifier >> import.version >> line >> column;
+        import.type = QDeclarativeScriptParser::Import::Type(type);
+        import.location.start.line = line;
+        import.location.start.column = column;
+        m_imports << import;
+    }
+
+    quint32 metaDataCount;
+    in >> m_typeNames >> m_typeFingerprints >> m_classNames
+       >> m_bytecode >> m_primitives >> m_datas >> m_urls >> m_metaTypes >> m_contextCaches
+       >> metaDataCount;
+
+    for (quint32 ii = 0; in.status() == QDataStream::Ok && ii < metaDataCount; ++ii) {
+        MetaData data;
+        in >> data.type >> data.data >> data.aliasData >> data.propertyCache;
+        m_metaData << data;
+    }
+
+    in >> m_v8bindings >> m_rootType >> m_rootMetaData;
+
+    return in.status() == QDataStream::Ok && m_typeNames.count() == m_typeFingerprints.count() &&
+           m_typeNames.count() == m_classNames.count();
+}
+
+/*!
+Fills \a parser with the imports and type references of the cached document, in place of
+parsing its source.
+*/
+void QDeclarativeCompiledDataCache::populateParser(QDeclarativeScriptParser *parser) const
+{
+    parser->clear();
+    parser->_imports = m_imports;
+    foreach (const QString &name, m_typeNames)
+        parser->findOrCreateType(name);
+}
+
+/*!
+Restores the cached compiled data for \a unit into \a out.  Returns false if the types
+\a unit resolved to no longer match those the cache was compiled against, in which case
+\a out is left partially filled and should be discarded.
+*/
+bool QDeclarativeCompiledDataCache::restore(QDeclarativeEngine *engine, QDeclarativeTypeData *unit,
+                                            QDeclarativeCompiledData *out) const
+{
+    QDeclarativeEnginePrivate *ep = QDeclarativeEnginePrivate::get(engine);
+    const QList<QDeclarativeTypeData::TypeReference> &resolvedTypes = unit->resolvedTypes();
+
+    if (resolvedTypes.count() != m_typeFingerprints.count())
+        return false;
+    for (int ii = 0; ii < resolvedTypes.count(); ++ii) {
+        if (fingerprint(resolvedTypes.at(ii)) != m_typeFingerprints.at(ii))
+            return false;
+    }
+
+    QList<int> metaTypes;
+    for (int ii = 0; ii < m_metaTypes.count(); ++ii) {
+        int type = QMetaType::type(m_metaTypes.at(ii).constData());
+        if (!type)
+            return false;
+        metaTypes << type;
+    }
+
+    // Fixup the instruction stream
+    QByteArray bytecode = m_bytecode;
+    char *instructionStream = bytecode.data();
+    const char *endInstructionStream = instructionStream + bytecode.size();
+    QList<int> compiledBindings;
+    while (instructionStream < endInstructionStream) {
+        QDeclarativeInstruction *instr = (QDeclarativeInstruction *)instructionStream;
+        switch (instr->type()) {
+        case QDeclarativeInstruction::CreateSimpleObject: {
+            QDeclarativeType *type = resolvedTypes.at(instr->createSimple.type).type;
+            if (!type || type->createSize() != instr->createSimple.typeSize)
+                return false;
+            instr->createSimple.create = type->createFunction();
+            break;
+        }
+        case QDeclarativeInstruction::CreateSimpleObjectBegin: {
+            QDeclarativeType *type = resolvedTypes.at(instr->createSimpleBegin.type).type;
+            if (!type || type->createSize() != instr->createSimpleBegin.typeSize)
+                return false;
+            instr->createSimpleBegin.create = type->createFunction();
+            break;
+        }
+        case QDeclarativeInstruction::AssignCustomType:
+            instr->assignCustomType.type = metaTypes.at(instr->assignCustomType.type);
+            break;
+        case QDeclarativeInstruction::FetchQList:
+            instr->fetchQmlList.type = metaTypes.at(instr->fetchQmlList.type);
+            break;
+        case QDeclarativeInstruction::Init:
+            if (instr->init.compiledBinding != -1)
+                compiledBindings << instr->init.compiledBinding;
+            break;
+        default:
+            break;
+        }
+        int size = instr->size();
+        if (!size)
+            return false;
+        instructionStream += size;
+    }
+
+    QList<QByteArray> datas = m_datas;
+    for (int ii = 0; ii < compiledBindings.count(); ++ii)
+        QDeclarativeV4Compiler::relocate(datas[compiledBindings.at(ii)]);
+
+    // Give the synthesized meta objects names that are unique in this process
+    for (int ii = 0; ii < m_metaData.count(); ++ii) {
+        QByteArray &metadata = datas[m_metaData.at(ii).data];
+
+        QMetaObject mo;
+        QMetaObjectBuilder::fromRelocatableData(&mo, 0, metadata);
+        QMetaObjectBuilder builder(&mo);
+        QByteArray className = builder.className();
+        className.truncate(className.lastIndexOf('_') + 1);
+        className.append(QByteArray::number(QDeclarativeCompiler::nextClassIndex()));
+        builder.setClassName(className);
+        metadata = builder.toRelocatableData();
+    }
+
+    // Compile types
+    for (int ii = 0; ii < resolvedTypes.count(); ++ii) {
+        QDeclarativeCompiledData::TypeReference ref;
+        const QDeclarativeTypeData::TypeReference &tref = resolvedTypes.at(ii);
+
+        if (tref.type) {
+            ref.type = tref.type;
+            if (ref.type->containsRevisionedAttributes()) {
+                QDeclarativeError cacheError;
+                ref.typePropertyCache = ep->cache(ref.type, tref.minorVersion, cacheError);
+                if (!ref.typePropertyCache)
+                    return false;
+                ref.typePropertyCache->addref();
+            }
+        } else if (tref.typeData) {
+            ref.component = tref.typeData->compiledData();
+        }
+        ref.className = m_classNames.at(ii);
+        out->types << ref;
+    }
+
+    QStringList importedScriptIndexes;
+    foreach (const QDeclarativeTypeData::ScriptReference &script, unit->resolvedScripts()) {
+        importedScriptIndexes.append(script.qualifier);
+
+        QDeclarativeScriptData *scriptData = script.script->scriptData();
+        scriptData->addref();
+        out->scripts << scriptData;
+    }
+
+    out->importCache = new QDeclarativeTypeNameCache(engine);
+    for (int ii = 0; ii < importedScriptIndexes.count(); ++ii)
+        out->importCache->add(importedScriptIndexes.at(ii), ii);
+    unit->imports().populateCache(out->importCache, engine);
+
+    out->bytecode = bytecode;
+    out->primitives = m_primitives;
+    out->datas = datas;
+    out->urls = m_urls;
+
+    for (int ii = 0; ii < m_contextCaches.count(); ++ii) {
+        const QStringList &ids = m_contextCaches.at(ii);
+        QDeclarativeIntegerCache *cache = new QDeclarativeIntegerCache();
+        for (int jj = 0; jj < ids.count(); ++jj)
+            cache->add(ids.at(jj), jj);
+        out->contextCaches << cache;
+    }
+
+    for (int ii = 0; ii < m_metaData.count(); ++ii) {
+        const MetaData &data = m_metaData.at(ii);
+        if (data.propertyCache == -1)
+            continue;
+
+        Q_ASSERT(data.propertyCache == out->propertyCaches.count());
+        QDeclarativeCompiledData::TypeReference &tr = out->types[data.type];
+
+        QMetaObject mo;
+        QMetaObjectBuilder::fromRelocatableData(&mo, tr.metaObject(), out->datas.at(data.data));
+
+        QDeclarativePropertyCache *cache = tr.createPropertyCache(engine)->copy();
+        cache->append(engine, &mo, QDeclarativePropertyCache::Data::NoFlags,
+                      QDeclarativePropertyCache::Data::IsVMEFunction,
+                      QDeclarativePropertyCache::Data::IsVMESignal);
+
+        const QByteArray &synthdata = out->datas.at(data.aliasData);
+        if (!synthdata.isEmpty()) {
+            const QDeclarativeVMEMetaData *vmeMetaData =
+                reinterpret_cast<const QDeclarativeVMEMetaData *>(synthdata.constData());
+            for (int jj = 0; jj < vmeMetaData->aliasCount; ++jj) {
+                int index = mo.propertyOffset() + vmeMetaData->propertyCount + jj;
+                QDeclarativePropertyCache::Data *propertyData = cache->property(index);
+                propertyData->setFlags(propertyData->getFlags() | QDeclarativePropertyCache::Data::IsAlias);
+            }
+        }
+
+        out->propertyCaches << cache;
+    }
+
+    for (int ii = 0; ii < m_v8bindings; ++ii)
+        out->v8bindings.append(v8::Persistent<v8::Array>());
+
+    if (m_rootMetaData == -1) {
+        out->root = out->types.at(m_rootType).metaObject();
+        out->rootPropertyCache = out->types[m_rootType].createPropertyCache(engine);
+        out->rootPropertyCache->addref();
+    } else {
+        const MetaData &data = m_metaData.at(m_rootMetaData);
+        QMetaObjectBuilder::fromRelocatableData(&out->rootData, out->types.at(m_rootType).metaObject(),
+                                                out->datas.at(data.data));
+        out->root = &out->rootData;
+        out->rootPropertyCache = out->propertyCaches.at(data.propertyCache);
+        out->rootPropertyCache->addref();
+        ep->registerCompositeType(out);
+    }
+
+    return true;
+}
+
+/*!
+Writes the compiled data \a data for \a unit to \a fileName.  Returns false, and writes
+nothing, if the compiled data contains state that cannot be restored in another process.
+*/
+bool QDeclarativeCompiledDataCache::save(const QString &fileName, const QByteArray &sourceHash,
+                                         QDeclarativeTypeData *unit, QDeclarativeCompiledData *data)
+{
+    QDeclarativeCompiledDataCache cache;
+
+    const QList<QDeclarativeTypeData::TypeReference> &resolvedTypes = unit->resolvedTypes();
+    for (int ii = 0; ii < resolvedTypes.count(); ++ii) {
+        QByteArray print = fingerprint(resolvedTypes.at(ii));
+        if (print.isEmpty())
+            return false;
+        cache.m_typeFingerprints << print;
+        cache.m_classNames << data->types.at(ii).className;
+    }
+
+    cache.m_imports = unit->parser().imports();
+    foreach (QDeclarativeScriptParser::TypeReference *type, unit->parser().referencedTypes())
+        cache.m_typeNames << type->name;
+
+    // Make the instruction stream process independent
+    cache.m_bytecode = data->bytecode;
+    char *instructionStream = cache.m_bytecode.data();
+    const char *endInstructionStream = instructionStream + cache.m_bytecode.size();
+    int lastCreatedType = -1;
+    while (instructionStream < endInstructionStream) {
+        QDeclarativeInstruction *instr = (QDeclarativeInstruction *)instructionStream;
+
+        int *metaType = 0;
+        switch (instr->type()) {
+        case QDeclarativeInstruction::CreateObject:
+            lastCreatedType = instr->create.type;
+            break;
+        case QDeclarativeInstruction::CreateSimpleObject:
+            lastCreatedType = instr->createSimple.type;
+            instr->createSimple.create = 0;
+            break;
+        case QDeclarativeInstruction::CreateSimpleObjectBegin:
+            lastCreatedType = instr->createSimpleBegin.type;
+            instr->createSimpleBegin.create = 0;
+            break;
+        case QDeclarativeInstruction::CreateComponent:
+            if (cache.m_rootType == -1) {
+                for (int ii = 0; cache.m_rootType == -1 && ii < data->types.count(); ++ii) {
+                    if (data->types.at(ii).type &&
+                        data->types.at(ii).metaObject() == &QDeclarativeComponent::staticMetaObject)
+                        cache.m_rootType = ii;
+                }
+                if (cache.m_rootType == -1)
+                    return false;
+            }
+            break;
+        case QDeclarativeInstruction::StoreMetaObject: {
+            MetaData meta;
+            meta.data = instr->storeMeta.data;
+            meta.aliasData = instr->storeMeta.aliasData;
+            meta.propertyCache = instr->storeMeta.propertyCache;
+            if (meta.propertyCache != -1)
+                meta.type = lastCreatedType;
+
+            QMetaObject mo;
+            QMetaObjectBuilder::fromRelocatableData(&mo, 0, data->datas.at(meta.data));
+            for (int ii = 0; ii < mo.propertyCount(); ++ii) {
+                if (isSynthesizedType(mo.property(ii).typeName()))
+                    return false;
+            }
+
+            if (data->root == &data->rootData && cache.m_rootMetaData == -1 &&
+                data->propertyCaches.value(meta.propertyCache) == data->rootPropertyCache)
+                cache.m_rootMetaData = cache.m_metaData.count();
+            cache.m_metaData << meta;
+            break;
+        }
+        case QDeclarativeInstruction::AssignCustomType:
+            metaType = &instr->assignCustomType.type;
+            break;
+        case QDeclarativeInstruction::FetchQList:
+            metaType = &instr->fetchQmlList.type;
+            break;
+        default:
+            break;
+        }
+
+        if (cache.m_rootType == -1 && lastCreatedType != -1)
+            cache.m_rootType = lastCreatedType;
+
+        if (metaType) {
+            QByteArray name(QMetaType::typeName(*metaType));
+            if (name.isEmpty() || isSynthesizedType(name))
+                return false;
+            int index = cache.m_metaTypes.indexOf(name);
+            if (index == -1) {
+                index = cache.m_metaTypes.count();
+                cache.m_metaTypes << name;
+            }
+            *metaType = index;
+        }
+
+        instructionStream += instr->size();
+    }
+
+    if (cache.m_rootType == -1 || (data->root == &data->rootData && cache.m_rootMetaData == -1))
+        return false;
+
+    for (int ii = 0; ii < data->contextCaches.count(); ++ii) {
+        QDeclarativeIntegerCache *contextCache = data->contextCaches.at(ii);
+        QStringList ids;
+        for (int jj = 0; jj < contextCache->count(); ++jj) {
+            QString id = contextCache->findId(jj);
+            if (id.isEmpty())
+                return false;
+            ids << id;
+        }
+        cache.m_contextCaches << ids;
+    }
+
+    QString tempFileName = fileName + QLatin1String(".tmp");
+    QFile file(tempFileName);
+    if (!QDir().mkpath(QFileInfo(fileName).absolutePath()) || !file.open(QFile::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_4_7);
+    out << QmlCacheMagic << QmlCacheVersion << buildKey() << sourceHash
+        << quint32(cache.m_imports.count());
+    for (int ii = 0; ii < cache.m_imports.count(); ++ii) {
+        const QDeclarativeScriptParser::Import &import = cache.m_imports.at(ii);
+        out << qint32(import.type) << import.uri << import.qualifier << import.version
+            << qint32(import.location.start.line) << qint32(import.location.start.column);
+    }
+    out << cache.m_typeNames << cache.m_typeFingerprints << cache.m_classNames
+        << cache.m_bytecode << data->primitives << data->datas << data->urls << cache.m_metaTypes
+        << cache.m_contextCaches << quint32(cache.m_metaData.count());
+    for (int ii = 0; ii < cache.m_metaData.count(); ++ii) {
+        const MetaData &meta = cache.m_metaData.at(ii);
+        out << meta.type << meta.data << meta.aliasData << meta.propertyCache;
+    }
+    out << qint32(data->v8bindings.count()) << cache.m_rootType << cache.m_rootMetaData;
+
+    file.close();
+    if (out.status() != QDataStream::Ok || file.error() != QFile::NoError) {
+        file.remove();
+        return false;
+    }
+
+    QFile::remove(fileName);
+    return file.rename(fileName);
+}
+
+QT_END_NAMESPACE
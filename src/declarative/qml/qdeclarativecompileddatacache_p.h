@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the QtDeclarative module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QDECLARATIVECOMPILEDDATACACHE_P_H
+#define QDECLARATIVECOMPILEDDATACACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qdeclarativescriptparser_p.h>
+#include <private/qdeclarativetypeloader_p.h>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qurl.h>
+
+QT_BEGIN_NAMESPACE
+
+class QDeclarativeEngine;
+class QDeclarativeCompiledData;
+class Q_AUTOTEST_EXPORT QDeclarativeCompiledDataCache
+{
+public:
+    QDeclarativeCompiledDataCache();
+
+    bool load(const QString &fileName, const QByteArray &sourceHash);
+    void populateParser(QDeclarativeScriptParser *) const;
+    bool restore(QDeclarativeEngine *, QDeclarativeTypeData *, QDeclarativeCompiledData *) const;
+
+    static bool save(const QString &fileName, const QByteArray &sourceHash,
+                     QDeclarativeTypeData *, QDeclarativeCompiledData *);
+
+    static QByteArray sourceHash(const QByteArray &);
+    static QByteArray typeHash(const QByteArray &sourceHash,
+                               const QList<QDeclarativeTypeData::TypeReference> &);
+
+private:
+    struct MetaData {
+        MetaData() : type(-1), data(-1), aliasData(-1), propertyCache(-1) {}
+        qint32 type;
+        qint32 data;
+        qint32 aliasData;
+        qint32 propertyCache;
+    };
+
+    static QByteArray fingerprint(const QDeclarativeTypeData::TypeReference &);
+
+    QList<QDeclarativeScriptParser::Import> m_imports;
+    QStringList m_typeNames;
+    QList<QByteArray> m_typeFingerprints;
+    QList<QByteArray> m_classNames;
+
+    QByteArray m_bytecode;
+    QList<QString> m_primitives;
+    QList<QByteArray> m_datas;
+    QList<QUrl> m_urls;
+    QList<QByteArray> m_metaTypes;
+    QList<QStringList> m_contextCaches;
+    QList<MetaData> m_metaData;
+    qint32 m_v8bindings;
+    qint32 m_rootType;
+    qint32 m_rootMetaData;
+};
+
+QT_END_NAMESPACE
+
+#endif // QDECLARATIVECOMPILEDDATACACHE_P_H
@@ -78,6 +78,8 @@ QT_BEGIN_NAMESPACE
 
 DEFINE_BOOL_CONFIG_OPTION(compilerDump, QML_COMPILER_DUMP);
 DEFINE_BOOL_CONFIG_OPTION(compilerStatDump, QML_COMPILER_STATS);
+DEFINE_BOOL_CONFIG_OPTION(compilerNoSuperInstructions, QML_DISABLE_SUPER_INSTRUCTIONS);
+DEFINE_BOOL_CONFIG_OPTION(compilerRejectedBindingsDump, QML_BINDINGS_REJECTED);
 
 using namespace QDeclarativeParser;
 
@@ -85,7 +87,7 @@ using namespace QDeclarativeParser;
     Instantiate a new QDeclarativeCompiler.
 */
 QDeclarativeCompiler::QDeclarativeCompiler()
-: output(0), engine(0), unitRoot(0), unit(0)
+: output(0), engine(0), unitRoot(0), unit(0), lastLiteralInstruction(-1)
 {
 }
 
@@ -351,7 +353,7 @@ void QDeclarativeCompiler::genLiteralAssignment(const QMetaProperty &prop,
         instr.setType(QDeclarativeInstruction::StoreInteger);
         instr.storeInteger.propertyIndex = prop.propertyIndex();
         instr.storeInteger.value = value;
-        output->addInstruction(instr);
+        addLiteralInstruction(instr);
         return;
     }
 
@@ -564,7 +566,50 @@ void QDeclarativeCompiler::genLiteralAssignment(const QMetaProperty &prop,
             }
             break;
     }
-    output->addInstruction(instr);
+    addLiteralInstruction(instr);
+}
+
+/*!
+    Adds the literal assignment \a instr to the output.  Consecutive StoreDouble
+    or StoreInteger instructions are fused into a single StoreDoublePair or
+    StoreIntegerPair super instruction, unless the QML_DISABLE_SUPER_INSTRUCTIONS
+    environment variable is set.
+*/
+void QDeclarativeCompiler::addLiteralInstruction(const QDeclarativeInstruction &instr)
+{
+    // Only fuse with the previous literal store if nothing was generated after it
+    if (lastLiteralInstruction != -1 && !compilerNoSuperInstructions() &&
+        lastLiteralInstruction + output->instruction(lastLiteralInstruction)->size() == output->nextInstructionIndex()) {
+
+        const QDeclarativeInstruction &last = *output->instruction(lastLiteralInstruction);
+
+        QDeclarativeInstruction pair;
+        if (last.type() == QDeclarativeInstruction::StoreDouble &&
+            instr.type() == QDeclarativeInstruction::StoreDouble) {
+            pair.setType(QDeclarativeInstruction::StoreDoublePair);
+            pair.storeDoublePair.propertyIndex = last.storeDouble.propertyIndex;
+            pair.storeDoublePair.value = last.storeDouble.value;
+            pair.storeDoublePair.propertyIndex2 = instr.storeDouble.propertyIndex;
+            pair.storeDoublePair.value2 = instr.storeDouble.value;
+        } else if (last.type() == QDeclarativeInstruction::StoreInteger &&
+                   instr.type() == QDeclarativeInstruction::StoreInteger) {
+            pair.setType(QDeclarativeInstruction::StoreIntegerPair);
+            pair.storeIntegerPair.propertyIndex = last.storeInteger.propertyIndex;
+            pair.storeIntegerPair.value = last.storeInteger.value;
+            pair.storeIntegerPair.propertyIndex2 = instr.storeInteger.propertyIndex;
+            pair.storeIntegerPair.value2 = instr.storeInteger.value;
+        } else {
+            lastLiteralInstruction = output->addInstruction(instr);
+            return;
+        }
+
+        output->bytecode.resize(lastLiteralInstruction);
+        output->addInstruction(pair);
+        lastLiteralInstruction = -1;
+        return;
+    }
+
+    lastLiteralInstruction = output->addInstruction(instr);
 }
 
 /*!
@@ -599,6 +644,7 @@ bool QDeclarativeCompiler::compile(QDeclarativeEngine *engine,
     reset(out);
 
     output = out;
+    lastLiteralInstruction = -1;
 
     // Compile types
     const QList<QDeclarativeTypeData::TypeReference>  &resolvedTypes = unit->resolvedTypes();
@@ -651,6 +697,8 @@ bool QDeclarativeCompiler::compile(QDeclarativeEngine *engine,
             out->dumpInstructions();
         if (compilerStatDump())
             dumpStats();
+        if (compilerRejectedBindingsDump())
+            dumpRejectedBindings();
         Q_ASSERT(out->rootPropertyCache);
     } else {
         reset(out);
@@ -932,6 +980,26 @@ void QDeclarativeCompiler::genObject(QDeclarativeParser::Object *obj)
 
     // Create the object
     if (obj->custom.isEmpty() && output->types.at(obj->type).type &&
+        !output->types.at(obj->type).type->isExtendedType() && obj != compileState.root &&
+        obj->metadata.isEmpty() && obj->parserStatusCast != -1 && !compilerNoSuperInstructions()) {
+
+        // Creating a simple object, setting its id and beginning it is by far the most
+        // common sequence, so it is fused into a single instruction.
+        QDeclarativeInstruction create;
+        create.setType(QDeclarativeInstruction::CreateSimpleObjectBegin);
+        create.createSimpleBegin.create = output->types.at(obj->type).type->createFunction();
+        create.createSimpleBegin.typeSize = output->types.at(obj->type).type->createSize();
+        create.createSimpleBegin.type = obj->type;
+        create.createSimpleBegin.id = obj->id.isEmpty() ? -1 : obj->idIndex;
+        create.createSimpleBegin.castValue = obj->parserStatusCast;
+        create.createSimpleBegin.line = obj->location.start.line;
+        create.createSimpleBegin.column = obj->location.start.column;
+        output->addInstruction(create);
+
+        genObjectBody(obj);
+        return;
+
+    } else if (obj->custom.isEmpty() && output->types.at(obj->type).type &&
         !output->types.at(obj->type).type->isExtendedType() && obj != compileState.root) {
 
         QDeclarativeInstruction create;
@@ -2439,6 +2507,14 @@ bool QDeclarativeCompiler::mergeDynamicMetaProperties(QDeclarativeParser::Object
 
 Q_GLOBAL_STATIC(QAtomicInt, classIndexCounter)
 
+/*!
+Returns a process unique index used to name synthesized meta objects.
+*/
+int QDeclarativeCompiler::nextClassIndex()
+{
+    return classIndexCounter()->fetchAndAddRelaxed(1);
+}
+
 bool QDeclarativeCompiler::buildDynamicMeta(QDeclarativeParser::Object *obj, DynamicMetaMode mode)
 {
     Q_ASSERT(obj);
@@ -2454,7 +2530,7 @@ bool QDeclarativeCompiler::buildDynamicMeta(QDeclarativeParser::Object *obj, Dyn
 
     QByteArray newClassName = obj->metatype->className();
     newClassName.append("_QML_");
-    int idx = classIndexCounter()->fetchAndAddRelaxed(1);
+    int idx = nextClassIndex();
     newClassName.append(QByteArray::number(idx));
     if (compileState.root == obj && !compileState.nested) {
         QString path = output->url.path();
@@ -2959,6 +3035,8 @@ bool QDeclarativeCompiler::completeComponentBuild()
 
         BindingReference &binding = *iter;
 
+        QString rejectReason;
+
         // ### We don't currently optimize for bindings on alias's - because 
         // of the solution to QTBUG-13719
         if (!binding.property->isAlias) {
@@ -2973,6 +3051,16 @@ bool QDeclarativeCompiler::completeComponentBuild()
                 componentStat.optimizedBindings.append(iter.key()->location);
                 continue;
             } 
+            rejectReason = bindingCompiler.discardReason();
+        } else {
+            rejectReason = QLatin1String("binding on alias property");
+        }
+
+        if (compilerRejectedBindingsDump()) {
+            const QDeclarativeParser::LocationSpan &l = iter.key()->location;
+            componentStat.rejectedBindings.append(QString(QLatin1String("(%1:%2) %3: %4 -- %5"))
+                .arg(l.start.line).arg(l.start.column).arg(QString::fromUtf8(binding.property->name))
+                .arg(binding.expression.asScript().simplified()).arg(rejectReason));
         }
 
         // Pre-rewrite the expression
@@ -3088,6 +3176,37 @@ void QDeclarativeCompiler::dumpStats()
     }
 }
 
+/*!
+    Prints each binding of the document that was not compiled to V4, together
+    with the reason it was rejected, and the fraction of bindings kept off V8
+    for this document and for all documents compiled so far.
+*/
+void QDeclarativeCompiler::dumpRejectedBindings()
+{
+    static int totalBindings = 0;
+    static int totalOptimized = 0;
+
+    int bindings = 0;
+    int optimized = 0;
+    for (int ii = 0; ii < savedComponentStats.count(); ++ii) {
+        const ComponentStat &stat = savedComponentStats.at(ii);
+        optimized += stat.optimizedBindings.count();
+        bindings += stat.optimizedBindings.count() + stat.scriptBindings.count();
+    }
+    totalBindings += bindings;
+    totalOptimized += optimized;
+
+    qWarning().nospace() << "QML Document: " << output->url.toString();
+    qWarning().nospace() << "    V4 Bindings: " << optimized << " of " << bindings
+                         << " (total " << totalOptimized << " of " << totalBindings << ", "
+                         << (totalBindings ? (100 * totalOptimized / totalBindings) : 100) << "%)";
+    for (int ii = 0; ii < savedComponentStats.count(); ++ii) {
+        const ComponentStat &stat = savedComponentStats.at(ii);
+        for (int jj = 0; jj < stat.rejectedBindings.count(); ++jj)
+            qWarning().nospace() << "        " << qPrintable(stat.rejectedBindings.at(jj));
+    }
+}
+
 /*!
     Returns true if from can be assigned to a (QObject) property of type
     to.
@@ -158,6 +158,8 @@ public:
     const QMetaObject *resolveType(const QByteArray& name) const; // for QDeclarativeCustomParser::resolveType
     int rewriteBinding(const QString& expression, const QByteArray& name); // for QDeclarativeCustomParser::rewriteBinding
 
+    static int nextClassIndex(); // for QDeclarativeCompiledDataCache
+
 private:
     static void reset(QDeclarativeCompiledData *);
 
@@ -257,6 +259,7 @@ private:
                                QDeclarativeParser::Property *valueTypeProperty = 0);
     void genLiteralAssignment(const QMetaProperty &prop, 
                               QDeclarativeParser::Value *value);
+    void addLiteralInstruction(const QDeclarativeInstruction &);
     void genBindingAssignment(QDeclarativeParser::Value *binding, 
                               QDeclarativeParser::Property *prop, 
                               QDeclarativeParser::Object *obj,
@@ -278,6 +281,7 @@ private:
     void addId(const QString &, QDeclarativeParser::Object *);
 
     void dumpStats();
+    void dumpRejectedBindings();
 
     struct BindingReference {
         QDeclarativeParser::Variant expression;
@@ -325,6 +329,7 @@ private:
         int ids;
         QList<QDeclarativeParser::LocationSpan> scriptBindings;
         QList<QDeclarativeParser::LocationSpan> optimizedBindings;
+        QStringList rejectedBindings;
         int objects;
     };
     ComponentStat componentStat;
@@ -341,6 +346,7 @@ private:
     QDeclarativeEnginePrivate *enginePrivate;
     QDeclarativeParser::Object *unitRoot;
     QDeclarativeTypeData *unit;
+    int lastLiteralInstruction;
 };
 QT_END_NAMESPACE
 
@@ -237,6 +237,16 @@ class QByteArray;
     \value Error An error has occurred.  Call errors() to retrieve a list of \{QDeclarativeError}{errors}.
 */
 
+/*!
+    \enum QDeclarativeComponent::CompilationMode
+
+    Specifies whether the QDeclarativeComponent should load the component immediately, or asynchronously.
+
+    \value PreferSynchronous Prefer loading/compiling the component immediately, blocking the thread.
+    This is not always possible, e.g. remote URLs will always load asynchronously.
+    \value Asynchronous Load/compile the component in a background thread.
+*/
+
 void QDeclarativeComponentPrivate::typeDataReady(QDeclarativeTypeData *)
 {
     Q_Q(QDeclarativeComponent);
@@ -436,6 +446,25 @@ QDeclarativeComponent::QDeclarativeComponent(QDeclarativeEngine *engine, const Q
     loadUrl(url);
 }
 
+/*!
+    Create a QDeclarativeComponent from the given \a url and give it the
+    specified \a parent and \a engine.  If \a mode is \l Asynchronous,
+    the component will be loaded and compiled asynchronously.
+
+    Ensure that the URL provided is full and correct, in particular, use
+    \l QUrl::fromLocalFile() when loading a file from the local filesystem.
+
+    \sa loadUrl()
+*/
+QDeclarativeComponent::QDeclarativeComponent(QDeclarativeEngine *engine, const QUrl &url, CompilationMode mode,
+                                             QObject *parent)
+: QObject(*(new QDeclarativeComponentPrivate), parent)
+{
+    Q_D(QDeclarativeComponent);
+    d->engine = engine;
+    loadUrl(url, mode);
+}
+
 /*!
     Create a QDeclarativeComponent from the given \a fileName and give it the specified 
     \a parent and \a engine.
@@ -513,6 +542,18 @@ QDeclarativeContext *QDeclarativeComponent::creationContext() const
     \l QUrl::fromLocalFile() when loading a file from the local filesystem.
 */
 void QDeclarativeComponent::loadUrl(const QUrl &url)
+{
+    loadUrl(url, PreferSynchronous);
+}
+
+/*!
+    Load the QDeclarativeComponent from the provided \a url.
+    If \a mode is \l Asynchronous, the component will be loaded and compiled asynchronously.
+
+    Ensure that the URL provided is full and correct, in particular, use
+    \l QUrl::fromLocalFile() when loading a file from the local filesystem.
+*/
+void QDeclarativeComponent::loadUrl(const QUrl &url, CompilationMode mode)
 {
     Q_D(QDeclarativeComponent);
 
@@ -531,7 +572,9 @@ void QDeclarativeComponent::loadUrl(const QUrl &url)
         return;
     }
 
-    QDeclarativeTypeData *data = QDeclarativeEnginePrivate::get(d->engine)->typeLoader.get(d->url);
+    QDeclarativeDataLoader::Mode loaderMode = (mode == Asynchronous) ? QDeclarativeDataLoader::Asynchronous
+                                                                     : QDeclarativeDataLoader::PreferSynchronous;
+    QDeclarativeTypeData *data = QDeclarativeEnginePrivate::get(d->engine)->typeLoader.get(d->url, loaderMode);
 
     if (data->isCompleteOrError()) {
         d->fromTypeData(data);
@@ -993,6 +1036,9 @@ void QDeclarativeComponentPrivate::complete(QDeclarativeEnginePrivate *enginePri
             QDeclarativeEnginePrivate::clear(bv);
         }
 
+        // Deferred binding updates must have settled before componentComplete()
+        enginePriv->flushDirtyBindings();
+
         for (int ii = 0; ii < state->parserStatus.count(); ++ii) {
             QDeclarativeEnginePrivate::SimpleList<QDeclarativeParserStatus> ps = 
                 state->parserStatus.at(ii);
@@ -1049,6 +1095,8 @@ void QDeclarativeComponentPrivate::complete(QDeclarativeEnginePrivate *enginePri
 
         enginePriv->inProgressCreations--;
         if (0 == enginePriv->inProgressCreations) {
+            enginePriv->flushDirtyBindings();
+
             while (enginePriv->erroredBindings) {
                 enginePriv->warning(enginePriv->erroredBindings->error);
                 enginePriv->erroredBindings->removeError();
@@ -71,10 +71,14 @@ class Q_DECLARATIVE_EXPORT QDeclarativeComponent : public QObject
     Q_PROPERTY(QUrl url READ url CONSTANT)
 
 public:
+    Q_ENUMS(CompilationMode)
+    enum CompilationMode { PreferSynchronous, Asynchronous };
+
     QDeclarativeComponent(QObject *parent = 0);
     QDeclarativeComponent(QDeclarativeEngine *, QObject *parent=0);
     QDeclarativeComponent(QDeclarativeEngine *, const QString &fileName, QObject *parent = 0);
     QDeclarativeComponent(QDeclarativeEngine *, const QUrl &url, QObject *parent = 0);
+    QDeclarativeComponent(QDeclarativeEngine *, const QUrl &url, CompilationMode mode, QObject *parent = 0);
     virtual ~QDeclarativeComponent();
 
     Q_ENUMS(Status)
@@ -103,6 +107,7 @@ public:
 
 public Q_SLOTS:
     void loadUrl(const QUrl &url);
+    void loadUrl(const QUrl &url, CompilationMode mode);
     void setData(const QByteArray &, const QUrl &baseUrl);
 
 Q_SIGNALS:
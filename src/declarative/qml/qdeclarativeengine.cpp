@@ -175,9 +175,15 @@ void qmlRegisterBaseTypes(const char *uri, int versionMajor, int versionMinor)
     \endcode
 */
 
+DEFINE_BOOL_CONFIG_OPTION(qmlDeferredBindings, QML_DEFERRED_BINDINGS)
+
 static bool qt_QmlQtModule_registered = false;
 bool QDeclarativeEnginePrivate::qml_debugging_enabled = false;
 
+// Engines with deferred binding updates pending.  Only engines living in the GUI thread defer
+// binding updates.
+static QDeclarativeEnginePrivate *dirtyEngines = 0;
+
 void QDeclarativeEnginePrivate::registerBaseTypes(const char *uri, int versionMajor, int versionMinor)
 {
     qmlRegisterType<QDeclarativeComponent>(uri,versionMajor,versionMinor,"Component");
@@ -342,7 +348,9 @@ the same object as is returned from the Qt.include() call.
 QDeclarativeEnginePrivate::QDeclarativeEnginePrivate(QDeclarativeEngine *e)
 : captureProperties(false), rootContext(0), isDebugging(false),
   outputWarningsToStdErr(true), sharedContext(0), sharedScope(0),
-  cleanup(0), erroredBindings(0), inProgressCreations(0), 
+  cleanup(0), erroredBindings(0), inProgressCreations(0), deferBindingUpdates(false),
+  bindingFlushPosted(false), bindingDepthsSweepSize(0), flushingBinding(0), flushingDepth(-1),
+  prevDirtyEngine(0), nextDirtyEngine(0),
   workerScriptEngine(0), componentAttached(0), inBeginCreate(false), 
   networkAccessManager(0), networkAccessManagerFactory(0),
   scarceResourcesRefCount(0), typeLoader(e), importDatabase(e), uniqueId(1),
@@ -453,6 +461,181 @@ void QDeclarativeEnginePrivate::init()
         QDeclarativeEngineDebugServer::instance()->addEngine(q);
         QJSDebugService::instance()->addEngine(q);
     }
+
+    if (qmlDeferredBindings())
+        setDeferredBindingUpdates(true);
+}
+
+/*!
+Sets whether binding notifications are deferred.  Deferral is only supported for engines
+living in the GUI thread; the call is ignored for other engines.  Disabling deferral
+flushes any pending updates.
+*/
+void QDeclarativeEnginePrivate::setDeferredBindingUpdates(bool defer)
+{
+    Q_Q(QDeclarativeEngine);
+    if (defer && QCoreApplication::instance()->thread() != q->thread())
+        return;
+
+    if (!defer)
+        flushDirtyBindings();
+    deferBindingUpdates = defer;
+}
+
+/*
+Marks \a binding dirty.  Returns false if the binding must instead be updated immediately.
+
+The binding is queued at its depth in the binding graph, which is learned while flushing: 
+a binding notified while another binding is being updated depends on it, so it is moved 
+deeper than that binding.  The depth is kept, so subsequent flushes evaluate the graph in 
+dependency order and each dirty binding only once.
+
+The queue and the depths are held by the engine rather than by the bindings, so bindings
+pay nothing when deferral is off.  A binding deleted while queued is detected through its
+weak pointer and skipped.
+*/
+bool QDeclarativeEnginePrivate::deferBindingUpdate(QDeclarativeAbstractBinding *binding)
+{
+    Q_Q(QDeclarativeEngine);
+
+    BindingDepth &entry = bindingDepths[binding];
+    if (entry.binding.isNull()) {
+        // New entry, or a deleted binding whose address has been reused
+        entry = BindingDepth();
+        entry.binding = QDeclarativeAbstractBinding::getPointer(binding);
+    }
+
+    int depth = entry.depth;
+    if (flushingDepth != -1 && depth <= flushingDepth) {
+        // This deep the graph is most likely a binding loop.  Updating immediately lets the
+        // binding report it.
+        if (flushingDepth + 1 == MaximumBindingDepth) {
+            if (!entry.dirty && !entry.depth)
+                bindingDepths.remove(binding);
+            return false;
+        }
+        depth = flushingDepth + 1;
+    }
+
+    if (entry.dirty && entry.depth == depth)
+        return true;
+
+    // A previous entry at another depth is left behind and skipped as stale
+    entry.depth = depth;
+    entry.dirty = true;
+    dirtyBindings[depth].append(binding);
+
+    if (!prevDirtyEngine) {
+        nextDirtyEngine = dirtyEngines;
+        if (nextDirtyEngine) nextDirtyEngine->prevDirtyEngine = &nextDirtyEngine;
+        prevDirtyEngine = &dirtyEngines;
+        dirtyEngines = this;
+    }
+
+    if (!bindingFlushPosted && flushingDepth == -1) {
+        bindingFlushPosted = true;
+        QMetaObject::invokeMethod(q, "_q_flushDirtyBindings", Qt::QueuedConnection);
+    }
+
+    return true;
+}
+
+/*!
+Updates the dirty bindings of this engine in dependency order.
+*/
+void QDeclarativeEnginePrivate::flushDirtyBindings()
+{
+    // Bindings dirtied by a flush in progress are picked up by that flush
+    if (!prevDirtyEngine || flushingDepth != -1)
+        return;
+
+    for (int depth = 0; depth < MaximumBindingDepth; ++depth) {
+        flushingDepth = depth;
+        // Updates only queue deeper, so the queue does not grow while it is walked
+        QPODVector<QDeclarativeAbstractBinding *, 64> &queue = dirtyBindings[depth];
+        for (int ii = 0; ii < queue.count(); ++ii) {
+            QHash<QDeclarativeAbstractBinding *, BindingDepth>::Iterator iter =
+                bindingDepths.find(queue.at(ii));
+            if (iter == bindingDepths.end() || !iter->dirty || iter->depth != depth)
+                continue;
+
+            if (iter->binding.isNull()) {
+                bindingDepths.erase(iter);
+                continue;
+            }
+
+            QDeclarativeAbstractBinding *binding = iter.key();
+            iter->dirty = false;
+            if (!depth
+                bindingDepths.erase(iter);
+
+            flushingBinding = binding;
+            ++bindingCounters.evaluations;
+            binding->update();
+        }
+        queue.clear();
+    }
+    flushingBinding = 0;
+    flushingDepth = -1;
+
+    // Forget the depths of deleted bindings once enough of them may have accumulated
+    if (bindingDepths.count() > 2 * bindingDepthsSweepSize + 64) {
+        QHash<QDeclarativeAbstractBinding *, BindingDepth>::Iterator iter = bindingDepths.begin();
+        while (iter != bindingDepths.end()) {
+            if (iter->binding.isNull())
+                iter = bindingDepths.erase(iter);
+            else
+                ++iter;
+        }
+        bindingDepthsSweepSize = bindingDepths.count();
+    }
+
+    if (nextDirtyEngine) nextDirtyEngine->prevDirtyEngine = prevDirtyEngine;
+    *prevDirtyEngine = nextDirtyEngine;
+    nextDirtyEngine = 0;
+    prevDirtyEngine = 0;
+}
+
+/*!
+Discards the pending binding updates of this engine.
+*/
+void QDeclarativeEnginePrivate::clearDirtyBindings()
+{
+    for (int ii = 0; ii < MaximumBindingDepth; ++ii)
+        dirtyBindings[ii].clear();
+
+    // Learned depths are kept
+    QHash<QDeclarativeAbstractBinding *, BindingDepth>::Iterator iter = bindingDepths.begin();
+    while (iter != bindingDepths.end()) {
+        if (iter->binding.isNull() || !iter->depth) {
+            iter = bindingDepths.erase(iter);
+        } else {
+            iter->dirty = false;
+            ++iter;
+        }
+    }
+
+    if (prevDirtyEngine) {
+        if (nextDirtyEngine) nextDirtyEngine->prevDirtyEngine = prevDirtyEngine;
+        *prevDirtyEngine = nextDirtyEngine;
+        nextDirtyEngine = 0;
+        prevDirtyEngine = 0;
+    }
+}
+
+void QDeclarativeEnginePrivate::_q_flushDirtyBindings()
+{
+    bindingFlushPosted = false;
+    flushDirtyBindings();
+}
+
+/*!
+Updates the dirty bindings of all engines.
+*/
+void QDeclarativeEnginePrivate::flushAllDirtyBindings()
+{
+    while (dirtyEngines && dirtyEngines->flushingDepth == -1)
+        dirtyEngines->flushDirtyBindings();
 }
 
 QDeclarativeWorkerScriptEngine *QDeclarativeEnginePrivate::getWorkerScriptEngine()
@@ -517,6 +700,8 @@ QDeclarativeEngine::~QDeclarativeEngine()
     if (d->isDebugging)
         QDeclarativeEngineDebugServer::instance()->remEngine(this);
 
+    d->clearDirtyBindings();
+
     // if we are the parent of any of the qobject module api instances,
     // we need to remove them from our internal list, in order to prevent
     // a segfault in engine private dtor.
@@ -1652,3 +1837,5 @@ bool QDeclarative_isFileCaseCorrect(const QString &fileName)
 }
 
 QT_END_NAMESPACE
+
+#include <moc_qdeclarativeengine.cpp>
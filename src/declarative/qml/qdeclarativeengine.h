@@ -124,6 +124,7 @@ Q_SIGNALS:
 private:
     Q_DISABLE_COPY(QDeclarativeEngine)
     Q_DECLARE_PRIVATE(QDeclarativeEngine)
+    Q_PRIVATE_SLOT(d_func(), void _q_flushDirtyBindings())
 };
 
 QT_END_NAMESPACE
@@ -75,6 +75,7 @@
 #include <QtCore/qpair.h>
 #include <QtCore/qstack.h>
 #include <QtCore/qmutex.h>
+#include <QtCore/qsharedpointer.h>
 
 #include <private/qobject_p.h>
 
@@ -139,6 +140,43 @@ public:
     QDeclarativeDelayedError *erroredBindings;
     int inProgressCreations;
 
+    // When deferred, binding notifications only mark the binding dirty.  Dirty bindings
+    // are re-evaluated once each, ordered by their depth in the binding graph, when the
+    // current event has been handled, after a component has been created, or before the 
+    // items of a QSGCanvas are polished.
+    enum { MaximumBindingDepth = 32 };
+    struct BindingCounters {
+        BindingCounters() : notifications(0), evaluations(0) {}
+        quint64 notifications; // Number of binding notifications
+        quint64 evaluations;   // Number of binding evaluations they caused
+    };
+    struct BindingDepth {
+        BindingDepth() : depth(0), dirty(false) {}
+        QWeakPointer<QDeclarativeAbstractBinding> binding; // null once the binding is deleted
+        int depth;
+        bool dirty;
+    };
+    bool deferBindingUpdates;
+    bool bindingFlushPosted;
+    BindingCounters bindingCounters;
+    // Bindings queued at each depth; entries whose BindingDepth no longer matches are stale
+    QPODVector<QDeclarativeAbstractBinding *, 64> dirtyBindings[MaximumBindingDepth];
+    // Dirty bindings and the bindings that have learned a non-zero depth
+    QHash<QDeclarativeAbstractBinding *, BindingDepth> bindingDepths;
+    int bindingDepthsSweepSize;
+    QDeclarativeAbstractBinding *flushingBinding;
+    int flushingDepth;
+    QDeclarativeEnginePrivate **prevDirtyEngine;
+    QDeclarativeEnginePrivate  *nextDirtyEngine;
+
+    void setDeferredBindingUpdates(bool);
+    inline bool scheduleBindingUpdate(QDeclarativeAbstractBinding *);
+    bool deferBindingUpdate(QDeclarativeAbstractBinding *);
+    void flushDirtyBindings();
+    void clearDirtyBindings();
+    void _q_flushDirtyBindings();
+    static void flushAllDirtyBindings();
+
     QV8Engine *v8engine() const { return q_func()->handle(); }
 
     QDeclarativeWorkerScriptEngine *getWorkerScriptEngine();
@@ -271,6 +309,20 @@ public:
     QSGContext *sgContext;
 };
 
+/*!
+Called when a property that \a binding depends on has changed.  Returns true if the 
+update of \a binding has been deferred, in which case the caller must not update it.
+*/
+bool QDeclarativeEnginePrivate::scheduleBindingUpdate(QDeclarativeAbstractBinding *binding)
+{
+    ++bindingCounters.notifications;
+    if (deferBindingUpdates && binding != flushingBinding && deferBindingUpdate(binding))
+        return true;
+
+    ++bindingCounters.evaluations;
+    return false;
+}
+
 /*!
 Returns a QDeclarativePropertyCache for \a obj if one is available.
 
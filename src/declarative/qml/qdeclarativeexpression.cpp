@@ -541,16 +541,27 @@ void QDeclarativeJavaScriptExpression::GuardList::updateGuards(QObject *notifyOb
         return;
     }
 
-    if (properties.count() != length) {
-        QDeclarativeNotifierEndpoint *newGuardList = new QDeclarativeNotifierEndpoint[properties.count()];
+    // Most evaluations depend on exactly the same properties as the last one
+    if (properties.count() == length && endpoints[0].target == notifyObject && 
+        endpoints[0].targetMethod == notifyIndex && isUnchanged(properties))
+        return;
+
+    if (properties.count() > capacity) {
+        int newCapacity = 0;
+        QDeclarativeNotifierEndpoint *newGuardList = 
+            QDeclarativeNotifierEndpoint::allocate(properties.count(), &newCapacity);
 
-        for (int ii = 0; ii < qMin(length, properties.count()); ++ii) 
+        for (int ii = 0; ii < length; ++ii) 
            endpoints[ii].copyAndClear(newGuardList[ii]);
 
-        delete [] endpoints;
+        QDeclarativeNotifierEndpoint::release(endpoints, capacity);
         endpoints = newGuardList;
-        length = properties.count();
+        capacity = newCapacity;
+    } else {
+        for (int ii = properties.count(); ii < length; ++ii)
+            endpoints[ii].disconnect();
     }
+    length = properties.count();
 
     bool outputWarningHeader = false;
     bool noChanges = true;
@@ -620,6 +631,44 @@ void QDeclarativeJavaScriptExpression::GuardList::updateGuards(QObject *notifyOb
     }
 }
 
+/*
+Returns true if the guards are already connected to exactly the captured \a properties.  
+A duplicated property only has its first guard connected.
+*/
+bool QDeclarativeJavaScriptExpression::GuardList::isUnchanged(const CapturedProperties &properties) const
+{
+    for (int ii = 0; ii < properties.count(); ++ii) {
+        QDeclarativeNotifierEndpoint &guard = endpoints[ii];
+        const QDeclarativeEnginePrivate::CapturedProperty &property = properties.at(ii);
+
+        if (property.notifier != 0) {
+            if (guard.isConnected(property.notifier))
+                continue;
+        } else if (property.notifyIndex != -1) {
+            if (guard.isConnected(property.object, property.notifyIndex))
+                continue;
+        } else {
+            // Let updateGuards() warn about it
+            return false;
+        }
+
+        if (guard.isConnected())
+            return false;
+
+        bool duplicate = false;
+        for (int jj = 0; !duplicate && jj < ii; ++jj) {
+            const QDeclarativeEnginePrivate::CapturedProperty &other = properties.at(jj);
+            duplicate = property.notifier ? other.notifier == property.notifier
+                                          : (other.object == property.object && 
+                                             other.notifyIndex == property.notifyIndex);
+        }
+        if (!duplicate)
+            return false;
+    }
+
+    return true;
+}
+
 // Must be called with a valid handle scope
 v8::Local<v8::Value> QDeclarativeExpressionPrivate::v8value(QObject *secondaryScope, bool *isUndefined)
 {
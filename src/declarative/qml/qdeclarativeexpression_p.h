@@ -176,8 +176,11 @@ private:
                           QDeclarativeJavaScriptExpression *, const CapturedProperties &properties);
 
     private:
+        bool isUnchanged(const CapturedProperties &properties) const;
+
         QDeclarativeNotifierEndpoint *endpoints;
         int length;
+        int capacity;
     };
     GuardList guardList;
 };
@@ -297,7 +300,7 @@ QString QDeclarativeJavaScriptExpression::expressionIdentifier()
 }
 
 QDeclarativeJavaScriptExpression::GuardList::GuardList() 
-: endpoints(0), length(0) 
+: endpoints(0), length(0), capacity(0)
 {
 }
 
@@ -308,9 +311,10 @@ QDeclarativeJavaScriptExpression::GuardList::~GuardList()
 
 void QDeclarativeJavaScriptExpression::GuardList::clear() 
 { 
-    delete [] endpoints; 
+    QDeclarativeNotifierEndpoint::release(endpoints, capacity);
     endpoints = 0; 
     length = 0; 
+    capacity = 0;
 }
 
 QDeclarativeExpressionPrivate *QDeclarativeExpressionPrivate::get(QDeclarativeExpression *expr) 
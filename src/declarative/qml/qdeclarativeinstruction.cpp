@@ -222,6 +222,15 @@ void QDeclarativeCompiledData::dump(QDeclarativeInstruction *instr, int idx)
     case QDeclarativeInstruction::Defer:
         qWarning().nospace() << idx << "\t\t" << "DEFER" << "\t\t\t" << instr->defer.deferCount;
         break;
+    case QDeclarativeInstruction::CreateSimpleObjectBegin:
+        qWarning().nospace() << idx << "\t\t" << "CREATE_SIMPLE_BEGIN\t" << instr->createSimpleBegin.typeSize << "\t" << instr->createSimpleBegin.id << "\t" << instr->createSimpleBegin.castValue;
+        break;
+    case QDeclarativeInstruction::StoreDoublePair:
+        qWarning().nospace() << idx << "\t\t" << "STORE_DOUBLE_PAIR\t" << instr->storeDoublePair.propertyIndex << "\t" << instr->storeDoublePair.value << "\t" << instr->storeDoublePair.propertyIndex2 << "\t" << instr->storeDoublePair.value2;
+        break;
+    case QDeclarativeInstruction::StoreIntegerPair:
+        qWarning().nospace() << idx << "\t\t" << "STORE_INTEGER_PAIR\t" << instr->storeIntegerPair.propertyIndex << "\t" << instr->storeIntegerPair.value << "\t" << instr->storeIntegerPair.propertyIndex2 << "\t" << instr->storeIntegerPair.value2;
+        break;
     default:
         qWarning().nospace() << idx << "\t\t" << "XXX UNKNOWN INSTRUCTION" << "\t" << instr->type();
         break;
@@ -113,7 +113,17 @@ QT_BEGIN_NAMESPACE
     F(Defer, defer) \
     F(PopFetchedObject, common) \
     F(FetchValueType, fetchValue) \
-    F(PopValueType, fetchValue) 
+    F(PopValueType, fetchValue) \
+    /* Super instructions */ \
+    F(CreateSimpleObjectBegin, createSimpleBegin) \
+    F(StoreDoublePair, storeDoublePair) \
+    F(StoreIntegerPair, storeIntegerPair)
+
+// The threaded VME dispatches through computed gotos, which are a GNU extension
+#if defined(Q_CC_GNU) && (!defined(Q_CC_INTEL) || __INTEL_COMPILER >= 1200) && \
+    !defined(QML_NO_THREADED_VME_INTERPRETER)
+#  define QML_THREADED_VME_INTERPRETER
+#endif
 
 #ifdef Q_ALIGNOF
 #  define QML_INSTR_ALIGN_MASK (Q_ALIGNOF(QDeclarativeInstruction) - 1)
@@ -161,6 +171,16 @@ union QDeclarativeInstruction
         ushort column;
         ushort line; 
     };
+    struct instr_createSimpleBegin {
+        QML_INSTR_HEADER
+        void (*create)(void *);
+        int typeSize;
+        int type;
+        int id;
+        int castValue;
+        ushort column;
+        ushort line;
+    };
     struct instr_storeMeta {
         QML_INSTR_HEADER
         int data;
@@ -233,6 +253,20 @@ union QDeclarativeInstruction
         int propertyIndex;
         int value;
     };
+    struct instr_storeDoublePair {
+        QML_INSTR_HEADER
+        int propertyIndex;
+        int propertyIndex2;
+        double value;
+        double value2;
+    };
+    struct instr_storeIntegerPair {
+        QML_INSTR_HEADER
+        int propertyIndex;
+        int propertyIndex2;
+        int value;
+        int value2;
+    };
     struct instr_storeBool {
         QML_INSTR_HEADER
         int propertyIndex;
@@ -410,6 +444,7 @@ union QDeclarativeInstruction
     instr_init init;
     instr_create create;
     instr_createSimple createSimple;
+    instr_createSimpleBegin createSimpleBegin;
     instr_storeMeta storeMeta;
     instr_setId setId;
     instr_assignValueSource assignValueSource;
@@ -423,6 +458,8 @@ union QDeclarativeInstruction
     instr_storeFloat storeFloat;
     instr_storeDouble storeDouble;
     instr_storeInteger storeInteger;
+    instr_storeDoublePair storeDoublePair;
+    instr_storeIntegerPair storeIntegerPair;
     instr_storeBool storeBool;
     instr_storeString storeString;
     instr_storeByteArray storeByteArray;
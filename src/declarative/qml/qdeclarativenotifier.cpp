@@ -42,8 +42,111 @@
 #include "private/qdeclarativenotifier_p.h"
 #include "private/qdeclarativeproperty_p.h"
 
+#include <QtCore/qthreadstorage.h>
+
 QT_BEGIN_NAMESPACE
 
+namespace {
+// Endpoint arrays are pooled per thread in power of two size classes, from
+// MinimumArraySize to MinimumArraySize << (ArraySizeClasses - 1) endpoints.
+enum { MinimumArraySize = 4, ArraySizeClasses = 5, MaximumFreeArrays = 64 };
+
+struct FreeArray {
+    FreeArray *next;
+};
+
+struct EndpointPool {
+    EndpointPool() {
+        for (int ii = 0; ii < ArraySizeClasses; ++ii) {
+            freeArrays[ii] = 0;
+            freeCount[ii] = 0;
+        }
+    }
+
+    ~EndpointPool() {
+        for (int ii = 0; ii < ArraySizeClasses; ++ii) {
+            while (FreeArray *array = freeArrays[ii]) {
+                freeArrays[ii] = array->next;
+                ::operator delete(array);
+            }
+        }
+    }
+
+    FreeArray *freeArrays[ArraySizeClasses];
+    int freeCount[ArraySizeClasses];
+};
+}
+
+static QThreadStorage<EndpointPool *> endpointPools;
+
+static int endpointSizeClass(int capacity)
+{
+    int sizeClass = 0;
+    while (sizeClass < ArraySizeClasses && (MinimumArraySize << sizeClass) != capacity)
+        ++sizeClass;
+    return sizeClass;
+}
+
+/*!
+Returns an array of at least \a count unconnected endpoints, and stores its size in
+\a capacity.  The array must be returned with release().
+*/
+QDeclarativeNotifierEndpoint *QDeclarativeNotifierEndpoint::allocate(int count, int *capacity)
+{
+    int sizeClass = 0;
+    while (sizeClass < ArraySizeClasses && (MinimumArraySize << sizeClass) < count)
+        ++sizeClass;
+    int size = sizeClass < ArraySizeClasses ? (MinimumArraySize << sizeClass) : count;
+
+    void *memory = 0;
+    if (sizeClass < ArraySizeClasses && endpointPools.hasLocalData()) {
+        EndpointPool *pool = endpointPools.localData();
+        if (FreeArray *array = pool->freeArrays[sizeClass]) {
+            pool->freeArrays[sizeClass] = array->next;
+            --pool->freeCount[sizeClass];
+            memory = array;
+        }
+    }
+    if (!memory)
+        memory = ::operator new(size * sizeof(QDeclarativeNotifierEndpoint));
+
+    QDeclarativeNotifierEndpoint *endpoints = static_cast<QDeclarativeNotifierEndpoint *>(memory);
+    for (int ii = 0; ii < size; ++ii)
+        new (endpoints + ii) QDeclarativeNotifierEndpoint;
+
+    *capacity = size;
+    return endpoints;
+}
+
+/*!
+Disconnects the \a capacity endpoints of an array returned by allocate() and returns it to
+the pool.
+*/
+void QDeclarativeNotifierEndpoint::release(QDeclarativeNotifierEndpoint *endpoints, int capacity)
+{
+    if (!endpoints)
+        return;
+
+    for (int ii = 0; ii < capacity; ++ii)
+        endpoints[ii].~QDeclarativeNotifierEndpoint();
+
+    int sizeClass = endpointSizeClass(capacity);
+    if (sizeClass < ArraySizeClasses) {
+        if (!endpointPools.hasLocalData())
+            endpointPools.setLocalData(new EndpointPool);
+        EndpointPool *pool = endpointPools.localData();
+        if (pool->freeCount[sizeClass] < MaximumFreeArrays) {
+            FreeArray *array = reinterpret_cast<FreeArray *>(endpoints);
+            array->next = pool->freeArrays[sizeClass];
+            pool->freeArrays[sizeClass] = array;
+            ++pool->freeCount[sizeClass];
+            return;
+        }
+    }
+
+    ::operator delete(endpoints);
+}
+
 void QDeclarativeNotifier::emitNotify(QDeclarativeNotifierEndpoint *endpoint)
 {
     QDeclarativeNotifierEndpoint::Notifier *n = endpoint->asNotifier();
@@ -81,6 +81,9 @@ public:
 
     void copyAndClear(QDeclarativeNotifierEndpoint &other);
 
+    static QDeclarativeNotifierEndpoint *allocate(int count, int *capacity);
+    static void release(QDeclarativeNotifierEndpoint *, int capacity);
+
 private:
     friend class QDeclarativeNotifier;
 
@@ -573,4 +573,69 @@ bool QDeclarativePropertyCache::isDynamicMetaObject(const QMetaObject *mo)
     return priv(mo->d.data)->revision >= 3 && priv(mo->d.data)->flags & DynamicMetaObject;
 }
 
+static int EnumType(const QMetaObject *meta, const QByteArray &str)
+{
+    QByteArray scope;
+    QByteArray name;
+    int scopeIdx = str.lastIndexOf("::");
+    if (scopeIdx != -1) {
+        scope = str.left(scopeIdx);
+        name = str.mid(scopeIdx + 2);
+    } else {
+        name = str;
+    }
+    for (int i = meta->enumeratorCount() - 1; i >= 0; --i) {
+        QMetaEnum m = meta->enumerator(i);
+        if ((m.name() == name) && (scope.isEmpty() || (m.scope() == scope)))
+            return QVariant::Int;
+    }
+    return QVariant::Invalid;
+}
+
+/*!
+Resolves the parameter types of method \a index on \a object into \a types.  Returns false,
+and sets \a unknownTypeName, if one of the parameter types is not known to the meta type
+system.
+
+The resolved types are stored in the object's property cache, so repeated calls to the same
+method do not need to parse its signature again.
+*/
+bool QDeclarativePropertyCache::methodParameterTypes(QObject *object, int index, QVector<int> *types,
+                                                     QByteArray *unknownTypeName)
+{
+    Q_ASSERT(object && index >= 0 && types);
+
+    QDeclarativeData *ddata = QDeclarativeData::get(object, false);
+    QDeclarativePropertyCache *cache = ddata ? ddata->propertyCache : 0;
+
+    if (cache) {
+        ArgumentTypesCache::ConstIterator iter = cache->argumentTypesCache.find(index);
+        if (iter != cache->argumentTypesCache.constEnd()) {
+            *types = *iter;
+            return true;
+        }
+    }
+
+    const QMetaObject *metaObject = object->metaObject();
+    QList<QByteArray> argTypeNames = metaObject->method(index).parameterTypes();
+
+    QVector<int> rv(argTypeNames.count());
+    for (int ii = 0; ii < argTypeNames.count(); ++ii) {
+        int type = QMetaType::type(argTypeNames.at(ii));
+        if (type == QVariant::Invalid)
+            type = EnumType(metaObject, argTypeNames.at(ii));
+        if (type == QVariant::Invalid) {
+            if (unknownTypeName) *unknownTypeName = argTypeNames.at(ii);
+            return false;
+        }
+        rv[ii] = type;
+    }
+
+    if (cache)
+        cache->argumentTypesCache.insert(index, rv);
+
+    *types = rv;
+    return true;
+}
+
 QT_END_NAMESPACE
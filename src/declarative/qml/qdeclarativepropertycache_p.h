@@ -59,6 +59,7 @@
 
 #include "private/qhashedstring_p.h"
 #include <QtCore/qvector.h>
+#include <QtCore/qhash.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -194,6 +195,11 @@ public:
     static Data *property(QDeclarativeEngine *, QObject *, const QHashedV8String &, Data &);
 
     static bool isDynamicMetaObject(const QMetaObject *);
+
+    static bool methodParameterTypes(QObject *, int index, QVector<int> *types,
+                                     QByteArray *unknownTypeName = 0);
+    inline int cachedOverload(int index, quint32 signature) const;
+    inline void cacheOverload(int index, quint32 signature, int overloadIndex);
 protected:
     virtual void clear();
 
@@ -207,6 +213,8 @@ private:
     typedef QVector<Data> IndexCache;
     typedef QStringHash<Data *> StringCache;
     typedef QVector<int> AllowedRevisionCache;
+    typedef QHash<int, QVector<int> > ArgumentTypesCache;
+    typedef QHash<quint64, int> OverloadCache;
 
     void resolve(Data *) const;
     void updateRecur(QDeclarativeEngine *, const QMetaObject *);
@@ -221,6 +229,8 @@ private:
     IndexCache methodIndexCache;
     StringCache stringCache;
     AllowedRevisionCache allowedRevisionCache;
+    ArgumentTypesCache argumentTypesCache;
+    OverloadCache overloadCache;
     v8::Persistent<v8::Function> constructor;
 };
 Q_DECLARE_OPERATORS_FOR_FLAGS(QDeclarativePropertyCache::Data::Flags);
@@ -275,6 +285,20 @@ QDeclarativeEngine *QDeclarativePropertyCache::qmlEngine() const
     return engine;
 }
 
+/*
+Returns the method index previously chosen for a call to the overloaded method \a index
+with arguments matching \a signature, or -1 if no choice has been recorded.
+*/
+int QDeclarativePropertyCache::cachedOverload(int index, quint32 signature) const
+{
+    return overloadCache.value((quint64(quint32(index)) << 32) | signature, -1);
+}
+
+void QDeclarativePropertyCache::cacheOverload(int index, quint32 signature, int overloadIndex)
+{
+    overloadCache.insert((quint64(quint32(index)) << 32) | signature, overloadIndex);
+}
+
 QDeclarativePropertyCache::Data *QDeclarativePropertyCache::property(const QHashedV8String &str) const
 {
     QDeclarativePropertyCache::Data **rv = stringCache.value(str);
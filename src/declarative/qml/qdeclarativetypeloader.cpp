@@ -46,14 +46,22 @@
 #include <private/qdeclarativecomponent_p.h>
 #include <private/qdeclarativeglobal_p.h>
 #include <private/qdeclarativedebugtrace_p.h>
+#include <private/qdeclarativecompileddatacache_p.h>
 
 #include <QtDeclarative/qdeclarativecomponent.h>
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qcryptographichash.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qwaitcondition.h>
 
 QT_BEGIN_NAMESPACE
 
+DEFINE_BOOL_CONFIG_OPTION(qmlDiskCache, QML_DISK_CACHE)
+
 /*!
 \class QDeclarativeDataBlob
 \brief The QDeclarativeDataBlob encapsulates a data request that can be issued to a QDeclarativeDataLoader.
@@ -98,7 +106,7 @@ Create a new QDeclarativeDataBlob for \a url and of the provided \a type.
 */
 QDeclarativeDataBlob::QDeclarativeDataBlob(const QUrl &url, Type type)
 : m_type(type), m_status(Null), m_progress(0), m_url(url), m_finalUrl(url), m_manager(0),
-  m_redirectCount(0), m_inCallback(false), m_isDone(false)
+  m_redirectCount(0), m_inCallback(false), m_isDone(false), m_isAsync(false)
 {
 }
 
@@ -211,6 +219,16 @@ QList<QDeclarativeError> QDeclarativeDataBlob::errors() const
     return m_errors;
 }
 
+/*!
+Returns true if the blob is being loaded asynchronously.
+
+\sa QDeclarativeDataLoader::load()
+*/
+bool QDeclarativeDataBlob::isAsynchronous() const
+{
+    return m_isAsync;
+}
+
 /*!
 Mark this blob as having \a errors.
 
@@ -259,6 +277,21 @@ void QDeclarativeDataBlob::addDependency(QDeclarativeDataBlob *blob)
     blob->m_waitingOnMe.append(this);
 }
 
+/*!
+Invoked on a loader thread with the blob's \a data when the blob is loaded
+asynchronously.  Implementors should use this callback to do any expensive
+processing, such as parsing, that does not depend on the engine.  The callback
+must not access the engine, other blobs or the type loader's caches, and may not
+call setError() or addDependency(); dataReceived() is invoked on the engine's
+thread once preparse() has returned.
+
+The default implementation does nothing.
+*/
+void QDeclarativeDataBlob::preparse(const QByteArray &data)
+{
+    Q_UNUSED(data);
+}
+
 /*!
 \fn void QDeclarativeDataBlob::dataReceived(const QByteArray &data)
 
@@ -464,11 +497,113 @@ one of these three preconditions are met.
 Thus QDeclarativeDataBlob::done() will always eventually be called, even if the blob has an error set.
 */
 
+class QDeclarativeDataLoaderEvent : public QEvent
+{
+public:
+    QDeclarativeDataLoaderEvent(QDeclarativeDataBlob *blob, const QByteArray &data,
+                                QNetworkReply::NetworkError error)
+    : QEvent(QEvent::User), blob(blob), data(data), error(error) {}
+
+    QDeclarativeDataBlob *blob;
+    QByteArray data;
+    QNetworkReply::NetworkError error;
+};
+
+/*
+Reads local files and calls QDeclarativeDataBlob::preparse() for blobs that are
+loaded asynchronously.  The blobs are referenced by the QDeclarativeDataLoader, and
+are only ever passed back to it through a QDeclarativeDataLoaderEvent, so the thread
+never adds or releases references itself.
+*/
+class QDeclarativeDataLoaderThread : public QThread
+{
+public:
+    QDeclarativeDataLoaderThread(QDeclarativeDataLoader *);
+    ~QDeclarativeDataLoaderThread();
+
+    void load(QDeclarativeDataBlob *, const QString &, const QByteArray &);
+
+protected:
+    virtual void run();
+
+private:
+    struct Job {
+        QDeclarativeDataBlob *blob;
+        QString fileName;
+        QByteArray data;
+    };
+
+    QDeclarativeDataLoader *m_loader;
+    QMutex m_mutex;
+    QWaitCondition m_condition;
+    QList<Job> m_jobs;
+    bool m_quit;
+};
+
+QDeclarativeDataLoaderThread::QDeclarativeDataLoaderThread(QDeclarativeDataLoader *loader)
+: m_loader(loader), m_quit(false)
+{
+    start(QThread::LowPriority);
+}
+
+QDeclarativeDataLoaderThread::~QDeclarativeDataLoaderThread()
+{
+    m_mutex.lock();
+    m_quit = true;
+    m_jobs.clear();
+    m_condition.wakeOne();
+    m_mutex.unlock();
+
+    wait();
+}
+
+void QDeclarativeDataLoaderThread::load(QDeclarativeDataBlob *blob, const QString &fileName,
+                                        const QByteArray &data)
+{
+    Job job;
+    job.blob = blob;
+    job.fileName = fileName;
+    job.data = data;
+
+    QMutexLocker locker(&m_mutex);
+    m_jobs.append(job);
+    m_condition.wakeOne();
+}
+
+void QDeclarativeDataLoaderThread::run()
+{
+    forever {
+        m_mutex.lock();
+        while (m_jobs.isEmpty() && !m_quit)
+            m_condition.wait(&m_mutex);
+        if (m_quit) {
+            m_mutex.unlock();
+            return;
+        }
+        Job job = m_jobs.takeFirst();
+        m_mutex.unlock();
+
+        QNetworkReply::NetworkError error = QNetworkReply::NoError;
+        if (!job.fileName.isEmpty()) {
+            QFile file(job.fileName);
+            if (file.open(QFile::ReadOnly))
+                job.data = file.readAll();
+            else
+                error = QNetworkReply::ContentNotFoundError;
+        }
+
+        if (error == QNetworkReply::NoError)
+            job.blob->preparse(job.data);
+
+        QCoreApplication::postEvent(m_loader, new QDeclarativeDataLoaderEvent(job.blob, job.data, error));
+    }
+}
+
 /*!
 Create a new QDeclarativeDataLoader for \a engine.
 */
 QDeclarativeDataLoader::QDeclarativeDataLoader(QDeclarativeEngine *engine)
-: m_engine(engine)
+: m_engine(engine), m_nextThread(0)
 {
 }
 
@@ -477,17 +612,49 @@ QDeclarativeDataLoader::~QDeclarativeDataLoader()
 {
     for (NetworkReplies::Iterator iter = m_networkReplies.begin(); iter != m_networkReplies.end(); ++iter) 
         (*iter)->release();
+
+    stopThreads();
 }
 
 /*!
-Load the provided \a blob from the network or filesystem.
+\internal
+
+Stops and joins the loader threads, discarding any loads that are still
+pending.  Subclasses whose state is read from the loader threads must call
+this before that state is destroyed.
+*/
+void QDeclarativeDataLoader::stopThreads()
+{
+    qDeleteAll(m_threads);
+    m_threads.clear();
+    m_nextThread = 0;
+    QCoreApplication::removePostedEvents(this, QEvent::User);
+    for (int ii = 0; ii < m_threadedBlobs.count(); ++ii)
+        m_threadedBlobs.at(ii)->release();
+    m_threadedBlobs.clear();
+}
+
+/*!
+\enum QDeclarativeDataLoader::Mode
+
+This enum describes how a blob is loaded.
+
+\value PreferSynchronous  Local files are read and processed before load() returns.
+                          Network data is always processed asynchronously.
+\value Asynchronous       Files are read and preparsed on a loader thread, and the
+                          blob is completed from the event loop.
+*/
+
+/*!
+Load the provided \a blob from the network or filesystem, according to \a mode.
 */
-void QDeclarativeDataLoader::load(QDeclarativeDataBlob *blob)
+void QDeclarativeDataLoader::load(QDeclarativeDataBlob *blob, Mode mode)
 {
     Q_ASSERT(blob->status() == QDeclarativeDataBlob::Null);
     Q_ASSERT(blob->m_manager == 0);
 
     blob->m_status = QDeclarativeDataBlob::Loading;
+    blob->m_isAsync = (mode == Asynchronous);
 
     if (blob->m_url.isEmpty()) {
         QDeclarativeError error;
@@ -506,6 +673,12 @@ void QDeclarativeDataLoader::load(QDeclarativeDataBlob *blob)
             blob->setError(error);
             return;
         }
+
+        if (blob->m_isAsync) {
+            loadThread(blob, lf, QByteArray());
+            return;
+        }
+
         QFile file(lf);
         if (file.open(QFile::ReadOnly)) {
             QByteArray data = file.readAll();
@@ -560,6 +733,8 @@ void QDeclarativeDataLoader::networkReplyFinished()
 
     if (reply->error()) {
         blob->networkError(reply->error());
+    } else if (blob->m_isAsync) {
+        loadThread(blob, QString(), reply->readAll());
     } else {
         QByteArray data = reply->readAll();
         setData(blob, data);
@@ -602,6 +777,49 @@ QDeclarativeEngine *QDeclarativeDataLoader::engine() const
     return m_engine;
 }
 
+/*! \internal */
+bool QDeclarativeDataLoader::event(QEvent *e)
+{
+    if (e->type() != QEvent::User)
+        return QObject::event(e);
+
+    QDeclarativeDataLoaderEvent *event = static_cast<QDeclarativeDataLoaderEvent *>(e);
+    QDeclarativeDataBlob *blob = event->blob;
+    m_threadedBlobs.removeOne(blob);
+
+    if (event->error != QNetworkReply::NoError) {
+        blob->networkError(event->error);
+    } else {
+        blob->m_progress = 1.;
+        blob->downloadProgressChanged(1.);
+
+        setData(blob, event->data);
+    }
+
+    blob->release();
+    return true;
+}
+
+/*
+Queue \a blob on one of the loader threads.  If \a fileName is not empty, the
+thread reads the blob's data from that file, otherwise \a data is used.
+*/
+void QDeclarativeDataLoader::loadThread(QDeclarativeDataBlob *blob, const QString &fileName,
+                                        const QByteArray &data)
+{
+    // Threads are started on demand, up to one per core
+    if (m_threads.count() < qMax(1, QThread::idealThreadCount())) {
+        m_nextThread = m_threads.count();
+        m_threads.append(new QDeclarativeDataLoaderThread(this));
+    }
+
+    blob->addref();
+    m_threadedBlobs.append(blob);
+
+    m_threads.at(m_nextThread)->load(blob, fileName, data);
+    m_nextThread = (m_nextThread + 1) % m_threads.count();
+}
+
 void QDeclarativeDataLoader::setData(QDeclarativeDataBlob *blob, const QByteArray &data)
 {
     blob->m_inCallback = true;
@@ -623,16 +841,20 @@ void QDeclarativeDataLoader::setData(QDeclarativeDataBlob *blob, const QByteArra
 Constructs a new type loader that uses the given \a engine.
 */
 QDeclarativeTypeLoader::QDeclarativeTypeLoader(QDeclarativeEngine *engine)
-: QDeclarativeDataLoader(engine)
+: QDeclarativeDataLoader(engine), m_diskCacheEnabled(qmlDiskCache()),
+  m_diskCachePath(QString::fromLocal8Bit(qgetenv("QML_DISK_CACHE_PATH")))
 {
 }
 
 /*!
-Destroys the type loader, first clearing the cache of any information about
-loaded files.
+Destroys the type loader, first stopping the loader threads and clearing the
+cache of any information about loaded files.
 */
 QDeclarativeTypeLoader::~QDeclarativeTypeLoader()
 {
+    // The loader threads use the type data we own, so they must be joined before
+    // any of our members are destroyed.
+    stopThreads();
     clearCache();
 }
 
@@ -645,12 +867,18 @@ This enum defines the options that control the way type data is handled.
                         are enabled.
 \value PreserveParser   The parser used to handle the type data is preserved
                         after the data has been parsed.
+\value UseDiskCache     The compiled type data may be restored from, and saved
+                        to, the disk cache.  This has no effect unless the disk
+                        cache is enabled.
 */
 
 /*!
 Returns a QDeclarativeTypeData for the specified \a url.  The QDeclarativeTypeData may be cached.
+
+If the type data is not cached it is loaded according to \a mode.  Types and scripts
+referenced by asynchronously loaded type data are loaded asynchronously too.
 */
-QDeclarativeTypeData *QDeclarativeTypeLoader::get(const QUrl &url)
+QDeclarativeTypeData *QDeclarativeTypeLoader::get(const QUrl &url, Mode mode)
 {
     Q_ASSERT(!url.isRelative() && 
             (QDeclarativeEnginePrivate::urlToLocalFileOrQrc(url).isEmpty() || 
@@ -659,9 +887,9 @@ QDeclarativeTypeData *QDeclarativeTypeLoader::get(const QUrl &url)
     QDeclarativeTypeData *typeData = m_typeCache.value(url);
 
     if (!typeData) {
-        typeData = new QDeclarativeTypeData(url, None, this);
+        typeData = new QDeclarativeTypeData(url, UseDiskCache, this);
         m_typeCache.insert(url, typeData);
-        QDeclarativeDataLoader::load(typeData);
+        QDeclarativeDataLoader::load(typeData, mode);
     }
 
     typeData->addref();
@@ -683,8 +911,10 @@ QDeclarativeTypeData *QDeclarativeTypeLoader::get(const QByteArray &data, const
 
 /*!
 Return a QDeclarativeScriptBlob for \a url.  The QDeclarativeScriptData may be cached.
+
+If the script is not cached it is loaded according to \a mode.
 */
-QDeclarativeScriptBlob *QDeclarativeTypeLoader::getScript(const QUrl &url)
+QDeclarativeScriptBlob *QDeclarativeTypeLoader::getScript(const QUrl &url, Mode mode)
 {
     Q_ASSERT(!url.isRelative() && 
             (QDeclarativeEnginePrivate::urlToLocalFileOrQrc(url).isEmpty() || 
@@ -695,7 +925,7 @@ QDeclarativeScriptBlob *QDeclarativeTypeLoader::getScript(const QUrl &url)
     if (!scriptBlob) {
         scriptBlob = new QDeclarativeScriptBlob(url, this);
         m_scriptCache.insert(url, scriptBlob);
-        QDeclarativeDataLoader::load(scriptBlob);
+        QDeclarativeDataLoader::load(scriptBlob, mode);
     }
 
     return scriptBlob;
@@ -703,8 +933,10 @@ QDeclarativeScriptBlob *QDeclarativeTypeLoader::getScript(const QUrl &url)
 
 /*!
 Returns a QDeclarativeQmldirData for \a url.  The QDeclarativeQmldirData may be cached.
+
+If the qmldir data is not cached it is loaded according to \a mode.
 */
-QDeclarativeQmldirData *QDeclarativeTypeLoader::getQmldir(const QUrl &url)
+QDeclarativeQmldirData *QDeclarativeTypeLoader::getQmldir(const QUrl &url, Mode mode)
 {
     Q_ASSERT(!url.isRelative() && 
             (QDeclarativeEnginePrivate::urlToLocalFileOrQrc(url).isEmpty() || 
@@ -715,13 +947,79 @@ QDeclarativeQmldirData *QDeclarativeTypeLoader::getQmldir(const QUrl &url)
     if (!qmldirData) {
         qmldirData = new QDeclarativeQmldirData(url);
         m_qmldirCache.insert(url, qmldirData);
-        QDeclarativeDataLoader::load(qmldirData);
+        QDeclarativeDataLoader::load(qmldirData, mode);
     }
 
     qmldirData->addref();
     return qmldirData;
 }
 
+/*!
+Returns true if compiled type data is persisted in the disk cache.
+
+The disk cache is disabled by default, and can be enabled by setting the
+QML_DISK_CACHE environment variable.
+
+\sa diskCachePath()
+*/
+bool QDeclarativeTypeLoader::isDiskCacheEnabled() const
+{
+    return m_diskCacheEnabled;
+}
+
+/*!
+Enables or disables the disk cache according to \a enabled.  This only affects
+files that have not yet been requested.
+*/
+void QDeclarativeTypeLoader::setDiskCacheEnabled(bool enabled)
+{
+    m_diskCacheEnabled = enabled;
+}
+
+/*!
+Returns the directory disk cache files are written to.  If the path is empty,
+which is the default, the cache file for a local file "Foo.qml" is written next to
+it as "Foo.qmlc".
+
+The initial value is taken from the QML_DISK_CACHE_PATH environment variable.
+*/
+QString QDeclarativeTypeLoader::diskCachePath() const
+{
+    return m_diskCachePath;
+}
+
+/*!
+Sets the directory disk cache files are written to to \a path.
+*/
+void QDeclarativeTypeLoader::setDiskCachePath(const QString &path)
+{
+    m_diskCachePath = path;
+}
+
+/*!
+Returns the disk cache file for the type data at \a url, or an empty string if
+the type data at \a url is not cached.  Only local files are cached, and
+resource files only if a diskCachePath() has been set.
+*/
+QString QDeclarativeTypeLoader::diskCacheFile(const QUrl &url) const
+{
+    if (!m_diskCacheEnabled)
+        return QString();
+
+    QString lf = QDeclarativeEnginePrivate::urlToLocalFileOrQrc(url);
+    if (lf.isEmpty())
+        return QString();
+
+    if (m_diskCachePath.isEmpty()) {
+        if (lf.startsWith(QLatin1Char(':')))
+            return QString();
+        return lf + QLatin1Char('c');
+    }
+
+    QByteArray name = QCryptographicHash::hash(url.toEncoded(), QCryptographicHash::Sha1).toHex();
+    return QDir(m_diskCachePath).filePath(QString::fromLatin1(name) + QLatin1String(".qmlc"));
+}
+
 /*!
 Clears cached information about loaded files, including any type data, scripts
 and qmldir information.
@@ -744,8 +1042,13 @@ void QDeclarativeTypeLoader::clearCache()
 QDeclarativeTypeData::QDeclarativeTypeData(const QUrl &url, QDeclarativeTypeLoader::Options options, 
                                            QDeclarativeTypeLoader *manager)
 : QDeclarativeDataBlob(url, QmlFile), m_options(options), m_typesResolved(false), 
-  m_compiledData(0), m_typeLoader(manager)
+  m_preparsed(false), m_parsed(false), m_compiledData(0), m_diskCache(0), m_typeLoader(manager)
 {
+    // The disk cache settings may change in the engine thread while the data is
+    // preparsed in a loader thread.  Only local files are cached, and their url is
+    // final, so the cache file can be resolved now.
+    if (options & QDeclarativeTypeLoader::UseDiskCache)
+        m_diskCacheFile = manager->diskCacheFile(url);
 }
 
 QDeclarativeTypeData::~QDeclarativeTypeData()
@@ -758,6 +1061,7 @@ QDeclarativeTypeData::~QDeclarativeTypeData()
         if (m_types.at(ii).typeData) m_types.at(ii).typeData->release();
     if (m_compiledData)
         m_compiledData->release();
+    delete m_diskCache;
 }
 
 QDeclarativeTypeLoader *QDeclarativeTypeData::typeLoader() const
@@ -793,6 +1097,16 @@ QDeclarativeCompiledData *QDeclarativeTypeData::compiledData() const
     return m_compiledData;
 }
 
+/*!
+Returns a hash identifying the source of this type and, transitively, of all the
+types it references.  The hash is only calculated when the disk cache is in use,
+and is empty otherwise.
+*/
+QByteArray QDeclarativeTypeData::typeHash() const
+{
+    return m_typeHash;
+}
+
 void QDeclarativeTypeData::registerCallback(TypeDataCallback *callback)
 {
     Q_ASSERT(!m_callbacks.contains(callback));
@@ -845,8 +1159,10 @@ void QDeclarativeTypeData::done()
     }
 
     // Compile component
-    if (!isError()) 
+    if (!isError()) {
+        m_typeHash = QDeclarativeCompiledDataCache::typeHash(m_sourceHash, m_types);
         compile();
+    }
 
     if (!(m_options & QDeclarativeTypeLoader::PreserveParser))
         scriptParser.clear();
@@ -860,26 +1176,53 @@ void QDeclarativeTypeData::done()
     release();
 }
 
+void QDeclarativeTypeData::preparse(const QByteArray &data)
+{
+    Q_ASSERT(!m_preparsed);
+    m_preparsed = true;
+
+    if (!m_diskCacheFile.isEmpty()) {
+        m_sourceHash = QDeclarativeCompiledDataCache::sourceHash(data);
+
+        QDeclarativeCompiledDataCache *cache = new QDeclarativeCompiledDataCache;
+        if (cache->load(m_diskCacheFile, m_sourceHash)) {
+            cache->populateParser(&scriptParser);
+            m_diskCache = cache;
+            m_source = data;
+        } else {
+            delete cache;
+        }
+    }
+
+    m_parsed = m_diskCache || scriptParser.parse(data, finalUrl());
+}
+
 void QDeclarativeTypeData::dataReceived(const QByteArray &data)
 {
-    if (!scriptParser.parse(data, finalUrl())) {
+    if (!m_preparsed)
+        preparse(data);
+
+    if (!m_parsed) {
         setError(scriptParser.errors());
         return;
     }
 
+    QDeclarativeTypeLoader::Mode mode = isAsynchronous() ? QDeclarativeTypeLoader::Asynchronous
+                                                         : QDeclarativeTypeLoader::PreferSynchronous;
+
     m_imports.setBaseUrl(finalUrl());
 
     foreach (const QDeclarativeScriptParser::Import &import, scriptParser.imports()) {
         if (import.type == QDeclarativeScriptParser::Import::File && import.qualifier.isEmpty()) {
             QUrl importUrl = finalUrl().resolved(QUrl(import.uri + QLatin1String("/qmldir")));
             if (QDeclarativeEnginePrivate::urlToLocalFileOrQrc(importUrl).isEmpty()) {
-                QDeclarativeQmldirData *data = typeLoader()->getQmldir(importUrl);
+                QDeclarativeQmldirData *data = typeLoader()->getQmldir(importUrl, mode);
                 addDependency(data);
                 m_qmldirs << data;
             }
         } else if (import.type == QDeclarativeScriptParser::Import::Script) {
             QUrl scriptUrl = finalUrl().resolved(QUrl(import.uri));
-            QDeclarativeScriptBlob *blob = typeLoader()->getScript(scriptUrl);
+            QDeclarativeScriptBlob *blob = typeLoader()->getScript(scriptUrl, mode);
             addDependency(blob);
 
             ScriptReference ref;
@@ -895,7 +1238,7 @@ void QDeclarativeTypeData::dataReceived(const QByteArray &data)
     if (!finalUrl().scheme().isEmpty()) {
         QUrl importUrl = finalUrl().resolved(QUrl(QLatin1String("qmldir")));
         if (QDeclarativeEnginePrivate::urlToLocalFileOrQrc(importUrl).isEmpty()) {
-            QDeclarativeQmldirData *data = typeLoader()->getQmldir(importUrl);
+            QDeclarativeQmldirData *data = typeLoader()->getQmldir(importUrl, mode);
             addDependency(data);
             m_qmldirs << data;
         }
@@ -928,11 +1271,43 @@ void QDeclarativeTypeData::compile()
     m_compiledData->name = m_compiledData->url.toString();
     QDeclarativeDebugTrace::rangeData(QDeclarativeDebugTrace::Compiling, m_compiledData->name);
 
+    if (m_diskCache) {
+        bool restored = m_diskCache->restore(typeLoader()->engine(), this, m_compiledData);
+        delete m_diskCache;
+        m_diskCache = 0;
+
+        if (restored) {
+            m_source.clear();
+            QDeclarativeDebugTrace::endRange(QDeclarativeDebugTrace::Compiling);
+            return;
+        }
+
+        // One of the referenced types has changed since the cache was written.  The
+        // source is unchanged, so parsing it yields the imports and types already resolved.
+        m_compiledData->release();
+        m_compiledData = new QDeclarativeCompiledData(typeLoader()->engine());
+        m_compiledData->url = m_imports.baseUrl();
+        m_compiledData->name = m_compiledData->url.toString();
+
+        bool parsed = scriptParser.parse(m_source, finalUrl());
+        m_source.clear();
+        if (!parsed) {
+            setError(scriptParser.errors());
+            m_compiledData->release();
+            m_compiledData = 0;
+            QDeclarativeDebugTrace::endRange(QDeclarativeDebugTrace::Compiling);
+            return;
+        }
+    }
+
     QDeclarativeCompiler compiler;
     if (!compiler.compile(typeLoader()->engine(), this, m_compiledData)) {
         setError(compiler.errors());
         m_compiledData->release();
         m_compiledData = 0;
+    } else if (!m_typeHash.isEmpty()) {
+        QDeclarativeCompiledDataCache::save(m_diskCacheFile, m_sourceHash,
+                                            this, m_compiledData);
     }
     QDeclarativeDebugTrace::endRange(QDeclarativeDebugTrace::Compiling);
 }
@@ -1056,7 +1431,8 @@ void QDeclarativeTypeData::resolveTypes()
             ref.majorVersion = majorVersion;
             ref.minorVersion = minorVersion;
         } else {
-            ref.typeData = typeLoader()->get(url);
+            ref.typeData = typeLoader()->get(url, isAsynchronous() ? QDeclarativeTypeLoader::Asynchronous
+                                                                   : QDeclarativeTypeLoader::PreferSynchronous);
             addDependency(ref.typeData);
         }
 
@@ -1104,7 +1480,7 @@ void QDeclarativeScriptData::clear()
 
 QDeclarativeScriptBlob::QDeclarativeScriptBlob(const QUrl &url, QDeclarativeTypeLoader *loader)
 : QDeclarativeDataBlob(url, JavaScriptFile), m_pragmas(QDeclarativeParser::Object::ScriptBlock::None),
-  m_scriptData(0), m_typeLoader(loader)
+  m_preparsed(false), m_scriptData(0), m_typeLoader(loader)
 {
 }
 
@@ -1141,15 +1517,23 @@ QDeclarativeScriptData *QDeclarativeScriptBlob::scriptData() const
     return m_scriptData;
 }
 
+void QDeclarativeScriptBlob::preparse(const QByteArray &data)
+{
+    m_source = QString::fromUtf8(data);
+    m_metadata = QDeclarativeScriptParser::extractMetaData(m_source);
+    m_preparsed = true;
+}
+
 void QDeclarativeScriptBlob::dataReceived(const QByteArray &data)
 {
     QDeclarativeEnginePrivate *ep = QDeclarativeEnginePrivate::get(m_typeLoader->engine());
     QDeclarativeImportDatabase *importDatabase = &ep->importDatabase;
 
-    m_source = QString::fromUtf8(data);
+    if (!m_preparsed)
+        preparse(data);
 
-    QDeclarativeScriptParser::JavaScriptMetaData metadata =
-        QDeclarativeScriptParser::extractMetaData(m_source);
+    QDeclarativeScriptParser::JavaScriptMetaData metadata = m_metadata;
+    m_metadata = QDeclarativeScriptParser::JavaScriptMetaData();
 
     m_imports.setBaseUrl(finalUrl());
 
@@ -1160,7 +1544,9 @@ void QDeclarativeScriptBlob::dataReceived(const QByteArray &data)
 
         if (import.type == QDeclarativeScriptParser::Import::Script) {
             QUrl scriptUrl = finalUrl().resolved(QUrl(import.uri));
-            QDeclarativeScriptBlob *blob = typeLoader()->getScript(scriptUrl);
+            QDeclarativeScriptBlob *blob = typeLoader()->getScript(scriptUrl,
+                    isAsynchronous() ? QDeclarativeTypeLoader::Asynchronous
+                                     : QDeclarativeTypeLoader::PreferSynchronous);
             addDependency(blob);
 
             ScriptReference ref;
@@ -1238,7 +1624,7 @@ void QDeclarativeScriptBlob::done()
 }
 
 QDeclarativeQmldirData::QDeclarativeQmldirData(const QUrl &url)
-: QDeclarativeDataBlob(url, QmldirFile)
+: QDeclarativeDataBlob(url, QmldirFile), m_preparsed(false)
 {
 }
 
@@ -1247,12 +1633,19 @@ const QDeclarativeDirComponents &QDeclarativeQmldirData::dirComponents() const
     return m_components;
 }
 
-void QDeclarativeQmldirData::dataReceived(const QByteArray &data)
+void QDeclarativeQmldirData::preparse(const QByteArray &data)
 {
     QDeclarativeDirParser parser;
     parser.setSource(QString::fromUtf8(data));
     parser.parse();
     m_components = parser.components();
+    m_preparsed = true;
+}
+
+void QDeclarativeQmldirData::dataReceived(const QByteArray &data)
+{
+    if (!m_preparsed)
+        preparse(data);
 }
 
 QT_END_NAMESPACE
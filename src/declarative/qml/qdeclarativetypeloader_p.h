@@ -75,6 +75,8 @@ class QDeclarativeCompiledData;
 class QDeclarativeComponentPrivate;
 class QDeclarativeTypeData;
 class QDeclarativeDataLoader;
+class QDeclarativeDataLoaderThread;
+class QDeclarativeCompiledDataCache;
 
 class Q_AUTOTEST_EXPORT QDeclarativeDataBlob : public QDeclarativeRefCount
 {
@@ -113,12 +115,15 @@ public:
 
     QList<QDeclarativeError> errors() const;
 
+    bool isAsynchronous() const;
+
     void setError(const QDeclarativeError &);
     void setError(const QList<QDeclarativeError> &errors);
 
     void addDependency(QDeclarativeDataBlob *);
 
 protected:
+    virtual void preparse(const QByteArray &);
     virtual void dataReceived(const QByteArray &) = 0;
 
     virtual void done();
@@ -132,6 +137,7 @@ protected:
 
 private:
     friend class QDeclarativeDataLoader;
+    friend class QDeclarativeDataLoaderThread;
     void tryDone();
     void cancelAllWaitingFor();
     void notifyAllWaitingOnMe();
@@ -152,9 +158,10 @@ private:
 
     // Manager that is currently fetching data for me
     QDeclarativeDataLoader *m_manager;
-    int m_redirectCount:30;
+    int m_redirectCount:29;
     bool m_inCallback:1;
     bool m_isDone:1;
+    bool m_isAsync:1;
 
     QList<QDeclarativeError> m_errors;
 };
@@ -166,21 +173,32 @@ public:
     QDeclarativeDataLoader(QDeclarativeEngine *);
     ~QDeclarativeDataLoader();
 
-    void load(QDeclarativeDataBlob *);
+    enum Mode { PreferSynchronous, Asynchronous };
+
+    void load(QDeclarativeDataBlob *, Mode = PreferSynchronous);
     void loadWithStaticData(QDeclarativeDataBlob *, const QByteArray &);
 
     QDeclarativeEngine *engine() const;
 
+protected:
+    bool event(QEvent *);
+    void stopThreads();
+
 private slots:
     void networkReplyFinished();
     void networkReplyProgress(qint64,qint64);
 
 private:
     void setData(QDeclarativeDataBlob *, const QByteArray &);
+    void loadThread(QDeclarativeDataBlob *, const QString &, const QByteArray &);
 
     QDeclarativeEngine *m_engine;
     typedef QHash<QNetworkReply *, QDeclarativeDataBlob *> NetworkReplies;
     NetworkReplies m_networkReplies;
+
+    QList<QDeclarativeDataLoaderThread *> m_threads;
+    int m_nextThread;
+    QList<QDeclarativeDataBlob *> m_threadedBlobs;
 };
 
 class Q_AUTOTEST_EXPORT QDeclarativeTypeLoader : public QDeclarativeDataLoader
@@ -192,16 +210,23 @@ public:
 
     enum Option {
         None,
-        PreserveParser
+        PreserveParser,
+        UseDiskCache
     };
     Q_DECLARE_FLAGS(Options, Option)
 
-    QDeclarativeTypeData *get(const QUrl &url);
+    QDeclarativeTypeData *get(const QUrl &url, Mode = PreferSynchronous);
     QDeclarativeTypeData *get(const QByteArray &, const QUrl &url, Options = None);
     void clearCache();
 
-    QDeclarativeScriptBlob *getScript(const QUrl &);
-    QDeclarativeQmldirData *getQmldir(const QUrl &);
+    QDeclarativeScriptBlob *getScript(const QUrl &, Mode = PreferSynchronous);
+    QDeclarativeQmldirData *getQmldir(const QUrl &, Mode = PreferSynchronous);
+
+    bool isDiskCacheEnabled() const;
+    void setDiskCacheEnabled(bool);
+    QString diskCachePath() const;
+    void setDiskCachePath(const QString &);
+    QString diskCacheFile(const QUrl &) const;
 private:
     typedef QHash<QUrl, QDeclarativeTypeData *> TypeCache;
     typedef QHash<QUrl, QDeclarativeScriptBlob *> ScriptCache;
@@ -210,6 +235,9 @@ private:
     TypeCache m_typeCache;
     ScriptCache m_scriptCache;
     QmldirCache m_qmldirCache;
+
+    bool m_diskCacheEnabled;
+    QString m_diskCachePath;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(QDeclarativeTypeLoader::Options)
@@ -250,6 +278,8 @@ public:
 
     QDeclarativeCompiledData *compiledData() const;
 
+    QByteArray typeHash() const;
+
     // Used by QDeclarativeComponent to get notifications
     struct TypeDataCallback {
         ~TypeDataCallback() {}
@@ -261,6 +291,7 @@ public:
 
 protected:
     virtual void done();
+    virtual void preparse(const QByteArray &);
     virtual void dataReceived(const QByteArray &);
     virtual void allDependenciesDone();
     virtual void downloadProgressChanged(qreal);
@@ -281,9 +312,17 @@ private:
 
     QList<TypeReference> m_types;
     bool m_typesResolved:1;
+    bool m_preparsed:1;
+    bool m_parsed:1;
 
     QDeclarativeCompiledData *m_compiledData;
 
+    QByteArray m_sourceHash;
+    QByteArray m_typeHash;
+    QByteArray m_source;
+    QString m_diskCacheFile;  // resolved in the engine thread, empty if not cached
+    QDeclarativeCompiledDataCache *m_diskCache;
+
     QList<TypeDataCallback *> m_callbacks;
    
     QDeclarativeTypeLoader *m_typeLoader;
@@ -338,12 +377,15 @@ public:
     QDeclarativeScriptData *scriptData() const;
 
 protected:
+    virtual void preparse(const QByteArray &);
     virtual void dataReceived(const QByteArray &);
     virtual void done();
 
 private:
     QDeclarativeParser::Object::ScriptBlock::Pragmas m_pragmas;
     QString m_source;
+    QDeclarativeScriptParser::JavaScriptMetaData m_metadata;
+    bool m_preparsed;
 
     QDeclarativeImports m_imports;
     QList<ScriptReference> m_scripts;
@@ -360,10 +402,12 @@ public:
     const QDeclarativeDirComponents &dirComponents() const;
 
 protected:
+    virtual void preparse(const QByteArray &);
     virtual void dataReceived(const QByteArray &);
 
 private:
     QDeclarativeDirComponents m_components;
+    bool m_preparsed;
 
 };
 
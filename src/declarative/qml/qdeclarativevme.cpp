@@ -166,13 +166,76 @@ static void removeBindingOnProperty(QObject *o, int index)
     if (binding) binding->destroy();
 }
 
-#define QML_BEGIN_INSTR(I) \
+// Creates the object of a CreateSimpleObject or CreateSimpleObjectBegin instruction, with its
+// declarative data allocated in the same block, and adds it to \a ctxt and \a parent.
+template<typename Instr>
+static inline QObject *createSimpleObject(const Instr &instr,
+                                          const QDeclarativeCompiledData::TypeReference &ref,
+                                          QDeclarativeContextData *ctxt, QObject *parent)
+{
+    QObject *o = (QObject *)operator new(instr.typeSize + sizeof(QDeclarativeData));
+    ::memset(o, 0, instr.typeSize + sizeof(QDeclarativeData));
+    instr.create(o);
+
+    QDeclarativeData *ddata = (QDeclarativeData *)(((const char *)o) + instr.typeSize);
+    if (!ddata->propertyCache && ref.typePropertyCache) {
+        ddata->propertyCache = ref.typePropertyCache;
+        ddata->propertyCache->addref();
+    }
+    ddata->lineNumber = instr.line;
+    ddata->columnNumber = instr.column;
+
+    QObjectPrivate::get(o)->declarativeData = ddata;
+    ddata->context = ddata->outerContext = ctxt;
+    ddata->nextContextObject = ctxt->contextObjects;
+    if (ddata->nextContextObject)
+        ddata->nextContextObject->prevContextObject = &ddata->nextContextObject;
+    ddata->prevContextObject = &ctxt->contextObjects;
+    ctxt->contextObjects = ddata;
+
+    QDeclarative_setParent_noEvent(o, parent);
+    return o;
+}
+
+// Calls classBegin() on the QDeclarativeParserStatus at \a castValue in \a o, and records it
+// so that componentComplete() is called once the objects are complete.
+static inline void beginObject(QObject *o, int castValue,
+                               QDeclarativeEnginePrivate::SimpleList<QDeclarativeParserStatus> &parserStatus)
+{
+    QDeclarativeParserStatus *status = reinterpret_cast<QDeclarativeParserStatus *>(reinterpret_cast<char *>(o) + castValue);
+    parserStatus.append(status);
+    status->d = &parserStatus.values[parserStatus.count - 1];
+
+    status->classBegin();
+}
+
+#ifdef QML_THREADED_VME_INTERPRETER
+// Each instruction jumps directly to the next one through the dispatch table, rather
+// than returning to a central switch.  The bytecode itself still stores the 
+// instruction type, so it remains independent of the process it was compiled in.
+// The body is wrapped in a do/while(0) so that "break" still ends the instruction.
+#  define QML_INSTR_ADDR(I, FMT) &&op_##I,
+#  define QML_NEXT_INSTR \
+    goto *dispatchTable[((const QDeclarativeInstruction *)instructionStream)->common.instructionType];
+
+#  define QML_BEGIN_INSTR(I) \
+    op_##I: do { \
+        const QDeclarativeInstructionMeta<(int)QDeclarativeInstruction::I>::DataType &instr = QDeclarativeInstructionMeta<(int)QDeclarativeInstruction::I>::data(*(const QDeclarativeInstruction *)instructionStream); \
+        instructionStream += QDeclarativeInstructionMeta<(int)QDeclarativeInstruction::I>::Size; \
+        Q_UNUSED(instr); 
+
+#  define QML_END_INSTR(I) } while (0); \
+    if (isError()) goto vmeExit; \
+    QML_NEXT_INSTR
+#else
+#  define QML_BEGIN_INSTR(I) \
     case QDeclarativeInstruction::I: { \
         const QDeclarativeInstructionMeta<(int)QDeclarativeInstruction::I>::DataType &instr = QDeclarativeInstructionMeta<(int)QDeclarativeInstruction::I>::data(genericInstr); \
         instructionStream += QDeclarativeInstructionMeta<(int)QDeclarativeInstruction::I>::Size; \
         Q_UNUSED(instr); 
 
-#define QML_END_INSTR(I) } break;
+#  define QML_END_INSTR(I) } break;
+#endif
 
 #define CLEAN_PROPERTY(o, index) if (fastHasBinding(o, index)) removeBindingOnProperty(o, index)
 
@@ -204,11 +267,18 @@ QObject *QDeclarativeVME::run(QDeclarativeVMEObjectStack &stack,
 
     const char *instructionStream = comp->bytecode.constData() + start;
 
-    bool done = false;
-    while (!isError() && !done) {
+#ifdef QML_THREADED_VME_INTERPRETER
+    static const void *const dispatchTable[] = {
+        FOR_EACH_QML_INSTR(QML_INSTR_ADDR)
+    };
+
+    QML_NEXT_INSTR
+#else
+    while (!isError()) {
         const QDeclarativeInstruction &genericInstr = *((QDeclarativeInstruction *)instructionStream);
 
         switch(genericInstr.type()) {
+#endif
         QML_BEGIN_INSTR(Init)
             if (instr.bindingsSize) 
                 bindValues = QDeclarativeEnginePrivate::SimpleList<QDeclarativeAbstractBinding>(instr.bindingsSize);
@@ -223,7 +293,7 @@ QObject *QDeclarativeVME::run(QDeclarativeVMEObjectStack &stack,
         QML_END_INSTR(Init)
 
         QML_BEGIN_INSTR(Done)
-            done = true;
+            goto vmeExit;
         QML_END_INSTR(Done)
 
         QML_BEGIN_INSTR(CreateObject)
@@ -291,32 +361,19 @@ QObject *QDeclarativeVME::run(QDeclarativeVMEObjectStack &stack,
         QML_END_INSTR(CreateObject)
 
         QML_BEGIN_INSTR(CreateSimpleObject)
-            QObject *o = (QObject *)operator new(instr.typeSize + sizeof(QDeclarativeData));   
-            ::memset(o, 0, instr.typeSize + sizeof(QDeclarativeData));
-            instr.create(o);
-
-            QDeclarativeData *ddata = (QDeclarativeData *)(((const char *)o) + instr.typeSize);
-            const QDeclarativeCompiledData::TypeReference &ref = types.at(instr.type);
-            if (!ddata->propertyCache && ref.typePropertyCache) {
-                ddata->propertyCache = ref.typePropertyCache;
-                ddata->propertyCache->addref();
-            }
-            ddata->lineNumber = instr.line;
-            ddata->columnNumber = instr.column;
+            QObject *o = createSimpleObject(instr, types.at(instr.type), ctxt, stack.top());
+            stack.push(o);
+        QML_END_INSTR(CreateSimpleObject)
 
-            QObjectPrivate::get(o)->declarativeData = ddata;                                                      
-            ddata->context = ddata->outerContext = ctxt;
-            ddata->nextContextObject = ctxt->contextObjects; 
-            if (ddata->nextContextObject) 
-                ddata->nextContextObject->prevContextObject = &ddata->nextContextObject; 
-            ddata->prevContextObject = &ctxt->contextObjects; 
-            ctxt->contextObjects = ddata; 
+        QML_BEGIN_INSTR(CreateSimpleObjectBegin)
+            QObject *o = createSimpleObject(instr, types.at(instr.type), ctxt, stack.top());
+            stack.push(o);
 
-            QObject *parent = stack.top();                                                                    
-            QDeclarative_setParent_noEvent(o, parent);                                                        
+            if (instr.id != -1)
+                ctxt->setIdProperty(instr.id, o);
 
-            stack.push(o);
-        QML_END_INSTR(CreateSimpleObject)
+            beginObject(o, instr.castValue, parserStatus);
+        QML_END_INSTR(CreateSimpleObjectBegin)
 
         QML_BEGIN_INSTR(SetId)
             QObject *target = stack.top();
@@ -475,6 +532,35 @@ QObject *QDeclarativeVME::run(QDeclarativeVMEObjectStack &stack,
                                   instr.propertyIndex, a);
         QML_END_INSTR(StoreInteger)
 
+        QML_BEGIN_INSTR(StoreDoublePair)
+            QObject *target = stack.top();
+            CLEAN_PROPERTY(target, instr.propertyIndex);
+            CLEAN_PROPERTY(target, instr.propertyIndex2);
+
+            double d = instr.value;
+            void *a[] = { &d, 0, &status, &flags };
+            QMetaObject::metacall(target, QMetaObject::WriteProperty,
+                                  instr.propertyIndex, a);
+
+            d = instr.value2;
+            QMetaObject::metacall(target, QMetaObject::WriteProperty,
+                                  instr.propertyIndex2, a);
+        QML_END_INSTR(StoreDoublePair)
+
+        QML_BEGIN_INSTR(StoreIntegerPair)
+            QObject *target = stack.top();
+            CLEAN_PROPERTY(target, instr.propertyIndex);
+            CLEAN_PROPERTY(target, instr.propertyIndex2);
+
+            void *a[] = { (void *)&instr.value, 0, &status, &flags };
+            QMetaObject::metacall(target, QMetaObject::WriteProperty, 
+                                  instr.propertyIndex, a);
+
+            a[0] = (void *)&instr.value2;
+            QMetaObject::metacall(target, QMetaObject::WriteProperty, 
+                                  instr.propertyIndex2, a);
+        QML_END_INSTR(StoreIntegerPair)
+
         QML_BEGIN_INSTR(StoreColor)
             QObject *target = stack.top();
             CLEAN_PROPERTY(target, instr.propertyIndex);
@@ -676,12 +762,7 @@ QObject *QDeclarativeVME::run(QDeclarativeVMEObjectStack &stack,
         QML_END_INSTR(StoreScriptString)
 
         QML_BEGIN_INSTR(BeginObject)
-            QObject *target = stack.top();
-            QDeclarativeParserStatus *status = reinterpret_cast<QDeclarativeParserStatus *>(reinterpret_cast<char *>(target) + instr.castValue);
-            parserStatus.append(status);
-            status->d = &parserStatus.values[parserStatus.count - 1];
-
-            status->classBegin();
+            beginObject(stack.top(), instr.castValue, parserStatus);
         QML_END_INSTR(BeginObject)
 
         QML_BEGIN_INSTR(InitV8Bindings)
@@ -951,12 +1032,15 @@ QObject *QDeclarativeVME::run(QDeclarativeVMEObjectStack &stack,
             valueHandler->write(target, instr.property, QDeclarativePropertyPrivate::BypassInterceptor);
         QML_END_INSTR(PopValueType)
 
+#ifndef QML_THREADED_VME_INTERPRETER
         default:
             qFatal("QDeclarativeCompiledData: Internal error - unknown instruction %d", genericInstr.type());
             break;
         }
     }
+#endif
 
+vmeExit:
     if (isError()) {
         if (!stack.isEmpty()) {
             delete stack.at(0); // ### What about failures in deferred creation?
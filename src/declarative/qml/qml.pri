@@ -16,6 +16,7 @@ SOURCES += \
     $$PWD/qdeclarativevme.cpp \
     $$PWD/qdeclarativecompiler.cpp \
     $$PWD/qdeclarativecompileddata.cpp \
+    $$PWD/qdeclarativecompileddatacache.cpp \
     $$PWD/qdeclarativeboundsignal.cpp \
     $$PWD/qdeclarativerefcount.cpp \
     $$PWD/qdeclarativemetatype.cpp \
@@ -69,6 +70,7 @@ HEADERS += \
     $$PWD/qdeclarativeproxymetaobject_p.h \
     $$PWD/qdeclarativevme_p.h \
     $$PWD/qdeclarativecompiler_p.h \
+    $$PWD/qdeclarativecompileddatacache_p.h \
     $$PWD/qdeclarativeengine_p.h \
     $$PWD/qdeclarativeexpression_p.h \
     $$PWD/qdeclarativeprivate.h \
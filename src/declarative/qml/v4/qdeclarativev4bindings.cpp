@@ -331,13 +331,16 @@ int QDeclarativeV4Bindings::qt_metacall(QMetaObject::Call c, int id, void **)
         id -= d->methodCount;
 
         QDeclarativeV4Program::BindingReferenceList *list = d->program->signalTable(id);
+        QDeclarativeEnginePrivate *ep = QDeclarativeEnginePrivate::get(QDeclarativeAbstractExpression::context());
 
         for (quint32 ii = 0; ii < list->count; ++ii) {
             QDeclarativeV4Program::BindingReference *bindingRef = list->bindings + ii;
 
             QDeclarativeV4BindingsPrivate::Binding *binding = d->bindings + bindingRef->binding;
-            if (binding->executedBlocks & bindingRef->blockMask)
-                d->run(binding, QDeclarativePropertyPrivate::DontRemoveBinding);
+            if (binding->executedBlocks & bindingRef->blockMask) {
+                if (!ep || !ep->scheduleBindingUpdate(binding))
+                    d->run(binding, QDeclarativePropertyPrivate::DontRemoveBinding);
+            }
         }
     }
     return -1;
@@ -713,6 +716,25 @@ inline quint32 QDeclarativeV4BindingsPrivate::toUint32(qreal n)
     return quint32 (n);
 }
 
+// Math.min() and Math.max() propagate NaN and order -0 before +0
+static inline qreal qmlMin(qreal l, qreal r)
+{
+    if (qIsNaN(l) || qIsNaN(r))
+        return qQNaN();
+    if (l == r && l == 0)
+        return (1 / l < 0) ? l : r;
+    return (l < r) ? l : r;
+}
+
+static inline qreal qmlMax(qreal l, qreal r)
+{
+    if (qIsNaN(l) || qIsNaN(r))
+        return qQNaN();
+    if (l == r && l == 0)
+        return (1 / l > 0) ? l : r;
+    return (l > r) ? l : r;
+}
+
 #define THROW_EXCEPTION_STR(id, str) { \
     if (testBinding) testBindingException(*testBindingSource, bindingLine, bindingColumn, context, scope); \
     throwException((id), error, program, context, (str)); \
@@ -1105,6 +1127,73 @@ void QDeclarativeV4BindingsPrivate::run(int instrIndex, quint32 &executedBlocks,
     }
     QML_V4_END_INSTR(MathPIReal, unaryop)
 
+    QML_V4_BEGIN_INSTR(MathCeilReal, unaryop)
+    {
+        const Register &src = registers[instr->unaryop.src];
+        Register &output = registers[instr->unaryop.output];
+        if (src.isUndefined()) output.setUndefined();
+        else output.setint(qCeil(src.getqreal()));
+    }
+    QML_V4_END_INSTR(MathCeilReal, unaryop)
+
+    QML_V4_BEGIN_INSTR(MathAbsReal, unaryop)
+    {
+        const Register &src = registers[instr->unaryop.src];
+        Register &output = registers[instr->unaryop.output];
+        if (src.isUndefined()) output.setUndefined();
+        else output.setqreal(qAbs(src.getqreal()));
+    }
+    QML_V4_END_INSTR(MathAbsReal, unaryop)
+
+    QML_V4_BEGIN_INSTR(MathSqrtReal, unaryop)
+    {
+        const Register &src = registers[instr->unaryop.src];
+        Register &output = registers[instr->unaryop.output];
+        if (src.isUndefined()) output.setUndefined();
+        else output.setqreal(qSqrt(src.getqreal()));
+    }
+    QML_V4_END_INSTR(MathSqrtReal, unaryop)
+
+    QML_V4_BEGIN_INSTR(MathMinReal, binaryop)
+    {
+        const Register &left = registers[instr->binaryop.left];
+        const Register &right = registers[instr->binaryop.right];
+        Register &output = registers[instr->binaryop.output];
+        if (left.isUndefined() || right.isUndefined()) output.setUndefined();
+        else output.setqreal(qmlMin(left.getqreal(), right.getqreal()));
+    }
+    QML_V4_END_INSTR(MathMinReal, binaryop)
+
+    QML_V4_BEGIN_INSTR(MathMaxReal, binaryop)
+    {
+        const Register &left = registers[instr->binaryop.left];
+        const Register &right = registers[instr->binaryop.right];
+        Register &output = registers[instr->binaryop.output];
+        if (left.isUndefined() || right.isUndefined()) output.setUndefined();
+        else output.setqreal(qmlMax(left.getqreal(), right.getqreal()));
+    }
+    QML_V4_END_INSTR(MathMaxReal, binaryop)
+
+    QML_V4_BEGIN_INSTR(MathMinInt, binaryop)
+    {
+        const Register &left = registers[instr->binaryop.left];
+        const Register &right = registers[instr->binaryop.right];
+        Register &output = registers[instr->binaryop.output];
+        if (left.isUndefined() || right.isUndefined()) output.setUndefined();
+        else output.setint(qMin(left.getint(), right.getint()));
+    }
+    QML_V4_END_INSTR(MathMinInt, binaryop)
+
+    QML_V4_BEGIN_INSTR(MathMaxInt, binaryop)
+    {
+        const Register &left = registers[instr->binaryop.left];
+        const Register &right = registers[instr->binaryop.right];
+        Register &output = registers[instr->binaryop.output];
+        if (left.isUndefined() || right.isUndefined()) output.setUndefined();
+        else output.setint(qMax(left.getint(), right.getint()));
+    }
+    QML_V4_END_INSTR(MathMaxInt, binaryop)
+
     QML_V4_BEGIN_INSTR(Real, real_value)
         registers[instr->real_value.reg].setqreal(instr->real_value.value);
     QML_V4_END_INSTR(Real, real_value)
@@ -1117,6 +1206,10 @@ void QDeclarativeV4BindingsPrivate::run(int instrIndex, quint32 &executedBlocks,
         registers[instr->bool_value.reg].setbool(instr->bool_value.value);
     QML_V4_END_INSTR(Bool, bool_value)
 
+    QML_V4_BEGIN_INSTR(Null, construct)
+        registers[instr->construct.reg].setQObject(0);
+    QML_V4_END_INSTR(Null, construct)
+
     QML_V4_BEGIN_INSTR(String, string_value)
     {
         Register &output = registers[instr->string_value.reg];
@@ -1206,6 +1299,38 @@ void QDeclarativeV4BindingsPrivate::run(int instrIndex, quint32 &executedBlocks,
     }
     QML_V4_END_INSTR(ModInt, binaryop)
 
+    // The int arithmetic instructions produce a real so that, as in JavaScript,
+    // the result cannot overflow.  An int * int product is exact in 64 bits
+    // and rounds to the same double as the JavaScript multiplication.
+    QML_V4_BEGIN_INSTR(AddInt, binaryop)
+    {
+        registers[instr->binaryop.output].setqreal(qreal(registers[instr->binaryop.left].getint()) + 
+                                                   qreal(registers[instr->binaryop.right].getint()));
+    }
+    QML_V4_END_INSTR(AddInt, binaryop)
+
+    QML_V4_BEGIN_INSTR(SubInt, binaryop)
+    {
+        registers[instr->binaryop.output].setqreal(qreal(registers[instr->binaryop.left].getint()) - 
+                                                   qreal(registers[instr->binaryop.right].getint()));
+    }
+    QML_V4_END_INSTR(SubInt, binaryop)
+
+    QML_V4_BEGIN_INSTR(MulInt, binaryop)
+    {
+        registers[instr->binaryop.output].setqreal(qreal(qint64(registers[instr->binaryop.left].getint()) * 
+                                                         qint64(registers[instr->binaryop.right].getint())));
+    }
+    QML_V4_END_INSTR(MulInt, binaryop)
+
+    QML_V4_BEGIN_INSTR(ModInt, binaryop)
+    {
+        // The compiler only emits ModInt for a constant divisor other than 0 and -1
+        registers[instr->binaryop.output].setint(registers[instr->binaryop.left].getint() % 
+                                                 registers[instr->binaryop.right].getint());
+    }
+    QML_V4_END_INSTR(ModInt, binaryop)
+
     QML_V4_BEGIN_INSTR(LShiftInt, binaryop)
     {
         registers[instr->binaryop.output].setint(registers[instr->binaryop.left].getint() << 
@@ -1283,6 +1408,48 @@ void QDeclarativeV4BindingsPrivate::run(int instrIndex, quint32 &executedBlocks,
     }
     QML_V4_END_INSTR(StrictNotEqualReal, binaryop)
 
+    QML_V4_BEGIN_INSTR(GtInt, binaryop)
+    {
+        registers[instr->binaryop.output].setbool(registers[instr->binaryop.left].getint() > 
+                                                  registers[instr->binaryop.right].getint());
+    }
+    QML_V4_END_INSTR(GtInt, binaryop)
+
+    QML_V4_BEGIN_INSTR(LtInt, binaryop)
+    {
+        registers[instr->binaryop.output].setbool(registers[instr->binaryop.left].getint() < 
+                                                  registers[instr->binaryop.right].getint());
+    }
+    QML_V4_END_INSTR(LtInt, binaryop)
+
+    QML_V4_BEGIN_INSTR(GeInt, binaryop)
+    {
+        registers[instr->binaryop.output].setbool(registers[instr->binaryop.left].getint() >= 
+                                                  registers[instr->binaryop.right].getint());
+    }
+    QML_V4_END_INSTR(GeInt, binaryop)
+
+    QML_V4_BEGIN_INSTR(LeInt, binaryop)
+    {
+        registers[instr->binaryop.output].setbool(registers[instr->binaryop.left].getint() <= 
+                                                  registers[instr->binaryop.right].getint());
+    }
+    QML_V4_END_INSTR(LeInt, binaryop)
+
+    QML_V4_BEGIN_INSTR(EqualInt, binaryop)
+    {
+        registers[instr->binaryop.output].setbool(registers[instr->binaryop.left].getint() == 
+                                                  registers[instr->binaryop.right].getint());
+    }
+    QML_V4_END_INSTR(EqualInt, binaryop)
+
+    QML_V4_BEGIN_INSTR(NotEqualInt, binaryop)
+    {
+        registers[instr->binaryop.output].setbool(registers[instr->binaryop.left].getint() != 
+                                                  registers[instr->binaryop.right].getint());
+    }
+    QML_V4_END_INSTR(NotEqualInt, binaryop)
+
     QML_V4_BEGIN_INSTR(GtString, binaryop)
     {
         const QString &a = *registers[instr->binaryop.left].getstringptr();
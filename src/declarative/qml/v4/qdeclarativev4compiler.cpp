@@ -44,6 +44,8 @@
 #include "qdeclarativev4program_p.h"
 #include "qdeclarativev4ir_p.h"
 #include "qdeclarativev4irbuilder_p.h"
+#include "qdeclarativev4iroptimizer_p.h"
+#include "qdeclarativev4bindings_p.h"
 
 #include <private/qdeclarativejsast_p.h>
 #include <private/qdeclarativefastproperties_p.h>
@@ -57,8 +59,10 @@ DEFINE_BOOL_CONFIG_OPTION(qmlDisableOptimizer, QML_DISABLE_OPTIMIZER)
 DEFINE_BOOL_CONFIG_OPTION(qmlExperimental, QML_EXPERIMENTAL)
 DEFINE_BOOL_CONFIG_OPTION(qmlVerboseCompiler, QML_VERBOSE_COMPILER)
 DEFINE_BOOL_CONFIG_OPTION(qmlBindingsTestEnv, QML_BINDINGS_TEST)
+DEFINE_BOOL_CONFIG_OPTION(qmlDisableIROptimizer, QML_DISABLE_IR_OPTIMIZER)
 
 static bool qmlBindingsTest = false;
+static bool qmlIROptimizer = true;
 
 using namespace QDeclarativeJS;
 QDeclarativeV4CompilerPrivate::QDeclarativeV4CompilerPrivate()
@@ -143,7 +147,7 @@ void QDeclarativeV4CompilerPrivate::trace(int line, int column)
 
         if (usic) {
             if (currentBlockMask == 0x80000000) {
-                discard();
+                discard(QLatin1String("too many subscription blocks"));
                 return;
             }
             currentBlockMask <<= 1;
@@ -224,10 +228,15 @@ void QDeclarativeV4CompilerPrivate::visitConst(IR::Const *e)
         gen(i);
         break;
 
+    case IR::NullType:
+        i.move_reg_null(currentReg);
+        gen(i);
+        break;
+
     default:
         if (qmlVerboseCompiler())
             qWarning() << Q_FUNC_INFO << "unexpected type";
-        discard();
+        discard(QLatin1String("unsupported constant of type ") + QLatin1String(IR::typeName(e->type)));
     }
 }
 
@@ -338,7 +347,7 @@ void QDeclarativeV4CompilerPrivate::visitName(IR::Name *e)
             } else {
                 if (qmlVerboseCompiler())
                     qWarning() << "Discard unsupported property type:" << QMetaType::typeName(propTy);
-                discard(); // Unsupported type
+                discard(QLatin1String("unsupported property type: ") + QLatin1String(QMetaType::typeName(propTy)));
                 return;
             }
 
@@ -592,18 +601,26 @@ quint8 QDeclarativeV4CompilerPrivate::instructionOpcode(IR::Binop *e)
     case IR::OpAdd:
         if (e->type == IR::StringType)
             return Instr::AddString;
+        if (e->left->type == IR::IntType)
+            return Instr::AddInt;
         return Instr::AddReal;
 
     case IR::OpSub:
+        if (e->left->type == IR::IntType)
+            return Instr::SubInt;
         return Instr::SubReal;
 
     case IR::OpMul:
+        if (e->left->type == IR::IntType)
+            return Instr::MulInt;
         return Instr::MulReal;
 
     case IR::OpDiv:
         return Instr::DivReal;
 
     case IR::OpMod:
+        if (e->type == IR::IntType)
+            return Instr::ModInt;
         return Instr::ModReal;
 
     case IR::OpLShift:
@@ -618,41 +635,57 @@ quint8 QDeclarativeV4CompilerPrivate::instructionOpcode(IR::Binop *e)
     case IR::OpGt:
         if (e->left->type == IR::StringType)
             return Instr::GtString;
+        if (e->left->type == IR::IntType)
+            return Instr::GtInt;
         return Instr::GtReal;
 
     case IR::OpLt:
         if (e->left->type == IR::StringType)
             return Instr::LtString;
+        if (e->left->type == IR::IntType)
+            return Instr::LtInt;
         return Instr::LtReal;
 
     case IR::OpGe:
         if (e->left->type == IR::StringType)
             return Instr::GeString;
+        if (e->left->type == IR::IntType)
+            return Instr::GeInt;
         return Instr::GeReal;
 
     case IR::OpLe:
         if (e->left->type == IR::StringType)
             return Instr::LeString;
+        if (e->left->type == IR::IntType)
+            return Instr::LeInt;
         return Instr::LeReal;
 
     case IR::OpEqual:
         if (e->left->type == IR::StringType)
             return Instr::EqualString;
+        if (e->left->type == IR::IntType)
+            return Instr::EqualInt;
         return Instr::EqualReal;
 
     case IR::OpNotEqual:
         if (e->left->type == IR::StringType)
             return Instr::NotEqualString;
+        if (e->left->type == IR::IntType)
+            return Instr::NotEqualInt;
         return Instr::NotEqualReal;
 
     case IR::OpStrictEqual:
         if (e->left->type == IR::StringType)
             return Instr::StrictEqualString;
+        if (e->left->type == IR::IntType)
+            return Instr::EqualInt;
         return Instr::StrictEqualReal;
 
     case IR::OpStrictNotEqual:
         if (e->left->type == IR::StringType)
             return Instr::StrictNotEqualString;
+        if (e->left->type == IR::IntType)
+            return Instr::NotEqualInt;
         return Instr::StrictNotEqualReal;
 
     case IR::OpAnd:
@@ -667,7 +700,8 @@ quint8 QDeclarativeV4CompilerPrivate::instructionOpcode(IR::Binop *e)
 void QDeclarativeV4CompilerPrivate::visitBinop(IR::Binop *e)
 {
     int left = currentReg;
-    int right = currentReg + 1; 
+    // Registers below tempCount may belong to live temps
+    int right = qMax<int>(currentReg + 1, _function->tempCount);
 
     if (e->left->asTemp() && e->type != IR::StringType)  // Not sure if the e->type != String test is needed
         left = e->left->asTemp()->index;
@@ -686,7 +720,10 @@ void QDeclarativeV4CompilerPrivate::visitBinop(IR::Binop *e)
                                  << "' and `"
                                  << IR::binaryOperator(e->right->type)
                                  << "'";
-        discard();
+        discard(QString(QLatin1String("invalid operands to binary operator %1 (%2 and %3)"))
+                .arg(QLatin1String(IR::opname(e->op)))
+                .arg(QLatin1String(IR::typeName(e->left->type)))
+                .arg(QLatin1String(IR::typeName(e->right->type))));
         return;
     }
 
@@ -715,16 +752,22 @@ void QDeclarativeV4CompilerPrivate::visitBinop(IR::Binop *e)
         break;
 
     case IR::OpAdd:
-        if (e->type != IR::StringType) {
+    case IR::OpSub:
+    case IR::OpMul:
+        if (e->type != IR::StringType && e->left->type != IR::IntType) {
             convertToReal(e->left, left);
             convertToReal(e->right, right);
         }
         break;
 
-    case IR::OpSub:
-    case IR::OpMul:
-    case IR::OpDiv:
     case IR::OpMod:
+        if (e->type != IR::IntType) {
+            convertToReal(e->left, left);
+            convertToReal(e->right, right);
+        }
+        break;
+
+    case IR::OpDiv:
         convertToReal(e->left, left);
         convertToReal(e->right, right);
         break;
@@ -737,7 +780,7 @@ void QDeclarativeV4CompilerPrivate::visitBinop(IR::Binop *e)
     case IR::OpNotEqual:
     case IR::OpStrictEqual:
     case IR::OpStrictNotEqual:
-        if (e->left->type != IR::StringType) {
+        if (e->left->type != IR::StringType && e->left->type != IR::IntType) {
             convertToReal(e->left, left);
             convertToReal(e->right, right);
         }
@@ -789,6 +832,20 @@ void QDeclarativeV4CompilerPrivate::visitCall(IR::Call *call)
                 instr.math_floor_real(currentReg);
                 break;
 
+            case IR::MathCeilBultinFunction:
+                instr.math_ceil_real(currentReg);
+                break;
+
+            case IR::MathAbsBultinFunction:
+                instr.math_abs_real(currentReg);
+                break;
+
+            case IR::MathSqrtBultinFunction:
+                instr.math_sqrt_real(currentReg);
+                break;
+
+            case IR::MathMinBultinFunction:
+            case IR::MathMaxBultinFunction:
             case IR::MathPIBuiltinConstant:
                 break;
             } // switch
@@ -797,12 +854,47 @@ void QDeclarativeV4CompilerPrivate::visitCall(IR::Call *call)
                 gen(instr);
                 return;
             }
+        } else if (call->args.size() == 2 && 
+                   (name->builtin == IR::MathMinBultinFunction || name->builtin == IR::MathMaxBultinFunction) &&
+                   call->args.at(0)->type == call->args.at(1)->type &&
+                   (call->args.at(0)->type == IR::RealType || call->args.at(0)->type == IR::IntType)) {
+            int left = currentReg;
+            int right = qMax<int>(currentReg + 1, _function->tempCount);
+
+            if (IR::Temp *t = call->args.at(0)->asTemp())
+                left = t->index;
+            else
+                traceExpression(call->args.at(0), left);
+
+            if (IR::Temp *t = call->args.at(1)->asTemp())
+                right = t->index;
+            else
+                traceExpression(call->args.at(1), right);
+
+            const bool isInt = call->args.at(0)->type == IR::IntType;
+
+            Instr instr;
+            if (name->builtin == IR::MathMinBultinFunction)
+                instr.common.type = isInt ? Instr::MathMinInt : Instr::MathMinReal;
+            else
+                instr.common.type = isInt ? Instr::MathMaxInt : Instr::MathMaxReal;
+            instr.binaryop.output = currentReg;
+            instr.binaryop.left = left;
+            instr.binaryop.right = right;
+            gen(instr);
+            return;
         }
+
+        if (qmlVerboseCompiler())
+            qWarning() << "TODO:" << Q_FUNC_INFO << __LINE__;
+        discard(QString(QLatin1String("unsupported call to %1() with %2 argument(s)"))
+                .arg(name->id).arg(call->args.size()));
+        return;
     }
 
     if (qmlVerboseCompiler())
         qWarning() << "TODO:" << Q_FUNC_INFO << __LINE__;
-    discard();
+    discard(QLatin1String("unsupported function call"));
 }
 
 
@@ -821,7 +913,10 @@ void QDeclarativeV4CompilerPrivate::visitMove(IR::Move *s)
 
     quint8 dest = target->index;
 
-    if (target->type != s->source->type) {
+    if (target->type == IR::ObjectType && s->source->type == IR::NullType) {
+        // null is loaded straight into an object register
+        traceExpression(s->source, dest);
+    } else if (target->type != s->source->type) {
         quint8 src = dest;
 
         if (IR::Temp *t = s->source->asTemp()) 
@@ -871,7 +966,9 @@ void QDeclarativeV4CompilerPrivate::visitMove(IR::Move *s)
             conv.unaryop.src = src;
             gen(conv);
         } else {
-            discard();
+            discard(QString(QLatin1String("unsupported conversion from %1 to %2"))
+                    .arg(QLatin1String(IR::typeName(s->source->type)))
+                    .arg(QLatin1String(IR::typeName(target->type))));
         }
     } else {
         traceExpression(s->source, dest);
@@ -975,6 +1072,33 @@ void QDeclarativeV4Compiler::dump(const QByteArray &programData)
     }
 }
 
+/*!
+Prepares \a programData, which was produced by program() in a different process,
+for execution in this one.  With the threaded interpreter every instruction
+carries the address of its handler, which is only valid for the process that
+compiled it, so the addresses are recomputed from the instruction types.
+*/
+void QDeclarativeV4Compiler::relocate(QByteArray &programData)
+{
+#ifdef QML_THREADED_INTERPRETER
+    if (programData.isEmpty())
+        return;
+
+    QDeclarativeV4Program *program = (QDeclarativeV4Program *)programData.data();
+    void **decodeInstr = QDeclarativeV4Bindings::getDecodeInstrTable();
+
+    char *code = (char *)program->instructions();
+    char *end = code + program->instructionCount;
+    while (code < end) {
+        Instr *instr = (Instr *) code;
+        instr->common.code = decodeInstr[instr->common.type];
+        code += instr->size();
+    }
+#else
+    Q_UNUSED(programData);
+#endif
+}
+
 /*!
 Clear the state associated with attempting to compile a specific binding.
 This does not clear the global "committed binding" states.
@@ -990,6 +1114,7 @@ void QDeclarativeV4CompilerPrivate::resetInstanceState()
     bytecode.clear();
     patches.clear();
     currentReg = 0;
+    _discardReason.clear();
 }
 
 /*!
@@ -1015,8 +1140,10 @@ bool QDeclarativeV4CompilerPrivate::compile(QDeclarativeJS::AST::Node *node)
 {
     resetInstanceState();
 
-    if (expression->property->type == -1)
+    if (expression->property->type == -1) {
+        _discardReason = QLatin1String("unknown property type");
         return false;
+    }
 
     AST::SourceLocation location;
     if (AST::ExpressionNode *astExpression = node->expressionCast()) {
@@ -1026,9 +1153,12 @@ bool QDeclarativeV4CompilerPrivate::compile(QDeclarativeJS::AST::Node *node)
             location = block->lbraceToken;
         else if (AST::IfStatement *ifStmt = AST::cast<AST::IfStatement *>(astStatement))
             location = ifStmt->ifToken;
-        else
+        else {
+            _discardReason = QLatin1String("unsupported statement");
             return false;
+        }
     } else {
+        _discardReason = QLatin1String("unsupported statement");
         return false;
     }
 
@@ -1036,8 +1166,15 @@ bool QDeclarativeV4CompilerPrivate::compile(QDeclarativeJS::AST::Node *node)
     IR::Function *function = 0;
 
     QDeclarativeV4IRBuilder irBuilder(expression, engine);
-    if (!(function = irBuilder(&module, node)))
+    if (!(function = irBuilder(&module, node))) {
+        _discardReason = irBuilder.discardReason();
         return false;
+    }
+
+    if (qmlIROptimizer && !qmlDisableIROptimizer()) {
+        QDeclarativeV4IROptimizer optimizer;
+        optimizer(function);
+    }
 
     bool discarded = false;
     qSwap(_discarded, discarded);
@@ -1060,6 +1197,9 @@ bool QDeclarativeV4CompilerPrivate::compile(QDeclarativeJS::AST::Node *node)
         qerr << endl;
     }
 
+    if (!discarded && (subscriptionIds.count() > 0xFFFF || registeredStrings.count() > 0xFFFF)) 
+        _discardReason = QLatin1String("too many subscriptions");
+
     if (discarded || subscriptionIds.count() > 0xFFFF || registeredStrings.count() > 0xFFFF)
         return false;
 
@@ -1202,13 +1342,20 @@ bool QDeclarativeV4Compiler::isValid() const
 */
 int QDeclarativeV4Compiler::compile(const Expression &expression, QDeclarativeEnginePrivate *engine)
 {
-    if (!expression.expression.asAST()) return false;
+    if (!expression.expression.asAST()) {
+        d->_discardReason = QLatin1String("not a script expression");
+        return -1;
+    }
 
-    if (!qmlExperimental() && expression.property->isValueTypeSubProperty)
+    if (!qmlExperimental() && expression.property->isValueTypeSubProperty) {
+        d->_discardReason = QLatin1String("value type sub-property");
         return -1;
+    }
 
-    if (qmlDisableOptimizer())
+    if (qmlDisableOptimizer()) {
+        d->_discardReason = QLatin1String("optimizer disabled");
         return -1;
+    }
 
     d->expression = &expression;
     d->engine = engine;
@@ -1216,10 +1363,21 @@ int QDeclarativeV4Compiler::compile(const Expression &expression, QDeclarativeEn
     if (d->compile(expression.expression.asAST())) {
         return d->commitCompile();
     } else {
+        if (d->_discardReason.isEmpty())
+            d->_discardReason = QLatin1String("unsupported expression");
         return -1;
     }
 }
 
+/*!
+Returns a short description of why the last call to compile() rejected its
+expression, or an empty string if it was accepted.
+*/
+QString QDeclarativeV4Compiler::discardReason() const
+{
+    return d->_discardReason;
+}
+
 QByteArray QDeclarativeV4CompilerPrivate::buildSignalTable() const
 {
     QHash<int, QList<QPair<int, quint32> > > table;
@@ -1329,4 +1487,13 @@ void QDeclarativeV4Compiler::enableBindingsTest(bool e)
         qmlBindingsTest = qmlBindingsTestEnv();
 }
 
+/*
+    Turns the optimization pass between the IR builder and the code generator
+    on or off.  It is on by default, unless QML_DISABLE_IR_OPTIMIZER is set.
+*/
+void QDeclarativeV4Compiler::enableIROptimizer(bool e)
+{
+    qmlIROptimizer = e;
+}
+
 QT_END_NAMESPACE
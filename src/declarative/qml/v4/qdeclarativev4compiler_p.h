@@ -85,11 +85,16 @@ public:
     // -1 on failure, otherwise the binding index to use
     int compile(const Expression &, QDeclarativeEnginePrivate *);
 
+    // Why the last call to compile() failed
+    QString discardReason() const;
+
     // Returns the compiled program
     QByteArray program() const;
 
     static void dump(const QByteArray &);
+    static void relocate(QByteArray &);
     static void enableBindingsTest(bool);
+    static void enableIROptimizer(bool);
 private:
     QDeclarativeV4CompilerPrivate *d;
 };
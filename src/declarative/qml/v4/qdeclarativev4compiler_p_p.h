@@ -108,6 +108,7 @@ public:
     QString contextName() const { return QLatin1String("$$$SCOPE_") + QString::number((quintptr)expression->context, 16); }
 
     bool compile(QDeclarativeJS::AST::Node *);
+    QString _discardReason;
 
     QHash<int, QPair<int, int> > registerCleanups;
 
@@ -197,7 +198,10 @@ private:
     QStringList _subscribeName;
     QDeclarativeJS::IR::Function *_function;
     QDeclarativeJS::IR::BasicBlock *_block;
-    void discard() { _discarded = true; }
+    void discard(const QString &reason = QString()) { 
+        if (!_discarded && !reason.isEmpty()) _discardReason = reason; 
+        _discarded = true; 
+    }
     bool _discarded;
     quint8 currentReg;
 
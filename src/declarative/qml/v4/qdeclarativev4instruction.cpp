@@ -180,6 +180,27 @@ void Instr::dump(int address) const
     case Instr::MathPIReal:
         INSTR_DUMP << "\t" << "MathPIReal" << "\t\t" << "Input_Reg(" << unaryop.src << ") -> Output_Reg(" << unaryop.output << ")";
         break;
+    case Instr::MathCeilReal:
+        INSTR_DUMP << "\t" << "MathCeilReal" << "\t\t" << "Input_Reg(" << unaryop.src << ") -> Output_Reg(" << unaryop.output << ")";
+        break;
+    case Instr::MathAbsReal:
+        INSTR_DUMP << "\t" << "MathAbsReal" << "\t\t" << "Input_Reg(" << unaryop.src << ") -> Output_Reg(" << unaryop.output << ")";
+        break;
+    case Instr::MathSqrtReal:
+        INSTR_DUMP << "\t" << "MathSqrtReal" << "\t\t" << "Input_Reg(" << unaryop.src << ") -> Output_Reg(" << unaryop.output << ")";
+        break;
+    case Instr::MathMinReal:
+        INSTR_DUMP << "\t" << "MathMinReal" << "\t\t" << "Input_Reg(" << binaryop.left << ") Input_Reg(" << binaryop.right << ") -> Output_Reg(" << binaryop.output << ")";
+        break;
+    case Instr::MathMaxReal:
+        INSTR_DUMP << "\t" << "MathMaxReal" << "\t\t" << "Input_Reg(" << binaryop.left << ") Input_Reg(" << binaryop.right << ") -> Output_Reg(" << binaryop.output << ")";
+        break;
+    case Instr::MathMinInt:
+        INSTR_DUMP << "\t" << "MathMinInt" << "\t\t" << "Input_Reg(" << binaryop.left << ") Input_Reg(" << binaryop.right << ") -> Output_Reg(" << binaryop.output << ")";
+        break;
+    case Instr::MathMaxInt:
+        INSTR_DUMP << "\t" << "MathMaxInt" << "\t\t" << "Input_Reg(" << binaryop.left << ") Input_Reg(" << binaryop.right << ") -> Output_Reg(" << binaryop.output << ")";
+        break;
     case Instr::Real:
         INSTR_DUMP << "\t" << "Real" << "\t\t\t" << "Constant(" << real_value.value << ") -> Output_Reg(" << real_value.reg << ")";
         break;
@@ -189,6 +210,9 @@ void Instr::dump(int address) const
     case Instr::Bool:
         INSTR_DUMP << "\t" << "Bool" << "\t\t\t" << "Constant(" << bool_value.value << ") -> Output_Reg(" << bool_value.reg << ")";
         break;
+    case Instr::Null:
+        INSTR_DUMP << "\t" << "Null" << "\t\t\t" << "Constant(null) -> Output_Reg(" << construct.reg << ")";
+        break;
     case Instr::String:
         INSTR_DUMP << "\t" << "String" << "\t\t\t" << "String_DataIndex(" << string_value.offset << ") String_Length(" << string_value.length << ") -> Output_Register(" << string_value.reg << ")";
         break;
@@ -225,6 +249,18 @@ void Instr::dump(int address) const
     case Instr::ModReal:
         INSTR_DUMP << "\t" << "ModReal" << "\t\t\t" << "Input_Reg(" << binaryop.left << ") Input_Reg(" << binaryop.right << ") -> Output_Reg(" << binaryop.output << ")";
         break;
+    case Instr::AddInt:
+        INSTR_DUMP << "\t" << "AddInt" << "\t\t\t" << "Input_Reg(" << binaryop.left << ") Input_Reg(" << binaryop.right << ") -> Output_Reg(" << binaryop.output << ")";
+        break;
+    case Instr::SubInt:
+        INSTR_DUMP << "\t" << "SubInt" << "\t\t\t" << "Input_Reg(" << binaryop.left << ") Input_Reg(" << binaryop.right << ") -> Output_Reg(" << binaryop.output << ")";
+        break;
+    case Instr::MulInt:
+        INSTR_DUMP << "\t" << "MulInt" << "\t\t\t" << "Input_Reg(" << binaryop.left << ") Input_Reg(" << binaryop.right << ") -> Output_Reg(" << binaryop.output << ")";
+        break;
+    case Instr::ModInt:
+        INSTR_DUMP << "\t" << "ModInt" << "\t\t\t" << "Input_Reg(" << binaryop.left << ") Input_Reg(" << binaryop.right << ") -> Output_Reg(" << binaryop.output << ")";
+        break;
     case Instr::LShiftInt:
         INSTR_DUMP << "\t" << "LShiftInt" << "\t\t" << "Input_Reg(" << binaryop.left << ") Input_Reg(" << binaryop.right << ") -> Output_Reg(" << binaryop.output << ")";
         break;
@@ -258,6 +294,24 @@ void Instr::dump(int address) const
     case Instr::StrictNotEqualReal:
         INSTR_DUMP << "\t" << "StrictNotEqualReal" << "\t" << "Input_Reg(" << binaryop.left << ") Input_Reg(" << binaryop.right << ") -> Output_Reg(" << binaryop.output << ")";
         break;
+    case Instr::GtInt:
+        INSTR_DUMP << "\t" << "GtInt" << "\t\t\t" << "Input_Reg(" << binaryop.left << ") Input_Reg(" << binaryop.right << ") -> Output_Reg(" << binaryop.output << ")";
+        break;
+    case Instr::LtInt:
+        INSTR_DUMP << "\t" << "LtInt" << "\t\t\t" << "Input_Reg(" << binaryop.left << ") Input_Reg(" << binaryop.right << ") -> Output_Reg(" << binaryop.output << ")";
+        break;
+    case Instr::GeInt:
+        INSTR_DUMP << "\t" << "GeInt" << "\t\t\t" << "Input_Reg(" << binaryop.left << ") Input_Reg(" << binaryop.right << ") -> Output_Reg(" << binaryop.output << ")";
+        break;
+    case Instr::LeInt:
+        INSTR_DUMP << "\t" << "LeInt" << "\t\t\t" << "Input_Reg(" << binaryop.left << ") Input_Reg(" << binaryop.right << ") -> Output_Reg(" << binaryop.output << ")";
+        break;
+    case Instr::EqualInt:
+        INSTR_DUMP << "\t" << "EqualInt" << "\t\t" << "Input_Reg(" << binaryop.left << ") Input_Reg(" << binaryop.right << ") -> Output_Reg(" << binaryop.output << ")";
+        break;
+    case Instr::NotEqualInt:
+        INSTR_DUMP << "\t" << "NotEqualInt" << "\t\t" << "Input_Reg(" << binaryop.left << ") Input_Reg(" << binaryop.right << ") -> Output_Reg(" << binaryop.output << ")";
+        break;
     case Instr::GtString:
         INSTR_DUMP << "\t" << "GtString" << "\t\t" << "Input_Reg(" << binaryop.left << ") Input_Reg(" << binaryop.right << ") -> Output_Reg(" << binaryop.output << ")";
         break;
@@ -391,6 +445,12 @@ void Instr::move_reg_qreal(quint8 reg, qreal value)
     real_value.value = value;
 }
 
+void Instr::move_reg_null(quint8 reg)
+{
+    common.type = Null;
+    construct.reg = reg;
+}
+
 void Instr::move_reg_reg(quint8 reg, quint8 src)
 {
     common.type = Copy;
@@ -484,6 +544,27 @@ void Instr::math_pi_real(quint8 reg)
     unaryop.output = reg;
 }
 
+void Instr::math_ceil_real(quint8 reg)
+{
+    common.type = MathCeilReal;
+    unaryop.src = reg;
+    unaryop.output = reg;
+}
+
+void Instr::math_abs_real(quint8 reg)
+{
+    common.type = MathAbsReal;
+    unaryop.src = reg;
+    unaryop.output = reg;
+}
+
+void Instr::math_sqrt_real(quint8 reg)
+{
+    common.type = MathSqrtReal;
+    unaryop.src = reg;
+    unaryop.output = reg;
+}
+
 void Instr::branch_true(quint8 reg, qint16 offset)
 {
     common.type = BranchTrue;
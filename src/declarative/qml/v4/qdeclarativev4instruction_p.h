@@ -93,9 +93,17 @@ QT_BEGIN_NAMESPACE
     F(MathRoundReal, unaryop) \
     F(MathFloorReal, unaryop) \
     F(MathPIReal, unaryop) \
+    F(MathCeilReal, unaryop) \
+    F(MathAbsReal, unaryop) \
+    F(MathSqrtReal, unaryop) \
+    F(MathMinReal, binaryop) \
+    F(MathMaxReal, binaryop) \
+    F(MathMinInt, binaryop) \
+    F(MathMaxInt, binaryop) \
     F(Real, real_value) \
     F(Int, int_value) \
     F(Bool, bool_value) \
+    F(Null, construct) \
     F(String, string_value) \
     F(EnableV4Test, string_value) \
     F(TestV4Store, storetest) \
@@ -108,6 +116,10 @@ QT_BEGIN_NAMESPACE
     F(MulReal, binaryop) \
     F(DivReal, binaryop) \
     F(ModReal, binaryop) \
+    F(AddInt, binaryop) \
+    F(SubInt, binaryop) \
+    F(MulInt, binaryop) \
+    F(ModInt, binaryop) \
     F(LShiftInt, binaryop) \
     F(RShiftInt, binaryop) \
     F(URShiftInt, binaryop) \
@@ -119,6 +131,12 @@ QT_BEGIN_NAMESPACE
     F(NotEqualReal, binaryop) \
     F(StrictEqualReal, binaryop) \
     F(StrictNotEqualReal, binaryop) \
+    F(GtInt, binaryop) \
+    F(LtInt, binaryop) \
+    F(GeInt, binaryop) \
+    F(LeInt, binaryop) \
+    F(EqualInt, binaryop) \
+    F(NotEqualInt, binaryop) \
     F(GtString, binaryop) \
     F(LtString, binaryop) \
     F(GeString, binaryop) \
@@ -179,6 +197,7 @@ union Instr {
     void move_reg_bool(quint8 reg, bool value);
     void move_reg_int(quint8 reg, int value);
     void move_reg_qreal(quint8 reg, qreal value);
+    void move_reg_null(quint8 reg);
     void move_reg_reg(quint8 reg, quint8 src);
 
     void unary_not(quint8 dest, quint8 src);
@@ -194,6 +213,9 @@ union Instr {
     void math_round_real(quint8 reg);
     void math_floor_real(quint8 reg);
     void math_pi_real(quint8 reg);
+    void math_ceil_real(quint8 reg);
+    void math_abs_real(quint8 reg);
+    void math_sqrt_real(quint8 reg);
     void branch_true(quint8 reg, qint16 offset);
     void branch_false(quint8 reg, qint16 offset);
     void branch(qint16 offset);
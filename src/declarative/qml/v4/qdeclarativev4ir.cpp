@@ -50,7 +50,7 @@ QT_BEGIN_NAMESPACE
 namespace QDeclarativeJS {
 namespace IR {
 
-inline const char *typeName(Type t)
+const char *typeName(Type t)
 {
     switch (t) {
     case InvalidType: return "invalid";
@@ -203,8 +203,18 @@ Name::Name(Name *base, Type type, const QString &id, Symbol symbol, quint32 line
         builtin = MathCosBultinFunction;
     } else if (id.length() == 10 && id == QLatin1String("Math.round")) {
         builtin = MathRoundBultinFunction;
-    } else if (id.length() == 10 && id == QLatin1String("Math.floor)")) {
+    } else if (id.length() == 10 && id == QLatin1String("Math.floor")) {
         builtin = MathFloorBultinFunction;
+    } else if (id.length() == 9 && id == QLatin1String("Math.ceil")) {
+        builtin = MathCeilBultinFunction;
+    } else if (id.length() == 8 && id == QLatin1String("Math.abs")) {
+        builtin = MathAbsBultinFunction;
+    } else if (id.length() == 9 && id == QLatin1String("Math.sqrt")) {
+        builtin = MathSqrtBultinFunction;
+    } else if (id.length() == 8 && id == QLatin1String("Math.min")) {
+        builtin = MathMinBultinFunction;
+    } else if (id.length() == 8 && id == QLatin1String("Math.max")) {
+        builtin = MathMaxBultinFunction;
     } else if (id.length() == 7 && id == QLatin1String("Math.PI")) {
         builtin = MathPIBuiltinConstant;
         type = RealType;
@@ -285,10 +295,16 @@ Type Binop::typeForOp(AluOp op, Expr *left, Expr *right)
             return StringType;
         return RealType;
 
+    case OpMod:
+        // The builder only keeps int operands for a modulo that cannot
+        // produce NaN or overflow (see QDeclarativeV4IRBuilder)
+        if (left->type == IntType && right->type == IntType)
+            return IntType;
+        return RealType;
+
     case OpSub:
     case OpMul:
     case OpDiv:
-    case OpMod:
         return RealType;
 
     case OpLShift:
@@ -326,7 +342,7 @@ void Call::dump(QTextStream &out)
     out << ')';
 }
 
-Type Call::typeForFunction(Expr *base)
+Type Call::typeForFunction(Expr *base, const QVector<Expr *> &args)
 {
     if (! base)
         return InvalidType;
@@ -335,12 +351,21 @@ Type Call::typeForFunction(Expr *base)
         switch (name->builtin) {
         case MathSinBultinFunction:
         case MathCosBultinFunction:
+        case MathAbsBultinFunction:
+        case MathSqrtBultinFunction:
             return RealType;
 
         case MathRoundBultinFunction:
         case MathFloorBultinFunction:
+        case MathCeilBultinFunction:
             return IntType;
 
+        case MathMinBultinFunction:
+        case MathMaxBultinFunction:
+            if (args.size() == 2 && args.at(0)->type == IntType && args.at(1)->type == IntType)
+                return IntType;
+            return RealType;
+
         case NoBuiltinSymbol:
         case MathPIBuiltinConstant:
             break;
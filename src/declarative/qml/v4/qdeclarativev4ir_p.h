@@ -134,6 +134,7 @@ enum AluOp {
     OpOr
 };
 AluOp binaryOperator(int op);
+const char *opname(AluOp op);
 
 enum Type {
     InvalidType,
@@ -154,6 +155,7 @@ enum Type {
     RealNaNType
 };
 Type maxType(IR::Type left, IR::Type right);
+const char *typeName(Type t);
 
 struct ExprVisitor {
     virtual ~ExprVisitor() {}
@@ -218,6 +220,11 @@ enum BuiltinSymbol {
     MathCosBultinFunction,
     MathRoundBultinFunction,
     MathFloorBultinFunction,
+    MathCeilBultinFunction,
+    MathAbsBultinFunction,
+    MathSqrtBultinFunction,
+    MathMinBultinFunction,
+    MathMaxBultinFunction,
 
     MathPIBuiltinConstant
 };
@@ -312,7 +319,7 @@ struct Call: Expr {
     QVector<Expr *> args;
 
     Call(Expr *base, const QVector<Expr *> &args)
-        : Expr(typeForFunction(base)), base(base), args(args) {}
+        : Expr(typeForFunction(base, args)), base(base), args(args) {}
 
     virtual void accept(ExprVisitor *v) { v->visitCall(this); }
     virtual Call *asCall() { return this; }
@@ -320,7 +327,7 @@ struct Call: Expr {
     virtual void dump(QTextStream &out);
 
 private:
-    static Type typeForFunction(Expr *base);
+    static Type typeForFunction(Expr *base, const QVector<Expr *> &args);
 };
 
 struct Stmt {
@@ -45,6 +45,9 @@
 #include <private/qsganchors_p_p.h> // For AnchorLine
 #include <private/qdeclarativetypenamecache_p.h>
 
+#include <QtCore/qmath.h>
+#include <limits.h>
+
 DEFINE_BOOL_CONFIG_OPTION(qmlVerboseCompiler, QML_VERBOSE_COMPILER)
 
 QT_BEGIN_NAMESPACE
@@ -94,6 +97,7 @@ QDeclarativeV4IRBuilder::operator()(QDeclarativeJS::IR::Module *module,
                                          QDeclarativeJS::AST::Node *ast)
 {
     bool discarded = false;
+    _discardReason.clear();
 
     qSwap(_module, module);
 
@@ -158,11 +162,21 @@ bool QDeclarativeV4IRBuilder::buildName(QStringList &name,
     return true;
 }
 
-void QDeclarativeV4IRBuilder::discard() 
+void QDeclarativeV4IRBuilder::discard(const QString &reason) 
 { 
+    // Keep the innermost reason, it is the most precise one
+    if (!_discard && !reason.isEmpty())
+        _discardReason = reason;
     _discard = true; 
 }
 
+static QString unsupported(AST::Node *ast)
+{
+    const AST::SourceLocation location = ast->firstSourceLocation();
+    return QString(QLatin1String("unsupported expression at %1:%2"))
+            .arg(location.startLine).arg(location.startColumn);
+}
+
 QDeclarativeV4IRBuilder::ExprResult 
 QDeclarativeV4IRBuilder::expression(AST::ExpressionNode *ast)
 {
@@ -173,7 +187,7 @@ QDeclarativeV4IRBuilder::expression(AST::ExpressionNode *ast)
         qSwap(_expr, r);
 
         if (r.is(IR::InvalidType))
-            discard();
+            discard(unsupported(ast));
         else {
             Q_ASSERT(r.hint == r.format);
         }
@@ -193,7 +207,7 @@ void QDeclarativeV4IRBuilder::condition(AST::ExpressionNode *ast, IR::BasicBlock
 
     if (r.format != ExprResult::cx) {
         if (! r.code)
-            discard();
+            discard(unsupported(ast));
 
         Q_ASSERT(r.hint == ExprResult::cx);
         Q_ASSERT(r.format == ExprResult::ex);
@@ -218,7 +232,7 @@ QDeclarativeV4IRBuilder::statement(AST::Statement *ast)
         qSwap(_expr, r);
 
         if (r.is(IR::InvalidType))
-            discard();
+            discard(unsupported(ast));
         else {
             Q_ASSERT(r.hint == r.format);
         }
@@ -242,6 +256,24 @@ void QDeclarativeV4IRBuilder::implicitCvt(ExprResult &expr, IR::Type type)
     expr.code = x;
 }
 
+// An integral literal next to an int operand is turned into an int, so
+// that the operation can stay in ints
+void QDeclarativeV4IRBuilder::narrowLiteral(ExprResult &expr, const ExprResult &other)
+{
+    if (!other.is(IR::IntType) || !expr.is(IR::RealType))
+        return;
+
+    IR::Const *c = expr->asConst();
+    if (!c)
+        return;
+
+    const double value = c->value;
+    if (value < INT_MIN || value > INT_MAX || value != ::floor(value) || (value == 0 && 1 / value < 0))
+        return; // not representable, or -0
+
+    expr.code = _block->CONST(IR::IntType, value);
+}
+
 // QML
 bool QDeclarativeV4IRBuilder::visit(AST::UiProgram *)
 {
@@ -438,6 +470,7 @@ bool QDeclarativeV4IRBuilder::visit(AST::IdentifierExpression *ast)
         _expr.code = _block->CONST(IR::UndefinedType, 0); // ### undefined value
     } else if (m_engine->v8engine()->illegalNames().contains(name) ) {
         if (qmlVerboseCompiler()) qWarning() << "*** illegal symbol:" << name;
+        discard(QLatin1String("illegal symbol: ") + name);
         return false;
     } else if (const QDeclarativeParser::Object *obj = m_expression->ids.value(name)) {
         IR::Name *code = _block->ID_OBJECT(name, obj, line, column);
@@ -447,10 +480,12 @@ bool QDeclarativeV4IRBuilder::visit(AST::IdentifierExpression *ast)
     } else if (QDeclarativeTypeNameCache::Data *typeNameData = m_expression->importCache->data(name)) {
         if (typeNameData->importedScriptIndex != -1) {
             // We don't support invoking imported scripts
+            discard(QLatin1String("imported script: ") + name);
         } else if (typeNameData->type) {
             _expr.code = _block->ATTACH_TYPE(name, typeNameData->type, IR::Name::ScopeStorage, line, column);
         } else if (typeNameData->typeNamespace) {
             // We don't support namespaces
+            discard(QLatin1String("type namespace: ") + name);
         } else {
             Q_ASSERT(!"Unreachable");
         }
@@ -468,7 +503,7 @@ bool QDeclarativeV4IRBuilder::visit(AST::IdentifierExpression *ast)
             if (data && data->revision != 0) {
                 if (qmlVerboseCompiler()) 
                     qWarning() << "*** versioned symbol:" << name;
-                discard();
+                discard(QLatin1String("versioned symbol: ") + name);
                 return false;
             }
 
@@ -489,7 +524,7 @@ bool QDeclarativeV4IRBuilder::visit(AST::IdentifierExpression *ast)
             if (data && data->revision != 0) {
                 if (qmlVerboseCompiler()) 
                     qWarning() << "*** versioned symbol:" << name;
-                discard();
+                discard(QLatin1String("versioned symbol: ") + name);
                 return false;
             }
 
@@ -500,8 +535,11 @@ bool QDeclarativeV4IRBuilder::visit(AST::IdentifierExpression *ast)
             } 
         }
 
-        if (!found && qmlVerboseCompiler())
-            qWarning() << "*** unknown symbol:" << name;
+        if (!found) {
+            if (qmlVerboseCompiler())
+                qWarning() << "*** unknown symbol:" << name;
+            discard(QLatin1String("unknown symbol: ") + name);
+        }
     }
 
     if (_expr.code && _expr.hint == ExprResult::cx) {
@@ -576,6 +614,15 @@ bool QDeclarativeV4IRBuilder::visit(AST::ArrayMemberExpression *)
 
 bool QDeclarativeV4IRBuilder::visit(AST::FieldMemberExpression *ast)
 {
+    if (ast->base->kind == AST::Node::Kind_IdentifierExpression &&
+        static_cast<AST::IdentifierExpression *>(ast->base)->name->asString() == QLatin1String("Math")) {
+        if (ast->name->asString() == QLatin1String("PI"))
+            _expr.code = _block->CONST(IR::RealType, M_PI);
+        else
+            discard(QLatin1String("unsupported Math member: ") + ast->name->asString());
+        return false;
+    }
+
     if (IR::Expr *left = expression(ast->base)) {
         if (IR::Name *baseName = left->asName()) {
             const quint32 line = ast->identifierToken.startLine;
@@ -604,20 +651,26 @@ bool QDeclarativeV4IRBuilder::visit(AST::FieldMemberExpression *ast)
                         }
                     }
 
-                    if (!found && qmlVerboseCompiler())
-                        qWarning() << "*** unresolved enum:" 
-                                   << (baseName->id + QLatin1String(".") + ast->name->asString());
+                    if (!found) {
+                        if (qmlVerboseCompiler())
+                            qWarning() << "*** unresolved enum:" 
+                                       << (baseName->id + QLatin1String(".") + ast->name->asString());
+                        discard(QLatin1String("unresolved enum: ") + baseName->id + QLatin1String(".") + name);
+                    }
                 } else if(const QMetaObject *attachedMeta = baseName->declarativeType->attachedPropertiesType()) {
                     QDeclarativePropertyCache *cache = m_engine->cache(attachedMeta);
                     QDeclarativePropertyCache::Data *data = cache->property(name);
 
-                    if (!data || data->isFunction())
+                    if (!data || data->isFunction()) {
+                        discard(QLatin1String("method or unknown property: ") + name);
                         return false; // Don't support methods (or non-existing properties ;)
+                    }
 
                     if(!data->isFinal()) {
                         if (qmlVerboseCompiler())
                             qWarning() << "*** non-final attached property:"
                                        << (baseName->id + QLatin1String(".") + ast->name->asString());
+                        discard(QLatin1String("non-final attached property: ") + name);
                         return false; // We don't know enough about this property
                     }
 
@@ -633,13 +686,15 @@ bool QDeclarativeV4IRBuilder::visit(AST::FieldMemberExpression *ast)
 
                 QDeclarativePropertyCache::Data *data = cache->property(name);
 
-                if (!data || data->isFunction())
+                if (!data || data->isFunction()) {
+                    discard(QLatin1String("method or unknown property: ") + name);
                     return false; // Don't support methods (or non-existing properties ;)
+                }
 
                 if (data->revision != 0) {
                     if (qmlVerboseCompiler()) 
                         qWarning() << "*** versioned symbol:" << name;
-                    discard();
+                    discard(QLatin1String("versioned symbol: ") + name);
                     return false;
                 }
 
@@ -657,13 +712,16 @@ bool QDeclarativeV4IRBuilder::visit(AST::FieldMemberExpression *ast)
 
                     QDeclarativePropertyCache::Data *data = cache->property(name);
 
-                    if (!data || data->isFunction())
+                    if (!data || data->isFunction()) {
+                        discard(QLatin1String("method or unknown property: ") + name);
                         return false; // Don't support methods (or non-existing properties ;)
+                    }
 
                     if(!data->isFinal()) {
                         if (qmlVerboseCompiler())
                             qWarning() << "*** non-final property access:"
                                 << (baseName->id + QLatin1String(".") + ast->name->asString());
+                        discard(QLatin1String("non-final property: ") + name);
                         return false; // We don't know enough about this property
                     }
 
@@ -704,9 +762,35 @@ bool QDeclarativeV4IRBuilder::visit(AST::CallExpression *ast)
         const quint32 column = nameNodes.last()->firstSourceLocation().startColumn;
         IR::Expr *base = _block->NAME(id, line, column);
 
-        QVector<IR::Expr *> args;
+        QVector<ExprResult> results;
         for (AST::ArgumentList *it = ast->arguments; it; it = it->next)
-            args.append(expression(it->expression));
+            results.append(expression(it->expression));
+
+        if (base->asName()->builtin != IR::NoBuiltinSymbol) {
+            // Math.min() and Math.max() stay in ints when all of their arguments are ints,
+            // all other builtins take reals
+            const bool isMinMax = base->asName()->builtin == IR::MathMinBultinFunction ||
+                                  base->asName()->builtin == IR::MathMaxBultinFunction;
+            if (isMinMax && results.size() == 2) {
+                narrowLiteral(results[0], results.at(1));
+                narrowLiteral(results[1], results.at(0));
+            }
+
+            bool allInts = true;
+            for (int ii = 0; ii < results.size(); ++ii)
+                allInts &= results.at(ii).is(IR::IntType);
+
+            if (!(isMinMax && allInts)) {
+                for (int ii = 0; ii < results.size(); ++ii) {
+                    if (results.at(ii).isValid())
+                        implicitCvt(results[ii], IR::RealType);
+                }
+            }
+        }
+
+        QVector<IR::Expr *> args;
+        for (int ii = 0; ii < results.size(); ++ii)
+            args.append(results.at(ii));
 
         IR::Temp *r = _block->TEMP(IR::InvalidType);
         IR::Expr *call = _block->CALL(base, args);
@@ -907,7 +991,9 @@ bool QDeclarativeV4IRBuilder::visit(AST::BinaryExpression *ast)
         _block->MOVE(r, right);
 
         if (left.type() != right.type())
-            discard();
+            discard(QString(QLatin1String("logical or mixes %1 and %2"))
+                    .arg(QLatin1String(IR::typeName(left.type())))
+                    .arg(QLatin1String(IR::typeName(right.type()))));
 
         _expr.code = r;
 
@@ -920,8 +1006,12 @@ bool QDeclarativeV4IRBuilder::visit(AST::BinaryExpression *ast)
     case QSOperator::Ge: {
         ExprResult left = expression(ast->left);
         ExprResult right = expression(ast->right);
+        narrowLiteral(left, right);
+        narrowLiteral(right, left);
         if (left.type() == IR::StringType && right.type() == IR::StringType) {
             binop(ast, left, right);
+        } else if (left.type() == IR::IntType && right.type() == IR::IntType) {
+            binop(ast, left, right);
         } else if (left.isValid() && right.isValid()) {
             implicitCvt(left, IR::RealType);
             implicitCvt(right, IR::RealType);
@@ -933,6 +1023,8 @@ bool QDeclarativeV4IRBuilder::visit(AST::BinaryExpression *ast)
     case QSOperator::Equal: {
         ExprResult left = expression(ast->left);
         ExprResult right = expression(ast->right);
+        narrowLiteral(left, right);
+        narrowLiteral(right, left);
         if ((left.type() == IR::NullType || left.type() == IR::UndefinedType) &&
                 (right.type() == IR::NullType || right.type() == IR::UndefinedType)) {
             const bool isEq = ast->op == QSOperator::Equal;
@@ -948,8 +1040,13 @@ bool QDeclarativeV4IRBuilder::visit(AST::BinaryExpression *ast)
             implicitCvt(right, IR::RealType);
             binop(ast, left, right);
         } else if (left.type() == IR::BoolType || right.type() == IR::BoolType) {
-            implicitCvt(left, IR::BoolType);
-            implicitCvt(right, IR::BoolType);
+            if (left.isValid() && right.isValid() && left.type() >= IR::FirstNumberType
+                    && right.type() >= IR::FirstNumberType) {
+                // a boolean compares as the number 0 or 1
+                implicitCvt(left, IR::RealType);
+                implicitCvt(right, IR::RealType);
+                binop(ast, left, right);
+            }
         } else if (left.isValid() && right.isValid()) {
             binop(ast, left, right);
         }
@@ -959,6 +1056,8 @@ bool QDeclarativeV4IRBuilder::visit(AST::BinaryExpression *ast)
     case QSOperator::StrictNotEqual: {
         ExprResult left = expression(ast->left);
         ExprResult right = expression(ast->right);
+        narrowLiteral(left, right);
+        narrowLiteral(right, left);
         if (left.type() == right.type()) {
             binop(ast, left, right);
         } else if (left.type() >= IR::BoolType && right.type() >= IR::BoolType) {
@@ -1007,6 +1106,9 @@ bool QDeclarativeV4IRBuilder::visit(AST::BinaryExpression *ast)
         if (right.is(IR::InvalidType))
             return false;
 
+        narrowLiteral(left, right);
+        narrowLiteral(right, left);
+
         if (left.isPrimitive() && right.isPrimitive()) {
             if (left.type() == IR::StringType || right.type() == IR::StringType) {
                 implicitCvt(left, IR::StringType);
@@ -1028,10 +1130,27 @@ bool QDeclarativeV4IRBuilder::visit(AST::BinaryExpression *ast)
         if (right.is(IR::InvalidType))
             return false;
 
+        if (ast->op != QSOperator::Div) {
+            narrowLiteral(left, right);
+            narrowLiteral(right, left);
+        }
+
         IR::Type t = maxType(left.type(), right.type());
         if (t >= IR::FirstNumberType) {
-            implicitCvt(left, IR::RealType);
-            implicitCvt(right, IR::RealType);
+            // Sub and Mul read int operands directly.  Mod stays in ints only for a
+            // constant divisor, as x % 0 is NaN and INT_MIN % -1 overflows.
+            bool intOperands = left.type() == IR::IntType && right.type() == IR::IntType;
+            if (intOperands && ast->op == QSOperator::Mod) {
+                IR::Const *c = right->asConst();
+                intOperands = c && c->value != 0 && c->value != -1;
+            } else if (ast->op == QSOperator::Div) {
+                intOperands = false;
+            }
+
+            if (!intOperands) {
+                implicitCvt(left, IR::RealType);
+                implicitCvt(right, IR::RealType);
+            }
 
             IR::Expr *code = _block->BINOP(IR::binaryOperator(ast->op), left, right);
             _expr.code = _block->TEMP(code->type);
@@ -1082,7 +1201,19 @@ bool QDeclarativeV4IRBuilder::visit(AST::ConditionalExpression *ast)
     _block->JUMP(endif);
     qSwap(_block, iffalse);
 
-    r->type = maxType(ok.type(), ko.type());
+    IR::Type type = maxType(ok.type(), ko.type());
+    if (type == IR::InvalidType) {
+        // obj ? item : null
+        if ((ok.type() == IR::ObjectType && ko.type() == IR::NullType) ||
+            (ok.type() == IR::NullType && ko.type() == IR::ObjectType))
+            type = IR::ObjectType;
+        else if (ok.isValid() && ko.isValid())
+            discard(QString(QLatin1String("conditional expression mixes %1 and %2"))
+                    .arg(QLatin1String(IR::typeName(ok.type())))
+                    .arg(QLatin1String(IR::typeName(ko.type()))));
+    }
+
+    r->type = type;
     _expr.code = r;
 
     _block = endif;
@@ -57,6 +57,9 @@ public:
 
     QDeclarativeJS::IR::Function *operator()(QDeclarativeJS::IR::Module *, QDeclarativeJS::AST::Node *);
 
+    // Why the last expression could not be built, if it was discarded
+    QString discardReason() const { return _discardReason; }
+
 protected:
     struct ExprResult {
         enum Format {
@@ -114,6 +117,7 @@ protected:
     void binop(QDeclarativeJS::AST::BinaryExpression *ast, ExprResult left, ExprResult right);
 
     void implicitCvt(ExprResult &expr, QDeclarativeJS::IR::Type type);
+    void narrowLiteral(ExprResult &expr, const ExprResult &other);
 
     // QML
     virtual bool visit(QDeclarativeJS::AST::UiProgram *ast);
@@ -222,7 +226,7 @@ protected:
 private:
     bool buildName(QStringList &name, QDeclarativeJS::AST::Node *node, 
                    QList<QDeclarativeJS::AST::ExpressionNode *> *nodes);
-    void discard();
+    void discard(const QString &reason = QString());
 
     const QDeclarativeV4Compiler::Expression *m_expression;
     QDeclarativeEnginePrivate *m_engine;
@@ -231,6 +235,7 @@ private:
     QDeclarativeJS::IR::Function *_function;
     QDeclarativeJS::IR::BasicBlock *_block;
     bool _discard;
+    QString _discardReason;
 
     ExprResult _expr;
 };
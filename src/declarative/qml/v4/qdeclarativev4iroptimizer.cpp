@@ -0,0 +1,696 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the QtDeclarative module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qdeclarativev4iroptimizer_p.h"
+
+#include <QtCore/qmath.h>
+#include <QtCore/qnumeric.h>
+#include <math.h>
+#include <limits.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QDeclarativeJS;
+
+static inline bool isNumber(IR::Type type)
+{
+    return type == IR::BoolType || type == IR::IntType || type == IR::RealType;
+}
+
+// Temps of these types hold plain values that need no cleanup, so their
+// registers can be handed to another temp once they are dead
+static inline bool isShareable(IR::Type type)
+{
+    return isNumber(type) || type == IR::ObjectType;
+}
+
+// Int and Real constants are both JS numbers; only bool differs in strict
+// (in)equality
+static inline bool sameJSType(IR::Type a, IR::Type b)
+{
+    return (a == IR::BoolType) == (b == IR::BoolType);
+}
+
+static inline bool isTrue(double value)
+{
+    return value != 0 && !qIsNaN(value);
+}
+
+static inline bool isIntValue(double value)
+{
+    return value >= INT_MIN && value <= INT_MAX && value == ::floor(value);
+}
+
+static bool isPure(IR::Expr *e)
+{
+    if (e->asConst() || e->asString() || e->asTemp())
+        return true;
+    else if (IR::Unop *u = e->asUnop())
+        return isPure(u->expr);
+    else if (IR::Binop *b = e->asBinop())
+        return isPure(b->left) && isPure(b->right);
+    else if (IR::Call *c = e->asCall()) {
+        IR::Name *name = c->base->asName();
+        if (!name || name->builtin == IR::NoBuiltinSymbol)
+            return false;
+        foreach (IR::Expr *arg, c->args) {
+            if (!isPure(arg))
+                return false;
+        }
+        return true;
+    }
+
+    // Fetching a property can throw, and subscribes the binding to it
+    return false;
+}
+
+static void collectTemps(IR::Expr *e, QList<IR::Temp *> *temps)
+{
+    if (!e)
+        return;
+
+    if (IR::Temp *t = e->asTemp()) {
+        temps->append(t);
+    } else if (IR::Unop *u = e->asUnop()) {
+        collectTemps(u->expr, temps);
+    } else if (IR::Binop *b = e->asBinop()) {
+        collectTemps(b->left, temps);
+        collectTemps(b->right, temps);
+    } else if (IR::Call *c = e->asCall()) {
+        collectTemps(c->base, temps);
+        foreach (IR::Expr *arg, c->args)
+            collectTemps(arg, temps);
+    }
+}
+
+// The temps read by s
+static void collectUses(IR::Stmt *s, QList<IR::Temp *> *temps)
+{
+    if (IR::Move *m = s->asMove())
+        collectTemps(m->source, temps);
+    else if (IR::Exp *e = s->asExp())
+        collectTemps(e->expr, temps);
+    else if (IR::CJump *cj = s->asCJump())
+        collectTemps(cj->cond, temps);
+    else if (IR::Ret *r = s->asRet())
+        collectTemps(r->expr, temps);
+}
+
+QDeclarativeV4IROptimizer::QDeclarativeV4IROptimizer()
+: _function(0), _changed(false)
+{
+}
+
+void QDeclarativeV4IROptimizer::operator()(IR::Function *function)
+{
+    _function = function;
+
+    // Make fall through explicit, so that blocks can be dropped without changing the flow
+    for (int ii = 0; ii + 1 < _function->basicBlocks.size(); ++ii) {
+        IR::BasicBlock *block = _function->basicBlocks.at(ii);
+        if (!block->isTerminated())
+            block->JUMP(_function->basicBlocks.at(ii + 1));
+    }
+
+    // Every round can only remove statements or make expressions constant, so
+    // this converges quickly.  The bound is just a safety net.
+    for (int round = 0; round < 8; ++round) {
+        analyze();
+        bool changed = propagate();
+        removeUnreachableBlocks();
+        analyze();
+        changed |= removeDeadMoves();
+        if (!changed)
+            break;
+    }
+
+    allocateRegisters();
+
+    _temps.clear();
+    _replacements.clear();
+    _function = 0;
+}
+
+void QDeclarativeV4IROptimizer::analyze()
+{
+    _temps.clear();
+
+    foreach (IR::BasicBlock *block, _function->basicBlocks) {
+        foreach (IR::Stmt *s, block->statements) {
+            if (IR::Move *m = s->asMove()) {
+                TempInfo &info = _temps[m->target->asTemp()->index];
+                ++info.defs;
+                info.def = m;
+                countUses(m->source);
+            } else if (IR::Exp *e = s->asExp()) {
+                countUses(e->expr);
+            } else if (IR::CJump *cj = s->asCJump()) {
+                countUses(cj->cond);
+            } else if (IR::Ret *r = s->asRet()) {
+                countUses(r->expr);
+            }
+        }
+    }
+}
+
+void QDeclarativeV4IROptimizer::countUses(IR::Expr *e)
+{
+    QList<IR::Temp *> temps;
+    collectTemps(e, &temps);
+    foreach (IR::Temp *t, temps)
+        ++_temps[t->index].uses;
+}
+
+/*
+    Forwards constants and copies held in temps that are assigned exactly once,
+    and folds whatever becomes constant, including conditional jumps.
+*/
+bool QDeclarativeV4IROptimizer::propagate()
+{
+    _replacements.clear();
+    _changed = false;
+
+    for (QHash<int, TempInfo>::ConstIterator iter = _temps.begin(); iter != _temps.end(); ++iter) {
+        const TempInfo &info = iter.value();
+        if (info.defs != 1 || !info.uses)
+            continue;
+
+        IR::Temp *target = info.def->target->asTemp();
+        if (IR::Const *c = info.def->source->asConst()) {
+            if (IR::Const *value = convert(c, target->type))
+                _replacements.insert(iter.key(), value);
+        } else if (IR::Temp *source = info.def->source->asTemp()) {
+            // The code generator converts some operand registers in place, so only
+            // forward a copy if it is the only reader of its source and has a single
+            // reader itself: the source must not gain readers.
+            const TempInfo &sourceInfo = _temps.value(source->index);
+            if (source->type == target->type && info.uses == 1 && source->index != target->index
+                && sourceInfo.defs == 1 && sourceInfo.uses == 1)
+                _replacements.insert(iter.key(), source);
+        }
+    }
+
+    foreach (IR::BasicBlock *block, _function->basicBlocks) {
+        for (int ii = 0; ii < block->statements.size(); ++ii) {
+            IR::Stmt *s = block->statements.at(ii);
+            if (IR::Move *m = s->asMove()) {
+                m->source = rewrite(m->source);
+            } else if (IR::Exp *e = s->asExp()) {
+                e->expr = rewrite(e->expr);
+            } else if (IR::Ret *r = s->asRet()) {
+                r->expr = rewrite(r->expr);
+            } else if (IR::CJump *cj = s->asCJump()) {
+                cj->cond = rewrite(cj->cond);
+                if (IR::Const *c = cj->cond->asConst()) {
+                    block->statements[ii] = new IR::Jump(isTrue(c->value) ? cj->iftrue : cj->iffalse);
+                    delete cj;
+                    _changed = true;
+                }
+            }
+        }
+    }
+
+    return _changed;
+}
+
+IR::Expr *QDeclarativeV4IROptimizer::rewrite(IR::Expr *e)
+{
+    if (!e)
+        return e;
+
+    if (IR::Temp *t = e->asTemp()) {
+        IR::Expr *replacement = _replacements.value(t->index);
+        if (!replacement)
+            return e;
+
+        _changed = true;
+        if (IR::Const *c = replacement->asConst())
+            return constant(c->type, c->value);
+
+        IR::Temp *source = replacement->asTemp();
+        return rewrite(_function->e(new IR::Temp(source->type, source->index)));
+    } else if (IR::Unop *u = e->asUnop()) {
+        u->expr = rewrite(u->expr);
+        return fold(u);
+    } else if (IR::Binop *b = e->asBinop()) {
+        b->left = rewrite(b->left);
+        b->right = rewrite(b->right);
+        return fold(b);
+    } else if (IR::Call *c = e->asCall()) {
+        for (int ii = 0; ii < c->args.size(); ++ii)
+            c->args[ii] = rewrite(c->args.at(ii));
+        return fold(c);
+    }
+
+    return e;
+}
+
+IR::Expr *QDeclarativeV4IROptimizer::fold(IR::Unop *u)
+{
+    IR::Const *c = u->expr->asConst();
+    if (!c || !isNumber(c->type))
+        return u;
+
+    switch (u->op) {
+    case IR::OpIfTrue:
+        return constant(IR::BoolType, isTrue(c->value));
+    case IR::OpNot:
+        return constant(IR::BoolType, !isTrue(c->value));
+    case IR::OpUMinus:
+        if (u->type == IR::RealType)
+            return constant(IR::RealType, -c->value);
+        break;
+    case IR::OpUPlus:
+        if (u->type == IR::RealType)
+            return constant(IR::RealType, c->value);
+        break;
+    default:
+        break;
+    }
+
+    return u;
+}
+
+IR::Expr *QDeclarativeV4IROptimizer::fold(IR::Binop *b)
+{
+    IR::Const *l = b->left->asConst();
+    IR::Const *r = b->right->asConst();
+    if (!l || !r || !isNumber(l->type) || !isNumber(r->type))
+        return b;
+
+    const double x = l->value;
+    const double y = r->value;
+    const bool ints = l->type == IR::IntType && r->type == IR::IntType;
+
+    switch (b->op) {
+    case IR::OpAdd:
+        if (b->type == IR::RealType)
+            return constant(IR::RealType, x + y);
+        break;
+    case IR::OpSub:
+        if (b->type == IR::RealType)
+            return constant(IR::RealType, x - y);
+        break;
+    case IR::OpMul:
+        if (b->type == IR::RealType)
+            return constant(IR::RealType, x * y);
+        break;
+    case IR::OpDiv:
+        if (b->type == IR::RealType)
+            return constant(IR::RealType, x / y);
+        break;
+    case IR::OpMod:
+        if (b->type == IR::IntType && ints && y != 0 && y != -1)
+            return constant(IR::IntType, int(x) % int(y));
+        else if (b->type == IR::RealType)
+            return constant(IR::RealType, ::fmod(x, y));
+        break;
+
+    case IR::OpBitAnd:
+        if (ints) return constant(IR::IntType, int(x) & int(y));
+        break;
+    case IR::OpBitOr:
+        if (ints) return constant(IR::IntType, int(x) | int(y));
+        break;
+    case IR::OpBitXor:
+        if (ints) return constant(IR::IntType, int(x) ^ int(y));
+        break;
+    case IR::OpLShift:
+        if (ints) return constant(IR::IntType, int(x) << (int(y) & 0x1f));
+        break;
+    case IR::OpRShift:
+        if (ints) return constant(IR::IntType, int(x) >> (int(y) & 0x1f));
+        break;
+    case IR::OpURShift:
+        if (ints) return constant(IR::IntType, int(unsigned(int(x)) >> (int(y) & 0x1f)));
+        break;
+
+    case IR::OpGt:
+        return constant(IR::BoolType, x > y);
+    case IR::OpLt:
+        return constant(IR::BoolType, x < y);
+    case IR::OpGe:
+        return constant(IR::BoolType, x >= y);
+    case IR::OpLe:
+        return constant(IR::BoolType, x <= y);
+    case IR::OpEqual:
+        return constant(IR::BoolType, x == y);
+    case IR::OpNotEqual:
+        return constant(IR::BoolType, x != y);
+    case IR::OpStrictEqual:
+        return constant(IR::BoolType, sameJSType(l->type, r->type) && x == y);
+    case IR::OpStrictNotEqual:
+        return constant(IR::BoolType, !sameJSType(l->type, r->type) || x != y);
+
+    default:
+        break;
+    }
+
+    return b;
+}
+
+IR::Expr *QDeclarativeV4IROptimizer::fold(IR::Call *call)
+{
+    IR::Name *name = call->base->asName();
+    if (!name)
+        return call;
+
+    foreach (IR::Expr *arg, call->args) {
+        IR::Const *c = arg->asConst();
+        if (!c || !isNumber(c->type))
+            return call;
+    }
+
+    if (call->args.size() == 1) {
+        const double x = call->args.at(0)->asConst()->value;
+
+        switch (name->builtin) {
+        case IR::MathSinBultinFunction:
+            return constant(IR::RealType, qSin(x));
+        case IR::MathCosBultinFunction:
+            return constant(IR::RealType, qCos(x));
+        case IR::MathAbsBultinFunction:
+            return constant(IR::RealType, qAbs(x));
+        case IR::MathSqrtBultinFunction:
+            return constant(IR::RealType, qSqrt(x));
+        case IR::MathFloorBultinFunction:
+            if (isIntValue(::floor(x)))
+                return constant(IR::IntType, ::floor(x));
+            break;
+        case IR::MathCeilBultinFunction:
+            if (isIntValue(::ceil(x)))
+                return constant(IR::IntType, ::ceil(x));
+            break;
+        case IR::MathRoundBultinFunction:
+            if (qAbs(x) < 0x3fffffff)
+                return constant(IR::IntType, qRound(x));
+            break;
+        default:
+            break;
+        }
+    } else if (call->args.size() == 2 && (name->builtin == IR::MathMinBultinFunction ||
+                                           name->builtin == IR::MathMaxBultinFunction)) {
+        const double x = call->args.at(0)->asConst()->value;
+        const double y = call->args.at(1)->asConst()->value;
+
+        // Leave NaN and signed zero handling to the interpreter
+        if (!qIsNaN(x) && !qIsNaN(y) && !(x == 0 && y == 0)) {
+            const double v = (name->builtin == IR::MathMinBultinFunction) ? qMin(x, y) : qMax(x, y);
+            return constant(call->type, v);
+        }
+    }
+
+    return call;
+}
+
+IR::Const *QDeclarativeV4IROptimizer::convert(IR::Const *c, IR::Type type)
+{
+    if (c->type == type)
+        return c;
+    else if (!isNumber(c->type))
+        return 0;
+
+    switch (type) {
+    case IR::BoolType:
+        return constant(IR::BoolType, isTrue(c->value));
+    case IR::RealType:
+        return constant(IR::RealType, c->value);
+    case IR::IntType:
+        // Conversions that truncate or round are left to the interpreter
+        if (isIntValue(c->value))
+            return constant(IR::IntType, c->value);
+        return 0;
+    default:
+        return 0;
+    }
+}
+
+IR::Const *QDeclarativeV4IROptimizer::constant(IR::Type type, double value)
+{
+    _changed = true;
+    return _function->e(new IR::Const(type, value));
+}
+
+bool QDeclarativeV4IROptimizer::removeDeadMoves()
+{
+    bool changed = false;
+
+    foreach (IR::BasicBlock *block, _function->basicBlocks) {
+        for (int ii = block->statements.size() - 1; ii >= 0; --ii) {
+            IR::Move *m = block->statements.at(ii)->asMove();
+            if (!m || _temps.value(m->target->asTemp()->index).uses || !isPure(m->source))
+                continue;
+
+            delete m;
+            block->statements.remove(ii);
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+static void successors(IR::BasicBlock *block, QList<IR::BasicBlock *> *blocks)
+{
+    // A jump is not necessarily the last statement of a block
+    foreach (IR::Stmt *s, block->statements) {
+        if (IR::Jump *j = s->asJump()) {
+            blocks->append(j->target);
+        } else if (IR::CJump *cj = s->asCJump()) {
+            blocks->append(cj->iftrue);
+            blocks->append(cj->iffalse);
+        }
+    }
+}
+
+void QDeclarativeV4IROptimizer::removeUnreachableBlocks()
+{
+    QVector<IR::BasicBlock *> &blocks = _function->basicBlocks;
+    if (blocks.isEmpty())
+        return;
+
+    QSet<IR::BasicBlock *> reachable;
+    QList<IR::BasicBlock *> todo;
+    todo.append(blocks.first());
+    while (!todo.isEmpty()) {
+        IR::BasicBlock *block = todo.takeLast();
+        if (reachable.contains(block))
+            continue;
+        reachable.insert(block);
+        successors(block, &todo);
+    }
+
+    if (reachable.count() == blocks.count())
+        return;
+
+    QVector<IR::BasicBlock *> kept;
+    foreach (IR::BasicBlock *block, blocks) {
+        if (reachable.contains(block)) {
+            block->index = kept.count();
+            kept.append(block);
+        } else {
+            delete block;
+        }
+    }
+    blocks = kept;
+}
+
+/*
+    Extends the live range of temp \a index in \a ranges to include \a pos.  Blocks are
+    numbered in order but walked backwards, so positions arrive in no particular order.
+*/
+static inline void extendRange(QHash<int, QPair<int, int> > *ranges, int index, int pos)
+{
+    QHash<int, QPair<int, int> >::Iterator range = ranges->find(index);
+    if (range == ranges->end()) {
+        ranges->insert(index, qMakePair(pos, pos));
+    } else {
+        range->first = qMin(range->first, pos);
+        range->second = qMax(range->second, pos);
+    }
+}
+
+/*
+    Linear scan register allocation.  Liveness is computed over the control flow
+    graph, and every temp gets the interval between the first and the last
+    statement at which it is live.  A temp is live at the statement that defines
+    it, and at the statement that last reads it, so the code generator is free to
+    use the target register while it evaluates the operands.
+*/
+void QDeclarativeV4IROptimizer::allocateRegisters()
+{
+    const QVector<IR::BasicBlock *> &blocks = _function->basicBlocks;
+    const int blockCount = blocks.count();
+
+    QHash<IR::BasicBlock *, int> blockIndex;
+    QVector<int> blockStart(blockCount);
+    int position = 0;
+    for (int ii = 0; ii < blockCount; ++ii) {
+        blockIndex.insert(blocks.at(ii), ii);
+        blockStart[ii] = position;
+        position += blocks.at(ii)->statements.count();
+    }
+
+    // There are no loops in a binding, but iterate to a fix point anyway
+    QVector<QSet<int> > liveIn(blockCount);
+    for (bool changed = true; changed; ) {
+        changed = false;
+        for (int ii = blockCount - 1; ii >= 0; --ii) {
+            IR::BasicBlock *block = blocks.at(ii);
+            QSet<int> live;
+            for (int jj = block->statements.count() - 1; jj >= 0; --jj) {
+                IR::Stmt *s = block->statements.at(jj);
+                if (IR::Jump *j = s->asJump()) {
+                    live |= liveIn.at(blockIndex.value(j->target));
+                } else if (IR::CJump *cj = s->asCJump()) {
+                    live |= liveIn.at(blockIndex.value(cj->iftrue));
+                    live |= liveIn.at(blockIndex.value(cj->iffalse));
+                } else if (IR::Move *m = s->asMove()) {
+                    live.remove(m->target->asTemp()->index);
+                }
+
+                QList<IR::Temp *> uses;
+                collectUses(s, &uses);
+                foreach (IR::Temp *t, uses)
+                    live.insert(t->index);
+            }
+
+            if (live != liveIn.at(ii)) {
+                liveIn[ii] = live;
+                changed = true;
+            }
+        }
+    }
+
+    QHash<int, QPair<int, int> > ranges;
+    QHash<int, bool> shareable;
+    QSet<IR::Temp *> nodes;
+
+    for (int ii = 0; ii < blockCount; ++ii) {
+        IR::BasicBlock *block = blocks.at(ii);
+        QSet<int> live;
+        for (int jj = block->statements.count() - 1; jj >= 0; --jj) {
+            IR::Stmt *s = block->statements.at(jj);
+            const int pos = blockStart.at(ii) + jj;
+
+            if (IR::Jump *j = s->asJump()) {
+                live |= liveIn.at(blockIndex.value(j->target));
+            } else if (IR::CJump *cj = s->asCJump()) {
+                live |= liveIn.at(blockIndex.value(cj->iftrue));
+                live |= liveIn.at(blockIndex.value(cj->iffalse));
+            }
+
+            QList<IR::Temp *> temps;
+            if (IR::Move *m = s->asMove()) {
+                IR::Temp *target = m->target->asTemp();
+                temps.append(target);
+                live.insert(target->index);
+            }
+            foreach (int index, live)
+                extendRange(&ranges, index, pos);
+            if (IR::Move *m = s->asMove())
+                live.remove(m->target->asTemp()->index);
+
+            QList<IR::Temp *> uses;
+            collectUses(s, &uses);
+            foreach (IR::Temp *t, uses) {
+                extendRange(&ranges, t->index, pos);
+                live.insert(t->index);
+            }
+            temps += uses;
+
+            foreach (IR::Temp *t, temps) {
+                nodes.insert(t);
+                QHash<int, bool>::Iterator share = shareable.find(t->index);
+                if (share == shareable.end())
+                    shareable.insert(t->index, isShareable(t->type));
+                else
+                    *share = *share && isShareable(t->type);
+            }
+        }
+
+        // Temps that are live into the block are live from its first statement, even if
+        // the block does not mention them
+        foreach (int index, liveIn.at(ii))
+            extendRange(&ranges, index, blockStart.at(ii));
+    }
+
+    QList<QPair<int, int> > order;
+    for (QHash<int, QPair<int, int> >::ConstIterator iter = ranges.begin(); iter != ranges.end(); ++iter)
+        order.append(qMakePair(iter->first, iter.key()));
+    qSort(order);
+
+    QHash<int, int> registers;
+    QList<QPair<int, int> > active; // (end, register)
+    QList<int> freeRegisters;
+    int registerCount = 0;
+
+    for (int ii = 0; ii < order.count(); ++ii) {
+        const int index = order.at(ii).second;
+        const QPair<int, int> range = ranges.value(index);
+
+        for (int jj = 0; jj < active.count(); ) {
+            if (active.at(jj).first < range.first)
+                freeRegisters.append(active.takeAt(jj).second);
+            else
+                ++jj;
+        }
+
+        int reg;
+        const bool share = shareable.value(index);
+        if (share && !freeRegisters.isEmpty()) {
+            qSort(freeRegisters);
+            reg = freeRegisters.takeFirst();
+        } else {
+            reg = registerCount++;
+        }
+
+        registers.insert(index, reg);
+        if (share)
+            active.append(qMakePair(range.second, reg));
+    }
+
+    foreach (IR::Temp *t, nodes)
+        t->index = registers.value(t->index);
+    _function->tempCount = registerCount;
+}
+
+QT_END_NAMESPACE
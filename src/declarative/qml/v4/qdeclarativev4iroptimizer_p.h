@@ -0,0 +1,103 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the QtDeclarative module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QDECLARATIVEV4IROPTIMIZER_P_H
+#define QDECLARATIVEV4IROPTIMIZER_P_H
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qset.h>
+
+#include "qdeclarativev4ir_p.h"
+
+QT_BEGIN_HEADER
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Runs between the IR builder and the V4 code generator.
+
+    The builder produces a temp for every intermediate value and folds only
+    constants that are literally adjacent.  The optimizer propagates constants
+    and copies through temps, folds the resulting constant expressions and
+    branches, drops moves whose results are never read and finally renumbers
+    the temps so that values with disjoint lifetimes share a register.
+*/
+class QDeclarativeV4IROptimizer
+{
+public:
+    QDeclarativeV4IROptimizer();
+
+    void operator()(QDeclarativeJS::IR::Function *);
+
+private:
+    struct TempInfo {
+        TempInfo() : defs(0), uses(0), def(0) {}
+        int defs;
+        int uses;
+        QDeclarativeJS::IR::Move *def;
+    };
+
+    void analyze();
+    void countUses(QDeclarativeJS::IR::Expr *);
+    bool propagate();
+    bool removeDeadMoves();
+    void removeUnreachableBlocks();
+    void allocateRegisters();
+
+    QDeclarativeJS::IR::Expr *rewrite(QDeclarativeJS::IR::Expr *);
+    QDeclarativeJS::IR::Expr *fold(QDeclarativeJS::IR::Unop *);
+    QDeclarativeJS::IR::Expr *fold(QDeclarativeJS::IR::Binop *);
+    QDeclarativeJS::IR::Expr *fold(QDeclarativeJS::IR::Call *);
+    QDeclarativeJS::IR::Const *convert(QDeclarativeJS::IR::Const *, QDeclarativeJS::IR::Type);
+    QDeclarativeJS::IR::Const *constant(QDeclarativeJS::IR::Type, double);
+
+    QDeclarativeJS::IR::Function *_function;
+    QHash<int, TempInfo> _temps;
+    QHash<int, QDeclarativeJS::IR::Expr *> _replacements;
+    bool _changed;
+};
+
+QT_END_NAMESPACE
+
+QT_END_HEADER
+
+#endif // QDECLARATIVEV4IROPTIMIZER_P_H
@@ -243,7 +243,10 @@ int QV8Bindings::qt_metacall(QMetaObject::Call c, int id, void **)
 
     if (c == QMetaObject::InvokeMetaMethod) {
         QV8BindingsPrivate::Binding *binding = d->bindings + id;
-        binding->update(QDeclarativePropertyPrivate::DontRemoveBinding);
+        QDeclarativeEnginePrivate *ep =
+            QDeclarativeEnginePrivate::get(binding->QDeclarativeAbstractExpression::context());
+        if (!ep || !ep->scheduleBindingUpdate(binding))
+            binding->update(QDeclarativePropertyPrivate::DontRemoveBinding);
     }
     return -1;
 }
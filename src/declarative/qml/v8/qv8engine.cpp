@@ -1465,11 +1465,16 @@ v8::Handle<v8::Value> QV8Engine::createQmlObject(const v8::Arguments &args)
 }
 
 /*!
-\qmlmethod object Qt::createComponent(url)
+\qmlmethod object Qt::createComponent(url, mode)
 
 Returns a \l Component object created using the QML file at the specified \a url,
 or \c null if an empty string was given.
 
+If the optional \a mode parameter is set to \c Component.Asynchronous, the
+component is loaded and compiled on a background thread and the returned
+component's status is \c Component.Loading until it is ready.  The default,
+\c Component.PreferSynchronous, loads local files immediately.
+
 The returned component's \l Component::status property indicates whether the
 component was successfully created. If the status is \c Component.Error, 
 see \l Component::errorString() for an error description.
@@ -1488,7 +1493,7 @@ use \l{QML:Qt::createQmlObject()}{Qt.createQmlObject()}.
 */
 v8::Handle<v8::Value> QV8Engine::createComponent(const v8::Arguments &args)
 {
-    if (args.Length() != 1)
+    if (args.Length() < 1 || args.Length() > 2)
         V8THROW_ERROR("Qt.createComponent(): Invalid arguments");
 
     QV8Engine *v8engine = V8ENGINE();
@@ -1504,8 +1509,16 @@ v8::Handle<v8::Value> QV8Engine::createComponent(const v8::Arguments &args)
     if (arg.isEmpty())
         return v8::Null();
 
+    QDeclarativeComponent::CompilationMode compileMode = QDeclarativeComponent::PreferSynchronous;
+    if (args.Length() == 2) {
+        if (!args[1]->IsInt32())
+            V8THROW_ERROR("Qt.createComponent(): Invalid arguments");
+        if (args[1]->Int32Value() == QDeclarativeComponent::Asynchronous)
+            compileMode = QDeclarativeComponent::Asynchronous;
+    }
+
     QUrl url = context->resolvedUrl(QUrl(arg));
-    QDeclarativeComponent *c = new QDeclarativeComponent(engine, url, engine);
+    QDeclarativeComponent *c = new QDeclarativeComponent(engine, url, compileMode, engine);
     QDeclarativeComponentPrivate::get(c)->creationContext = effectiveContext;
     QDeclarativeData::get(c, true)->setImplicitDestructible();
     return v8engine->newQObject(c);
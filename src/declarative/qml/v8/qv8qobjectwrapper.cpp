@@ -736,6 +736,42 @@ FAST_VALUE_GETTER(UInt, uint, 0, v8::Integer::NewFromUnsigned);
 FAST_VALUE_GETTER(Float, float, 0, v8::Number::New);
 FAST_VALUE_GETTER(Double, double, 0, v8::Number::New);
 
+// Getter for all other property types (QUrl, QVariant, value types, lists, etc.).  The property
+// is found by index in the object's property cache rather than by name through the interceptor.
+#define FAST_GENERIC_GETTER(name, load) \
+static v8::Handle<v8::Value> name(v8::Local<v8::String>, const v8::AccessorInfo &info) \
+{ \
+    v8::Handle<v8::Object> This = info.This(); \
+    QV8QObjectResource *resource = v8_resource_check<QV8QObjectResource>(This); \
+ \
+    if (resource->object.isNull()) return v8::Undefined(); \
+ \
+    QObject *object = resource->object; \
+ \
+    uint32_t data = info.Data()->Uint32Value(); \
+    int index = data & 0x7FFF; \
+    int notify = (data & 0x0FFF0000) >> 16; \
+    if (notify == 0x0FFF) notify = -1; \
+ \
+    QDeclarativeData *ddata = QDeclarativeData::get(object, false); \
+    Q_ASSERT(ddata); \
+    Q_ASSERT(ddata->propertyCache); \
+ \
+    QDeclarativePropertyCache::Data *pdata = ddata->propertyCache->property(index); \
+    Q_ASSERT(pdata); \
+ \
+    QDeclarativeEnginePrivate *ep = resource->engine->engine()?QDeclarativeEnginePrivate::get(resource->engine->engine()):0; \
+    if (ep && notify /* 0 means constant */ && ep->captureProperties) { \
+        typedef QDeclarativeEnginePrivate::CapturedProperty CapturedProperty; \
+        ep->capturedProperties << CapturedProperty(object, index, notify); \
+    } \
+ \
+    return load(resource->engine, object, *pdata); \
+}
+
+FAST_GENERIC_GETTER(GenericValueGetter, LoadProperty);
+FAST_GENERIC_GETTER(GenericValueGetterDirect, LoadPropertyDirect);
+
 static void FastValueSetter(v8::Local<v8::String>, v8::Local<v8::Value> value,
                             const v8::AccessorInfo& info)
 {
@@ -818,19 +854,23 @@ v8::Local<v8::Object> QDeclarativePropertyCache::newQObject(QObject *object, QV8
         QString toString = QLatin1String("toString");
         QString destroy = QLatin1String("destroy");
 
-        // XXX TODO: Enables fast property accessors.  These more than double the property access 
-        // performance, but the  cost of setting up this structure hasn't been measured so 
-        // its not guarenteed that this is a win overall.  We need to try and measure the cost.
+        // Install every property as an accessor on the per-type template, so that reads and
+        // writes skip the interceptor's name lookup.  Revisioned properties are not installed,
+        // so that GetProperty() and SetProperty() stay the only places that decide whether
+        // they are visible in the imported version.
         for (StringCache::ConstIterator iter = stringCache.begin(); iter != stringCache.end(); ++iter) {
             Data *property = *iter;
             if (property->isFunction() || 
                 property->coreIndex >= 0x7FFF || property->notifyIndex >= 0x0FFF || 
-                property->coreIndex == 0)
+                property->coreIndex == 0 || property->revision != 0)
                 continue;
 
+            // The accessors are chosen by type, so the type must be known up front
+            if (property->notFullyResolved()) resolve(property);
+
             v8::AccessorGetter fastgetter = 0;
             v8::AccessorSetter fastsetter = FastValueSetter;
-            if (!property->isWritable())
+            if (!property->isWritable() && !property->isQList())
                 fastsetter = FastValueSetterReadOnly;
 
             if (property->isQObject()) 
@@ -847,6 +887,8 @@ v8::Local<v8::Object> QDeclarativePropertyCache::newQObject(QObject *object, QV8
                 fastgetter = property->isDirect()?FloatValueGetterDirect:FloatValueGetter;
             else if (property->propType == QMetaType::Double) 
                 fastgetter = property->isDirect()?DoubleValueGetterDirect:DoubleValueGetter;
+            else
+                fastgetter = property->isDirect()?GenericValueGetterDirect:GenericValueGetter;
 
             if (fastgetter) {
                 int notifyIndex = property->notifyIndex;
@@ -1347,7 +1389,7 @@ private:
 }
 
 static v8::Handle<v8::Value> CallMethod(QObject *object, int index, int returnType, int argCount, 
-                                        int *argTypes, QV8Engine *engine, CallArgs &callArgs)
+                                        const int *argTypes, QV8Engine *engine, CallArgs &callArgs)
 {
     if (argCount > 0) {
 
@@ -1385,34 +1427,13 @@ static v8::Handle<v8::Value> CallMethod(QObject *object, int index, int returnTy
     }
 }
 
-static int EnumType(const QMetaObject *meta, const QString &strname)
-{
-    QByteArray str = strname.toUtf8();
-    QByteArray scope;
-    QByteArray name;
-    int scopeIdx = str.lastIndexOf("::");
-    if (scopeIdx != -1) {
-        scope = str.left(scopeIdx);
-        name = str.mid(scopeIdx + 2);
-    } else { 
-        name = str;
-    }
-    for (int i = meta->enumeratorCount() - 1; i >= 0; --i) {
-        QMetaEnum m = meta->enumerator(i);
-        if ((m.name() == name) && (scope.isEmpty() || (m.scope() == scope)))
-            return QVariant::Int;
-    }
-    return QVariant::Invalid;
-}
-
 /*!
     Returns the match score for converting \a actual to be of type \a conversionType.  A 
     zero score means "perfect match" whereas a higher score is worse.
 
     The conversion table is copied out of the QtScript callQtMethod() function.
 */
-static int MatchScore(v8::Handle<v8::Value> actual, int conversionType, 
-                      const QByteArray &conversionTypeName)
+static int MatchScore(v8::Handle<v8::Value> actual, int conversionType)
 {
     if (actual->IsNumber()) {
         switch (conversionType) {
@@ -1484,12 +1505,15 @@ static int MatchScore(v8::Handle<v8::Value> actual, int conversionType,
         case QMetaType::VoidStar:
         case QMetaType::QObjectStar:
             return 0;
-        default:
-            if (!conversionTypeName.endsWith('*'))
+        default: {
+            const char *conversionTypeName = QMetaType::typeName(conversionType);
+            int length = conversionTypeName ? qstrlen(conversionTypeName) : 0;
+            if (length == 0 || conversionTypeName[length - 1] != '*')
                 return 10;
             else
                 return 0;
         }
+        }
     } else if (actual->IsObject()) {
         v8::Handle<v8::Object> obj = v8::Handle<v8::Object>::Cast(actual);
 
@@ -1517,6 +1541,67 @@ static int MatchScore(v8::Handle<v8::Value> actual, int conversionType,
     }
 }
 
+enum ArgumentKind {
+    NumberArgument = 1,
+    StringArgument,
+    BooleanArgument,
+    DateArgument,
+    RegExpArgument,
+    ArrayArgument,
+    NullArgument,
+    QObjectArgument,
+    OtherArgument
+};
+
+/*!
+Encodes the number of arguments in \a callArgs, and the kind of value passed for each of them,
+into \a signature.  MatchScore() only looks at the kind of each argument, so the overload
+chosen for one call can be reused for any later call with the same signature.
+
+Returns false if the call cannot be encoded, either because it has too many arguments or
+because one of the arguments is a variant whose score depends on its contents.
+*/
+static bool ArgumentSignature(CallArgs &callArgs, quint32 *signature)
+{
+    int argumentCount = callArgs.Length();
+    if (argumentCount > 7)
+        return false;
+
+    quint32 rv = argumentCount;
+    for (int ii = 0; ii < argumentCount; ++ii) {
+        v8::Local<v8::Value> actual = callArgs[ii];
+
+        quint32 kind = OtherArgument;
+        if (actual->IsNumber()) {
+            kind = NumberArgument;
+        } else if (actual->IsString()) {
+            kind = StringArgument;
+        } else if (actual->IsBoolean()) {
+            kind = BooleanArgument;
+        } else if (actual->IsDate()) {
+            kind = DateArgument;
+        } else if (actual->IsRegExp()) {
+            kind = RegExpArgument;
+        } else if (actual->IsArray()) {
+            kind = ArrayArgument;
+        } else if (actual->IsNull()) {
+            kind = NullArgument;
+        } else if (actual->IsObject()) {
+            v8::Handle<v8::Object> obj = v8::Handle<v8::Object>::Cast(actual);
+            QV8ObjectResource *r = static_cast<QV8ObjectResource *>(obj->GetExternalResource());
+            if (r && r->resourceType() == QV8ObjectResource::QObjectType)
+                kind = QObjectArgument;
+            else if (r && r->resourceType() == QV8ObjectResource::VariantType)
+                return false;
+        }
+
+        rv |= kind << (4 + 4 * ii);
+    }
+
+    *signature = rv;
+    return true;
+}
+
 static inline int QMetaObject_methods(const QMetaObject *metaObject)
 {
     struct Private
@@ -1583,20 +1668,12 @@ static v8::Handle<v8::Value> CallPrecise(QObject *object, const QDeclarativeProp
 {
     if (data.hasArguments()) {
 
-        QMetaMethod m = object->metaObject()->method(data.coreIndex);
-        QList<QByteArray> argTypeNames = m.parameterTypes();
-        QVarLengthArray<int, 9> argTypes(argTypeNames.count());
-
-        // ### Cache
-        for (int ii = 0; ii < argTypeNames.count(); ++ii) {
-            argTypes[ii] = QMetaType::type(argTypeNames.at(ii));
-            if (argTypes[ii] == QVariant::Invalid) 
-                argTypes[ii] = EnumType(object->metaObject(), QString::fromLatin1(argTypeNames.at(ii)));
-            if (argTypes[ii] == QVariant::Invalid) {
-                QString error = QString::fromLatin1("Unknown method parameter type: %1").arg(QLatin1String(argTypeNames.at(ii)));
-                v8::ThrowException(v8::Exception::Error(engine->toString(error)));
-                return v8::Handle<v8::Value>();
-            }
+        QVector<int> argTypes;
+        QByteArray unknownTypeName;
+        if (!QDeclarativePropertyCache::methodParameterTypes(object, data.coreIndex, &argTypes, &unknownTypeName)) {
+            QString error = QString::fromLatin1("Unknown method parameter type: %1").arg(QLatin1String(unknownTypeName));
+            v8::ThrowException(v8::Exception::Error(engine->toString(error)));
+            return v8::Handle<v8::Value>();
         }
 
         if (argTypes.count() > callArgs.Length()) {
@@ -1606,7 +1683,7 @@ static v8::Handle<v8::Value> CallPrecise(QObject *object, const QDeclarativeProp
         }
 
         return CallMethod(object, data.coreIndex, data.propType, argTypes.count(), 
-                          argTypes.data(), engine, callArgs);
+                          argTypes.constData(), engine, callArgs);
 
     } else {
 
@@ -1627,10 +1704,24 @@ Resolve the overloaded method to call.  The algorithm works conceptually like th
     3.  Find the best remaining overload based on its match score.  
         If two or more overloads have the same match score, call the last one.  The match
         score is constructed by adding the matchScore() result for each of the parameters.
+
+The chosen overload is remembered in the object's property cache against the signature of
+the arguments, so later calls with the same kinds of arguments skip straight to it.
 */
 static v8::Handle<v8::Value> CallOverloaded(QObject *object, const QDeclarativePropertyCache::Data &data, 
                                             QV8Engine *engine, CallArgs &callArgs)
 {
+    QDeclarativeData *ddata = QDeclarativeData::get(object, false);
+    QDeclarativePropertyCache *cache = ddata ? ddata->propertyCache : 0;
+
+    quint32 signature = 0;
+    bool cacheable = cache && ArgumentSignature(callArgs, &signature);
+    if (cacheable) {
+        int overloadIndex = cache->cachedOverload(data.coreIndex, signature);
+        if (overloadIndex != -1)
+            return CallPrecise(object, *cache->method(overloadIndex), engine, callArgs);
+    }
+
     int argumentCount = callArgs.Length();
 
     const QDeclarativePropertyCache::Data *best = 0;
@@ -1641,12 +1732,13 @@ static v8::Handle<v8::Value> CallOverloaded(QObject *object, const QDeclarativeP
     const QDeclarativePropertyCache::Data *attempt = &data;
 
     do {
-        QList<QByteArray> methodArgTypeNames;
+        QVector<int> methodArgTypes;
 
-        if (attempt->hasArguments())
-            methodArgTypeNames = object->metaObject()->method(attempt->coreIndex).parameterTypes();
+        if (attempt->hasArguments() && 
+            !QDeclarativePropertyCache::methodParameterTypes(object, attempt->coreIndex, &methodArgTypes))
+            continue; // We don't understand all the parameters
 
-        int methodArgumentCount = methodArgTypeNames.count();
+        int methodArgumentCount = methodArgTypes.count();
 
         if (methodArgumentCount > argumentCount)
             continue; // We don't have sufficient arguments to call this method
@@ -1656,22 +1748,8 @@ static v8::Handle<v8::Value> CallOverloaded(QObject *object, const QDeclarativeP
             continue; // We already have a better option
 
         int methodMatchScore = 0;
-        QVarLengthArray<int, 9> methodArgTypes(methodArgumentCount);
-
-        bool unknownArgument = false;
-        for (int ii = 0; ii < methodArgumentCount; ++ii) {
-            methodArgTypes[ii] = QMetaType::type(methodArgTypeNames.at(ii));
-            if (methodArgTypes[ii] == QVariant::Invalid) 
-                methodArgTypes[ii] = EnumType(object->metaObject(), 
-                                              QString::fromLatin1(methodArgTypeNames.at(ii)));
-            if (methodArgTypes[ii] == QVariant::Invalid) {
-                unknownArgument = true;
-                break;
-            }
-            methodMatchScore += MatchScore(callArgs[ii], methodArgTypes[ii], methodArgTypeNames.at(ii));
-        }
-        if (unknownArgument)
-            continue; // We don't understand all the parameters
+        for (int ii = 0; ii < methodArgumentCount; ++ii)
+            methodMatchScore += MatchScore(callArgs[ii], methodArgTypes.at(ii));
 
         if (bestParameterScore > methodParameterScore || bestMatchScore > methodMatchScore) {
             best = attempt;
@@ -1685,6 +1763,8 @@ static v8::Handle<v8::Value> CallOverloaded(QObject *object, const QDeclarativeP
     } while((attempt = RelatedMethod(object, attempt, dummy)) != 0);
 
     if (best) {
+        if (cacheable)
+            cache->cacheOverload(data.coreIndex, signature, best->coreIndex);
         return CallPrecise(object, *best, engine, callArgs);
     } else {
         QString error = QLatin1String("Unable to determine callable overload.  Candidates are:");
@@ -1897,33 +1977,45 @@ void MetaCallArgument::fromValue(int callType, QV8Engine *engine, v8::Handle<v8:
 {
     if (type != 0) { cleanup(); type = 0; }
 
-    if (callType == qMetaTypeId<QJSValue>()) {
-        qjsValuePtr = new (&allocData) QJSValue(QJSValuePrivate::get(new QJSValuePrivate(engine, value)));
-        type = qMetaTypeId<QJSValue>();
-    } else if (callType == QMetaType::Int) {
+    // Convert the common builtin types without first comparing against the type ids of
+    // the dynamically registered types below
+    switch (callType) {
+    case QMetaType::Int:
         intValue = quint32(value->Int32Value());
         type = callType;
-    } else if (callType == QMetaType::UInt) {
-        intValue = quint32(value->Uint32Value());
-        type = callType;
-    } else if (callType == QMetaType::Bool) {
-        boolValue = value->BooleanValue();
-        type = callType;
-    } else if (callType == QMetaType::Double) {
+        return;
+    case QMetaType::Double:
         doubleValue = double(value->NumberValue());
         type = callType;
-    } else if (callType == QMetaType::Float) {
-        floatValue = float(value->NumberValue());
+        return;
+    case QMetaType::Bool:
+        boolValue = value->BooleanValue();
         type = callType;
-    } else if (callType == QMetaType::QString) {
+        return;
+    case QMetaType::QString:
         if (value->IsNull() || value->IsUndefined())
             qstringPtr = new (&allocData) QString();
         else
             qstringPtr = new (&allocData) QString(engine->toString(value->ToString()));
         type = callType;
-    } else if (callType == QMetaType::QObjectStar) {
+        return;
+    case QMetaType::QObjectStar:
         qobjectPtr = engine->toQObject(value);
         type = callType;
+        return;
+    default:
+        break;
+    }
+
+    if (callType == qMetaTypeId<QJSValue>()) {
+        qjsValuePtr = new (&allocData) QJSValue(QJSValuePrivate::get(new QJSValuePrivate(engine, value)));
+        type = qMetaTypeId<QJSValue>();
+    } else if (callType == QMetaType::UInt) {
+        intValue = quint32(value->Uint32Value());
+        type = callType;
+    } else if (callType == QMetaType::Float) {
+        floatValue = float(value->NumberValue());
+        type = callType;
     } else if (callType == qMetaTypeId<QVariant>()) {
         qvariantPtr = new (&allocData) QVariant(engine->toVariant(value, -1));
         type = callType;
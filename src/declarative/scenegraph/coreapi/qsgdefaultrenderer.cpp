@@ -112,6 +112,102 @@ static bool nodeLessThanWithRenderOrder(QSGGeometryNode *a, QSGGeometryNode *b)
 }
 
 
+// Larger geometries are not worth copying into a batch; they are drawn on their own
+static const int maximumBatchedNodeVertexCount = 1024;
+// Batches use 16-bit indices
+static const int maximumBatchVertexCount = 0xffff;
+
+static inline bool isAffine(const QMatrix4x4 *m)
+{
+    return !m || ((*m)(3, 0) == 0 && (*m)(3, 1) == 0 && (*m)(3, 2) == 0 && (*m)(3, 3) == 1);
+}
+
+static bool isBatchable(QSGGeometryNode *node)
+{
+    if (!(node->activeMaterial()->flags() & QSGMaterial::CanBeBatched))
+        return false;
+
+    const QSGGeometry *g = node->geometry();
+    if (g->drawingMode() != GL_TRIANGLES && g->drawingMode() != GL_TRIANGLE_STRIP)
+        return false;
+    if (g->vertexCount() == 0 || g->vertexCount() > maximumBatchedNodeVertexCount)
+        return false;
+
+    const QSGGeometry::Attribute &position = g->attributes()[0];
+    if (position.position != 0 || position.tupleSize != 2 || position.type != GL_FLOAT)
+        return false;
+
+    return isAffine(node->matrix());
+}
+
+static bool canBatch(QSGGeometryNode *a, QSGGeometryNode *b)
+{
+    if (a->clipList() != b->clipList() || a->inheritedOpacity() != b->inheritedOpacity())
+        return false;
+    if (a->geometry()->attributes() != b->geometry()->attributes())
+        return false;
+
+    QSGMaterial *aMaterial = a->activeMaterial();
+    QSGMaterial *bMaterial = b->activeMaterial();
+    return aMaterial->type() == bMaterial->type() && aMaterial->compare(bMaterial) == 0
+        && isBatchable(b);
+}
+
+// Number of indices \a g takes up in a batch, where everything is drawn as GL_TRIANGLES
+static inline int batchIndexCount(const QSGGeometry *g)
+{
+    int count = g->indexCount() ? g->indexCount() : g->vertexCount();
+    if (g->drawingMode() == GL_TRIANGLE_STRIP)
+        count = qMax(0, count - 2) * 3;
+    return count;
+}
+
+static inline int sourceIndex(const QSGGeometry *g, int i)
+{
+    if (!g->indexCount())
+        return i;
+    if (g->indexType() == GL_UNSIGNED_INT)
+        return g->indexDataAsUInt()[i];
+    return g->indexDataAsUShort()[i];
+}
+
+// Render orders are spaced out, so that nodes added later can be given render orders
+// between those of their neighbours without renumbering the whole tree.
+static const int renderOrderStride = 8;
+
+// The render orders are mapped to depth; beyond this they would no longer map to
+// distinct values in a 24-bit depth buffer.
+static const int maximumRenderOrder = 1 << 22;
+
+static bool nodeLessThanRenderOrder(QSGGeometryNode *a, QSGGeometryNode *b)
+{
+    return a->renderOrder() < b->renderOrder();
+}
+
+static inline bool isOpaque(QSGGeometryNode *node)
+{
+#ifdef FORCE_NO_REORDER
+    Q_UNUSED(node);
+    return false;
+#else
+    return !(node->activeMaterial()->flags() & QSGMaterial::Blending) && node->inheritedOpacity() >= 1;
+#endif
+}
+
+static bool removeNode(QDataBuffer<QSGGeometryNode *> &list, QSGGeometryNode *node)
+{
+    for (int i = list.size() - 1; i >= 0; --i) {
+        if (list.at(i) == node) {
+            int tail = list.size() - i - 1;
+            if (tail)
+                memmove(&list.at(i), &list.at(i + 1), tail * sizeof(QSGGeometryNode *));
+            list.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
 IndexGeometryNodePair::IndexGeometryNodePair(int i, QSGGeometryNode *node)
     : QPair<int, QSGGeometryNode *>(i, node)
 {
@@ -164,8 +260,10 @@ QSGDefaultRenderer::QSGDefaultRenderer(QSGContext *context)
     , m_transparentNodes(64)
     , m_tempNodes(64)
     , m_rebuild_lists(false)
+    , m_lists_changed(false)
     , m_needs_sorting(false)
     , m_sort_front_to_back(false)
+    , m_batch_geometry(false)
     , m_currentRenderOrder(1)
 {
     QStringList args = qApp->arguments();
@@ -175,18 +273,37 @@ QSGDefaultRenderer::QSGDefaultRenderer(QSGContext *context)
 #endif
 }
 
+QSGDefaultRenderer::~QSGDefaultRenderer()
+{
+    clearBatches();
+}
+
 void QSGDefaultRenderer::nodeChanged(QSGNode *node, QSGNode::DirtyFlags flags)
 {
     QSGRenderer::nodeChanged(node, flags);
 
-    quint32 rebuildFlags = QSGNode::DirtyNodeAdded | QSGNode::DirtyNodeRemoved
-                         | QSGNode::DirtyMaterial | QSGNode::DirtyOpacity
-                         | QSGNode::DirtyForceUpdate;
+    if (m_batch_geometry) {
+        if (flags & QSGNode::DirtyNodeAdded)
+            addDirtyGeometry(node);
+        else if ((flags & QSGNode::DirtyGeometry) && node->type() == QSGNode::GeometryNodeType)
+            m_dirtyGeometryNodes.insert(static_cast<QSGGeometryNode *>(node));
+    }
 
-    if (flags & rebuildFlags)
+    // Nodes being added, removed or changing material are dealt with incrementally,
+    // anything else that changes which list a node belongs to rebuilds the lists.
+    if ((flags & (QSGNode::DirtyOpacity | QSGNode::DirtyForceUpdate)) || node == rootNode()) {
         m_rebuild_lists = true;
+        m_needs_sorting = true;
+    } else if (!m_rebuild_lists) {
+        if (flags & QSGNode::DirtyNodeRemoved)
+            removeGeometryNodes(node);
+        if (flags & QSGNode::DirtyNodeAdded)
+            m_addedSubtrees.insert(node);
+        if ((flags & QSGNode::DirtyMaterial) && node->type() == QSGNode::GeometryNodeType)
+            m_materialChangedNodes.insert(static_cast<QSGGeometryNode *>(node));
+    }
 
-    if (flags & (rebuildFlags | QSGNode::DirtyClipList))
+    if (flags & QSGNode::DirtyClipList)
         m_needs_sorting = true;
 }
 
@@ -247,14 +364,27 @@ void QSGDefaultRenderer::render()
     m_currentProgram = 0;
     m_currentMatrix = 0;
 
+    QElapsedTimer phaseTimer;
+    phaseTimer.start();
+
+    if (!m_rebuild_lists && (!m_addedSubtrees.isEmpty() || !m_materialChangedNodes.isEmpty()))
+        updateLists();
+
+    bool repartition = m_rebuild_lists || m_needs_sorting || m_lists_changed;
+    m_lists_changed = false;
+
     if (m_rebuild_lists) {
         m_opaqueNodes.reset();
         m_transparentNodes.reset();
+        m_addedSubtrees.clear();
+        m_materialChangedNodes.clear();
         m_currentRenderOrder = 1;
         buildLists(rootNode());
         m_rebuild_lists = false;
     }
 
+    m_statistics.buildListsTime = phaseTimer.nsecsElapsed();
+
 #ifdef RENDERER_DEBUG
     int debugtimeLists = debugTimer.elapsed();
 #endif
@@ -270,6 +400,17 @@ void QSGDefaultRenderer::render()
         m_needs_sorting = false;
     }
 
+    if (m_batch_geometry) {
+        updateBatches(m_opaqueNodes, m_opaqueBatches, repartition);
+        updateBatches(m_transparentNodes, m_transparentBatches, repartition);
+        m_dirtyGeometryNodes.clear();
+    } else if (!m_opaqueBatches.isEmpty() || !m_transparentBatches.isEmpty()) {
+        clearBatches();
+    }
+
+    // Includes the batch updates, as those depend on the sorted order
+    m_statistics.sortTime = phaseTimer.nsecsElapsed() - m_statistics.buildListsTime;
+
 #ifdef RENDERER_DEBUG
     int debugtimeSorting = debugTimer.elapsed();
 #endif
@@ -287,7 +428,7 @@ void QSGDefaultRenderer::render()
         if (dumpTree)
             qDebug() << "Opaque Nodes:";
 #endif
-        renderNodes(m_opaqueNodes);
+        renderNodes(m_opaqueNodes, m_opaqueBatches);
     }
 
 #ifdef RENDERER_DEBUG
@@ -306,7 +447,7 @@ void QSGDefaultRenderer::render()
         if (dumpTree)
             qDebug() << "Alpha Nodes:";
 #endif
-        renderNodes(m_transparentNodes);
+        renderNodes(m_transparentNodes, m_transparentBatches);
     }
 
 #ifdef RENDERER_DEBUG
@@ -347,6 +488,25 @@ bool QSGDefaultRenderer::isSortFrontToBackEnabled() const
     return m_sort_front_to_back;
 }
 
+/*!
+    When geometry batching is enabled, consecutive nodes in the render lists that
+    share clip, opacity and material state, and whose material has the
+    QSGMaterial::CanBeBatched flag set, are merged into a single draw call.
+
+    Their vertices are transformed on the CPU and kept in vertex and index buffer
+    objects across frames. Only the ranges of nodes with dirty geometry or a changed
+    matrix are uploaded again.
+ */
+void QSGDefaultRenderer::setGeometryBatchingEnabled(bool batching)
+{
+    m_batch_geometry = batching;
+}
+
+bool QSGDefaultRenderer::isGeometryBatchingEnabled() const
+{
+    return m_batch_geometry;
+}
+
 void QSGDefaultRenderer::buildLists(QSGNode *node)
 {
     if (node->isSubtreeBlocked())
@@ -354,21 +514,12 @@ void QSGDefaultRenderer::buildLists(QSGNode *node)
 
     if (node->type() == QSGNode::GeometryNodeType) {
         QSGGeometryNode *geomNode = static_cast<QSGGeometryNode *>(node);
-        qreal opacity = geomNode->inheritedOpacity();
-        QSGMaterial *m = geomNode->activeMaterial();
-
-#ifdef FORCE_NO_REORDER
-        if (true) {
-#else
-        if ((m->flags() & QSGMaterial::Blending) || opacity < 1) {
-#endif
-            geomNode->setRenderOrder(m_currentRenderOrder - 1);
+        geomNode->setRenderOrder(m_currentRenderOrder);
+        m_currentRenderOrder += renderOrderStride;
+        if (!isOpaque(geomNode))
             m_transparentNodes.add(geomNode);
-        } else {
-            geomNode->setRenderOrder(m_currentRenderOrder);
+        else
             m_opaqueNodes.add(geomNode);
-            m_currentRenderOrder += 2;
-        }
     }
 
     if (!node->firstChild())
@@ -420,7 +571,262 @@ void QSGDefaultRenderer::buildLists(QSGNode *node)
     }
 }
 
-void QSGDefaultRenderer::renderNodes(const QDataBuffer<QSGGeometryNode *> &list)
+// Whether \a node is below a node whose children buildLists() may reorder by material
+// in the transparent list, which then is not in render order
+static bool isReorderedByMaterial(QSGNode *node, QSGNode *root)
+{
+    for (node = node->parent(); node; node = node == root ? 0 : node->parent()) {
+        if ((node->flags() & QSGNode::ChildrenDoNotOverlap) && node->firstChild() != node->lastChild())
+            return true;
+    }
+    return false;
+}
+
+/*!
+    Brings the render lists up to date with the nodes added and the materials changed
+    since the last frame, without walking the whole tree or sorting the opaque list
+    again. If that is not possible, the lists are marked to be rebuilt.
+
+    Added opaque nodes and those that changed material are inserted into the sorted
+    opaque list with a binary search.
+ */
+void QSGDefaultRenderer::updateLists()
+{
+    if (!m_addedSubtrees.isEmpty()) {
+        bool inserted = insertAddedSubtrees();
+        m_addedSubtrees.clear();
+        if (!inserted) {
+            m_rebuild_lists = true;
+            return;
+        }
+
+        // The opaque list is sorted by render order too when sorting front to back
+        if (m_sort_front_to_back)
+            m_needs_sorting = true;
+    }
+
+    QSGNode *root = rootNode();
+    for (QSet<QSGGeometryNode *>::const_iterator it = m_materialChangedNodes.constBegin();
+         it != m_materialChangedNodes.constEnd(); ++it) {
+        QSGGeometryNode *node = *it;
+        bool opaque = isOpaque(node);
+        if (removeNode(m_opaqueNodes, node)) {
+            if (opaque) {
+                insertOpaqueNode(node);
+            } else if (isReorderedByMaterial(node, root)) {
+                m_rebuild_lists = true;
+                break;
+            } else {
+                insertTransparentNode(node);
+            }
+        } else if (opaque && removeNode(m_transparentNodes, node)) {
+            insertOpaqueNode(node);
+        }
+    }
+    m_materialChangedNodes.clear();
+
+    m_lists_changed = true;
+}
+
+// The last node in the subtree at \a node, in tree order, that is in the render lists
+static QSGGeometryNode *lastListedNode(QSGNode *node)
+{
+    if (node->isSubtreeBlocked())
+        return 0;
+    for (QSGNode *c = node->lastChild(); c; c = c->previousSibling()) {
+        if (QSGGeometryNode *geomNode = lastListedNode(c))
+            return geomNode;
+    }
+    if (node->type() == QSGNode::GeometryNodeType && static_cast<QSGGeometryNode *>(node)->renderOrder() >= 0)
+        return static_cast<QSGGeometryNode *>(node);
+    return 0;
+}
+
+// The first node in the subtree at \a node, in tree order, that is in the render lists
+static QSGGeometryNode *firstListedNode(QSGNode *node)
+{
+    if (node->isSubtreeBlocked())
+        return 0;
+    if (node->type() == QSGNode::GeometryNodeType && static_cast<QSGGeometryNode *>(node)->renderOrder() >= 0)
+        return static_cast<QSGGeometryNode *>(node);
+    for (QSGNode *c = node->firstChild(); c; c = c->nextSibling()) {
+        if (QSGGeometryNode *geomNode = firstListedNode(c))
+            return geomNode;
+    }
+    return 0;
+}
+
+// The listed nodes that precede and follow the subtree at \a node in tree order
+static QSGGeometryNode *previousListedNode(QSGNode *node, QSGNode *root)
+{
+    for (; node != root; node = node->parent()) {
+        for (QSGNode *s = node->previousSibling(); s; s = s->previousSibling()) {
+            if (QSGGeometryNode *geomNode = lastListedNode(s))
+                return geomNode;
+        }
+        QSGNode *parent = node->parent();
+        if (parent->type() == QSGNode::GeometryNodeType && static_cast<QSGGeometryNode *>(parent)->renderOrder() >= 0)
+            return static_cast<QSGGeometryNode *>(parent);
+    }
+    return 0;
+}
+
+static QSGGeometryNode *nextListedNode(QSGNode *node, QSGNode *root)
+{
+    for (; node != root; node = node->parent()) {
+        for (QSGNode *s = node->nextSibling(); s; s = s->nextSibling()) {
+            if (QSGGeometryNode *geomNode = firstListedNode(s))
+                return geomNode;
+        }
+    }
+    return 0;
+}
+
+/*!
+    Inserts the geometry nodes of the subtrees added since the last frame into the
+    render lists, and gives them render orders between those of their neighbours in
+    the tree. Render orders are spaced out by buildLists() to leave room for this.
+
+    Returns false if the lists have to be rebuilt instead: when there is no room left
+    between the neighbours' render orders, or when an added node is below a node
+    whose children are reordered by material in the transparent list.
+ */
+bool QSGDefaultRenderer::insertAddedSubtrees()
+{
+    QSGNode *root = rootNode();
+
+    // Only the outermost added subtrees that are still in the tree are inserted. Their
+    // nodes may have been in the lists before, so all render orders are cleared first;
+    // nodes that are not inserted yet are then told apart by their invalid render order.
+    QVarLengthArray<QSGNode *, 16> subtrees;
+    for (QSet<QSGNode *>::const_iterator it = m_addedSubtrees.constBegin();
+         it != m_addedSubtrees.constEnd(); ++it) {
+        QSGNode *subtree = *it;
+        bool blocked = false;
+        QSGNode *n = subtree;
+        while (n && n != root) {
+            if (n != subtree && m_addedSubtrees.contains(n))
+                break;
+            blocked = blocked || n->isSubtreeBlocked();
+            n = n->parent();
+        }
+        if (n != root)
+            continue;
+        if (isReorderedByMaterial(subtree, root))
+            return false;
+
+        m_tempNodes.reset();
+        if (!collectAddedNodes(subtree, blocked))
+            return false;
+        if (!m_tempNodes.isEmpty())
+            subtrees.append(subtree);
+    }
+
+    for (int i = 0; i < subtrees.size(); ++i) {
+        QSGNode *subtree = subtrees.at(i);
+
+        m_tempNodes.reset();
+        collectAddedNodes(subtree, false);
+        int count = m_tempNodes.size();
+
+        QSGGeometryNode *previous = previousListedNode(subtree, root);
+        QSGGeometryNode *next = nextListedNode(subtree, root);
+        int first = previous ? previous->renderOrder() : 0;
+        int step = renderOrderStride;
+        if (next) {
+            step = (next->renderOrder() - first) / (count + 1);
+            if (step < 1)
+                return false;
+        } else {
+            if (first + (count + 1) * step > maximumRenderOrder)
+                return false;
+            m_currentRenderOrder = qMax(m_currentRenderOrder, first + (count + 1) * step);
+        }
+
+        for (int j = 0; j < count; ++j) {
+            QSGGeometryNode *node = m_tempNodes.at(j);
+            node->setRenderOrder(first + (j + 1) * step);
+            if (isOpaque(node))
+                insertOpaqueNode(node);
+            else
+                insertTransparentNode(node);
+            m_materialChangedNodes.remove(node);
+        }
+    }
+
+    return true;
+}
+
+/*!
+    Clears the render order of the geometry nodes in the subtree at \a node. Unless
+    the subtree is \a blocked, the nodes that are rendered are appended to m_tempNodes
+    in tree order.
+
+    Returns false if the subtree contains a node whose children are reordered by
+    material in the transparent list.
+ */
+bool QSGDefaultRenderer::collectAddedNodes(QSGNode *node, bool blocked)
+{
+    blocked = blocked || node->isSubtreeBlocked();
+    if (node->type() == QSGNode::GeometryNodeType) {
+        QSGGeometryNode *geomNode = static_cast<QSGGeometryNode *>(node);
+        geomNode->setRenderOrder(-1);
+        if (!blocked)
+            m_tempNodes.add(geomNode);
+    }
+    if ((node->flags() & QSGNode::ChildrenDoNotOverlap) && node->firstChild() != node->lastChild())
+        return false;
+    for (QSGNode *c = node->firstChild(); c; c = c->nextSibling()) {
+        if (!collectAddedNodes(c, blocked))
+            return false;
+    }
+    return true;
+}
+
+void QSGDefaultRenderer::removeGeometryNodes(QSGNode *node)
+{
+    m_addedSubtrees.remove(node);
+    if (node->type() == QSGNode::GeometryNodeType) {
+        QSGGeometryNode *geomNode = static_cast<QSGGeometryNode *>(node);
+        if (!removeNode(m_transparentNodes, geomNode))
+            removeNode(m_opaqueNodes, geomNode);
+        m_materialChangedNodes.remove(geomNode);
+        m_lists_changed = true;
+    }
+    for (QSGNode *c = node->firstChild(); c; c = c->nextSibling())
+        removeGeometryNodes(c);
+}
+
+void QSGDefaultRenderer::insertOpaqueNode(QSGGeometryNode *node)
+{
+    m_opaqueNodes.add(node);
+    if (m_needs_sorting || m_opaqueNodes.size() == 1)
+        return;
+
+    QSGGeometryNode **begin = &m_opaqueNodes.first();
+    QSGGeometryNode **end = begin + m_opaqueNodes.size() - 1;
+    QSGGeometryNode **pos = qUpperBound(begin, end, node,
+                                        m_sort_front_to_back
+                                        ? nodeLessThanWithRenderOrder
+                                        : nodeLessThan);
+    memmove(pos + 1, pos, (end - pos) * sizeof(QSGGeometryNode *));
+    *pos = node;
+}
+
+void QSGDefaultRenderer::insertTransparentNode(QSGGeometryNode *node)
+{
+    m_transparentNodes.add(node);
+    if (m_transparentNodes.size() == 1)
+        return;
+
+    QSGGeometryNode **begin = &m_transparentNodes.first();
+    QSGGeometryNode **end = begin + m_transparentNodes.size() - 1;
+    QSGGeometryNode **pos = qUpperBound(begin, end, node, nodeLessThanRenderOrder);
+    memmove(pos + 1, pos, (end - pos) * sizeof(QSGGeometryNode *));
+    *pos = node;
+}
+
+void QSGDefaultRenderer::renderNodes(const QDataBuffer<QSGGeometryNode *> &list, const QVector<QSGGeometryBatch *> &batches)
 {
     const float scale = 1.0f / m_currentRenderOrder;
     int count = list.size();
@@ -434,6 +840,12 @@ void QSGDefaultRenderer::renderNodes(const QDataBuffer<QSGGeometryNode *> &list)
     for (int i = 0; i < count; ++i) {
         QSGGeometryNode *geomNode = list.at(i);
 
+        // A batch is drawn with the state of its first node; its vertices are already
+        // transformed and carry their render order as z.
+        QSGGeometryBatch *batch = i < batches.size() ? batches.at(i) : 0;
+        const QMatrix4x4 *matrix = batch ? 0 : geomNode->matrix();
+        int renderOrder = batch ? 0 : geomNode->renderOrder();
+
         QSGMaterialShader::RenderState::DirtyStates updates;
 
 #if defined (QML_RUNTIME_TESTING)
@@ -442,10 +854,10 @@ void QSGDefaultRenderer::renderNodes(const QDataBuffer<QSGGeometryNode *> &list)
             qDebug() << geomNode;
 #endif
 
-        bool changeMatrix = m_currentMatrix != geomNode->matrix();
+        bool changeMatrix = m_currentMatrix != matrix;
 
         if (changeMatrix) {
-            m_currentMatrix = geomNode->matrix();
+            m_currentMatrix = matrix;
             if (m_currentMatrix)
                 m_current_model_view_matrix = *m_currentMatrix;
             else
@@ -486,15 +898,16 @@ void QSGDefaultRenderer::renderNodes(const QDataBuffer<QSGGeometryNode *> &list)
             m_currentProgram->activate();
             //++programChangeCount;
             updates |= (QSGMaterialShader::RenderState::DirtyMatrix | QSGMaterialShader::RenderState::DirtyOpacity);
+            ++m_statistics.materialChanges;
 
 #ifdef RENDERER_DEBUG
             materialChanges++;
 #endif
         }
 
-        bool changeRenderOrder = currentRenderOrder != geomNode->renderOrder();
+        bool changeRenderOrder = currentRenderOrder != renderOrder;
         if (changeRenderOrder) {
-            currentRenderOrder = geomNode->renderOrder();
+            currentRenderOrder = renderOrder;
             m_current_projection_matrix.setColumn(3, projectionMatrix().column(3)
                                                   + currentRenderOrder
                                                   * m_current_projection_matrix.column(2));
@@ -509,6 +922,16 @@ void QSGDefaultRenderer::renderNodes(const QDataBuffer<QSGGeometryNode *> &list)
 
         //glDepthRange((geomNode->renderOrder() + 0.1) * scale, (geomNode->renderOrder() + 0.9) * scale);
 
+        if (batch) {
+            bindBatch(program, batch);
+            drawBatch(batch);
+            i += batch->entries.size() - 1;
+#ifdef RENDERER_DEBUG
+            geometryNodesDrawn += batch->entries.size();
+#endif
+            continue;
+        }
+
         const QSGGeometry *g = geomNode->geometry();
         bindGeometry(program, g);
         draw(geomNode);
@@ -522,4 +945,314 @@ void QSGDefaultRenderer::renderNodes(const QDataBuffer<QSGGeometryNode *> &list)
     //    &list == &m_transparentNodes ? "transparent" : "opaque");
 }
 
+void QSGDefaultRenderer::addDirtyGeometry(QSGNode *node)
+{
+    if (node->type() == QSGNode::GeometryNodeType)
+        m_dirtyGeometryNodes.insert(static_cast<QSGGeometryNode *>(node));
+    for (QSGNode *c = node->firstChild(); c; c = c->nextSibling())
+        addDirtyGeometry(c);
+}
+
+/*!
+    Brings \a batches up to date with \a list. If \a repartition is false, the list
+    is the same as in the previous frame and only the contents of the existing
+    batches are updated. Otherwise the list is split into batches again, reusing
+    existing batches that cover the same sequence of nodes.
+ */
+void QSGDefaultRenderer::updateBatches(const QDataBuffer<QSGGeometryNode *> &list, QVector<QSGGeometryBatch *> &batches, bool repartition)
+{
+    int count = list.size();
+    if (batches.size() != count)
+        repartition = true;
+
+    if (!repartition) {
+        for (int i = 0; i < count; ++i) {
+            if (batches.at(i) && !updateBatch(batches.at(i))) {
+                repartition = true;
+                break;
+            }
+        }
+        if (!repartition)
+            return;
+    }
+
+    QHash<QSGGeometryNode *, QSGGeometryBatch *> oldBatches;
+    for (int i = 0; i < batches.size(); ++i) {
+        if (QSGGeometryBatch *batch = batches.at(i))
+            oldBatches.insert(batch->entries.first().node, batch);
+    }
+    batches.fill(0, count);
+
+    int i = 0;
+    while (i < count) {
+        QSGGeometryNode *first = list.at(i);
+        int end = i + 1;
+        if (isBatchable(first)) {
+            int vertexCount = first->geometry()->vertexCount();
+            while (end < count && canBatch(first, list.at(end))
+                   && vertexCount + list.at(end)->geometry()->vertexCount() <= maximumBatchVertexCount) {
+                vertexCount += list.at(end)->geometry()->vertexCount();
+                ++end;
+            }
+        }
+
+        if (end - i > 1) {
+            // Nodes that were deleted since the old batch was built cannot match, as
+            // the list only holds live nodes; their addresses may have been reused by
+            // new nodes, but those are in m_dirtyGeometryNodes.
+            QSGGeometryBatch *batch = oldBatches.take(first);
+            bool reuse = batch && batch->entries.size() == end - i;
+            for (int j = 0; reuse && j < end - i; ++j)
+                reuse = batch->entries.at(j).node == list.at(i + j);
+
+            if (reuse && !updateBatch(batch))
+                reuse = false;
+            if (!reuse) {
+                if (!batch)
+                    batch = new QSGGeometryBatch;
+                batch->entries.resize(end - i);
+                for (int j = 0; j < end - i; ++j)
+                    batch->entries[j].node = list.at(i + j);
+                if (!fillBatch(batch)) {
+                    deleteBatch(batch);
+                    batch = 0;
+                }
+            }
+            batches[i] = batch;
+        }
+        i = end;
+    }
+
+    for (QHash<QSGGeometryNode *, QSGGeometryBatch *>::const_iterator it = oldBatches.constBegin();
+         it != oldBatches.constEnd(); ++it) {
+        deleteBatch(it.value());
+    }
+}
+
+/*!
+    Uploads the vertices of the nodes in \a batch whose geometry or matrix changed.
+    Returns false if the nodes can no longer be drawn as one batch.
+ */
+bool QSGDefaultRenderer::updateBatch(QSGGeometryBatch *batch)
+{
+    int vertexBegin = batch->entries.size();
+    int vertexEnd = -1;
+    int indexBegin = batch->entries.size();
+    int indexEnd = -1;
+
+    for (int i = 0; i < batch->entries.size(); ++i) {
+        QSGGeometryBatch::Entry &entry = batch->entries[i];
+        QSGGeometryNode *node = entry.node;
+        const QSGGeometry *g = node->geometry();
+        if (g->attributes() != batch->attributes || !isBatchable(node))
+            return false;
+
+        bool geometryChanged = g != entry.geometry || m_dirtyGeometryNodes.contains(node);
+        const QMatrix4x4 *matrix = node->matrix();
+        bool matrixChanged = (matrix ? *matrix : QMatrix4x4()) != entry.matrix
+                             || node->renderOrder() != entry.renderOrder;
+        if (!geometryChanged && !matrixChanged)
+            continue;
+
+        if (g->vertexCount() != entry.vertexCount || batchIndexCount(g) != entry.indexCount)
+            return fillBatch(batch);
+
+        entry.geometry = g;
+        entry.matrix = matrix ? *matrix : QMatrix4x4();
+        entry.renderOrder = node->renderOrder();
+        writeBatchEntry(batch, entry, geometryChanged);
+
+        vertexBegin = qMin(vertexBegin, i);
+        vertexEnd = i;
+        if (geometryChanged) {
+            indexBegin = qMin(indexBegin, i);
+            indexEnd = i;
+        }
+    }
+
+    if (vertexEnd >= 0) {
+        const QSGGeometryBatch::Entry &begin = batch->entries.at(vertexBegin);
+        const QSGGeometryBatch::Entry &end = batch->entries.at(vertexEnd);
+        int offset = begin.vertexOffset * batch->stride;
+        int size = (end.vertexOffset + end.vertexCount) * batch->stride - offset;
+        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer);
+        glBufferSubData(GL_ARRAY_BUFFER, offset, size, batch->vertexData.constData() + offset);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        m_statistics.uploadedBytes += size;
+    }
+
+    if (indexEnd >= 0) {
+        const QSGGeometryBatch::Entry &begin = batch->entries.at(indexBegin);
+        const QSGGeometryBatch::Entry &end = batch->entries.at(indexEnd);
+        int offset = begin.indexOffset * sizeof(quint16);
+        int size = (end.indexOffset + end.indexCount) * sizeof(quint16) - offset;
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->indexBuffer);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, size, batch->indexData.constData() + begin.indexOffset);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        m_statistics.uploadedBytes += size;
+    }
+
+    return true;
+}
+
+/*!
+    Lays out and uploads all nodes in \a batch. Returns false if they do not fit in
+    one batch.
+ */
+bool QSGDefaultRenderer::fillBatch(QSGGeometryBatch *batch)
+{
+    int vertexCount = 0;
+    int indexCount = 0;
+    for (int i = 0; i < batch->entries.size(); ++i) {
+        QSGGeometryBatch::Entry &entry = batch->entries[i];
+        const QSGGeometry *g = entry.node->geometry();
+        const QMatrix4x4 *matrix = entry.node->matrix();
+        entry.geometry = g;
+        entry.matrix = matrix ? *matrix : QMatrix4x4();
+        entry.renderOrder = entry.node->renderOrder();
+        entry.vertexOffset = vertexCount;
+        entry.vertexCount = g->vertexCount();
+        entry.indexOffset = indexCount;
+        entry.indexCount = batchIndexCount(g);
+        vertexCount += entry.vertexCount;
+        indexCount += entry.indexCount;
+    }
+    if (vertexCount > maximumBatchVertexCount)
+        return false;
+
+    const QSGGeometry *g = batch->entries.first().geometry;
+    batch->attributes = g->attributes();
+    batch->stride = g->stride() + sizeof(float);
+    batch->vertexData.resize(vertexCount * batch->stride);
+    batch->indexData.resize(indexCount);
+    for (int i = 0; i < batch->entries.size(); ++i)
+        writeBatchEntry(batch, batch->entries.at(i), true);
+
+    if (!batch->vertexBuffer) {
+        glGenBuffers(1, &batch->vertexBuffer);
+        glGenBuffers(1, &batch->indexBuffer);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, batch->vertexData.size(), batch->vertexData.constData(), GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->indexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(quint16), batch->indexData.constData(), GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    m_statistics.uploadedBytes += batch->vertexData.size() + indexCount * sizeof(quint16);
+
+    return true;
+}
+
+/*!
+    Writes the vertices of \a entry to the client side copy of \a batch, and its
+    indices if \a indices is true.
+
+    The positions are transformed by the node's matrix and get the node's render order
+    added to z, which gives the same depth as drawing the node on its own.
+ */
+void QSGDefaultRenderer::writeBatchEntry(QSGGeometryBatch *batch, const QSGGeometryBatch::Entry &entry, bool indices)
+{
+    const QSGGeometry *g = entry.geometry;
+    const qreal *m = entry.matrix.constData();
+    const int sourceStride = g->stride();
+    const int attributeBytes = sourceStride - 2 * sizeof(float);
+    const char *src = static_cast<const char *>(g->vertexData());
+    char *dst = batch->vertexData.data() + entry.vertexOffset * batch->stride;
+
+    for (int i = 0; i < entry.vertexCount; ++i) {
+        const float *p = reinterpret_cast<const float *>(src);
+        float *v = reinterpret_cast<float *>(dst);
+        qreal x = p[0];
+        qreal y = p[1];
+        v[0] = m[0] * x + m[4] * y + m[12];
+        v[1] = m[1] * x + m[5] * y + m[13];
+        v[2] = m[2] * x + m[6] * y + m[14] + entry.renderOrder;
+        qMemCopy(dst + 3 * sizeof(float), src + 2 * sizeof(float), attributeBytes);
+        src += sourceStride;
+        dst += batch->stride;
+    }
+
+    if (!indices)
+        return;
+
+    quint16 *out = batch->indexData.data() + entry.indexOffset;
+    const int base = entry.vertexOffset;
+    if (g->drawingMode() == GL_TRIANGLES) {
+        for (int i = 0; i < entry.indexCount; ++i)
+            out[i] = base + sourceIndex(g, i);
+    } else {
+        // Unroll the strip, keeping degenerate triangles so the count stays fixed
+        for (int i = 0; i < entry.indexCount / 3; ++i) {
+            int a = sourceIndex(g, i);
+            int b = sourceIndex(g, i + 1);
+            if (i & 1)
+                qSwap(a, b);
+            *out++ = base + a;
+            *out++ = base + b;
+            *out++ = base + sourceIndex(g, i + 2);
+        }
+    }
+}
+
+void QSGDefaultRenderer::bindBatch(QSGMaterialShader *material, const QSGGeometryBatch *batch)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->indexBuffer);
+
+    char const *const *attrNames = material->attributeNames();
+    int offset = 0;
+    for (int j = 0; attrNames[j]; ++j) {
+        const QSGGeometry::Attribute &a = batch->attributes[j];
+        if (*attrNames[j]) {
+            if (j == 0) {
+                glVertexAttribPointer(0, 3, GL_FLOAT, false, batch->stride, 0);
+            } else {
+#if defined(QT_OPENGL_ES_2)
+                GLboolean normalize = a.type != GL_FLOAT;
+#else
+                GLboolean normalize = a.type != GL_FLOAT && a.type != GL_DOUBLE;
+#endif
+                glVertexAttribPointer(a.position, a.tupleSize, a.type, normalize, batch->stride,
+                                      (char *) 0 + offset + sizeof(float));
+            }
+        }
+        offset += a.tupleSize * qt_size_of_gl_type(a.type);
+    }
+}
+
+void QSGDefaultRenderer::drawBatch(const QSGGeometryBatch *batch)
+{
+    glDrawElements(GL_TRIANGLES, batch->indexData.size(), GL_UNSIGNED_SHORT, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    ++m_statistics.drawCalls;
+    ++m_statistics.batches;
+    m_statistics.geometryNodes += batch->entries.size();
+}
+
+void QSGDefaultRenderer::deleteBatch(QSGGeometryBatch *batch)
+{
+    if (batch->vertexBuffer) {
+        glDeleteBuffers(1, &batch->vertexBuffer);
+        glDeleteBuffers(1, &batch->indexBuffer);
+    }
+    delete batch;
+}
+
+void QSGDefaultRenderer::clearBatches()
+{
+    for (int i = 0; i < m_opaqueBatches.size(); ++i) {
+        if (m_opaqueBatches.at(i))
+            deleteBatch(m_opaqueBatches.at(i));
+    }
+    for (int i = 0; i < m_transparentBatches.size(); ++i) {
+        if (m_transparentBatches.at(i))
+            deleteBatch(m_transparentBatches.at(i));
+    }
+    m_opaqueBatches.clear();
+    m_transparentBatches.clear();
+    m_dirtyGeometryNodes.clear();
+}
+
 QT_END_NAMESPACE
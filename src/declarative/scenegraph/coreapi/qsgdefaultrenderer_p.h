@@ -45,6 +45,8 @@
 #include "qsgrenderer_p.h"
 
 #include <QtGui/private/qdatabuffer_p.h>
+#include <QtCore/qset.h>
+#include <QtCore/qvector.h>
 
 QT_BEGIN_HEADER
 
@@ -77,11 +79,41 @@ private:
 };
 
 
-class QSGDefaultRenderer : public QSGRenderer
+// Geometry of several nodes with the same material state, merged into
+// retained vertex and index buffers so that it can be drawn in one call.
+class QSGGeometryBatch
+{
+public:
+    struct Entry
+    {
+        QSGGeometryNode *node;
+        const QSGGeometry *geometry;
+        QMatrix4x4 matrix;
+        int renderOrder;
+        int vertexOffset;
+        int vertexCount;
+        int indexOffset;
+        int indexCount;
+    };
+
+    QSGGeometryBatch() : attributes(0), stride(0), vertexBuffer(0), indexBuffer(0) { }
+
+    QVector<Entry> entries;
+    const QSGGeometry::Attribute *attributes;
+    int stride;
+    QByteArray vertexData;
+    QVector<quint16> indexData;
+    GLuint vertexBuffer;
+    GLuint indexBuffer;
+};
+
+
+class Q_DECLARATIVE_EXPORT QSGDefaultRenderer : public QSGRenderer
 {
     Q_OBJECT
 public:
     QSGDefaultRenderer(QSGContext *context);
+    ~QSGDefaultRenderer();
 
     void render();
 
@@ -90,9 +122,28 @@ public:
     void setSortFrontToBackEnabled(bool sort);
     bool isSortFrontToBackEnabled() const;
 
+    void setGeometryBatchingEnabled(bool batching);
+    bool isGeometryBatchingEnabled() const;
+
 private:
     void buildLists(QSGNode *node);
-    void renderNodes(const QDataBuffer<QSGGeometryNode *> &list);
+    void updateLists();
+    bool insertAddedSubtrees();
+    bool collectAddedNodes(QSGNode *node, bool blocked);
+    void removeGeometryNodes(QSGNode *node);
+    void insertOpaqueNode(QSGGeometryNode *node);
+    void insertTransparentNode(QSGGeometryNode *node);
+    void renderNodes(const QDataBuffer<QSGGeometryNode *> &list, const QVector<QSGGeometryBatch *> &batches);
+
+    void addDirtyGeometry(QSGNode *node);
+    void updateBatches(const QDataBuffer<QSGGeometryNode *> &list, QVector<QSGGeometryBatch *> &batches, bool repartition);
+    bool updateBatch(QSGGeometryBatch *batch);
+    bool fillBatch(QSGGeometryBatch *batch);
+    void writeBatchEntry(QSGGeometryBatch *batch, const QSGGeometryBatch::Entry &entry, bool indices);
+    void bindBatch(QSGMaterialShader *material, const QSGGeometryBatch *batch);
+    void drawBatch(const QSGGeometryBatch *batch);
+    void deleteBatch(QSGGeometryBatch *batch);
+    void clearBatches();
 
     const QSGClipNode *m_currentClip;
     QSGMaterial *m_currentMaterial;
@@ -104,9 +155,18 @@ private:
     QDataBuffer<QSGGeometryNode *> m_tempNodes;
     IndexGeometryNodePairHeap m_heap;
 
+    QVector<QSGGeometryBatch *> m_opaqueBatches;
+    QVector<QSGGeometryBatch *> m_transparentBatches;
+    QSet<QSGGeometryNode *> m_dirtyGeometryNodes;
+
+    QSet<QSGNode *> m_addedSubtrees;
+    QSet<QSGGeometryNode *> m_materialChangedNodes;
+
     bool m_rebuild_lists;
+    bool m_lists_changed;
     bool m_needs_sorting;
     bool m_sort_front_to_back;
+    bool m_batch_geometry;
     int m_currentRenderOrder;
 
 #ifdef QML_RUNTIME_TESTING
@@ -471,6 +471,14 @@ QSGMaterial::~QSGMaterial()
 
     \value Blending Set this flag to true if the material requires GL_BLEND to be
     enabled during rendering.
+
+    \value CanBeBatched Set this flag to true if the material's shader only uses
+    the vertex positions together with the combined matrix, so that the renderer
+    may transform the vertices of several geometry nodes on the CPU and draw them
+    in one call. The geometry must have its position as two floats in attribute 0.
+    The flag is not inherited from the convenience materials, such as
+    QSGFlatColorMaterial; the nodes that own them set it, and a subclass with its
+    own shader or uniforms has to opt in itself.
  */
 
 
@@ -114,7 +114,8 @@ class Q_DECLARATIVE_EXPORT QSGMaterial
 {
 public:
     enum Flag {
-        Blending = 0x0001
+        Blending = 0x0001,
+        CanBeBatched = 0x0002
     };
     Q_DECLARE_FLAGS(Flags, Flag)
 
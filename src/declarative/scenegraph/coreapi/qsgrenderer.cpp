@@ -51,6 +51,7 @@
 #include <QtGui/qapplication.h>
 
 #include <qdatetime.h>
+#include <qelapsedtimer.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -114,6 +115,9 @@ void QSGBindableFbo::bind() const
     The renderer can make use of stencil, depth and color buffers in addition to the
     scissor rect.
 
+    The number of draw calls and the amount of vertex data sent to the GL during the
+    last frame are available through statistics().
+
     \internal
  */
 
@@ -217,6 +221,7 @@ void QSGRenderer::renderScene(const QSGBindable &bindable)
         return;
 
     m_is_rendering = true;
+    m_statistics = Statistics();
 #ifdef QSG_RENDERER_TIMING
     frameTimer.start();
 #endif
@@ -244,7 +249,10 @@ void QSGRenderer::renderScene(const QSGBindable &bindable)
     }
 #endif
 
+    QElapsedTimer renderTimer;
+    renderTimer.start();
     render();
+    m_statistics.renderTime = renderTimer.nsecsElapsed();
 #ifdef QSG_RENDERER_TIMING
     int renderTime = frameTimer.elapsed();
 #endif
@@ -326,6 +334,9 @@ void QSGRenderer::preprocess()
 {
     Q_ASSERT(m_root_node);
 
+    QElapsedTimer timer;
+    timer.start();
+
     // We need to take a copy here, in case any of the preprocess calls deletes a node that
     // is in the preprocess list and thus, changes the m_nodes_to_preprocess behind our backs
     // For the default case, when this does not happen, the cost is neglishible.
@@ -339,12 +350,14 @@ void QSGRenderer::preprocess()
         }
     }
 
+    m_statistics.preprocessTime = timer.nsecsElapsed();
 #ifdef QSG_RENDERER_TIMING
     preprocessTime = frameTimer.elapsed();
 #endif
 
     nodeUpdater()->setToplevelOpacity(context()->renderAlpha());
     nodeUpdater()->updateStates(m_root_node);
+    m_statistics.updateTime = timer.nsecsElapsed() - m_statistics.preprocessTime;
 
 #ifdef QSG_RENDERER_TIMING
     updatePassTime = frameTimer.elapsed();
@@ -505,7 +518,14 @@ QSGRenderer::ClipType QSGRenderer::updateStencilClip(const QSGClipNode *clip)
 void QSGRenderer::draw(const QSGBasicGeometryNode *node)
 {
     const QSGGeometry *g = node->geometry();
+
+    // Client side arrays are transferred to the GL on every draw
+    ++m_statistics.drawCalls;
+    ++m_statistics.geometryNodes;
+    m_statistics.uploadedBytes += g->vertexCount() * g->stride();
+
     if (g->indexCount()) {
+        m_statistics.uploadedBytes += g->indexCount() * (g->indexType() == GL_UNSIGNED_INT ? sizeof(GLuint) : sizeof(GLushort));
         glDrawElements(g->drawingMode(), g->indexCount(), g->indexType(), g->indexData());
     } else {
         glDrawArrays(g->drawingMode(), 0, g->vertexCount());
@@ -513,24 +533,6 @@ void QSGRenderer::draw(const QSGBasicGeometryNode *node)
 }
 
 
-static inline int size_of_type(GLenum type)
-{
-    static int sizes[] = {
-        sizeof(char),
-        sizeof(unsigned char),
-        sizeof(short),
-        sizeof(unsigned short),
-        sizeof(int),
-        sizeof(unsigned int),
-        sizeof(float),
-        2,
-        3,
-        4,
-        sizeof(double)
-    };
-    return sizes[type - GL_BYTE];
-}
-
 /*!
     Convenience function to set up and bind the vertex data in \a g to the
     required attribute positions defined in \a material.
@@ -554,7 +556,7 @@ void QSGRenderer::bindGeometry(QSGMaterialShader *material, const QSGGeometry *g
         GLboolean normalize = a.type != GL_FLOAT && a.type != GL_DOUBLE;
 #endif
         glVertexAttribPointer(a.position, a.tupleSize, a.type, normalize, g->stride(), (char *) g->vertexData() + offset);
-        offset += a.tupleSize * size_of_type(a.type);
+        offset += a.tupleSize * qt_size_of_gl_type(a.type);
     }
 }
 
@@ -87,6 +87,28 @@ public:
     };
     Q_DECLARE_FLAGS(ClearMode, ClearModeBit)
 
+    struct Statistics
+    {
+        Statistics()
+            : drawCalls(0), geometryNodes(0), batches(0), materialChanges(0), uploadedBytes(0)
+            , preprocessTime(0), updateTime(0), buildListsTime(0), sortTime(0), renderTime(0)
+        { }
+
+        int drawCalls;
+        int geometryNodes;
+        int batches;
+        int materialChanges;
+        qint64 uploadedBytes;
+
+        // Times in nanoseconds. renderTime covers all of render(), including
+        // buildListsTime and sortTime.
+        qint64 preprocessTime;
+        qint64 updateTime;
+        qint64 buildListsTime;
+        qint64 sortTime;
+        qint64 renderTime;
+    };
+
     QSGRenderer(QSGContext *context);
     virtual ~QSGRenderer();
 
@@ -133,6 +155,8 @@ public:
     void setClearMode(ClearMode mode) { m_clear_mode = mode; }
     ClearMode clearMode() const { return m_clear_mode; }
 
+    const Statistics &statistics() const { return m_statistics; }
+
 signals:
     void sceneGraphChanged(); // Add, remove, ChangeFlags changes...
 
@@ -158,6 +182,7 @@ protected:
     qreal m_current_opacity;
 
     QSGContext *m_context;
+    Statistics m_statistics;
 
 private:
     QSGRootNode *m_root_node;
@@ -201,6 +226,24 @@ private:
 
 
 
+inline int qt_size_of_gl_type(GLenum type)
+{
+    static int sizes[] = {
+        sizeof(char),
+        sizeof(unsigned char),
+        sizeof(short),
+        sizeof(unsigned short),
+        sizeof(int),
+        sizeof(unsigned int),
+        sizeof(float),
+        2,
+        3,
+        4,
+        sizeof(double)
+    };
+    return sizes[type - GL_BYTE];
+}
+
 QSGMaterialShader::RenderState QSGRenderer::state(QSGMaterialShader::RenderState::DirtyStates dirty) const
 {
     QSGMaterialShader::RenderState s;
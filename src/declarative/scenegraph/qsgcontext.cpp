@@ -63,6 +63,7 @@
 DEFINE_BOOL_CONFIG_OPTION(qmlFlashMode, QML_FLASH_MODE)
 DEFINE_BOOL_CONFIG_OPTION(qmlTranslucentMode, QML_TRANSLUCENT_MODE)
 DEFINE_BOOL_CONFIG_OPTION(qmlDisableDistanceField, QML_DISABLE_DISTANCEFIELD)
+DEFINE_BOOL_CONFIG_OPTION(qmlBatchGeometry, QML_BATCH_GEOMETRY)
 
 /*
     Comments about this class from Gunnar:
@@ -333,6 +334,7 @@ QSGRenderer *QSGContext::createRenderer()
         printf("QSGContext: Sorting opaque nodes front to back...\n");
         renderer->setSortFrontToBackEnabled(true);
     }
+    renderer->setGeometryBatchingEnabled(qmlBatchGeometry());
     return renderer;
 }
 
@@ -162,6 +162,7 @@ void QSGTextMaskMaterial::init()
 
     QFontEngineGlyphCache::Type type = QFontEngineGlyphCache::Raster_A8;
     setFlag(Blending, true);
+    setFlag(CanBeBatched);
 
     QGLContext *ctx = const_cast<QGLContext *>(QGLContext::currentContext());
     Q_ASSERT(ctx != 0);
@@ -54,6 +54,8 @@ QSGDefaultImageNode::QSGDefaultImageNode()
     , m_dirtyGeometry(false)
     , m_geometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 4)
 {
+    m_material.setFlag(QSGMaterial::CanBeBatched);
+    m_materialO.setFlag(QSGMaterial::CanBeBatched);
     setMaterial(&m_materialO);
     setOpaqueMaterial(&m_material);
     setGeometry(&m_geometry);
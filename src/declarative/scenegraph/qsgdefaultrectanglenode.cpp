@@ -64,6 +64,8 @@ QSGDefaultRectangleNode::QSGDefaultRectangleNode(QSGContext *context)
     , m_default_geometry(QSGGeometry::defaultAttributes_Point2D(), 4)
     , m_context(context)
 {
+    m_fill_material.setFlag(QSGMaterial::CanBeBatched);
+    m_border_material.setFlag(QSGMaterial::CanBeBatched);
     setGeometry(&m_default_geometry);
     setMaterial(&m_fill_material);
     m_border_material.setColor(QColor(0, 0, 0));
@@ -168,6 +170,7 @@ void QSGDefaultRectangleNode::setGradientStops(const QGradientStops &stops)
     } else {
         if (m_material_type == TypeFlat) {
             QSGVertexColorMaterial *material = new QSGVertexColorMaterial;
+            material->setFlag(QSGMaterial::CanBeBatched);
             setMaterial(material);
             m_material_type = TypeVertexGradient;
             QSGGeometry *g = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), 0);
@@ -0,0 +1,383 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the QtDeclarative module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsgdistancefielddiskcache_p.h"
+
+#include <private/qrawfont_p.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qsysinfo.h>
+#include <QtCore/qtemporaryfile.h>
+#include <QtCore/qvector.h>
+#include <QtGui/qdesktopservices.h>
+
+#if defined(Q_OS_WIN)
+#  include <QtCore/qt_windows.h>
+#else
+#  include <stdio.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+DEFINE_BOOL_CONFIG_OPTION(qmlDisableDistanceFieldCache, QML_DISABLE_DISTANCEFIELD_CACHE)
+
+/*!
+\class QSGDistanceFieldDiskCache
+\brief The QSGDistanceFieldDiskCache class persists generated distance field glyphs between runs.
+\internal
+
+There is one cache file per font, identified by its family, style and weight and a hash
+of the font's header table, so that a different version of the same font does not pick
+up stale glyphs.  The file holds a header, an index with one entry per glyph in the
+font, and a record for each glyph that has been generated so far: the glyph's bounding
+rectangle at the distance field base font size and, unless the glyph is empty, its
+distance field image.
+
+The file is memory mapped, so opening it costs the same however many glyphs it holds,
+and cached images are uploaded to the texture straight from the mapping.  Newly
+generated glyphs are kept in memory until flush() rewrites the file, which happens when
+the cache is destroyed.  The file is replaced atomically, so concurrent processes
+always see either the old or the new version.
+
+A file written with different distance field parameters, by a build of different
+endianness or by an older version is ignored, and overwritten on the next flush().
+
+The cache can be disabled by setting the QML_DISABLE_DISTANCEFIELD_CACHE environment
+variable.  The files are written to defaultPath(), unless QML_DISTANCEFIELD_CACHE_PATH
+is set.
+*/
+
+static const quint32 DistanceFieldCacheMagic = 0x51534446; // "QSDF"
+static const quint32 DistanceFieldCacheVersion = 1;
+
+struct QSGDistanceFieldDiskCache::Header
+{
+    quint32 magic;
+    quint32 version;
+    quint32 byteOrder;
+    quint32 glyphCount;
+    quint32 tileSize;
+    quint32 scale;
+    quint32 radius;
+    quint32 baseFontSize;
+    char fontHash[20];
+    // quint32 offsets[glyphCount], 0 for glyphs not in the cache
+};
+
+struct QSGDistanceFieldDiskCache::Record
+{
+    float x;
+    float y;
+    float width;
+    float height;
+    quint32 hasImage;
+    // uchar image[tileSize * tileSize] if hasImage
+};
+
+// Renames \a from to \a to, replacing \a to in a single step so that there is
+// never a moment without a cache file.  QFile::rename() refuses to overwrite.
+static bool replaceFile(const QString &from, const QString &to)
+{
+#if defined(Q_OS_WINCE)
+    QFile::remove(to);
+    return QFile::rename(from, to);
+#elif defined(Q_OS_WIN)
+    return MoveFileEx(reinterpret_cast<const wchar_t *>(QDir::toNativeSeparators(from).utf16()),
+                      reinterpret_cast<const wchar_t *>(QDir::toNativeSeparators(to).utf16()),
+                      MOVEFILE_REPLACE_EXISTING);
+#else
+    return ::rename(QFile::encodeName(from).constData(), QFile::encodeName(to).constData()) == 0;
+#endif
+}
+
+QSGDistanceFieldDiskCache::QSGDistanceFieldDiskCache(const QRawFont &font, const Parameters &parameters,
+                                                     const QString &path)
+: m_parameters(parameters), m_glyphCount(0), m_data(0), m_size(0)
+{
+    QRawFont referenceFont = font;
+    referenceFont.setPixelSize(parameters.baseFontSize);
+    QRawFontPrivate *fontD = QRawFontPrivate::get(referenceFont);
+    m_glyphCount = fontD->fontEngine->glyphCount();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(font.fontTable("head"));
+    hash.addData(QByteArray::number(m_glyphCount));
+    m_fontHash = hash.result();
+
+    QString dir = path.isEmpty() ? defaultPath() : path;
+    QString name = QString::fromLatin1("%1_%2_%3_%4_%5.qsgdf")
+            .arg(font.familyName())
+            .arg(font.styleName())
+            .arg(font.weight())
+            .arg(font.style())
+            .arg(QString::fromLatin1(m_fontHash.toHex().left(16)));
+    name.replace(QLatin1Char('/'), QLatin1Char('_'));
+    name.replace(QLatin1Char('\\'), QLatin1Char('_'));
+    m_file.setFileName(QDir(dir).filePath(name));
+
+    map();
+}
+
+QSGDistanceFieldDiskCache::~QSGDistanceFieldDiskCache()
+{
+    flush();
+    unmap();
+}
+
+/*!
+Returns false if the cache was disabled through the QML_DISABLE_DISTANCEFIELD_CACHE
+environment variable.
+*/
+bool QSGDistanceFieldDiskCache::isEnabled()
+{
+    return !qmlDisableDistanceFieldCache();
+}
+
+/*!
+Returns the directory cache files are written to by default.  This is taken from the
+QML_DISTANCEFIELD_CACHE_PATH environment variable if set, otherwise it is the
+"distancefields" directory in the application's cache location.
+*/
+QString QSGDistanceFieldDiskCache::defaultPath()
+{
+    QString path = QString::fromLocal8Bit(qgetenv("QML_DISTANCEFIELD_CACHE_PATH"));
+    if (!path.isEmpty())
+        return path;
+    path = QDesktopServices::storageLocation(QDesktopServices::CacheLocation);
+    if (path.isEmpty())
+        path = QDir::tempPath() + QLatin1String("/.qt");
+    return path + QLatin1String("/distancefields");
+}
+
+QString QSGDistanceFieldDiskCache::fileName() const
+{
+    return m_file.fileName();
+}
+
+bool QSGDistanceFieldDiskCache::map()
+{
+    if (!m_file.open(QFile::ReadOnly))
+        return false;
+
+    m_size = m_file.size();
+    qint64 indexEnd = sizeof(Header) + qint64(m_glyphCount) * sizeof(quint32);
+    if (m_size >= indexEnd)
+        m_data = m_file.map(0, m_size);
+    if (m_data) {
+        const Header *header = reinterpret_cast<const Header *>(m_data);
+        if (header->magic == DistanceFieldCacheMagic
+                && header->version == DistanceFieldCacheVersion
+                && header->byteOrder == quint32(QSysInfo::ByteOrder)
+                && header->glyphCount == m_glyphCount
+                && header->tileSize == quint32(m_parameters.tileSize)
+                && header->scale == quint32(m_parameters.scale)
+                && header->radius == quint32(m_parameters.radius)
+                && header->baseFontSize == quint32(m_parameters.baseFontSize)
+                && !memcmp(header->fontHash, m_fontHash.constData(), sizeof(header->fontHash)))
+            return true;
+    }
+
+    unmap();
+    return false;
+}
+
+void QSGDistanceFieldDiskCache::unmap()
+{
+    if (m_data)
+        m_file.unmap(m_data);
+    m_data = 0;
+    m_size = 0;
+    m_file.close();
+}
+
+const QSGDistanceFieldDiskCache::Record *QSGDistanceFieldDiskCache::mappedRecord(glyph_t glyph) const
+{
+    if (!m_data || glyph >= m_glyphCount)
+        return 0;
+    const quint32 *offsets = reinterpret_cast<const quint32 *>(m_data + sizeof(Header));
+    quint32 offset = offsets[glyph];
+    if (!offset || offset + sizeof(Record) > quint64(m_size))
+        return 0;
+    const Record *record = reinterpret_cast<const Record *>(m_data + offset);
+    if (record->hasImage && offset + sizeof(Record)
+            + quint64(m_parameters.tileSize) * m_parameters.tileSize > quint64(m_size))
+        return 0;
+    return record;
+}
+
+bool QSGDistanceFieldDiskCache::contains(glyph_t glyph) const
+{
+    return m_pending.contains(glyph) || mappedRecord(glyph);
+}
+
+/*!
+Sets \a rect to the bounding rectangle of \a glyph at the base font size.  Returns false
+if the glyph is not in the cache.
+*/
+bool QSGDistanceFieldDiskCache::glyphRect(glyph_t glyph, QRectF *rect) const
+{
+    QHash<glyph_t, Pending>::const_iterator pending = m_pending.constFind(glyph);
+    if (pending != m_pending.constEnd()) {
+        *rect = pending->rect;
+        return true;
+    }
+    const Record *record = mappedRecord(glyph);
+    if (!record)
+        return false;
+    *rect = QRectF(record->x, record->y, record->width, record->height);
+    return true;
+}
+
+/*!
+Returns the tileSize x tileSize distance field of \a glyph, or 0 if it is not in the
+cache or is empty.  The data is valid until the next call to flush().
+*/
+const uchar *QSGDistanceFieldDiskCache::glyphImage(glyph_t glyph) const
+{
+    QHash<glyph_t, Pending>::const_iterator pending = m_pending.constFind(glyph);
+    if (pending != m_pending.constEnd())
+        return pending->image.isEmpty() ? 0 : reinterpret_cast<const uchar *>(pending->image.constData());
+    const Record *record = mappedRecord(glyph);
+    if (!record || !record->hasImage)
+        return 0;
+    return reinterpret_cast<const uchar *>(record + 1);
+}
+
+/*!
+Adds \a glyph, with bounding rectangle \a rect and distance field \a image, to the
+cache.  \a image may be null for empty glyphs.
+*/
+void QSGDistanceFieldDiskCache::insert(glyph_t glyph, const QRectF &rect, const QImage &image)
+{
+    if (glyph >= m_glyphCount || contains(glyph))
+        return;
+
+    Pending pending;
+    pending.rect = rect;
+    if (!image.isNull()) {
+        int size = m_parameters.tileSize;
+        Q_ASSERT(image.depth() == 8 && image.width() >= size && image.height() >= size);
+        pending.image.resize(size * size);
+        for (int y = 0; y < size; ++y)
+            qMemCopy(pending.image.data() + y * size, image.constScanLine(y), size);
+    }
+    m_pending.insert(glyph, pending);
+}
+
+/*!
+Writes all glyphs added since the last flush to the cache file, and maps the new file.
+*/
+bool QSGDistanceFieldDiskCache::flush()
+{
+    if (m_pending.isEmpty())
+        return true;
+
+    QString fileName = m_file.fileName();
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+
+    // Each process writes its own file, so that concurrent flushes never interleave.  It is
+    // created next to the cache file so that it can be renamed over it.
+    QTemporaryFile out(fileName + QLatin1String(".XXXXXX"));
+    if (!out.open())
+        return false;
+
+    Header header;
+    header.magic = DistanceFieldCacheMagic;
+    header.version = DistanceFieldCacheVersion;
+    header.byteOrder = QSysInfo::ByteOrder;
+    header.glyphCount = m_glyphCount;
+    header.tileSize = m_parameters.tileSize;
+    header.scale = m_parameters.scale;
+    header.radius = m_parameters.radius;
+    header.baseFontSize = m_parameters.baseFontSize;
+    memcpy(header.fontHash, m_fontHash.constData(), sizeof(header.fontHash));
+
+    const int imageSize = m_parameters.tileSize * m_parameters.tileSize;
+    QVector<quint32> offsets(m_glyphCount, 0);
+    quint32 offset = sizeof(Header) + m_glyphCount * sizeof(quint32);
+    for (glyph_t glyph = 0; glyph < m_glyphCount; ++glyph) {
+        if (!contains(glyph))
+            continue;
+        offsets[glyph] = offset;
+        offset += sizeof(Record) + (glyphImage(glyph) ? imageSize : 0);
+    }
+
+    bool ok = out.write(reinterpret_cast<const char *>(&header), sizeof(Header)) == sizeof(Header);
+    ok = ok && out.write(reinterpret_cast<const char *>(offsets.constData()), m_glyphCount * sizeof(quint32))
+            == qint64(m_glyphCount * sizeof(quint32));
+    for (glyph_t glyph = 0; ok && glyph < m_glyphCount; ++glyph) {
+        if (!offsets.at(glyph))
+            continue;
+        QRectF rect;
+        glyphRect(glyph, &rect);
+        const uchar *image = glyphImage(glyph);
+
+        Record record;
+        record.x = rect.x();
+        record.y = rect.y();
+        record.width = rect.width();
+        record.height = rect.height();
+        record.hasImage = image ? 1 : 0;
+        ok = out.write(reinterpret_cast<const char *>(&record), sizeof(Record)) == sizeof(Record);
+        if (ok && image)
+            ok = out.write(reinterpret_cast<const char *>(image), imageSize) == imageSize;
+    }
+    out.close();
+
+    if (!ok) {
+        out.remove();
+        return false;
+    }
+
+    // The mapping has to go first, as Windows will not replace a mapped file
+    unmap();
+    if (!replaceFile(out.fileName(), fileName)) {
+        out.remove();
+        map();
+        return false;
+    }
+    out.setAutoRemove(false);
+    m_pending.clear();
+    return map();
+}
+
+QT_END_NAMESPACE
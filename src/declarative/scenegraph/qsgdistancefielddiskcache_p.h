@@ -0,0 +1,116 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the QtDeclarative module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSGDISTANCEFIELDDISKCACHE_P_H
+#define QSGDISTANCEFIELDDISKCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qdeclarativeglobal_p.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qrect.h>
+#include <QtGui/qimage.h>
+#include <QtGui/qrawfont.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_DECLARATIVE_EXPORT QSGDistanceFieldDiskCache
+{
+public:
+    struct Parameters {
+        int tileSize;
+        int scale;
+        int radius;
+        int baseFontSize;
+    };
+
+    QSGDistanceFieldDiskCache(const QRawFont &font, const Parameters &parameters,
+                              const QString &path = QString());
+    ~QSGDistanceFieldDiskCache();
+
+    static bool isEnabled();
+    static QString defaultPath();
+
+    QString fileName() const;
+
+    bool contains(glyph_t glyph) const;
+    bool glyphRect(glyph_t glyph, QRectF *rect) const;
+    const uchar *glyphImage(glyph_t glyph) const;
+
+    void insert(glyph_t glyph, const QRectF &rect, const QImage &image);
+    bool flush();
+
+private:
+    struct Header;
+    struct Record;
+
+    bool map();
+    void unmap();
+    const Record *mappedRecord(glyph_t glyph) const;
+
+    Parameters m_parameters;
+    quint32 m_glyphCount;
+    QByteArray m_fontHash;
+
+    QFile m_file;
+    uchar *m_data;
+    qint64 m_size;
+
+    struct Pending {
+        QRectF rect;
+        QByteArray image;
+    };
+    QHash<glyph_t, Pending> m_pending;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSGDISTANCEFIELDDISKCACHE_P_H
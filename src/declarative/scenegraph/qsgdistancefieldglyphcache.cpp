@@ -40,6 +40,7 @@
 ****************************************************************************/
 
 #include "qsgdistancefieldglyphcache_p.h"
+#include "qsgdistancefielddiskcache_p.h"
 
 #include <qmath.h>
 #include <private/qsgpathsimplifier_p.h>
@@ -51,7 +52,6 @@
 #include <qglfunctions.h>
 #include <qglyphrun.h>
 #include <qrawfont.h>
-#include <qdir.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -905,10 +905,26 @@ QSGDistanceFieldGlyphCache::QSGDistanceFieldGlyphCache(QSGDistanceFieldGlyphCach
     m_referenceFont = m_font;
     m_referenceFont.setPixelSize(QT_DISTANCEFIELD_BASEFONTSIZE);
     Q_ASSERT(m_referenceFont.isValid());
+
+    if (!m_textureData->diskCache && QSGDistanceFieldDiskCache::isEnabled()) {
+        QSGDistanceFieldDiskCache::Parameters parameters;
+        parameters.tileSize = QT_DISTANCEFIELD_TILESIZE;
+        parameters.scale = QT_DISTANCEFIELD_SCALE;
+        parameters.radius = QT_DISTANCEFIELD_RADIUS;
+        parameters.baseFontSize = QT_DISTANCEFIELD_BASEFONTSIZE;
+        m_textureData->diskCache = new QSGDistanceFieldDiskCache(m_font, parameters);
+    }
 }
 
 QSGDistanceFieldGlyphCache::~QSGDistanceFieldGlyphCache()
 {
+    if (m_textureData->diskCache)
+        m_textureData->diskCache->flush();
+}
+
+QSGDistanceFieldGlyphCache::DistanceFieldTextureData::~DistanceFieldTextureData()
+{
+    delete diskCache;
 }
 
 GLuint QSGDistanceFieldGlyphCache::texture()
@@ -925,8 +941,9 @@ QSGDistanceFieldGlyphCache::Metrics QSGDistanceFieldGlyphCache::glyphMetrics(gly
 {
     QHash<glyph_t, Metrics>::iterator metric = m_metrics.find(glyph);
     if (metric == m_metrics.end()) {
-        QPainterPath path = m_font.pathForGlyph(glyph);
-        QRectF br = path.boundingRect();
+        QRectF br = glyphBoundingRect(glyph);
+        qreal scale = fontScale();
+        br = QRectF(br.x() * scale, br.y() * scale, br.width() * scale, br.height() * scale);
 
         Metrics m;
         m.width = br.width();
@@ -940,6 +957,22 @@ QSGDistanceFieldGlyphCache::Metrics QSGDistanceFieldGlyphCache::glyphMetrics(gly
     return metric.value();
 }
 
+// Bounding rect of the glyph at the base font size, from the disk cache if possible
+QRectF QSGDistanceFieldGlyphCache::glyphBoundingRect(glyph_t glyph)
+{
+    QSGDistanceFieldDiskCache *diskCache = m_textureData->diskCache;
+    QRectF br;
+    if (diskCache && diskCache->glyphRect(glyph, &br))
+        return br;
+
+    QPainterPath path = m_referenceFont.pathForGlyph(glyph);
+    if (!path.isEmpty())
+        br = path.boundingRect();
+    if (diskCache && br.isEmpty())
+        diskCache->insert(glyph, br, QImage());
+    return br;
+}
+
 QSGDistanceFieldGlyphCache::TexCoord QSGDistanceFieldGlyphCache::glyphTexCoord(glyph_t glyph)
 {
     return m_textureData->texCoords.value(glyph);
@@ -996,12 +1029,11 @@ void QSGDistanceFieldGlyphCache::populate(int count, const glyph_t *glyphs)
                 || (cacheIsFull() && m_textureData->unusedGlyphs.isEmpty()))
             continue;
 
-        QPainterPath path = m_referenceFont.pathForGlyph(glyphIndex);
-        if (path.isEmpty()) {
+        QRectF br = glyphBoundingRect(glyphIndex);
+        if (br.isEmpty()) {
             m_textureData->texCoords.insert(glyphIndex, TexCoord());
             continue;
         }
-        QRectF br = path.boundingRect();
 
         TexCoord c;
         c.xMargin = QT_DISTANCEFIELD_RADIUS / qreal(QT_DISTANCEFIELD_SCALE);
@@ -1179,40 +1211,31 @@ void QSGDistanceFieldGlyphCache::updateCache()
     resizeTexture((requiredWidth), (requiredHeight));
     glBindTexture(GL_TEXTURE_2D, m_textureData->texture);
 
-    // ### Remove before final release
-    static bool cacheDistanceFields = QApplication::arguments().contains("--cache-distance-fields");
-
 // #define QSGDISTANCEFIELDS_TIME_CREATION
 #ifdef QSGDISTANCEFIELDS_TIME_CREATION
     QTime time;
     time.start();
 #endif
 
-    QString tmpPath = QString::fromLatin1("%1/.qt/").arg(QDir::tempPath());
-    QString keyBase = QString::fromLatin1("%1%2%3_%4_%5_%6.fontblob")
-            .arg(tmpPath)
-            .arg(m_font.familyName())
-            .arg(m_font.styleName())
-            .arg(m_font.weight())
-            .arg(m_font.style());
-
-    if (cacheDistanceFields && !QFile::exists(tmpPath))
-        QDir(tmpPath).mkpath(tmpPath);
+    QSGDistanceFieldDiskCache *diskCache = m_textureData->diskCache;
+    const int tileSize = QT_DISTANCEFIELD_TILESIZE;
 
     for (int i = 0; i < m_textureData->pendingGlyphs.size(); ++i) {
         glyph_t glyphIndex = m_textureData->pendingGlyphs.at(i);
         TexCoord c = m_textureData->texCoords.value(glyphIndex);
 
-        if (cacheDistanceFields) {
-            QString key = keyBase.arg(glyphIndex);
-            QFile file(key);
-            if (file.open(QFile::ReadOnly)) {
-                int fileSize = file.size();
-                int dim = sqrt(float(fileSize));
-                QByteArray blob = file.readAll();
-                glTexSubImage2D(GL_TEXTURE_2D, 0, c.x, c.y, dim, dim, GL_ALPHA, GL_UNSIGNED_BYTE, blob.constData());
-                continue;
+        // Upload cached glyphs straight from the mapped cache file
+        const uchar *cached = diskCache ? diskCache->glyphImage(glyphIndex) : 0;
+        if (cached) {
+            if (ctx->d_ptr->workaround_brokenFBOReadBack) {
+                uchar *outBits = m_textureData->image.scanLine(int(c.y)) + int(c.x);
+                for (int y = 0; y < tileSize; ++y) {
+                    qMemCopy(outBits, cached + y * tileSize, tileSize);
+                    outBits += m_textureData->image.bytesPerLine();
+                }
             }
+            glTexSubImage2D(GL_TEXTURE_2D, 0, c.x, c.y, tileSize, tileSize, GL_ALPHA, GL_UNSIGNED_BYTE, cached);
+            continue;
         }
 
         QImage glyph = renderDistanceFieldGlyph(glyphIndex);
@@ -1229,12 +1252,8 @@ void QSGDistanceFieldGlyphCache::updateCache()
 
         glTexSubImage2D(GL_TEXTURE_2D, 0, c.x, c.y, glyph.width(), glyph.height(), GL_ALPHA, GL_UNSIGNED_BYTE, glyph.constBits());
 
-        if (cacheDistanceFields) {
-            QString key = keyBase.arg(glyphIndex);
-            QFile file(key);
-            file.open(QFile::WriteOnly);
-            file.write((const char *) glyph.constBits(), glyph.width() * glyph.height());
-        }
+        if (diskCache)
+            diskCache->insert(glyphIndex, glyphBoundingRect(glyphIndex), glyph);
     }
 
 #ifdef QSGDISTANCEFIELDS_TIME_CREATION
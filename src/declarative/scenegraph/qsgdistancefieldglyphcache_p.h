@@ -57,6 +57,7 @@ typedef float (*AntialiasingSpreadFunc)(float glyphScale);
 
 class QGLShaderProgram;
 class QSGDistanceFieldGlyphCache;
+class QSGDistanceFieldDiskCache;
 
 class Q_DECLARATIVE_EXPORT QSGDistanceFieldGlyphCacheManager
 {
@@ -149,6 +150,7 @@ private:
 
     void createTexture(int width, int height);
     void resizeTexture(int width, int height);
+    QRectF glyphBoundingRect(glyph_t glyph);
 
     QSGDistanceFieldGlyphCacheManager *m_manager;
 
@@ -170,6 +172,7 @@ private:
         int currY;
         QImage image;
         bool doubleGlyphResolution;
+        QSGDistanceFieldDiskCache *diskCache;
 
         DistanceFieldTextureData(const QGLContext *)
             : texture(0)
@@ -178,7 +181,9 @@ private:
             , currX(0)
             , currY(0)
             , doubleGlyphResolution(false)
+            , diskCache(0)
         { }
+        ~DistanceFieldTextureData();
     };
     DistanceFieldTextureData *textureData();
     DistanceFieldTextureData *m_textureData;
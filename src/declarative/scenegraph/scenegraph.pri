@@ -56,6 +56,7 @@ HEADERS += \
     $$PWD/qsgcontext_p.h \
     $$PWD/qsgcontextplugin_p.h \
     $$PWD/qsgdefaultglyphnode_p.h \
+    $$PWD/qsgdistancefielddiskcache_p.h \
     $$PWD/qsgdistancefieldglyphcache_p.h \
     $$PWD/qsgdistancefieldglyphnode_p.h \
     $$PWD/qsgdistancefieldglyphnode_p_p.h \
@@ -71,6 +72,7 @@ SOURCES += \
     $$PWD/qsgcontextplugin.cpp \
     $$PWD/qsgdefaultglyphnode.cpp \
     $$PWD/qsgdefaultglyphnode_p.cpp \
+    $$PWD/qsgdistancefielddiskcache.cpp \
     $$PWD/qsgdistancefieldglyphcache.cpp \
     $$PWD/qsgdistancefieldglyphnode.cpp \
     $$PWD/qsgdistancefieldglyphnode_p.cpp \
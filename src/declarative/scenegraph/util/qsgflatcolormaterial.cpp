@@ -189,4 +189,19 @@ QSGMaterialShader *QSGFlatColorMaterial::createShader() const
     return new FlatColorMaterialShader;
 }
 
+
+
+/*!
+    \internal
+ */
+
+int QSGFlatColorMaterial::compare(const QSGMaterial *o) const
+{
+    Q_ASSERT(o && type() == o->type());
+    const QSGFlatColorMaterial *other = static_cast<const QSGFlatColorMaterial *>(o);
+    QRgb c1 = m_color.rgba();
+    QRgb c2 = other->m_color.rgba();
+    return int(c2 < c1) - int(c1 < c2);
+}
+
 QT_END_NAMESPACE
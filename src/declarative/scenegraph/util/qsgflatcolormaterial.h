@@ -56,6 +56,7 @@ public:
     QSGFlatColorMaterial();
     virtual QSGMaterialType *type() const;
     virtual QSGMaterialShader *createShader() const;
+    virtual int compare(const QSGMaterial *other) const;
 
     void setColor(const QColor &color);
     const QColor &color() const { return m_color; }
@@ -124,6 +124,8 @@ QSGPainterNode::QSGPainterNode(QSGPaintedItem *item)
     , m_dirtyRenderTarget(false)
     , m_dirtyTexture(false)
 {
+    m_material.setFlag(QSGMaterial::CanBeBatched);
+    m_materialO.setFlag(QSGMaterial::CanBeBatched);
     setMaterial(&m_materialO);
     setOpaqueMaterial(&m_material);
     setGeometry(&m_geometry);
@@ -63,6 +63,7 @@ QSGSimpleRectNode::QSGSimpleRectNode(const QRectF &rect, const QColor &color)
 {
     QSGGeometry::updateRectGeometry(&m_geometry, rect);
     m_material.setColor(color);
+    m_material.setFlag(QSGMaterial::CanBeBatched);
     setMaterial(&m_material);
     setGeometry(&m_geometry);
 }
@@ -77,6 +78,7 @@ QSGSimpleRectNode::QSGSimpleRectNode()
     : m_geometry(QSGGeometry::defaultAttributes_Point2D(), 4)
 {
     QSGGeometry::updateRectGeometry(&m_geometry, QRectF());
+    m_material.setFlag(QSGMaterial::CanBeBatched);
     setMaterial(&m_material);
     setGeometry(&m_geometry);
 }
@@ -71,6 +71,8 @@ static void qsgsimpletexturenode_update(QSGGeometry *g,
 QSGSimpleTextureNode::QSGSimpleTextureNode()
     : m_geometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 4)
 {
+    m_material.setFlag(QSGMaterial::CanBeBatched);
+    m_opaque_material.setFlag(QSGMaterial::CanBeBatched);
     setGeometry(&m_geometry);
     setMaterial(&m_material);
     setOpaqueMaterial(&m_opaque_material);
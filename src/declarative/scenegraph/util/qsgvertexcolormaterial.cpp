@@ -168,4 +168,17 @@ QSGMaterialShader *QSGVertexColorMaterial::createShader() const
     return new QSGVertexColorMaterialShader;
 }
 
+
+
+/*!
+    \internal
+
+    The vertex color material has no state of its own, so all instances are equal.
+ */
+
+int QSGVertexColorMaterial::compare(const QSGMaterial *) const
+{
+    return 0;
+}
+
 QT_END_NAMESPACE
@@ -60,6 +60,7 @@ public:
 protected:
     virtual QSGMaterialType *type() const;
     virtual QSGMaterialShader *createShader() const;
+    virtual int compare(const QSGMaterial *other) const;
 };
 
 QT_END_NAMESPACE
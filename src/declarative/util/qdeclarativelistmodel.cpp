@@ -85,6 +85,9 @@ public:
     static v8::Handle<v8::Value> Setter(v8::Local<v8::String> property, 
                                         v8::Local<v8::Value> value,
                                         const v8::AccessorInfo &info);
+    static v8::Handle<v8::Integer> Query(v8::Local<v8::String> property,
+                                         const v8::AccessorInfo &info);
+    static v8::Handle<v8::Array> Enumerator(const v8::AccessorInfo &info);
 };
 
 v8::Local<v8::Object> QDeclarativeListModelV8Data::create(QV8Engine *engine)
@@ -101,7 +104,7 @@ v8::Local<v8::Object> QDeclarativeListModelV8Data::create(QV8Engine *engine)
 QDeclarativeListModelV8Data::QDeclarativeListModelV8Data()
 {
     v8::Local<v8::FunctionTemplate> ft = v8::FunctionTemplate::New();
-    ft->InstanceTemplate()->SetNamedPropertyHandler(Getter, Setter);
+    ft->InstanceTemplate()->SetNamedPropertyHandler(Getter, Setter, Query, 0, Enumerator);
     ft->InstanceTemplate()->SetHasExternalResource(true);
     constructor = qPersistentNew<v8::Function>(ft->GetFunction());
 }
@@ -127,10 +130,8 @@ v8::Handle<v8::Value> QDeclarativeListModelV8Data::Getter(v8::Local<v8::String>
 
     int role = r->model->m_strings.value(propName, -1);
 
-    if (role >= 0 && index >=0 ) {
-        const QHash<int, QVariant> &row = r->model->m_values[index];
-        return r->engine->fromVariant(row[role]);
-    }
+    if (role >= 0 && index >=0 )
+        return r->engine->fromVariant(r->model->m_values.value(index, role));
 
     return v8::Undefined();
 }
@@ -147,18 +148,29 @@ v8::Handle<v8::Value> QDeclarativeListModelV8Data::Setter(v8::Local<v8::String>
         return value;
 
 
+    int index = r->nodeData->index;
+
     if (!value->IsRegExp() && !value->IsDate() && value->IsObject() && !r->engine->isVariant(value)) {
-        qmlInfo(r->model->m_listModel) << "Cannot add list-type data when modifying or after modification from a worker script";
+        QDeclarativeListModel *listModel = r->model->m_listModel;
+        if (!listModel->canUnflatten()) {
+            qmlInfo(listModel) << "Cannot add list-type data when modifying or after modification from a worker script";
+            return value;
+        }
+
+        // Only the nested model can hold list-type data, so switch to it and assign
+        // the value to its object for the row.  This object is then no longer valid.
+        listModel->unflatten();
+        v8::Handle<v8::Value> object = listModel->m_nested->get(index);
+        if (object->IsObject())
+            object->ToObject()->Set(property, value);
         return value;
     }
 
-    int index = r->nodeData->index;
     QString propName = r->engine->toString(property);
 
     int role = r->model->m_strings.value(propName, -1);
     if (role >= 0 && index >= 0) {
-        QHash<int, QVariant> &row = r->model->m_values[index];
-        row[role] = r->engine->toVariant(value, -1);
+        r->model->m_values.setValue(index, role, r->engine->toVariant(value, -1));
 
         QList<int> roles;
         roles << role;
@@ -175,6 +187,37 @@ v8::Handle<v8::Value> QDeclarativeListModelV8Data::Setter(v8::Local<v8::String>
     return value;
 }
 
+v8::Handle<v8::Integer> QDeclarativeListModelV8Data::Query(v8::Local<v8::String> property,
+                                                            const v8::AccessorInfo &info)
+{
+    QV8ListModelResource *r =  v8_resource_cast<QV8ListModelResource>(info.This());
+    if (!r || !r->nodeData)
+        return v8::Handle<v8::Integer>();
+
+    int role = r->model->m_strings.value(r->engine->toString(property), -1);
+    if (role < 0 || !r->model->m_values.value(r->nodeData->index, role).isValid())
+        return v8::Handle<v8::Integer>();
+
+    return v8::Integer::New(v8::DontDelete);
+}
+
+v8::Handle<v8::Array> QDeclarativeListModelV8Data::Enumerator(const v8::AccessorInfo &info)
+{
+    QV8ListModelResource *r =  v8_resource_cast<QV8ListModelResource>(info.This());
+    if (!r || !r->nodeData)
+        return v8::Array::New();
+
+    // Roles are numbered in the order they were added
+    int index = r->nodeData->index;
+    v8::Local<v8::Array> names = v8::Array::New();
+    uint32_t count = 0;
+    for (int role = 0; role < r->model->m_roles.count(); ++role) {
+        if (r->model->m_values.value(index, role).isValid())
+            names->Set(count++, r->engine->toString(r->model->m_roles.value(role)));
+    }
+    return names;
+}
+
 template<typename T>
 void qdeclarativelistmodel_move(int from, int to, int n, T *items)
 {
@@ -197,6 +240,69 @@ void qdeclarativelistmodel_move(int from, int to, int n, T *items)
     }
 }
 
+template<typename T>
+void qdeclarativelistmodel_move(int from, int to, int n, QVector<T> *items)
+{
+    QVector<T> moved(n);
+    T *data = items->data();
+    for (int i=0; i<n; ++i)
+        moved[i] = data[from + i];
+    for (int i=from; i<to; ++i)
+        data[i] = data[i + n];
+    for (int i=0; i<n; ++i)
+        data[to + i] = moved.at(i);
+}
+
+static void qdeclarativelistmodel_move(int from, int to, int n, QBitArray *bits)
+{
+    QBitArray moved(n);
+    for (int i=0; i<n; ++i)
+        moved.setBit(i, bits->testBit(from + i));
+    for (int i=from; i<to; ++i)
+        bits->setBit(i, bits->testBit(i + n));
+    for (int i=0; i<n; ++i)
+        bits->setBit(to + i, moved.testBit(i));
+}
+
+static void qdeclarativelistmodel_insert(int index, int n, QBitArray *bits)
+{
+    int size = bits->size();
+    bits->resize(size + n);
+    for (int i=size - 1; i>=index; --i)
+        bits->setBit(i + n, bits->testBit(i));
+    for (int i=index; i<index + n; ++i)
+        bits->clearBit(i);
+}
+
+static void qdeclarativelistmodel_remove(int index, int n, QBitArray *bits)
+{
+    int size = bits->size();
+    for (int i=index + n; i<size; ++i)
+        bits->setBit(i - n, bits->testBit(i));
+    bits->truncate(size - n);
+}
+
+/*
+    Returns the number of rows described by \a value, which may be an object
+    or an array of objects, or -1 if it is neither.
+*/
+static int qdeclarativelistmodel_rowCount(v8::Handle<v8::Value> value)
+{
+    if (!value->IsObject())
+        return -1;
+    if (!value->IsArray())
+        return 1;
+
+    v8::Handle<v8::Array> array = v8::Handle<v8::Array>::Cast(value);
+    uint32_t length = array->Length();
+    for (uint32_t ii = 0; ii < length; ++ii) {
+        v8::Handle<v8::Value> row = array->Get(ii);
+        if (!row->IsObject() || row->IsArray())
+            return -1;
+    }
+    return length;
+}
+
 QDeclarativeListModelParser::ListInstruction *QDeclarativeListModelParser::ListModelData::instructions() const
 {
     return (QDeclarativeListModelParser::ListInstruction *)((char *)this + sizeof(ListModelData));
@@ -326,15 +432,21 @@ QDeclarativeListModelParser::ListInstruction *QDeclarativeListModelParser::ListM
     when retrieved from get() is accessible as a list model within the list
     model) whereas a FlatListModel cannot.
 
-    ListModel uses a NestedListModel to begin with, and if the model is later 
-    used from a WorkerScript, it changes to use a FlatListModel instead. This
-    is because ModelNode (which abstracts the nested list model data) needs
-    access to the declarative engine and script engine, which cannot be
-    safely used from outside of the main thread.
+    A ListModel that is filled from JavaScript uses a FlatListModel to begin
+    with, as it stores plain data much more compactly.  It changes to use a
+    NestedListModel when list-type data is added, including through an object
+    returned by get().  ListModels that are declared with ListElements always
+    use a NestedListModel.
+
+    If the model is later used from a WorkerScript, it changes back to use a
+    FlatListModel. This is because ModelNode (which abstracts the nested list
+    model data) needs access to the declarative engine and script engine,
+    which cannot be safely used from outside of the main thread.  Once used
+    from a WorkerScript, the model stays flat.
 */
 
 QDeclarativeListModel::QDeclarativeListModel(QObject *parent)
-: QListModelInterface(parent), m_agent(0), m_nested(new NestedListModel(this)), m_flat(0)
+: QListModelInterface(parent), m_agent(0), m_nested(0), m_flat(new FlatListModel(this))
 {
 }
 
@@ -380,7 +492,12 @@ bool QDeclarativeListModel::flatten()
     }
 
     FlatListModel *flat = new FlatListModel(this);
-    flat->m_values = values;
+    flat->m_values.insertRows(0, values.count());
+    for (int i=0; i<values.count(); i++) {
+        const QHash<int, QVariant> &row = values.at(i);
+        for (QHash<int, QVariant>::ConstIterator iter = row.constBegin(); iter != row.constEnd(); ++iter)
+            flat->m_values.setValue(i, iter.key(), iter.value());
+    }
 
     for (int i=0; i<roles.count(); i++) {
         QString s = m_nested->toString(roles[i]);
@@ -398,11 +515,49 @@ bool QDeclarativeListModel::flatten()
     return true;
 }
 
+void QDeclarativeListModel::unflatten()
+{
+    if (m_nested)
+        return;
+
+    NestedListModel *nested = new NestedListModel(this);
+    for (int role=0; role<m_flat->m_roles.count(); role++)
+        nested->roleStrings << m_flat->m_roles.value(role);
+
+    int count = m_flat->count();
+    if (count) {
+        nested->_root = new ModelNode(nested);
+        nested->m_ownsRoot = true;
+        for (int i=0; i<count; i++) {
+            ModelNode *node = new ModelNode(nested);
+            node->listIndex = i;
+            for (int role=0; role<nested->roleStrings.count(); role++) {
+                QVariant value = m_flat->m_values.value(i, role);
+                if (value.isValid()) {
+                    ModelNode *valueNode = new ModelNode(nested);
+                    valueNode->values << value;
+                    node->properties.insert(nested->roleStrings.at(role), valueNode);
+                }
+            }
+            nested->_root->values.append(QVariant::fromValue(node));
+        }
+    }
+
+    m_nested = nested;
+    delete m_flat;
+    m_flat = 0;
+}
+
 bool QDeclarativeListModel::inWorkerThread() const
 {
     return m_flat && m_flat->m_parentAgent;
 }
 
+bool QDeclarativeListModel::canUnflatten() const
+{
+    return m_flat && !m_agent && !m_flat->m_parentAgent;
+}
+
 QDeclarativeListModelWorkerAgent *QDeclarativeListModel::agent()
 {
     if (m_agent)
@@ -469,6 +624,7 @@ QDeclarativeListModel *ModelNode::model(const NestedListModel *model)
 {
     if (!modelCache) { 
         modelCache = new QDeclarativeListModel;
+        modelCache->unflatten();
         QDeclarativeEngine::setContextForObject(modelCache,QDeclarativeEngine::contextForObject(model->m_listModel));
         modelCache->m_nested->_root = this;  // ListModel defaults to nestable model
 
@@ -532,6 +688,10 @@ void QDeclarativeListModel::remove(int index)
         fruitModel.insert(2, {"cost": 5.95, "name":"Pizza"})
     \endcode
 
+    \a dict may also be an array of objects, in which case an item is
+    inserted for each of them, starting at \a index.  This is faster than
+    inserting the items one at a time.
+
     The \a index must be to an existing item in the list, or one past
     the end of the list (equivalent to append).
 
@@ -541,7 +701,8 @@ void QDeclarativeListModel::insert(int index, const QDeclarativeV8Handle &handle
 {
     v8::Handle<v8::Value> valuemap = handle.toHandle();
 
-    if (!valuemap->IsObject() || valuemap->IsArray()) {
+    int rows = qdeclarativelistmodel_rowCount(valuemap);
+    if (rows < 0) {
         qmlInfo(this) << tr("insert: value is not an object");
         return;
     }
@@ -551,10 +712,23 @@ void QDeclarativeListModel::insert(int index, const QDeclarativeV8Handle &handle
         return;
     }
 
-    bool ok = m_flat ?  m_flat->insert(index, valuemap) : m_nested->insert(index, valuemap);
+    if (rows == 0)
+        return;
+
+    bool ok;
+    if (m_flat) {
+        bool hasNested = false;
+        ok = m_flat->insert(index, valuemap, canUnflatten() ? &hasNested : 0);
+        if (!ok && hasNested) {
+            unflatten();
+            ok = m_nested->insert(index, valuemap);
+        }
+    } else {
+        ok = m_nested->insert(index, valuemap);
+    }
 
     if (ok && !inWorkerThread()) {
-        emit itemsInserted(index, 1);
+        emit itemsInserted(index, rows);
         emit countChanged();
     }
 }
@@ -613,13 +787,21 @@ void QDeclarativeListModel::move(int from, int to, int n)
         fruitModel.append({"cost": 5.95, "name":"Pizza"})
     \endcode
 
+    \a dict may also be an array of objects, in which case an item is
+    appended for each of them.  This is faster than appending the items
+    one at a time.
+
+    \code
+        fruitModel.append([{"cost": 5.95, "name":"Pizza"}, {"cost": 3.25, "name":"Pie"}])
+    \endcode
+
     \sa set() remove()
 */
 void QDeclarativeListModel::append(const QDeclarativeV8Handle &handle)
 {
     v8::Handle<v8::Value> valuemap = handle.toHandle();
 
-    if (!valuemap->IsObject() || valuemap->IsArray()) {
+    if (qdeclarativelistmodel_rowCount(valuemap) < 0) {
         qmlInfo(this) << tr("append: value is not an object");
         return;
     }
@@ -704,10 +886,15 @@ void QDeclarativeListModel::set(int index, const QDeclarativeV8Handle &handle, Q
     if (index == count()) {
         append(handle);
     } else {
-        if (m_flat)
-            m_flat->set(index, valuemap, roles);
-        else
+        if (m_flat) {
+            bool hasNested = false;
+            if (!m_flat->set(index, valuemap, roles, canUnflatten() ? &hasNested : 0) && hasNested) {
+                unflatten();
+                m_nested->set(index, valuemap, roles);
+            }
+        } else {
             m_nested->set(index, valuemap, roles);
+        }
     }
 }
 
@@ -931,6 +1118,14 @@ void QDeclarativeListModelParser::setCustomData(QObject *obj, const QByteArray &
 {
     QDeclarativeListModel *rv = static_cast<QDeclarativeListModel *>(obj);
 
+    const ListModelData *lmd = (const ListModelData *)d.constData();
+    const char *data = ((const char *)lmd) + lmd->dataOffset;
+
+    // A ListModel without ListElements keeps its compact flat storage
+    if (!lmd->instrCount)
+        return;
+
+    rv->unflatten();
     ModelNode *root = new ModelNode(rv->m_nested);
     rv->m_nested->_root = root;
     QStack<ModelNode *> nodes;
@@ -938,9 +1133,6 @@ void QDeclarativeListModelParser::setCustomData(QObject *obj, const QByteArray &
 
     bool processingSet = false;
 
-    const ListModelData *lmd = (const ListModelData *)d.constData();
-    const char *data = ((const char *)lmd) + lmd->dataOffset;
-
     for (int ii = 0; ii < lmd->instrCount; ++ii) {
         const ListInstruction &instr = lmd->instructions()[ii];
 
@@ -1059,6 +1251,286 @@ bool QDeclarativeListModelParser::definesEmptyList(const QString &s)
     \sa ListModel
 */
 
+ListModelColumns::Type ListModelColumns::typeOf(const QVariant &value)
+{
+    switch (value.userType()) {
+    case QVariant::Int:
+        return Int;
+    case QVariant::Double:
+        return Real;
+    case QVariant::Bool:
+        return Bool;
+    case QVariant::String:
+        return String;
+    default:
+        return Variant;
+    }
+}
+
+QVariant ListModelColumns::cell(const Column &column, int row) const
+{
+    if (!column.isSet.testBit(row))
+        return QVariant();
+
+    switch (column.type) {
+    case Int:
+        return column.ints.at(row);
+    case Real:
+        if (column.isInt.testBit(row))
+            return int(column.reals.at(row));
+        return column.reals.at(row);
+    case Bool:
+        return bool(column.ints.at(row));
+    case String:
+        return m_strings.at(column.ints.at(row));
+    case Variant:
+        return column.variants.at(row);
+    default:
+        return QVariant();
+    }
+}
+
+QVariant ListModelColumns::value(int row, int role) const
+{
+    Q_ASSERT(row >= 0 && row < m_count);
+    if (role < 0 || role >= m_columns.count())
+        return QVariant();
+    return cell(m_columns.at(role), row);
+}
+
+/*
+    Sets the value of \a role in \a row, and returns true if it has changed.
+*/
+bool ListModelColumns::setValue(int row, int role, const QVariant &value)
+{
+    Q_ASSERT(row >= 0 && row < m_count && role >= 0);
+    if (role >= m_columns.count())
+        m_columns.resize(role + 1);
+
+    Column &column = m_columns[role];
+    Type type = typeOf(value);
+    if (column.type == Empty) {
+        column.type = type;
+        column.isSet.resize(m_count);
+        if (type == Real) {
+            column.reals.resize(m_count);
+            column.isInt.resize(m_count);
+        } else if (type == Variant) {
+            column.variants.resize(m_count);
+        } else {
+            column.ints.resize(m_count);
+        }
+    } else if (column.type != type && column.type != Variant) {
+        if (column.type == Int && type == Real)
+            convertToReal(&column);
+        else if (column.type != Real || type != Int)
+            convertToVariant(&column);
+    }
+
+    bool wasSet = column.isSet.testBit(row);
+    switch (column.type) {
+    case Int:
+    case Bool: {
+        int v = column.type == Int ? value.toInt() : int(value.toBool());
+        if (wasSet && column.ints.at(row) == v)
+            return false;
+        column.ints[row] = v;
+        break;
+    }
+    case String: {
+        int v = acquireString(value.toString());
+        if (wasSet) {
+            // Releasing the old string cannot free the new one, which was just acquired
+            int old = column.ints.at(row);
+            releaseString(old);
+            if (old == v)
+                return false;
+        }
+        column.ints[row] = v;
+        break;
+    }
+    case Real: {
+        double v = value.toDouble();
+        bool isInt = type == Int;
+        if (wasSet && column.reals.at(row) == v && column.isInt.testBit(row) == isInt)
+            return false;
+        column.reals[row] = v;
+        column.isInt.setBit(row, isInt);
+        break;
+    }
+    default:
+        if (wasSet && column.variants.at(row) == value)
+            return false;
+        column.variants[row] = value;
+        break;
+    }
+
+    column.isSet.setBit(row);
+    return true;
+}
+
+void ListModelColumns::convertToReal(Column *column)
+{
+    column->reals.resize(m_count);
+    for (int i=0; i<m_count; i++)
+        column->reals[i] = column->ints.at(i);
+
+    column->type = Real;
+    column->isInt = column->isSet;
+    column->ints.clear();
+}
+
+void ListModelColumns::convertToVariant(Column *column)
+{
+    QVector<QVariant> variants(m_count);
+    for (int i=0; i<m_count; i++)
+        variants[i] = cell(*column, i);
+
+    releaseStrings(*column, 0, m_count);
+
+    column->type = Variant;
+    column->isInt.clear();
+    column->ints.clear();
+    column->reals.clear();
+    column->variants = variants;
+}
+
+/*
+    Releases the strings of the \a count cells of \a column starting at \a row,
+    if it is a String column.
+*/
+void ListModelColumns::releaseStrings(const Column &column, int row, int count)
+{
+    if (column.type != String)
+        return;
+    for (int i=row; i<row + count; i++) {
+        if (column.isSet.testBit(i))
+            releaseString(column.ints.at(i));
+    }
+}
+
+/*
+    Returns the index of \a string in the string table and adds a reference
+    to it, adding the string if it is not yet in the table.
+*/
+int ListModelColumns::acquireString(const QString &string)
+{
+    QHash<QString, int>::ConstIterator iter = m_stringIndexes.constFind(string);
+    if (iter != m_stringIndexes.constEnd()) {
+        ++m_stringRefs[*iter];
+        return *iter;
+    }
+
+    int index;
+    if (!m_freeStrings.isEmpty()) {
+        index = m_freeStrings.last();
+        m_freeStrings.remove(m_freeStrings.count() - 1);
+        m_strings[index] = string;
+        m_stringRefs[index] = 1;
+    } else {
+        index = m_strings.count();
+        m_strings.append(string);
+        m_stringRefs.append(1);
+    }
+    m_stringIndexes.insert(string, index);
+    return index;
+}
+
+void ListModelColumns::releaseString(int index)
+{
+    Q_ASSERT(m_stringRefs.at(index) > 0);
+    if (--m_stringRefs[index] == 0) {
+        m_stringIndexes.remove(m_strings.at(index));
+        m_strings[index] = QString();
+        m_freeStrings.append(index);
+    }
+}
+
+void ListModelColumns::insertRows(int row, int count)
+{
+    Q_ASSERT(row >= 0 && row <= m_count);
+    for (int i=0; i<m_columns.count(); i++) {
+        Column &column = m_columns[i];
+        switch (column.type) {
+        case Empty:
+            continue;
+        case Real:
+            column.reals.insert(row, count, 0.);
+            qdeclarativelistmodel_insert(row, count, &column.isInt);
+            break;
+        case Variant:
+            column.variants.insert(row, count, QVariant());
+            break;
+        default:
+            column.ints.insert(row, count, 0);
+            break;
+        }
+        qdeclarativelistmodel_insert(row, count, &column.isSet);
+    }
+    m_count += count;
+}
+
+void ListModelColumns::removeRows(int row, int count)
+{
+    Q_ASSERT(row >= 0 && row + count <= m_count);
+    for (int i=0; i<m_columns.count(); i++) {
+        Column &column = m_columns[i];
+        switch (column.type) {
+        case Empty:
+            continue;
+        case Real:
+            column.reals.remove(row, count);
+            qdeclarativelistmodel_remove(row, count, &column.isInt);
+            break;
+        case Variant:
+            column.variants.remove(row, count);
+            break;
+        default:
+            releaseStrings(column, row, count);
+            column.ints.remove(row, count);
+            break;
+        }
+        qdeclarativelistmodel_remove(row, count, &column.isSet);
+    }
+    m_count -= count;
+}
+
+/*
+    Moves \a count rows at \a from to \a to, where \a from is less than \a to.
+*/
+void ListModelColumns::moveRows(int from, int to, int count)
+{
+    Q_ASSERT(from < to && to + count <= m_count);
+    for (int i=0; i<m_columns.count(); i++) {
+        Column &column = m_columns[i];
+        switch (column.type) {
+        case Empty:
+            continue;
+        case Real:
+            qdeclarativelistmodel_move(from, to, count, &column.reals);
+            qdeclarativelistmodel_move(from, to, count, &column.isInt);
+            break;
+        case Variant:
+            qdeclarativelistmodel_move(from, to, count, &column.variants);
+            break;
+        default:
+            qdeclarativelistmodel_move(from, to, count, &column.ints);
+            break;
+        }
+        qdeclarativelistmodel_move(from, to, count, &column.isSet);
+    }
+}
+
+void ListModelColumns::clear()
+{
+    m_count = 0;
+    m_columns.clear();
+    m_strings.clear();
+    m_stringRefs.clear();
+    m_freeStrings.clear();
+    m_stringIndexes.clear();
+}
+
 FlatListModel::FlatListModel(QDeclarativeListModel *base)
 : m_engine(0), m_listModel(base), m_parentAgent(0)
 {
@@ -1072,9 +1544,7 @@ FlatListModel::~FlatListModel()
 QVariant FlatListModel::data(int index, int role) const
 {
     Q_ASSERT(index >= 0 && index < m_values.count());
-    if (m_values[index].contains(role))
-        return m_values[index][role];
-    return QVariant();
+    return m_values.value(index, role);
 }
 
 QList<int> FlatListModel::roles() const
@@ -1104,20 +1574,40 @@ void FlatListModel::clear()
 
 void FlatListModel::remove(int index)
 {
-    m_values.removeAt(index);
+    m_values.removeRows(index, 1);
     removedNode(index);
 }
 
-bool FlatListModel::insert(int index, v8::Handle<v8::Value> value)
+bool FlatListModel::insert(int index, v8::Handle<v8::Value> value, bool *hasNested)
 {
     Q_ASSERT(index >= 0 && index <= m_values.count());
 
-    QHash<int, QVariant> row;
-    if (!addValue(value, &row, 0))
-        return false;
+    // Read all of the rows before inserting any, so that neither rows nor
+    // roles are added if one of them cannot be added
+    QList<Row> rows;
+    if (value->IsArray()) {
+        v8::Handle<v8::Array> array = v8::Handle<v8::Array>::Cast(value);
+        uint32_t length = array->Length();
+        for (uint32_t ii = 0; ii < length; ++ii) {
+            Row row;
+            if (!readValue(array->Get(ii), &row, hasNested))
+                return false;
+            rows.append(row);
+        }
+    } else {
+        Row row;
+        if (!readValue(value, &row, hasNested))
+            return false;
+        rows.append(row);
+    }
 
-    m_values.insert(index, row);
-    insertedNode(index);
+    m_values.insertRows(index, rows.count());
+    for (int i=0; i<rows.count(); i++) {
+        const Row &row = rows.at(i);
+        for (Row::ConstIterator iter = row.constBegin(); iter != row.constEnd(); ++iter)
+            m_values.setValue(index + i, role(iter->first), iter->second);
+        insertedNode(index + i);
+    }
 
     return true;
 }
@@ -1156,42 +1646,43 @@ v8::Handle<v8::Value> FlatListModel::get(int index) const
     return rv;
 }
 
-void FlatListModel::set(int index, v8::Handle<v8::Value> value, QList<int> *roles)
+bool FlatListModel::set(int index, v8::Handle<v8::Value> value, QList<int> *roles, bool *hasNested)
 {
     Q_ASSERT(index >= 0 && index < m_values.count());
 
-    QHash<int, QVariant> row = m_values[index];
-    if (addValue(value, &row, roles))
-        m_values[index] = row;
+    Row row;
+    if (!readValue(value, &row, hasNested))
+        return false;
+
+    for (Row::ConstIterator iter = row.constBegin(); iter != row.constEnd(); ++iter) {
+        int r = role(iter->first);
+        if (m_values.setValue(index, r, iter->second) && roles)
+            roles->append(r);
+    }
+    return true;
 }
 
 void FlatListModel::setProperty(int index, const QString& property, const QVariant& value, QList<int> *roles)
 {
     Q_ASSERT(index >= 0 && index < m_values.count());
 
-    QHash<QString, int>::Iterator iter = m_strings.find(property);
-    int role;
-    if (iter == m_strings.end()) {
-        role = m_roles.count();
-        m_roles.insert(role, property);
-        m_strings.insert(property, role);
-    } else {
-        role = iter.value();
-    }
-
-    if (m_values[index][role] != value) {
-        roles->append(role);
-        m_values[index][role] = value;
-    }
+    int r = role(property);
+    if (m_values.setValue(index, r, value))
+        roles->append(r);
 }
 
 void FlatListModel::move(int from, int to, int n)
 {
-    qdeclarativelistmodel_move<QList<QHash<int, QVariant> > >(from, to, n, &m_values);
+    m_values.moveRows(from, to, n);
     moveNodes(from, to, n);
 }
 
-bool FlatListModel::addValue(v8::Handle<v8::Value> value, QHash<int, QVariant> *row, QList<int> *roles)
+/*
+    Reads the properties of \a value into \a row without adding any roles.
+    If \a value contains list-type data, false is returned and \a hasNested
+    is set if it is given; otherwise a warning is printed.
+*/
+bool FlatListModel::readValue(v8::Handle<v8::Value> value, Row *row, bool *hasNested)
 {
     if (!value->IsObject())
         return false;
@@ -1204,30 +1695,33 @@ bool FlatListModel::addValue(v8::Handle<v8::Value> value, QHash<int, QVariant> *
         v8::Handle<v8::Value> jsv = value->ToObject()->Get(property);
 
         if (!jsv->IsRegExp() && !jsv->IsDate() && jsv->IsObject() && !engine()->isVariant(jsv)) {
-            qmlInfo(m_listModel) << "Cannot add list-type data when modifying or after modification from a worker script";
+            if (hasNested)
+                *hasNested = true;
+            else
+                qmlInfo(m_listModel) << "Cannot add list-type data when modifying or after modification from a worker script";
             return false;
         }
 
-        QString name = engine()->toString(property);
-        QVariant v = engine()->toVariant(jsv, -1);
-
-        QHash<QString, int>::Iterator iter = m_strings.find(name);
-        if (iter == m_strings.end()) {
-            int role = m_roles.count();
-            m_roles.insert(role, name);
-            iter = m_strings.insert(name, role);
-            if (roles)
-                roles->append(role);
-        } else {
-            int role = iter.value();
-            if (roles && row->contains(role) && row->value(role) != v)
-                roles->append(role);
-        }
-        row->insert(*iter, v);
+        row->append(qMakePair(engine()->toString(property), engine()->toVariant(jsv, -1)));
     }
     return true;
 }
 
+/*
+    Returns the role for \a name, adding it if the model does not have it yet.
+*/
+int FlatListModel::role(const QString &name)
+{
+    QHash<QString, int>::ConstIterator iter = m_strings.constFind(name);
+    if (iter != m_strings.constEnd())
+        return *iter;
+
+    int role = m_roles.count();
+    m_roles.insert(role, name);
+    m_strings.insert(name, role);
+    return role;
+}
+
 void FlatListModel::insertedNode(int index)
 {
     if (index >= 0 && index <= m_values.count()) {
@@ -1409,6 +1903,14 @@ void NestedListModel::remove(int index)
 
 bool NestedListModel::insert(int index, v8::Handle<v8::Value> valuemap)
 {
+    if (valuemap->IsArray()) {
+        v8::Handle<v8::Array> array = v8::Handle<v8::Array>::Cast(valuemap);
+        uint32_t length = array->Length();
+        for (uint32_t ii = 0; ii < length; ++ii)
+            insert(index + ii, array->Get(ii));
+        return true;
+    }
+
     if (!_root) {
         _root = new ModelNode(this);
         m_ownsRoot = true;
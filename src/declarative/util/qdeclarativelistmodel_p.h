@@ -107,7 +107,9 @@ private:
     void setProperty(int index, const QString& property, const QVariant& value, QList<int> *roles);
 
     bool flatten();
+    void unflatten();
     bool inWorkerThread() const;
+    bool canUnflatten() const;
 
     inline bool canMove(int from, int to, int n) const { return !(from+n > count() || to+n > count() || from < 0 || to < 0 || n < 0); }
 
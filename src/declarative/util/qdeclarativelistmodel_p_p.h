@@ -58,6 +58,10 @@
 #include "private/qdeclarativeopenmetaobject_p.h"
 #include "qdeclarative.h"
 
+#include <QtCore/qbitarray.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qvector.h>
+
 QT_BEGIN_HEADER
 
 QT_BEGIN_NAMESPACE
@@ -69,6 +73,64 @@ class QDeclarativeListModelWorkerAgent;
 struct ModelNode;
 class FlatNodeData;
 
+/*
+    ListModelColumns holds the data of a FlatListModel.  Values are stored
+    by role rather than by row: each role has a column that keeps its values
+    in a typed array, so that int, real, bool and string values do not need
+    a QVariant per cell and can be looked up by role and row in constant time.
+    Strings are stored as reference counted indexes into a table shared by
+    all columns, and a slot is reused once no cell refers to its string.
+
+    A column takes the type of the first value set in it.  An int column
+    becomes a real column when it is given a real, as script numbers are
+    converted to either, and remembers which cells were ints so that they
+    are read back as ints; other changes of type make the column hold QVariants.
+*/
+class ListModelColumns
+{
+public:
+    ListModelColumns() : m_count(0) {}
+
+    int count() const { return m_count; }
+
+    QVariant value(int row, int role) const;
+    bool setValue(int row, int role, const QVariant &value);
+
+    void insertRows(int row, int count);
+    void removeRows(int row, int count);
+    void moveRows(int from, int to, int count);
+    void clear();
+
+private:
+    enum Type { Empty, Int, Real, Bool, String, Variant };
+
+    struct Column {
+        Column() : type(Empty) {}
+
+        Type type;
+        QBitArray isSet;
+        QBitArray isInt;            // Real only, the cells that were set to ints
+        QVector<int> ints;          // Int, Bool, and String as an index into m_strings
+        QVector<double> reals;
+        QVector<QVariant> variants;
+    };
+
+    static Type typeOf(const QVariant &value);
+    QVariant cell(const Column &column, int row) const;
+    void convertToReal(Column *column);
+    void convertToVariant(Column *column);
+    void releaseStrings(const Column &column, int row, int count);
+    int acquireString(const QString &string);
+    void releaseString(int index);
+
+    int m_count;
+    QVector<Column> m_columns;
+    QStringList m_strings;
+    QVector<int> m_stringRefs;
+    QVector<int> m_freeStrings;
+    QHash<QString, int> m_stringIndexes;
+};
+
 class FlatListModel
 {
 public:
@@ -83,9 +145,9 @@ public:
     int count() const;
     void clear();
     void remove(int index);
-    bool insert(int index, v8::Handle<v8::Value>);
+    bool insert(int index, v8::Handle<v8::Value>, bool *hasNested = 0);
     v8::Handle<v8::Value> get(int index) const;
-    void set(int index, v8::Handle<v8::Value>, QList<int> *roles);
+    bool set(int index, v8::Handle<v8::Value>, QList<int> *roles, bool *hasNested = 0);
     void setProperty(int index, const QString& property, const QVariant& value, QList<int> *roles);
     void move(int from, int to, int count);
 
@@ -95,7 +157,9 @@ private:
     friend class QDeclarativeListModelV8Data;
     friend class FlatNodeData;
 
-    bool addValue(v8::Handle<v8::Value> value, QHash<int, QVariant> *row, QList<int> *roles);
+    typedef QList<QPair<QString, QVariant> > Row;
+    bool readValue(v8::Handle<v8::Value> value, Row *row, bool *hasNested);
+    int role(const QString &name);
     void insertedNode(int index);
     void removedNode(int index);
     void moveNodes(int from, int to, int n);
@@ -104,7 +168,7 @@ private:
     QV8Engine *m_engine;
     QHash<int, QString> m_roles;
     QHash<QString, int> m_strings;
-    QList<QHash<int, QVariant> > m_values;
+    ListModelColumns m_values;
     QDeclarativeListModel *m_listModel;
 
     QList<FlatNodeData *> m_nodeData;
@@ -175,6 +239,7 @@ public:
     QV8Engine *engine() const;
 private:
     friend struct ModelNode;
+    friend class QDeclarativeListModel;
     mutable QStringList roleStrings;
     mutable bool _rolesOk;
 };
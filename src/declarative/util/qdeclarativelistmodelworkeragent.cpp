@@ -143,7 +143,7 @@ void QDeclarativeListModelWorkerAgent::append(const QDeclarativeV8Handle &value)
     m_copy->append(value);
 
     if (m_copy->count() != count)
-        data.insertChange(m_copy->count() - 1, 1);
+        data.insertChange(count, m_copy->count() - count);
 }
 
 void QDeclarativeListModelWorkerAgent::insert(int index, const QDeclarativeV8Handle &value)
@@ -152,7 +152,7 @@ void QDeclarativeListModelWorkerAgent::insert(int index, const QDeclarativeV8Han
     m_copy->insert(index, value);
 
     if (m_copy->count() != count)
-        data.insertChange(index, 1);
+        data.insertChange(index, m_copy->count() - count);
 }
 
 QDeclarativeV8Handle QDeclarativeListModelWorkerAgent::get(int index) const
@@ -227,7 +227,8 @@ bool QDeclarativeListModelWorkerAgent::event(QEvent *e)
                 const Change &change = changes.at(ii);
                 switch (change.type) {
                 case Change::Inserted:
-                    orig->insertedNode(change.index);
+                    for (int i = 0; i < change.count; ++i)
+                        orig->insertedNode(change.index + i);
                     break;
                 case Change::Removed:
                     orig->removedNode(change.index);
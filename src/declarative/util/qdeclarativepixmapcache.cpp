@@ -64,24 +64,34 @@
 #include <QBuffer>
 #include <QWaitCondition>
 #include <QtCore/qdebug.h>
+#include <QtCore/qelapsedtimer.h>
 #include <private/qobject_p.h>
 #include <QSslError>
 
 #define IMAGEREQUEST_MAX_REQUEST_COUNT       8
+#define IMAGEREQUEST_MAX_DECODE_THREADS      8
 #define IMAGEREQUEST_MAX_REDIRECT_RECURSION 16
 #define CACHE_EXPIRE_TIME 30
 #define CACHE_REMOVAL_FRACTION 4
+#define CACHE_EVICTION_WINDOW 8
 
 QT_BEGIN_NAMESPACE
 
-// The cache limit describes the maximum "junk" in the cache.
-// These are the same defaults as QPixmapCache
+// The cache limit describes the maximum "junk" in the cache.  The cache is shared by
+// all engines in the process, so the limit is too; it can be changed with
+// QML_PIXMAP_CACHE_LIMIT (in bytes) or QDeclarativePixmap::setCacheLimit().
+// Textures were once costed in pixels; these keep the same number of 32-bit
+// textures in the cache now that they are costed in bytes.
 #if defined(Q_WS_QWS) || defined(Q_WS_WINCE)
-static int cache_limit = 2048 * 1024; // 2048 KB cache limit for embedded
+static int cache_limit = 2048 * 1024 * 4; // 8 MB cache limit for embedded
 #else
-static int cache_limit = 128 * 1024; // 10 MB cache limit for desktop
+static int cache_limit = 128 * 1024 * 4; // 512 KB cache limit for desktop
 #endif
 
+// The number of threads that decode local files and downloaded data, per engine.
+// 0 means one per core.
+static int decode_thread_count = qgetenv("QML_IMAGE_DECODE_THREADS").toInt();
+
 class QDeclarativePixmapReader;
 class QDeclarativePixmapData;
 class QDeclarativePixmapReply : public QObject
@@ -99,11 +109,14 @@ public:
 
     bool loading;
     int redirectCount;
+    int priority;
+    int decodeTime;
 
     class Event : public QEvent {
     public:
         Event(ReadError, const QString &, const QSize &, const QImage &image);
         Event(ReadError, const QString &, const QSize &, QSGTexture *t, QSGContext *context, const QImage &image);
+        Event(QSGContext *context, const QByteArray &encodedData);
 
         ReadError error;
         QString errorString;
@@ -111,9 +124,11 @@ public:
         QImage image;
         QSGTexture *texture;
         QSGContext *context;
+        QByteArray encodedData;
     };
     void postReply(ReadError, const QString &, const QSize &, const QImage &);
     void postReply(ReadError, const QString &, const QSize &, QSGTexture *t, QSGContext *context, const QImage &image);
+    void postReply(QSGContext *context, const QByteArray &encodedData);
 
 
 Q_SIGNALS:
@@ -143,6 +158,18 @@ private:
     QDeclarativePixmapReader *reader;
 };
 
+class QDeclarativePixmapDecoder : public QThread
+{
+public:
+    QDeclarativePixmapDecoder(QDeclarativePixmapReader *);
+
+protected:
+    virtual void run();
+
+private:
+    QDeclarativePixmapReader *reader;
+};
+
 class QDeclarativePixmapData;
 class QDeclarativePixmapReader : public QThread
 {
@@ -153,6 +180,7 @@ public:
 
     QDeclarativePixmapReply *getImage(QDeclarativePixmapData *);
     void cancel(QDeclarativePixmapReply *rep);
+    void setPriority(QDeclarativePixmapReply *rep, int priority);
 
     static QDeclarativePixmapReader *instance(QDeclarativeEngine *engine);
 
@@ -161,12 +189,34 @@ protected:
 
 private:
     friend class QDeclarativePixmapReaderThreadObject;
+    friend class QDeclarativePixmapDecoder;
     void processJobs();
     void processJob(QDeclarativePixmapReply *, const QUrl &, const QSize &);
     void networkRequestDone(QNetworkReply *);
 
+    // Local files, and the data of finished network requests, are decoded by a
+    // pool of decoder threads.  The reader thread only drives network requests
+    // and image providers.
+    struct DecodeJob {
+        QDeclarativePixmapReply *reply;
+        QUrl url;
+        QSize requestSize;
+        QString localFile;
+        QByteArray data;
+    };
+    void queueDecode(const DecodeJob &);
+    void removeDecodeJob(QDeclarativePixmapReply *);
+    bool takeDecodeJob(DecodeJob *);
+    void decode(const DecodeJob &);
+
     QList<QDeclarativePixmapReply*> jobs;
     QList<QDeclarativePixmapReply*> cancelled;
+    QList<DecodeJob> decodeJobs;
+    QList<QDeclarativePixmapReply*> decoding;
+    QList<QDeclarativePixmapDecoder *> decoders;
+    int maxDecoders;
+    int idleDecoders;
+    bool quitDecoders;
     QDeclarativeEngine *engine;
     QObject *eventLoopQuitHack;
 
@@ -191,35 +241,35 @@ class QDeclarativePixmapData
 {
 public:
     QDeclarativePixmapData(const QUrl &u, const QSize &s, const QString &e)
-    : refCount(1), inCache(false), pixmapStatus(QDeclarativePixmap::Error), 
+    : refCount(1), inCache(false), pinned(false), pixmapStatus(QDeclarativePixmap::Error), 
       url(u), errorString(e), requestSize(s), texture(0), context(0), reply(0), prevUnreferenced(0),
       prevUnreferencedPtr(0), nextUnreferenced(0)
     {
     }
 
     QDeclarativePixmapData(const QUrl &u, const QSize &r)
-    : refCount(1), inCache(false), pixmapStatus(QDeclarativePixmap::Loading), 
+    : refCount(1), inCache(false), pinned(false), pixmapStatus(QDeclarativePixmap::Loading), 
       url(u), requestSize(r), texture(0), context(0), reply(0), prevUnreferenced(0), prevUnreferencedPtr(0),
       nextUnreferenced(0)
     {
     }
 
     QDeclarativePixmapData(const QUrl &u, const QPixmap &p, const QSize &s, const QSize &r)
-    : refCount(1), inCache(false), privatePixmap(false), pixmapStatus(QDeclarativePixmap::Ready),
+    : refCount(1), inCache(false), privatePixmap(false), pinned(false), pixmapStatus(QDeclarativePixmap::Ready),
       url(u), pixmap(p), implicitSize(s), requestSize(r), texture(0), context(0), reply(0), prevUnreferenced(0),
       prevUnreferencedPtr(0), nextUnreferenced(0)
     {
     }
 
     QDeclarativePixmapData(const QUrl &u, QSGTexture *t, QSGContext *c, const QPixmap &p, const QSize &s, const QSize &r)
-    : refCount(1), inCache(false), privatePixmap(false), pixmapStatus(QDeclarativePixmap::Ready),
+    : refCount(1), inCache(false), privatePixmap(false), pinned(false), pixmapStatus(QDeclarativePixmap::Ready),
       url(u), pixmap(p), implicitSize(s), requestSize(r), texture(t), context(c), reply(0), prevUnreferenced(0),
       prevUnreferencedPtr(0), nextUnreferenced(0)
     {
     }
 
     QDeclarativePixmapData(const QPixmap &p)
-    : refCount(1), inCache(false), privatePixmap(true), pixmapStatus(QDeclarativePixmap::Ready),
+    : refCount(1), inCache(false), privatePixmap(true), pinned(false), pixmapStatus(QDeclarativePixmap::Ready),
       pixmap(p), implicitSize(p.size()), requestSize(p.size()), texture(0), context(0), reply(0), prevUnreferenced(0),
       prevUnreferencedPtr(0), nextUnreferenced(0)
     {
@@ -242,6 +292,7 @@ public:
 
     bool inCache:1;
     bool privatePixmap:1;
+    bool pinned:1;
     
     QDeclarativePixmap::Status pixmapStatus;
     QUrl url;
@@ -288,6 +339,12 @@ void QDeclarativePixmapReply::postReply(ReadError error, const QString &errorStr
     QCoreApplication::postEvent(this, new Event(error, errorString, implicitSize, texture, context, image));
 }
 
+void QDeclarativePixmapReply::postReply(QSGContext *context, const QByteArray &encodedData)
+{
+    loading = false;
+    QCoreApplication::postEvent(this, new Event(context, encodedData));
+}
+
 QDeclarativePixmapReply::Event::Event(ReadError e, const QString &s, const QSize &iSize, const QImage &i)
     : QEvent(QEvent::User), error(e), errorString(s), implicitSize(iSize), image(i), texture(0), context(0)
 {
@@ -298,6 +355,11 @@ QDeclarativePixmapReply::Event::Event(ReadError e, const QString &s, const QSize
 {
 }
 
+QDeclarativePixmapReply::Event::Event(QSGContext *c, const QByteArray &d)
+    : QEvent(QEvent::User), error(NoError), texture(0), context(c), encodedData(d)
+{
+}
+
 QNetworkAccessManager *QDeclarativePixmapReader::networkAccessManager()
 {
     if (!accessManager) {
@@ -350,8 +412,11 @@ static bool readImage(const QUrl& url, QIODevice *dev, QImage *image, QString *e
 }
 
 QDeclarativePixmapReader::QDeclarativePixmapReader(QDeclarativeEngine *eng)
-: QThread(eng), engine(eng), threadObject(0), accessManager(0)
+: QThread(eng), idleDecoders(0), quitDecoders(false), engine(eng), threadObject(0), accessManager(0)
 {
+    maxDecoders = decode_thread_count > 0 ? decode_thread_count : QThread::idealThreadCount();
+    maxDecoders = qBound(1, maxDecoders, IMAGEREQUEST_MAX_DECODE_THREADS);
+
     eventLoopQuitHack = new QObject;
     eventLoopQuitHack->moveToThread(this);
     connect(eventLoopQuitHack, SIGNAL(destroyed(QObject*)), SLOT(quit()), Qt::DirectConnection);
@@ -366,6 +431,15 @@ QDeclarativePixmapReader::~QDeclarativePixmapReader()
 
     eventLoopQuitHack->deleteLater();
     wait();
+
+    mutex.lock();
+    quitDecoders = true;
+    waitCondition.wakeAll();
+    mutex.unlock();
+
+    foreach (QDeclarativePixmapDecoder *decoder, decoders)
+        decoder->wait();
+    qDeleteAll(decoders);
 }
 
 void QDeclarativePixmapReader::networkRequestDone(QNetworkReply *reply)
@@ -392,38 +466,19 @@ void QDeclarativePixmapReader::networkRequestDone(QNetworkReply *reply)
             }
         }
 
-        QImage image;
-        QSGTexture *texture = 0;
-        QSGContext *ctx = QDeclarativeEnginePrivate::get(engine)->sgContext;
-        QDeclarativePixmapReply::ReadError error = QDeclarativePixmapReply::NoError;
-        QString errorString;
-        QSize readSize;
-        if (reply->error()) {
-            error = QDeclarativePixmapReply::Loading;
-            errorString = reply->errorString();
-        } else {
-            QByteArray all = reply->readAll();
-            QBuffer buff(&all);
-            buff.open(QIODevice::ReadOnly);
-            if (ctx && ctx->canDecodeImageToTexture())
-                texture = ctx->decodeImageToTexture(&buff, &readSize, job->requestSize);
-            if (!texture) {
-                if (!readImage(reply->url(), &buff, &image, &errorString, &readSize, job->requestSize)) {
-                    error = QDeclarativePixmapReply::Decoding;
-                } else if (ctx) {
-                    texture = ctx->createTexture(image);
-                }
-            }
-        }
-        // send completion event to the QDeclarativePixmapReply
         mutex.lock();
         if (!cancelled.contains(job)) {
-            if (texture)
-                job->postReply(error, errorString, readSize, texture, ctx, image);
-            else
-                job->postReply(error, errorString, readSize, image);
-        } else {
-            delete texture;
+            if (reply->error()) {
+                // send completion event to the QDeclarativePixmapReply
+                job->postReply(QDeclarativePixmapReply::Loading, reply->errorString(), QSize(), QImage());
+            } else {
+                DecodeJob decodeJob;
+                decodeJob.reply = job;
+                decodeJob.url = reply->url();
+                decodeJob.requestSize = job->requestSize;
+                decodeJob.data = reply->readAll();
+                queueDecode(decodeJob);
+            }
         }
         mutex.unlock();
     }
@@ -464,35 +519,45 @@ void QDeclarativePixmapReader::processJobs()
     QMutexLocker locker(&mutex);
 
     while (true) {
-        if (cancelled.isEmpty() && (jobs.isEmpty() || replies.count() >= IMAGEREQUEST_MAX_REQUEST_COUNT)) 
-            return; // Nothing else to do
+        // Clean cancelled jobs.  Jobs that are being decoded are cleaned by their decoder.
+        for (int i = 0; i < cancelled.count();) {
+            QDeclarativePixmapReply *job = cancelled.at(i);
+            if (decoding.contains(job)) {
+                ++i;
+                continue;
+            }
 
-        // Clean cancelled jobs
-        if (cancelled.count()) {
-            for (int i = 0; i < cancelled.count(); ++i) {
-                QDeclarativePixmapReply *job = cancelled.at(i);
-                QNetworkReply *reply = replies.key(job, 0);
-                if (reply && reply->isRunning()) {
-                    // cancel any jobs already started
-                    replies.remove(reply);
+            QNetworkReply *reply = replies.key(job, 0);
+            if (reply) {
+                // cancel any jobs already started
+                replies.remove(reply);
+                if (reply->isRunning())
                     reply->close();
-                }
-                // deleteLater, since not owned by this thread
-                job->deleteLater();
             }
-            cancelled.clear();
+            removeDecodeJob(job);
+            // deleteLater, since not owned by this thread
+            job->deleteLater();
+            cancelled.removeAt(i);
         }
 
-        if (!jobs.isEmpty() && replies.count() < IMAGEREQUEST_MAX_REQUEST_COUNT) {
-            QDeclarativePixmapReply *runningJob = jobs.takeLast();
-            runningJob->loading = true;
+        if (jobs.isEmpty() || replies.count() >= IMAGEREQUEST_MAX_REQUEST_COUNT)
+            return; // Nothing else to do
 
-            QUrl url = runningJob->data->url;
-            QSize requestSize = runningJob->data->requestSize;
-            locker.unlock();
-            processJob(runningJob, url, requestSize);
-            locker.relock();
+        // The most recent of the requests with the highest priority
+        int next = jobs.count() - 1;
+        for (int i = next - 1; i >= 0; --i) {
+            if (jobs.at(i)->priority > jobs.at(next)->priority)
+                next = i;
         }
+
+        QDeclarativePixmapReply *runningJob = jobs.takeAt(next);
+        runningJob->loading = true;
+
+        QUrl url = runningJob->data->url;
+        QSize requestSize = runningJob->data->requestSize;
+        locker.unlock();
+        processJob(runningJob, url, requestSize);
+        locker.relock();
     }
 }
 
@@ -512,12 +577,8 @@ void QDeclarativePixmapReader::processJob(QDeclarativePixmapReply *runningJob, c
             QString errorStr = QDeclarativePixmap::tr("Invalid image provider: %1").arg(url.toString());
             QImage image;
             mutex.lock();
-            if (!cancelled.contains(runningJob)) {
-                if (sgContext)
-                    runningJob->postReply(errorCode, errorStr, readSize, sgContext->createTexture(image), sgContext, image);
-                else
-                    runningJob->postReply(errorCode, errorStr, readSize, image);
-            }
+            if (!cancelled.contains(runningJob))
+                runningJob->postReply(errorCode, errorStr, readSize, image);
             mutex.unlock();
         } else if (imageType == QDeclarativeImageProvider::Image) {
             QImage image = ep->getImageFromProvider(url, &readSize, requestSize);
@@ -528,12 +589,8 @@ void QDeclarativePixmapReader::processJob(QDeclarativePixmapReply *runningJob, c
                 errorStr = QDeclarativePixmap::tr("Failed to get image from provider: %1").arg(url.toString());
             }
             mutex.lock();
-            if (!cancelled.contains(runningJob)) {
-                if (sgContext)
-                    runningJob->postReply(errorCode, errorStr, readSize, sgContext->createTexture(image), sgContext, image);
-                else
-                    runningJob->postReply(errorCode, errorStr, readSize, image);
-            }
+            if (!cancelled.contains(runningJob))
+                runningJob->postReply(errorCode, errorStr, readSize, 0, sgContext, image);
             mutex.unlock();
         } else {
             QSGTexture *t = ep->getTextureFromProvider(url, &readSize, requestSize);
@@ -551,51 +608,131 @@ void QDeclarativePixmapReader::processJob(QDeclarativePixmapReply *runningJob, c
         }
 
     } else {
-        QString lf = QDeclarativeEnginePrivate::urlToLocalFileOrQrc(url);
-        if (!lf.isEmpty()) {
-            // Image is local - load/decode immediately
-            QImage image;
-            QDeclarativePixmapReply::ReadError errorCode = QDeclarativePixmapReply::NoError;
-            QString errorStr;
-            QFile f(lf);
-            QSize readSize;
-            QSGTexture *texture = 0;
-            if (f.open(QIODevice::ReadOnly)) {
-                if (sgContext && sgContext ->canDecodeImageToTexture())
-                    texture = sgContext->decodeImageToTexture(&f, &readSize, requestSize);
-                if (!texture) {
-                    if (!readImage(url, &f, &image, &errorStr, &readSize, requestSize)) {
-                        errorCode = QDeclarativePixmapReply::Loading;
-                    } else if (sgContext) {
-                        texture = sgContext->createTexture(image);
-                    }
-                }
-            } else {
-                errorStr = QDeclarativePixmap::tr("Cannot open: %1").arg(url.toString());
-                errorCode = QDeclarativePixmapReply::Loading;
-            }
-            mutex.lock();
-            if (!cancelled.contains(runningJob)) {
-                if (texture)
-                    runningJob->postReply(errorCode, errorStr, readSize, texture, sgContext, image);
-                else
-                    runningJob->postReply(errorCode, errorStr, readSize, image);
-            } else {
-                delete texture;
-            }
-            mutex.unlock();
-        } else {
-            // Network resource
-            QNetworkRequest req(url);
-            req.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
-            QNetworkReply *reply = networkAccessManager()->get(req);
+        // Network resource.  Local files are queued straight to the decoders by getImage().
+        QNetworkRequest req(url);
+        req.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
+        QNetworkReply *reply = networkAccessManager()->get(req);
+
+        QMetaObject::connect(reply, replyDownloadProgress, runningJob, downloadProgress);
+        QMetaObject::connect(reply, replyFinished, threadObject, threadNetworkRequestDone);
+
+        replies.insert(reply, runningJob);
+    }
+}
+
+// Must be called with the mutex locked
+void QDeclarativePixmapReader::queueDecode(const DecodeJob &job)
+{
+    decodeJobs.append(job);
+
+    // Decoders are started on demand
+    if (!idleDecoders && decoders.count() < maxDecoders)
+        decoders.append(new QDeclarativePixmapDecoder(this));
+    else
+        waitCondition.wakeOne();
+}
+
+// Must be called with the mutex locked
+void QDeclarativePixmapReader::removeDecodeJob(QDeclarativePixmapReply *reply)
+{
+    for (int i = 0; i < decodeJobs.count(); ++i) {
+        if (decodeJobs.at(i).reply == reply) {
+            decodeJobs.removeAt(i);
+            return;
+        }
+    }
+}
+
+bool QDeclarativePixmapReader::takeDecodeJob(DecodeJob *job)
+{
+    QMutexLocker locker(&mutex);
+
+    ++idleDecoders;
+    while (decodeJobs.isEmpty() && !quitDecoders)
+        waitCondition.wait(&mutex);
+    --idleDecoders;
+
+    if (quitDecoders)
+        return false;
 
-            QMetaObject::connect(reply, replyDownloadProgress, runningJob, downloadProgress);
-            QMetaObject::connect(reply, replyFinished, threadObject, threadNetworkRequestDone);
+    // The most recent of the requests with the highest priority
+    int next = decodeJobs.count() - 1;
+    for (int i = next - 1; i >= 0; --i) {
+        if (decodeJobs.at(i).reply->priority > decodeJobs.at(next).reply->priority)
+            next = i;
+    }
+
+    *job = decodeJobs.takeAt(next);
+    job->reply->loading = true;
+    decoding.append(job->reply);
+    return true;
+}
+
+void QDeclarativePixmapReader::decode(const DecodeJob &job)
+{
+    QSGContext *sgContext = QDeclarativeEnginePrivate::get(engine)->sgContext;
+    QElapsedTimer timer;
+    timer.start();
+
+    QImage image;
+    QDeclarativePixmapReply::ReadError errorCode = QDeclarativePixmapReply::NoError;
+    QString errorStr;
+    QSize readSize;
+    QByteArray encodedData;
+
+    QFile f(job.localFile);
+    QBuffer buff;
+    QIODevice *device = 0;
+    if (job.localFile.isEmpty()) {
+        buff.setData(job.data);
+        buff.open(QIODevice::ReadOnly);
+        device = &buff;
+    } else if (f.open(QIODevice::ReadOnly)) {
+        device = &f;
+    } else {
+        errorStr = QDeclarativePixmap::tr("Cannot open: %1").arg(job.url.toString());
+        errorCode = QDeclarativePixmapReply::Loading;
+    }
 
-            replies.insert(reply, runningJob);
+    // The scene graph context is not thread safe, so the decoders only ever
+    // produce QImages.  A context that decodes straight to textures is handed
+    // the encoded data instead, and QDeclarativePixmapReply::event() does the
+    // work on the context's thread.
+    if (device) {
+        if (sgContext && sgContext->canDecodeImageToTexture()) {
+            encodedData = device == &buff ? job.data : device->readAll();
+        } else if (!readImage(job.url, device, &image, &errorStr, &readSize, job.requestSize)) {
+            errorCode = device == &f ? QDeclarativePixmapReply::Loading
+                                     : QDeclarativePixmapReply::Decoding;
         }
     }
+
+    // send completion event to the QDeclarativePixmapReply
+    mutex.lock();
+    job.reply->decodeTime = timer.elapsed();
+    decoding.removeOne(job.reply);
+    if (cancelled.removeAll(job.reply)) {
+        // deleteLater, since not owned by this thread
+        job.reply->deleteLater();
+    } else if (!encodedData.isNull()) {
+        job.reply->postReply(sgContext, encodedData);
+    } else {
+        job.reply->postReply(errorCode, errorStr, readSize, 0, sgContext, image);
+    }
+    mutex.unlock();
+}
+
+QDeclarativePixmapDecoder::QDeclarativePixmapDecoder(QDeclarativePixmapReader *r)
+: reader(r)
+{
+    start(QThread::LowPriority);
+}
+
+void QDeclarativePixmapDecoder::run()
+{
+    QDeclarativePixmapReader::DecodeJob job;
+    while (reader->takeDecodeJob(&job))
+        reader->decode(job);
 }
 
 QDeclarativePixmapReader *QDeclarativePixmapReader::instance(QDeclarativeEngine *engine)
@@ -616,9 +753,23 @@ QDeclarativePixmapReply *QDeclarativePixmapReader::getImage(QDeclarativePixmapDa
     mutex.lock();
     QDeclarativePixmapReply *reply = new QDeclarativePixmapReply(data);
     reply->reader = this;
-    jobs.append(reply);
-    // XXX 
-    if (threadObject) threadObject->processJobs();
+
+    QString localFile;
+    if (data->url.scheme() != QLatin1String("image"))
+        localFile = QDeclarativeEnginePrivate::urlToLocalFileOrQrc(data->url);
+
+    if (!localFile.isEmpty()) {
+        DecodeJob job;
+        job.reply = reply;
+        job.url = data->url;
+        job.requestSize = data->requestSize;
+        job.localFile = localFile;
+        queueDecode(job);
+    } else {
+        jobs.append(reply);
+        // XXX 
+        if (threadObject) threadObject->processJobs();
+    }
     mutex.unlock();
     return reply;
 }
@@ -633,11 +784,19 @@ void QDeclarativePixmapReader::cancel(QDeclarativePixmapReply *reply)
         if (threadObject) threadObject->processJobs();
     } else {
         jobs.removeAll(reply);
+        removeDecodeJob(reply);
         delete reply;
     }
     mutex.unlock();
 }
 
+void QDeclarativePixmapReader::setPriority(QDeclarativePixmapReply *reply, int priority)
+{
+    mutex.lock();
+    reply->priority = priority;
+    mutex.unlock();
+}
+
 void QDeclarativePixmapReader::run()
 {
     if (replyDownloadProgress == -1) {
@@ -689,17 +848,23 @@ public:
     void unreferencePixmap(QDeclarativePixmapData *);
     void referencePixmap(QDeclarativePixmapData *);
 
+    void setLimit(int);
+    QDeclarativePixmap::CacheStatistics statistics() const;
+
 protected:
     virtual void timerEvent(QTimerEvent *);
 
 public:
     QHash<QDeclarativePixmapKey, QDeclarativePixmapData *> m_cache;
+    QDeclarativePixmap::CacheStatistics m_statistics;
+    int m_limit;
 
     void cleanTexturesForContext(QSGContext *context);
     void cleanTextureForContext(QDeclarativePixmapData *data);
 
 private:
     void shrinkCache(int remove);
+    void unlinkUnreferenced(QDeclarativePixmapData *);
 
     QDeclarativePixmapData *m_unreferencedPixmaps;
     QDeclarativePixmapData *m_lastUnreferencedPixmap;
@@ -717,8 +882,36 @@ void qt_declarative_pixmapstore_clean(QSGContext *context)
 
 
 QDeclarativePixmapStore::QDeclarativePixmapStore()
-: m_unreferencedPixmaps(0), m_lastUnreferencedPixmap(0), m_unreferencedCost(0), m_timerId(-1)
+: m_limit(cache_limit), m_unreferencedPixmaps(0), m_lastUnreferencedPixmap(0), m_unreferencedCost(0),
+  m_timerId(-1)
+{
+    bool ok = false;
+    int limit = qgetenv("QML_PIXMAP_CACHE_LIMIT").toInt(&ok);
+    if (ok && limit >= 0)
+        m_limit = limit;
+}
+
+void QDeclarativePixmapStore::setLimit(int limit)
 {
+    m_limit = limit;
+    shrinkCache(-1);
+}
+
+QDeclarativePixmap::CacheStatistics QDeclarativePixmapStore::statistics() const
+{
+    QDeclarativePixmap::CacheStatistics rv = m_statistics;
+
+    QHash<QDeclarativePixmapKey, QDeclarativePixmapData *>::ConstIterator it = m_cache.begin();
+    for (; it != m_cache.end(); ++it) {
+        if ((*it)->pixmapStatus == QDeclarativePixmap::Ready) {
+            rv.residentBytes += (*it)->cost();
+            if ((*it)->pinned)
+                rv.pinnedBytes += (*it)->cost();
+        }
+    }
+    rv.unreferencedBytes = m_unreferencedCost;
+
+    return rv;
 }
 
 void QDeclarativePixmapStore::cleanTextureForContext(QDeclarativePixmapData *data)
@@ -775,13 +968,18 @@ void QDeclarativePixmapStore::unreferencePixmap(QDeclarativePixmapData *data)
 
     m_unreferencedCost += data->cost();
 
-    shrinkCache(-1); // Shrink the cache incase it has become larger than cache_limit
+    shrinkCache(-1); // Shrink the cache incase it has become larger than m_limit
 
     if (m_timerId == -1 && m_unreferencedPixmaps) 
         m_timerId = startTimer(CACHE_EXPIRE_TIME * 1000);
 }
 
 void QDeclarativePixmapStore::referencePixmap(QDeclarativePixmapData *data)
+{
+    unlinkUnreferenced(data);
+}
+
+void QDeclarativePixmapStore::unlinkUnreferenced(QDeclarativePixmapData *data)
 {
     Q_ASSERT(data->prevUnreferencedPtr);
 
@@ -800,19 +998,33 @@ void QDeclarativePixmapStore::referencePixmap(QDeclarativePixmapData *data)
     m_unreferencedCost -= data->cost();
 }
 
+/*
+    Evicts unreferenced pixmaps until at least \a remove bytes have been freed and
+    the remaining ones fit the cache limit.  The largest of the few least recently
+    used pixmaps is evicted first, so that a single large image goes before several
+    small ones that are about as old.
+*/
 void QDeclarativePixmapStore::shrinkCache(int remove)
 {
-    while ((remove > 0 || m_unreferencedCost > cache_limit) && m_lastUnreferencedPixmap) {
+    while ((remove > 0 || m_unreferencedCost > m_limit) && m_lastUnreferencedPixmap) {
         QDeclarativePixmapData *data = m_lastUnreferencedPixmap;
         Q_ASSERT(data->nextUnreferenced == 0);
 
-        *data->prevUnreferencedPtr = 0;
-        m_lastUnreferencedPixmap = data->prevUnreferenced;
-        data->prevUnreferencedPtr = 0;
-        data->prevUnreferenced = 0;
+        int cost = data->cost();
+        QDeclarativePixmapData *candidate = data->prevUnreferenced;
+        for (int ii = 1; candidate && ii < CACHE_EVICTION_WINDOW; ++ii) {
+            const int candidateCost = candidate->cost();
+            if (candidateCost > cost) {
+                data = candidate;
+                cost = candidateCost;
+            }
+            candidate = candidate->prevUnreferenced;
+        }
 
-        remove -= data->cost();
-        m_unreferencedCost -= data->cost();
+        unlinkUnreferenced(data);
+
+        remove -= cost;
+        ++m_statistics.evictions;
         data->removeFromCache();
         delete data;
     }
@@ -831,7 +1043,8 @@ void QDeclarativePixmapStore::timerEvent(QTimerEvent *)
 }
 
 QDeclarativePixmapReply::QDeclarativePixmapReply(QDeclarativePixmapData *d)
-: data(d), reader(0), requestSize(d->requestSize), loading(false), redirectCount(0)
+: data(d), reader(0), requestSize(d->requestSize), loading(false), redirectCount(0), priority(0),
+  decodeTime(0)
 {
     if (finishedIndex == -1) {
         finishedIndex = QDeclarativePixmapReply::staticMetaObject.indexOfSignal("finished()");
@@ -849,7 +1062,25 @@ bool QDeclarativePixmapReply::event(QEvent *event)
 
         if (data) {
             Event *de = static_cast<Event *>(event);
+
+            // Textures are only created here, on the thread that owns the context
+            if (de->context && !de->texture && de->error == NoError) {
+                if (!de->encodedData.isNull()) {
+                    QBuffer buffer(&de->encodedData);
+                    buffer.open(QIODevice::ReadOnly);
+                    de->texture = de->context->decodeImageToTexture(&buffer, &de->implicitSize, requestSize);
+                    if (!de->texture) {
+                        buffer.seek(0);
+                        if (!readImage(data->url, &buffer, &de->image, &de->errorString, &de->implicitSize, requestSize))
+                            de->error = Decoding;
+                    }
+                }
+                if (!de->texture && de->error == NoError)
+                    de->texture = de->context->createTexture(de->image);
+            }
+
             data->pixmapStatus = (de->error == NoError) ? QDeclarativePixmap::Ready : QDeclarativePixmap::Error;
+            pixmapStore()->m_statistics.decodeTime += decodeTime;
 
             if (data->pixmapStatus == QDeclarativePixmap::Ready) {
                 if (de->texture) {
@@ -877,8 +1108,9 @@ bool QDeclarativePixmapReply::event(QEvent *event)
 int QDeclarativePixmapData::cost() const
 {
     if (texture) {
+        // Textures are uploaded as 32-bit RGBA
         const QSize textureSize = texture->textureSize();
-        return textureSize.width() * textureSize.height();
+        return textureSize.width() * textureSize.height() * 4;
     }
     return (pixmap.width() * pixmap.height() * pixmap.depth()) / 8;
 }
@@ -902,7 +1134,9 @@ void QDeclarativePixmapData::release()
         }
 
         if (pixmapStatus == QDeclarativePixmap::Ready) {
-            pixmapStore()->unreferencePixmap(this);
+            // Pinned pixmaps stay in the cache, and are never evicted
+            if (!pinned || !inCache)
+                pixmapStore()->unreferencePixmap(this);
         } else {
             removeFromCache();
             delete this;
@@ -1199,9 +1433,14 @@ void QDeclarativePixmap::load(QDeclarativeEngine *engine, const QUrl &url, const
             }
         }
 
+        ++store->m_statistics.misses;
+
         if (!(options & QDeclarativePixmap::Asynchronous)) {
             bool ok = false;
+            QElapsedTimer timer;
+            timer.start();
             d = createPixmapDataSync(engine, url, requestSize, &ok);
+            store->m_statistics.decodeTime += timer.elapsed();
             if (ok) {
                 if (options & QDeclarativePixmap::Cache)
                     d->addToCache();
@@ -1222,6 +1461,7 @@ void QDeclarativePixmap::load(QDeclarativeEngine *engine, const QUrl &url, const
 
         d->reply = reader->getImage(d);
     } else {
+        ++store->m_statistics.hits;
         d = *iter;
         d->addref();
     }
@@ -1245,6 +1485,74 @@ void QDeclarativePixmap::clear(QObject *obj)
     }
 }
 
+/*
+    Pins the pixmap if \a pinned is true.  A pinned pixmap that is cached stays in
+    the cache when it is no longer referenced, and is never evicted, until it is
+    unpinned again.  Unpinning only takes effect once all references are released.
+*/
+void QDeclarativePixmap::setPinned(bool pinned)
+{
+    if (d)
+        d->pinned = pinned;
+}
+
+bool QDeclarativePixmap::isPinned() const
+{
+    return d && d->pinned;
+}
+
+/*
+    Sets the maximum cost, in bytes, of the pixmaps that are kept in the cache
+    after they are no longer referenced, and evicts pixmaps as needed.  Pinned
+    pixmaps and pixmaps that are still referenced do not count.  The cache is
+    shared by all engines, so the limit applies to the whole process.
+*/
+void QDeclarativePixmap::setCacheLimit(int bytes)
+{
+    pixmapStore()->setLimit(bytes);
+}
+
+int QDeclarativePixmap::cacheLimit()
+{
+    return pixmapStore()->m_limit;
+}
+
+/*
+    Returns the counters of the pixmap cache, which is shared by all engines.
+*/
+QDeclarativePixmap::CacheStatistics QDeclarativePixmap::cacheStatistics()
+{
+    return pixmapStore()->statistics();
+}
+
+void QDeclarativePixmap::resetCacheStatistics()
+{
+    pixmapStore()->m_statistics = CacheStatistics();
+}
+
+/*
+    Sets the \a priority of a pending asynchronous request.  Requests with a higher
+    priority are started first; among requests with the same priority the most
+    recent one is started first.  Items that are not visible should use a lower
+    priority than visible ones.
+*/
+void QDeclarativePixmap::setPriority(int priority)
+{
+    if (d && d->reply)
+        d->reply->reader->setPriority(d->reply, priority);
+}
+
+/*
+    Sets the number of threads that decode images asynchronously for each engine
+    to \a count, or to one per core if \a count is 0.  This only affects engines
+    that have not loaded images yet.  The default can also be set with the
+    QML_IMAGE_DECODE_THREADS environment variable.
+*/
+void QDeclarativePixmap::setDecodeThreadCount(int count)
+{
+    decode_thread_count = count;
+}
+
 bool QDeclarativePixmap::connectFinished(QObject *object, const char *method)
 {
     if (!d || !d->reply) {
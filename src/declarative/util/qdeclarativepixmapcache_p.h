@@ -108,6 +108,31 @@ public:
     bool connectDownloadProgress(QObject *, const char *);
     bool connectDownloadProgress(QObject *, int);
 
+    void setPriority(int);
+    static void setDecodeThreadCount(int);
+
+    void setPinned(bool);
+    bool isPinned() const;
+
+    struct CacheStatistics {
+        CacheStatistics()
+        : hits(0), misses(0), evictions(0), residentBytes(0), pinnedBytes(0),
+          unreferencedBytes(0), decodeTime(0) {}
+
+        int hits;
+        int misses;
+        int evictions;
+        qint64 residentBytes;     // cost of all cached pixmaps that are ready
+        qint64 pinnedBytes;
+        qint64 unreferencedBytes; // cost of the cached pixmaps that may be evicted
+        qint64 decodeTime;        // in milliseconds
+    };
+
+    static void setCacheLimit(int);
+    static int cacheLimit();
+    static CacheStatistics cacheStatistics();
+    static void resetCacheStatistics();
+
 private:
     Q_DISABLE_COPY(QDeclarativePixmap)
     QDeclarativePixmapData *d;
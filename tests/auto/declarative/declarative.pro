@@ -30,11 +30,13 @@ PRIVATETESTS += \
     qdeclarativeapplication \
     qdeclarativebehaviors \
     qdeclarativebinding \
+    qdeclarativecompileddatacache \
     qdeclarativeconnection \
     qdeclarativedebug \
     qdeclarativedebugclient \
     qdeclarativedebughelper \
     qdeclarativedebugservice \
+    qdeclarativedebugtrace \
     qdeclarativeecmascript \
     qdeclarativeimageprovider \
     qdeclarativeinstruction \
@@ -61,6 +63,9 @@ SGTESTS =  \
     qsganimatedimage \
     qsgborderimage \
     qsgcanvas \
+    qsgcanvasitem \
+    qsgdefaultrenderer \
+    qsgdistancefielddiskcache \
     qsgflickable \
     qsgflipable \
     qsgfocusscope \
@@ -71,6 +76,7 @@ SGTESTS =  \
     qsgloader \
     qsgmousearea \
     qsgpathview \
+    qsgparticlesystem \
     qsgpincharea \
     qsgpositioners \
     qsgrepeater \
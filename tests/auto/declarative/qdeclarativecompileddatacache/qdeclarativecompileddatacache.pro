@@ -0,0 +1,8 @@
+load(qttest_p4)
+contains(QT_CONFIG,declarative): QT += declarative
+SOURCES += tst_qdeclarativecompileddatacache.cpp
+macx:CONFIG -= app_bundle
+
+CONFIG += parallel_test
+
+QT += core-private gui-private declarative-private
@@ -0,0 +1,280 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtTest/QtTest>
+#include <QtDeclarative/qdeclarativeengine.h>
+#include <QtDeclarative/qdeclarativecomponent.h>
+#include <private/qdeclarativeengine_p.h>
+#include <private/qdeclarativecompileddatacache_p.h>
+
+class tst_qdeclarativecompileddatacache : public QObject
+{
+    Q_OBJECT
+public:
+    tst_qdeclarativecompileddatacache() {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void roundTrip();
+    void staleSource();
+    void corruptFile_data();
+    void corruptFile();
+    void versionMismatch_data();
+    void versionMismatch();
+
+private:
+    QByteArray source(int value) const;
+    void writeSource(const QByteArray &);
+    bool isCached(const QByteArray &source) const;
+    bool create(int *value = 0);
+
+    QString path;
+    QString fileName;
+    QString cacheFileName;
+};
+
+void tst_qdeclarativecompileddatacache::initTestCase()
+{
+    path = QDir::tempPath() + QLatin1String("/tst_qdeclarativecompileddatacache");
+    fileName = path + QLatin1String("/Cached.qml");
+    cacheFileName = fileName + QLatin1Char('c');
+    cleanupTestCase();
+    QVERIFY(QDir().mkpath(path));
+}
+
+void tst_qdeclarativecompileddatacache::cleanupTestCase()
+{
+    QDir dir(path);
+    foreach (const QString &file, dir.entryList(QDir::Files))
+        dir.remove(file);
+    dir.rmdir(path);
+}
+
+void tst_qdeclarativecompileddatacache::init()
+{
+    QFile::remove(cacheFileName);
+}
+
+QByteArray tst_qdeclarativecompileddatacache::source(int value) const
+{
+    return "import QtQuick 2.0\n"
+           "Item {\n"
+           "    property int value: " + QByteArray::number(value) + "\n"
+           "    property string name: \"cached\"\n"
+           "    width: value * 2\n"
+           "    Item { objectName: \"child\"; height: parent.value + 1 }\n"
+           "}\n";
+}
+
+void tst_qdeclarativecompileddatacache::writeSource(const QByteArray &data)
+{
+    QFile file(fileName);
+    QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+    file.write(data);
+}
+
+bool tst_qdeclarativecompileddatacache::isCached(const QByteArray &data) const
+{
+    QDeclarativeCompiledDataCache cache;
+    return cache.load(cacheFileName, QDeclarativeCompiledDataCache::sourceHash(data));
+}
+
+// Creates the component in a new engine, so that it is not found in the type loader's
+// in memory cache, and checks that it behaves as described by source()
+bool tst_qdeclarativecompileddatacache::create(int *value)
+{
+    QDeclarativeEngine engine;
+    QDeclarativeTypeLoader &loader = QDeclarativeEnginePrivate::get(&engine)->typeLoader;
+    loader.setDiskCacheEnabled(true);
+    loader.setDiskCachePath(QString());
+
+    QDeclarativeComponent component(&engine, QUrl::fromLocalFile(fileName));
+    QObject *object = component.create();
+    if (!object) {
+        qWarning() << component.errors();
+        return false;
+    }
+
+    int v = object->property("value").toInt();
+    if (value)
+        *value = v;
+    QObject *child = object->findChild<QObject *>("child");
+    bool ok = object->property("name").toString() == QLatin1String("cached")
+              && object->property("width").toInt() == v * 2
+              && child && child->property("height").toInt() == v + 1;
+    delete object;
+    return ok;
+}
+
+void tst_qdeclarativecompileddatacache::roundTrip()
+{
+    writeSource(source(42));
+
+    int value = 0;
+    QVERIFY(create(&value));
+    QCOMPARE(value, 42);
+    QVERIFY(QFile::exists(cacheFileName));
+    QVERIFY(isCached(source(42)));
+
+    // The second engine restores the component from the cache, leaving it untouched
+    QByteArray cached;
+    {
+        QFile file(cacheFileName);
+        QVERIFY(file.open(QFile::ReadOnly));
+        cached = file.readAll();
+    }
+    value = 0;
+    QVERIFY(create(&value));
+    QCOMPARE(value, 42);
+    QFile file(cacheFileName);
+    QVERIFY(file.open(QFile::ReadOnly));
+    QCOMPARE(file.readAll(), cached);
+}
+
+void tst_qdeclarativecompileddatacache::staleSource()
+{
+    writeSource(source(42));
+    QVERIFY(create());
+    QVERIFY(isCached(source(42)));
+
+    // A cache compiled from another source is ignored and replaced
+    writeSource(source(7));
+    QVERIFY(!isCached(source(7)));
+
+    int value = 0;
+    QVERIFY(create(&value));
+    QCOMPARE(value, 7);
+    QVERIFY(isCached(source(7)));
+    QVERIFY(!isCached(source(42)));
+}
+
+void tst_qdeclarativecompileddatacache::corruptFile_data()
+{
+    QTest::addColumn<int>("size");      // bytes of the valid file kept, -1 for all of it
+    QTest::addColumn<QByteArray>("garbage");
+
+    QTest::newRow("empty") << 0 << QByteArray();
+    QTest::newRow("header only") << 12 << QByteArray();
+    QTest::newRow("truncated") << -2 << QByteArray();
+    QTest::newRow("garbage") << 0 << QByteArray(256, '\xa5');
+    QTest::newRow("garbage appended") << -1 << QByteArray("trailing");
+    QTest::newRow("garbage after header") << 64 << QByteArray(512, '\xff');
+}
+
+void tst_qdeclarativecompileddatacache::corruptFile()
+{
+    QFETCH(int, size);
+    QFETCH(QByteArray, garbage);
+
+    writeSource(source(42));
+    QVERIFY(create());
+
+    QByteArray data;
+    {
+        QFile file(cacheFileName);
+        QVERIFY(file.open(QFile::ReadOnly));
+        data = file.readAll();
+    }
+    QVERIFY(data.size() > 64);
+    if (size == -2)
+        size = data.size() / 2;
+    if (size >= 0)
+        data.truncate(size);
+    data += garbage;
+    {
+        QFile file(cacheFileName);
+        QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+        file.write(data);
+    }
+
+    // "garbage appended" still holds a complete cache, everything else must be rejected
+    if (size != -1)
+        QVERIFY(!isCached(source(42)));
+
+    // A corrupt cache falls back to compiling the source, and is rewritten
+    int value = 0;
+    QVERIFY(create(&value));
+    QCOMPARE(value, 42);
+    QVERIFY(isCached(source(42)));
+}
+
+void tst_qdeclarativecompileddatacache::versionMismatch_data()
+{
+    QTest::addColumn<int>("offset");
+    QTest::addColumn<int>("delta");
+
+    // The file starts with the magic number and the format version, followed by the build key
+    QTest::newRow("magic") << 3 << 1;
+    QTest::newRow("newer version") << 7 << 1;
+    QTest::newRow("older version") << 7 << -1;
+    QTest::newRow("build key") << 12 << 1;
+}
+
+void tst_qdeclarativecompileddatacache::versionMismatch()
+{
+    QFETCH(int, offset);
+    QFETCH(int, delta);
+
+    writeSource(source(42));
+    QVERIFY(create());
+    QVERIFY(isCached(source(42)));
+
+    {
+        QFile file(cacheFileName);
+        QVERIFY(file.open(QFile::ReadWrite));
+        QByteArray data = file.readAll();
+        QVERIFY(data.size() > offset);
+        data[offset] = char(data.at(offset) + delta);
+        QVERIFY(file.seek(0));
+        file.write(data);
+    }
+    QVERIFY(!isCached(source(42)));
+
+    int value = 0;
+    QVERIFY(create(&value));
+    QCOMPARE(value, 42);
+    QVERIFY(isCached(source(42)));
+}
+
+QTEST_MAIN(tst_qdeclarativecompileddatacache)
+
+#include "tst_qdeclarativecompileddatacache.moc"
@@ -46,6 +46,7 @@
 #include <QtDeclarative/qsgitem.h>
 #include <QtDeclarative/qdeclarativeproperty.h>
 #include <qcolor.h>
+#include "../../../shared/util.h"
 
 #ifdef Q_OS_SYMBIAN
 // In Symbian OS test data is located in applications private dir
@@ -63,6 +64,7 @@ private slots:
     void loadEmptyUrl();
     void qmlCreateObject();
     void qmlCreateObjectWithProperties();
+    void loadAsynchronous();
 
 private:
     QDeclarativeEngine engine;
@@ -160,6 +162,23 @@ void tst_qdeclarativecomponent::qmlCreateObjectWithProperties()
     delete testBindingThisObj;
 }
 
+void tst_qdeclarativecomponent::loadAsynchronous()
+{
+    QDeclarativeEngine engine;
+    QDeclarativeComponent component(&engine, QUrl::fromLocalFile(SRCDIR "/data/createObject.qml"),
+                                    QDeclarativeComponent::Asynchronous);
+    QVERIFY(component.isLoading());
+
+    QTRY_VERIFY(!component.isLoading());
+    QVERIFY(component.isReady());
+
+    QObject *object = component.create();
+    QVERIFY(object != 0);
+    QVERIFY(object->property("qobject").value<QObject*>() != 0);
+
+    delete object;
+}
+
 QTEST_MAIN(tst_qdeclarativecomponent)
 
 #include "tst_qdeclarativecomponent.moc"
@@ -0,0 +1,11 @@
+load(qttest_p4)
+contains(QT_CONFIG,declarative): QT += network declarative
+macx:CONFIG -= app_bundle
+
+HEADERS += ../shared/debugutil_p.h
+SOURCES += tst_qdeclarativedebugtrace.cpp \
+           ../shared/debugutil.cpp
+
+CONFIG += parallel_test
+
+QT += core-private gui-private declarative-private
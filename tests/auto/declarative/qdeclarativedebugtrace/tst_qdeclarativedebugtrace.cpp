@@ -0,0 +1,183 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtest.h>
+#include <QDataStream>
+
+#include <QtDeclarative/qdeclarativeengine.h>
+#include <private/qdeclarativedebughelper_p.h>
+
+#include <private/qdeclarativedebugclient_p.h>
+#include <private/qdeclarativedebugservice_p.h>
+#include <private/qdeclarativedebugtrace_p.h>
+
+#include "../../../shared/util.h"
+#include "../shared/debugutil_p.h"
+
+// Collects the messages sent by the trace service until it reports that they are complete
+class QDeclarativeDebugTraceClient : public QDeclarativeDebugClient
+{
+    Q_OBJECT
+public:
+    QDeclarativeDebugTraceClient(QDeclarativeDebugConnection *connection)
+        : QDeclarativeDebugClient(QLatin1String("CanvasFrameRate"), connection), complete(false) {}
+
+    void setTracing(bool enabled)
+    {
+        QByteArray message;
+        QDataStream stream(&message, QIODevice::WriteOnly);
+        stream << enabled;
+        sendMessage(message);
+    }
+
+    QList<QByteArray> messages;
+    bool complete;
+
+protected:
+    virtual void messageReceived(const QByteArray &message)
+    {
+        QDataStream stream(message);
+        qint64 time;
+        int messageType;
+        stream >> time >> messageType;
+        if (messageType == QDeclarativeDebugTrace::Complete)
+            complete = true;
+        else
+            messages.append(message);
+    }
+};
+
+class tst_QDeclarativeDebugTrace : public QObject
+{
+    Q_OBJECT
+private:
+    QDeclarativeDebugConnection *m_conn;
+
+private slots:
+    void initTestCase();
+
+    void sceneGraphFrame();
+};
+
+void tst_QDeclarativeDebugTrace::initTestCase()
+{
+    QTest::ignoreMessage(QtWarningMsg, "Qml debugging is enabled. Only use this in a safe environment!");
+    QDeclarativeDebugHelper::enableDebugging();
+
+    QTest::ignoreMessage(QtWarningMsg, "QDeclarativeDebugServer: Waiting for connection on port 13771...");
+    new QDeclarativeEngine(this);
+
+    m_conn = new QDeclarativeDebugConnection(this);
+    m_conn->connectToHost("127.0.0.1", 13771);
+
+    QTest::ignoreMessage(QtWarningMsg, "QDeclarativeDebugServer: Connection established");
+    bool ok = m_conn->waitForConnected();
+    QVERIFY(ok);
+
+    QTRY_VERIFY(QDeclarativeDebugService::hasDebuggingClient());
+
+    // Create the trace service before its client, so that it does not wait for a message
+    QDeclarativeDebugTrace::addEvent(QDeclarativeDebugTrace::Key);
+}
+
+void tst_QDeclarativeDebugTrace::sceneGraphFrame()
+{
+    QVector<qint64> values(QDeclarativeDebugTrace::MaximumSceneGraphFrameValue);
+    for (int ii = 0; ii < values.count(); ++ii)
+        values[ii] = 100 + ii;
+
+    QDeclarativeDebugTraceClient client(m_conn);
+    QTRY_COMPARE(client.status(), QDeclarativeDebugClient::Enabled);
+    QVERIFY(!QDeclarativeDebugTrace::isEnabled());
+
+    client.setTracing(true);
+    QTRY_VERIFY(QDeclarativeDebugTrace::isEnabled());
+
+    QDeclarativeDebugTrace::sceneGraphFrame(values);
+
+    client.setTracing(false);
+    QTRY_VERIFY(client.complete);
+    QVERIFY(!QDeclarativeDebugTrace::isEnabled());
+
+    int frames = 0;
+    foreach (const QByteArray &message, client.messages) {
+        QDataStream stream(message);
+        qint64 time;
+        int messageType;
+        int detailType;
+        stream >> time >> messageType >> detailType;
+        if (messageType != QDeclarativeDebugTrace::Event
+                || detailType != QDeclarativeDebugTrace::SceneGraphFrame)
+            continue;
+
+        ++frames;
+        QVERIFY(time >= 0);
+        for (int ii = 0; ii < values.count(); ++ii) {
+            qint64 value;
+            stream >> value;
+            QCOMPARE(value, values.at(ii));
+        }
+        QVERIFY(stream.atEnd());
+    }
+    QCOMPARE(frames, 1);
+
+    // Frames are not recorded while tracing is disabled
+    client.messages.clear();
+    client.complete = false;
+    QDeclarativeDebugTrace::sceneGraphFrame(values);
+    client.setTracing(false);
+    QTRY_VERIFY(client.complete);
+    QVERIFY(client.messages.isEmpty());
+}
+
+int main(int argc, char *argv[])
+{
+    int _argc = argc + 1;
+    char **_argv = new char*[_argc];
+    for (int i = 0; i < argc; ++i)
+        _argv[i] = argv[i];
+    _argv[_argc - 1] = "-qmljsdebugger=port:13771";
+
+    QApplication app(_argc, _argv);
+    tst_QDeclarativeDebugTrace tc;
+    return QTest::qExec(&tc, _argc, _argv);
+}
+
+#include "tst_qdeclarativedebugtrace.moc"
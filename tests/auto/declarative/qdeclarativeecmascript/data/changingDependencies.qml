@@ -0,0 +1,13 @@
+import QtQuick 2.0
+
+QtObject {
+    property bool useA: true
+    property int a: 1
+    property int b: 10
+
+    function pick() {
+        return useA ? a + a : b;
+    }
+
+    property int result: pick()
+}
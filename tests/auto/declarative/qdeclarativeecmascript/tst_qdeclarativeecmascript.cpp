@@ -186,6 +186,7 @@ private slots:
     void aliasToCompositeElement();
     void realToInt();
     void dynamicString();
+    void changingDependencies();
     void include();
 
     void callQtInvokables();
@@ -3800,6 +3801,32 @@ void tst_qdeclarativeecmascript::dynamicString()
              QString::fromLatin1("string:Hello World false:0 true:1 uint32:100 int32:-100 double:3.14159 date:2011-02-11 05::30:50!"));
 }
 
+// Bindings keep tracking the right properties when their dependencies change
+void tst_qdeclarativeecmascript::changingDependencies()
+{
+    QDeclarativeComponent component(&engine, TEST_FILE("changingDependencies.qml"));
+    QObject *object = component.create();
+    QVERIFY(object != 0);
+
+    QCOMPARE(object->property("result").toInt(), 2);
+    object->setProperty("a", 2);
+    QCOMPARE(object->property("result").toInt(), 4);
+    object->setProperty("useA", false);
+    QCOMPARE(object->property("result").toInt(), 10);
+    object->setProperty("b", 20);
+    QCOMPARE(object->property("result").toInt(), 20);
+    object->setProperty("a", 3);
+    QCOMPARE(object->property("result").toInt(), 20);
+    object->setProperty("useA", true);
+    QCOMPARE(object->property("result").toInt(), 6);
+    object->setProperty("a", 4);
+    QCOMPARE(object->property("result").toInt(), 8);
+    object->setProperty("b", 30);
+    QCOMPARE(object->property("result").toInt(), 8);
+
+    delete object;
+}
+
 QTEST_MAIN(tst_qdeclarativeecmascript)
 
 #include "tst_qdeclarativeecmascript.moc"
@@ -50,6 +50,7 @@
 #include <QDeclarativeComponent>
 #include <QDeclarativeNetworkAccessManagerFactory>
 #include <QDeclarativeExpression>
+#include <private/qdeclarativeengine_p.h>
 
 #ifdef Q_OS_SYMBIAN
 // In Symbian OS test data is located in applications private dir
@@ -72,6 +73,7 @@ private slots:
     void outputWarningsToStandardError();
     void objectOwnership();
     void multipleEngines();
+    void deferredBindingUpdates();
 };
 
 void tst_qdeclarativeengine::rootContext()
@@ -365,6 +367,55 @@ void tst_qdeclarativeengine::multipleEngines()
     }
 }
 
+void tst_qdeclarativeengine::deferredBindingUpdates()
+{
+    QDeclarativeEngine engine;
+    QDeclarativeEnginePrivate *ep = QDeclarativeEnginePrivate::get(&engine);
+    ep->setDeferredBindingUpdates(true);
+
+    QDeclarativeComponent c(&engine);
+    c.setData("import QtQuick 1.0\n"
+              "QtObject {\n"
+              "    property int a: 1\n"
+              "    property int b: a + 1\n"
+              "    property int c: a * 2\n"
+              "    property int d: b + c\n"
+              "    property int e: d + a\n"
+              "}\n", QUrl());
+    QObject *object = c.create();
+    QVERIFY(object != 0);
+
+    // Bindings have settled once the component is created
+    QCOMPARE(object->property("d").toInt(), 4);
+    QCOMPARE(object->property("e").toInt(), 5);
+
+    // Updates are deferred until the end of the event
+    object->setProperty("a", 2);
+    QCOMPARE(object->property("d").toInt(), 4);
+    QCoreApplication::processEvents();
+    QCOMPARE(object->property("d").toInt(), 7);
+    QCOMPARE(object->property("e").toInt(), 9);
+
+    // Once the graph is known each dirty binding is evaluated once, in dependency order
+    QDeclarativeEnginePrivate::BindingCounters start = ep->bindingCounters;
+    object->setProperty("a", 3);
+    ep->flushDirtyBindings();
+    QCOMPARE(object->property("d").toInt(), 10);
+    QCOMPARE(object->property("e").toInt(), 13);
+    QCOMPARE(ep->bindingCounters.evaluations - start.evaluations, quint64(4));
+    QVERIFY(ep->bindingCounters.notifications - start.notifications > 4);
+
+    // Turning deferral off flushes pending updates
+    object->setProperty("a", 4);
+    ep->setDeferredBindingUpdates(false);
+    QCOMPARE(object->property("e").toInt(), 17);
+
+    object->setProperty("a", 5);
+    QCOMPARE(object->property("e").toInt(), 21);
+
+    delete object;
+}
+
 QTEST_MAIN(tst_qdeclarativeengine)
 
 #include "tst_qdeclarativeengine.moc"
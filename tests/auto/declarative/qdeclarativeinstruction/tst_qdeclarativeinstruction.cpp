@@ -498,6 +498,39 @@ void tst_qdeclarativeinstruction::dump()
         data->addInstruction(i);
     }
 
+    {
+        QDeclarativeInstruction i;
+        i.setType(QDeclarativeInstruction::CreateSimpleObjectBegin);
+        i.createSimpleBegin.create = 0;
+        i.createSimpleBegin.typeSize = 36;
+        i.createSimpleBegin.type = 0;
+        i.createSimpleBegin.id = 2;
+        i.createSimpleBegin.castValue = 8;
+        i.createSimpleBegin.line = 3;
+        i.createSimpleBegin.column = 4;
+        data->addInstruction(i);
+    }
+
+    {
+        QDeclarativeInstruction i;
+        i.setType(QDeclarativeInstruction::StoreDoublePair);
+        i.storeDoublePair.propertyIndex = 12;
+        i.storeDoublePair.value = 1.5;
+        i.storeDoublePair.propertyIndex2 = 13;
+        i.storeDoublePair.value2 = 7.25;
+        data->addInstruction(i);
+    }
+
+    {
+        QDeclarativeInstruction i;
+        i.setType(QDeclarativeInstruction::StoreIntegerPair);
+        i.storeIntegerPair.propertyIndex = 14;
+        i.storeIntegerPair.value = 6;
+        i.storeIntegerPair.propertyIndex2 = 15;
+        i.storeIntegerPair.value2 = -3;
+        data->addInstruction(i);
+    }
+
     {
         QDeclarativeInstruction i;
         i.setType(QDeclarativeInstruction::Done);
@@ -558,7 +591,10 @@ void tst_qdeclarativeinstruction::dump()
         << "47\t\tSTORE_IMPORTED_SCRIPT\t2"
         << "48\t\tSTORE_VARIANT_INTEGER\t\t32\t11"
         << "49\t\tSTORE_VARIANT_DOUBLE\t\t19\t33.7"
-        << "50\t\tDONE"
+        << "50\t\tCREATE_SIMPLE_BEGIN\t36\t2\t8"
+        << "51\t\tSTORE_DOUBLE_PAIR\t12\t1.5\t13\t7.25"
+        << "52\t\tSTORE_INTEGER_PAIR\t14\t6\t15\t-3"
+        << "53\t\tDONE"
         << "-------------------------------------------------------------------------------";
 
     messages = QStringList();
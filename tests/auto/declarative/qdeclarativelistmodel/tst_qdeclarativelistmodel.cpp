@@ -89,6 +89,10 @@ private slots:
     void convertNestedToFlat_fail_data();
     void convertNestedToFlat_ok();
     void convertNestedToFlat_ok_data();
+    void convertFlatToNested();
+    void flatGet();
+    void flatValues();
+    void flatFailedInsert();
     void enumerate();
     void error_data();
     void error();
@@ -334,6 +338,9 @@ void tst_qdeclarativelistmodel::dynamic_data()
     QTest::newRow("append3b") << "{append({'foo':123});append({'foo':456});get(1).foo}" << 456 << "";
     QTest::newRow("append4a") << "{append(123)}" << 0 << "<Unknown File>: QML ListModel: append: value is not an object";
     QTest::newRow("append4b") << "{append([1,2,3])}" << 0 << "<Unknown File>: QML ListModel: append: value is not an object";
+    QTest::newRow("append5a") << "{append([{'foo':123},{'foo':456}]);count}" << 2 << "";
+    QTest::newRow("append5b") << "{append({'foo':123});append([{'foo':456},{'foo':789}]);get(2).foo}" << 789 << "";
+    QTest::newRow("append5c") << "{append([{'foo':123},456]);count}" << 0 << "<Unknown File>: QML ListModel: append: value is not an object";
 
     QTest::newRow("clear1") << "{append({'foo':456});clear();count}" << 0 << "";
     QTest::newRow("clear2") << "{append({'foo':123});append({'foo':456});clear();count}" << 0 << "";
@@ -359,6 +366,9 @@ void tst_qdeclarativelistmodel::dynamic_data()
     QTest::newRow("insert4") << "{append({'foo':123});insert(-1,{'foo':456});count}" << 1 << "<Unknown File>: QML ListModel: insert: index -1 out of range";
     QTest::newRow("insert5a") << "{insert(0,123)}" << 0 << "<Unknown File>: QML ListModel: insert: value is not an object";
     QTest::newRow("insert5b") << "{insert(0,[1,2,3])}" << 0 << "<Unknown File>: QML ListModel: insert: value is not an object";
+    QTest::newRow("insert6a") << "{append({'foo':123});insert(0,[{'foo':456},{'foo':789}]);count}" << 3 << "";
+    QTest::newRow("insert6b") << "{append({'foo':123});insert(0,[{'foo':456},{'foo':789}]);get(1).foo}" << 789 << "";
+    QTest::newRow("insert6c") << "{append({'foo':123});insert(0,[{'foo':456},{'foo':789}]);get(2).foo}" << 123 << "";
 
     QTest::newRow("set1") << "{append({'foo':123});set(0,{'foo':456});count}" << 1 << "";
     QTest::newRow("set2") << "{append({'foo':123});set(0,{'foo':456});get(0).foo}" << 456 << "";
@@ -378,6 +388,7 @@ void tst_qdeclarativelistmodel::dynamic_data()
     QTest::newRow("setprop4b") << "{setProperty(-1,'foo',456)}" << 0 << "<Unknown File>: QML ListModel: set: index -1 out of range";
     QTest::newRow("setprop4c") << "{append({'foo':123,'bar':456});setProperty(1,'foo',456);count}" << 1 << "<Unknown File>: QML ListModel: set: index 1 out of range";
     QTest::newRow("setprop5") << "{append({'foo':123,'bar':456});append({'foo':111});setProperty(1,'bar',222);get(1).bar}" << 222 << "";
+    QTest::newRow("setprop6") << "{append({'foo':123});setProperty(0,'foo','abc');get(0).foo == 'abc'}" << 1 << "";
 
     QTest::newRow("move1a") << "{append({'foo':123});append({'foo':456});move(0,1,1);count}" << 2 << "";
     QTest::newRow("move1b") << "{append({'foo':123});append({'foo':456});move(0,1,1);get(0).foo}" << 456 << "";
@@ -635,6 +646,128 @@ void tst_qdeclarativelistmodel::convertNestedToFlat_ok_data()
     convertNestedToFlat_fail_data();
 }
 
+void tst_qdeclarativelistmodel::convertFlatToNested()
+{
+    // A model filled from script keeps its data in the flat model until
+    // list-type data is added, and the roles must not change when it
+    // switches to the nested model
+
+    QDeclarativeEngine engine;
+    QDeclarativeListModel model;
+    QDeclarativeEngine::setContextForObject(&model, engine.rootContext());
+    engine.rootContext()->setContextProperty("model", &model);
+
+    RUNEXPR("model.append([{name: 'a', value: 1, cost: 1.5, ok: true}, {name: 'b', value: 2}])");
+    RUNEXPR("model.setProperty(1, 'cost', 'free')");
+    QCOMPARE(model.count(), 2);
+
+    int name = roleFromName(&model, "name");
+    int value = roleFromName(&model, "value");
+    int cost = roleFromName(&model, "cost");
+    int ok = roleFromName(&model, "ok");
+    QVERIFY(name >= 0 && value >= 0 && cost >= 0 && ok >= 0);
+
+    QCOMPARE(model.data(0, name), QVariant(QString("a")));
+    QCOMPARE(model.data(1, value), QVariant(2));
+    QCOMPARE(model.data(0, cost), QVariant(1.5));
+    QCOMPARE(model.data(1, cost), QVariant(QString("free")));
+    QCOMPARE(model.data(0, ok), QVariant(true));
+    QCOMPARE(model.data(1, ok), QVariant());
+
+    RUNEXPR("model.append({name: 'c', list: [{x: 1}]})");
+    QCOMPARE(model.count(), 3);
+    QCOMPARE(RUNEXPR("model.get(2).list.get(0).x").toInt(), 1);
+
+    QCOMPARE(roleFromName(&model, "name"), name);
+    QCOMPARE(roleFromName(&model, "cost"), cost);
+    QCOMPARE(model.data(0, name), QVariant(QString("a")));
+    QCOMPARE(model.data(1, value), QVariant(2));
+    QCOMPARE(model.data(0, cost), QVariant(1.5));
+    QCOMPARE(model.data(1, cost), QVariant(QString("free")));
+    QCOMPARE(model.data(0, ok), QVariant(true));
+    QCOMPARE(model.data(1, ok), QVariant());
+}
+
+// Objects returned by get() for a flat model read and write the flat data
+void tst_qdeclarativelistmodel::flatGet()
+{
+    QDeclarativeEngine engine;
+    QDeclarativeListModel model;
+    QDeclarativeEngine::setContextForObject(&model, engine.rootContext());
+    engine.rootContext()->setContextProperty("model", &model);
+
+    RUNEXPR("model.append([{name: 'a', value: 1}, {value: 2, name: 'b', ok: true}])");
+    int name = roleFromName(&model, "name");
+    int value = roleFromName(&model, "value");
+
+    QSignalSpy spy(&model, SIGNAL(itemsChanged(int, int, QList<int>)));
+    RUNEXPR("model.get(1).value = 5");
+    QCOMPARE(model.data(1, value), QVariant(5));
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(2).value<QList<int> >(), QList<int>() << value);
+    QCOMPARE(RUNEXPR("model.get(1).value").toInt(), 5);
+
+    QCOMPARE(RUNEXPR("(function() { var s = ''; for (var i in model.get(1)) s += i + ';'; return s })()").toString(), QString("name;value;ok;"));
+    QCOMPARE(RUNEXPR("'ok' in model.get(0)").toBool(), false);
+
+    // List-type data switches to the nested model
+    RUNEXPR("model.get(0).name = [{'a': 50}]");
+    QVariantMap map;
+    map["a"] = 50;
+    QCOMPARE(model.data(0, name), QVariant(QVariantList() << map));
+    QCOMPARE(model.data(1, name), QVariant(QString("b")));
+}
+
+// Values keep their type, and strings that are no longer used are released
+void tst_qdeclarativelistmodel::flatValues()
+{
+    QDeclarativeEngine engine;
+    QDeclarativeListModel model;
+    QDeclarativeEngine::setContextForObject(&model, engine.rootContext());
+    engine.rootContext()->setContextProperty("model", &model);
+
+    RUNEXPR("model.append([{name: 'a', value: 1}, {name: 'b', value: 1.5}])");
+    int name = roleFromName(&model, "name");
+    int value = roleFromName(&model, "value");
+
+    QCOMPARE(model.data(0, value).userType(), int(QVariant::Int));
+    QCOMPARE(model.data(1, value), QVariant(1.5));
+    model.setProperty(1, "value", QVariant(2.0));
+    QCOMPARE(model.data(1, value).userType(), int(QVariant::Double));
+    QCOMPARE(model.data(1, value), QVariant(2.0));
+    model.setProperty(1, "value", QVariant(3));
+    QCOMPARE(model.data(1, value).userType(), int(QVariant::Int));
+
+    RUNEXPR("model.setProperty(0, 'name', 'c')");
+    RUNEXPR("model.setProperty(1, 'name', 'a')");
+    RUNEXPR("model.setProperty(0, 'name', 'b')");
+    QCOMPARE(model.data(0, name), QVariant(QString("b")));
+    QCOMPARE(model.data(1, name), QVariant(QString("a")));
+    RUNEXPR("model.remove(1)");
+    RUNEXPR("model.append({name: 'd'})");
+    QCOMPARE(model.data(0, name), QVariant(QString("b")));
+    QCOMPARE(model.data(1, name), QVariant(QString("d")));
+}
+
+// A flat model that cannot switch to the nested model adds no rows or roles
+// for an insert that fails
+void tst_qdeclarativelistmodel::flatFailedInsert()
+{
+    QDeclarativeEngine engine;
+    QDeclarativeListModel model;
+    QDeclarativeEngine::setContextForObject(&model, engine.rootContext());
+    engine.rootContext()->setContextProperty("model", &model);
+
+    RUNEXPR("model.append({foo: 1})");
+    QVERIFY(model.agent());
+
+    QTest::ignoreMessage(QtWarningMsg, "<Unknown File>: QML ListModel: Cannot add list-type data when modifying or after modification from a worker script");
+    RUNEXPR("model.append([{bar: 2}, {baz: [{x: 1}]}])");
+    QCOMPARE(model.count(), 1);
+    QCOMPARE(model.roles().count(), 1);
+    QCOMPARE(roleFromName(&model, "bar"), -1);
+}
+
 void tst_qdeclarativelistmodel::enumerate()
 {
     QDeclarativeEngine eng;
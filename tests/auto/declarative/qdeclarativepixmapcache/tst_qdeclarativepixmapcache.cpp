@@ -79,6 +79,8 @@ private slots:
     void massive();
     void cancelcrash();
     void shrinkcache();
+    void pinning();
+    void statistics();
 #ifndef QT_NO_CONCURRENT
     void networkCrash();
 #endif
@@ -362,6 +364,71 @@ void tst_qdeclarativepixmapcache::shrinkcache()
     }
 }
 
+void tst_qdeclarativepixmapcache::pinning()
+{
+    QDeclarativeEngine engine;
+    QUrl url = thisfile.resolved(QUrl("data/massive.png"));
+
+    // massive.png exceeds the cache limit, but stays cached while it is pinned
+    qint64 cachekey = 0;
+    {
+        QDeclarativePixmap p(&engine, url);
+        QVERIFY(p.isReady());
+        QVERIFY(!p.isPinned());
+        p.setPinned(true);
+        cachekey = p.pixmap().cacheKey();
+    }
+
+    {
+        QDeclarativePixmap p(&engine, url);
+        QVERIFY(p.isReady());
+        QVERIFY(p.isPinned());
+        QCOMPARE(p.pixmap().cacheKey(), cachekey);
+        p.setPinned(false);
+    }
+
+    QDeclarativePixmap p(&engine, url);
+    QVERIFY(p.isReady());
+    QVERIFY(p.pixmap().cacheKey() != cachekey);
+}
+
+void tst_qdeclarativepixmapcache::statistics()
+{
+    QDeclarativeEngine engine;
+    QUrl url = thisfile.resolved(QUrl("data/exists.png"));
+
+    // Flush what the other tests left behind
+    const int limit = QDeclarativePixmap::cacheLimit();
+    QDeclarativePixmap::setCacheLimit(0);
+    QDeclarativePixmap::resetCacheStatistics();
+
+    {
+        QDeclarativePixmap p1(&engine, url);
+        QVERIFY(p1.isReady());
+        QDeclarativePixmap p2(&engine, url);
+        QVERIFY(p2.isReady());
+
+        QDeclarativePixmap::CacheStatistics stats = QDeclarativePixmap::cacheStatistics();
+        QCOMPARE(stats.misses, 1);
+        QCOMPARE(stats.hits, 1);
+        QCOMPARE(stats.evictions, 0);
+        QVERIFY(stats.residentBytes > 0);
+        QCOMPARE(stats.unreferencedBytes, qint64(0));
+    }
+
+    QDeclarativePixmap::CacheStatistics stats = QDeclarativePixmap::cacheStatistics();
+    QCOMPARE(stats.evictions, 1);
+    QCOMPARE(stats.unreferencedBytes, qint64(0));
+
+    QDeclarativePixmap::setCacheLimit(limit);
+    {
+        QDeclarativePixmap p(&engine, url);
+        QVERIFY(p.isReady());
+    }
+    QVERIFY(QDeclarativePixmap::cacheStatistics().unreferencedBytes > 0);
+    QCOMPARE(QDeclarativePixmap::cacheStatistics().misses, 2);
+}
+
 #ifndef QT_NO_CONCURRENT
 
 void createNetworkServer()
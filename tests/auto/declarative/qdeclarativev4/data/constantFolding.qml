@@ -0,0 +1,27 @@
+import QtQuick 2.0
+
+Item { 
+    property real test1: 10 * 3 + i1.a * 2
+    property int test2: (i1.a + 4 * 4) % 3
+    property int test3: i1.a > 10 + 2 ? i1.a - 1 : i1.a + 1
+    property bool test4: 2 > 3 ? i1.t : !i1.t
+    property int test5: Math.max(i1.a, 4 * 4) + Math.min(i1.b, 2 - 3)
+    property real test6: Math.floor(7.5) + Math.ceil(-0.5) + Math.abs(-2)
+    property int test7: (1 << 33) | (i1.a & 0xff)
+    property real test8: i1.r * (i1.a == 17 ? 1 : 2) + i1.r
+    property bool test9: i1.a === 17.0 && i1.b != -5.5
+    property real test10: Math.max(i1.a, 17.5) - Math.min(i1.a, -0)
+    property int test11: (true === 1) ? i1.a : i1.b
+    property int test12: (false !== 0) ? i1.a : i1.b
+    property int test13: (1 === 1.0) ? i1.a : i1.b
+    property int test14: (true === true) && (2 !== 2.5) ? i1.a : i1.b
+    property bool test15: (1 == true) && i1.t
+
+    QtObject {
+        id: i1
+        property int a: 17
+        property int b: -5
+        property bool t: true
+        property real r: 35.2
+    }
+ }
@@ -0,0 +1,28 @@
+import QtQuick 2.0
+
+Item { 
+    property real test1: i1.a + i1.b
+    property int test2: i1.a - i1.b
+    property real test3: i1.a * i1.c
+    property int test4: i1.a % 3
+    property int test5: i1.b % -4
+    property real test6: i1.a % i1.b
+    property bool test7: i1.a > i1.b
+    property bool test8: i1.a <= i1.b
+    property bool test9: i1.a == i1.b
+    property bool test10: i1.a !== i1.b
+    property bool test11: i1.t == 1
+    property bool test12: i1.t == i1.a
+    property int test13: i1.r / 2 | 0
+    property real test14: i1.big * i1.big
+
+    QtObject {
+        id: i1
+        property int a: 17
+        property int b: -5
+        property int c: 2000000000
+        property bool t: true
+        property real r: 35.2
+        property int big: 2147483647
+    }
+ } 
@@ -0,0 +1,23 @@
+import QtQuick 2.0
+
+Item { 
+    property real test1: Math.abs(i1.neg)
+    property real test2: Math.abs(i1.i)
+    property int test3: Math.ceil(i1.pos)
+    property int test4: Math.ceil(i1.neg)
+    property real test5: Math.sqrt(i1.pos)
+    property real test6: Math.min(i1.pos, i1.neg)
+    property real test7: Math.max(i1.pos, i1.neg)
+    property int test8: Math.min(i1.i, 3)
+    property int test9: Math.max(i1.i, 3)
+    property real test10: Math.max(i1.i, i1.pos)
+    property int test11: Math.floor(i1.pos)
+    property real test12: Math.PI * i1.pos
+
+    QtObject {
+        id: i1
+        property real pos: 12.25
+        property real neg: -3.5
+        property int i: -7
+    }
+ } 
@@ -0,0 +1,12 @@
+import QtQuick 2.0
+
+Item { 
+    id: root
+    property int index: 3
+    property QtObject test1: index % 2 ? o1 : o2
+    property QtObject test2: index > 2 ? null : o1
+    property QtObject test3: index < 2 ? o2 : null
+
+    QtObject { id: o1 }
+    QtObject { id: o2 }
+ } 
@@ -0,0 +1,10 @@
+import QtQuick 2.0
+
+QtObject {
+    property int a: 4
+    property int b: 1
+
+    property int test1: (a + 1) * (b > 0 ? 2 : 3)
+    property int test2: (a + 1) * (b > 0 && a > 0 ? 2 : 3) + (a - 1)
+    property real test3: (a * 2) + (b < 0 || a > 10 ? a : b) * (a + b)
+}
@@ -77,6 +77,7 @@ private slots:
     void qtscript_data();
     void nestedObjectAccess();
     void subscriptionsInConditionalExpressions();
+    void temporaryRegisters();
 
 private:
     QDeclarativeEngine engine;
@@ -126,6 +127,11 @@ void tst_qdeclarativev4::qtscript_data()
     QTest::newRow("double bool jump") << "doubleBoolJump.qml";
     QTest::newRow("unary minus") << "unaryMinus.qml";
     QTest::newRow("null qobject") << "nullQObject.qml";
+    QTest::newRow("int arithmetic") << "intArithmetic.qml";
+    QTest::newRow("math functions") << "mathFunctions.qml";
+    QTest::newRow("constant folding") << "constantFolding.qml";
+    QTest::newRow("object conditional") << "objectConditional.qml";
+    QTest::newRow("temporary registers") << "temporaryRegisters.qml";
 }
 
 void tst_qdeclarativev4::unnecessaryReeval()
@@ -239,6 +245,27 @@ void tst_qdeclarativev4::subscriptionsInConditionalExpressions()
     delete o;
 }
 
+// Temps that are still live where the branches of a conditional join must keep their
+// registers until they are last read.
+void tst_qdeclarativev4::temporaryRegisters()
+{
+    QDeclarativeComponent component(&engine, TEST_FILE("temporaryRegisters.qml"));
+
+    QObject *o = component.create();
+    QVERIFY(o != 0);
+
+    QCOMPARE(o->property("test1").toInt(), 10);
+    QCOMPARE(o->property("test2").toInt(), 13);
+    QCOMPARE(o->property("test3").toReal(), qreal(13));
+
+    o->setProperty("b", -1);
+    QCOMPARE(o->property("test1").toInt(), 15);
+    QCOMPARE(o->property("test2").toInt(), 18);
+    QCOMPARE(o->property("test3").toReal(), qreal(5));
+
+    delete o;
+}
+
 QTEST_MAIN(tst_qdeclarativev4)
 
 #include "tst_qdeclarativev4.moc"
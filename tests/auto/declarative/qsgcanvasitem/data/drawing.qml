@@ -0,0 +1,29 @@
+import QtQuick 2.0
+
+Rectangle {
+    width: 100
+    height: 100
+    color: "white"
+
+    property string fill: "red"
+    property int paintCount: 0
+
+    Canvas {
+        id: canvas
+        objectName: "canvas"
+        anchors.fill: parent
+
+        property url image: "green.png"
+
+        onPaint: {
+            context.fillStyle = fill;
+            context.fillRect(0, 0, 100, 50);
+            context.drawImage(image, 0, 50);
+            context.drawImage(image, 25, 50, 50, 25);
+            context.drawImage(image, 0, 0, 5, 5, 75, 75, 25, 25);
+            paintCount++;
+        }
+
+        Component.onCompleted: requestPaint()
+    }
+}
@@ -0,0 +1,128 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtest.h>
+#include <QtTest/QtTest>
+#include <QtTest/QSignalSpy>
+#include <QtDeclarative/qsgview.h>
+#include <QtDeclarative/qsgitem.h>
+
+#ifdef Q_OS_SYMBIAN
+// In Symbian OS test data is located in applications private dir
+#define SRCDIR "."
+#endif
+
+/*
+    Canvas replays its command buffers on a painting thread unless QML_NO_THREADED_CANVAS
+    is set or fonts cannot be rendered outside the GUI thread, so these tests cover the
+    threaded replay where the platform supports it.
+*/
+class tst_qsgcanvasitem : public QObject
+{
+    Q_OBJECT
+public:
+    tst_qsgcanvasitem();
+
+private slots:
+    void threadedReplay();
+    void regionalRepaint();
+};
+
+tst_qsgcanvasitem::tst_qsgcanvasitem()
+{
+    // Render in the GUI thread so that grabFrameBuffer() renders the scene on demand
+    qputenv("QML_NO_THREADED_RENDERER", "1");
+}
+
+// Rectangles and images, which are resolved on the GUI thread, end up in the frame
+void tst_qsgcanvasitem::threadedReplay()
+{
+    QSGView view;
+    view.setSource(QUrl::fromLocalFile(SRCDIR "/data/drawing.qml"));
+    QSGItem *root = view.rootObject();
+    QVERIFY(root);
+    QSGItem *canvas = root->findChild<QSGItem *>("canvas");
+    QVERIFY(canvas);
+
+    QSignalSpy paintedSpy(canvas, SIGNAL(painted()));
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+    QTRY_VERIFY(paintedSpy.count() > 0);
+    QCOMPARE(root->property("paintCount").toInt(), 1);
+
+    QImage frame = view.grabFrameBuffer();
+    QCOMPARE(frame.pixel(50, 25), qRgb(255, 0, 0));
+    QCOMPARE(frame.pixel(5, 55), qRgb(0, 255, 0));
+    QCOMPARE(frame.pixel(50, 70), qRgb(0, 255, 0));
+    QCOMPARE(frame.pixel(90, 90), qRgb(0, 255, 0));
+    QCOMPARE(frame.pixel(50, 90), qRgb(255, 255, 255));
+}
+
+// Only the requested region is replayed, the rest of the retained raster is kept
+void tst_qsgcanvasitem::regionalRepaint()
+{
+    QSGView view;
+    view.setSource(QUrl::fromLocalFile(SRCDIR "/data/drawing.qml"));
+    QSGItem *root = view.rootObject();
+    QVERIFY(root);
+    QSGItem *canvas = root->findChild<QSGItem *>("canvas");
+    QVERIFY(canvas);
+
+    QSignalSpy paintedSpy(canvas, SIGNAL(painted()));
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+    QTRY_VERIFY(paintedSpy.count() > 0);
+
+    int painted = paintedSpy.count();
+    root->setProperty("fill", QLatin1String("blue"));
+    QMetaObject::invokeMethod(canvas, "requestPaint", Q_ARG(QRect, QRect(0, 0, 50, 50)));
+    QTRY_VERIFY(paintedSpy.count() > painted);
+    QCOMPARE(root->property("paintCount").toInt(), 2);
+
+    QImage frame = view.grabFrameBuffer();
+    QCOMPARE(frame.pixel(25, 25), qRgb(0, 0, 255));
+    QCOMPARE(frame.pixel(75, 25), qRgb(255, 0, 0));
+    QCOMPARE(frame.pixel(5, 55), qRgb(0, 255, 0));
+    QCOMPARE(frame.pixel(90, 90), qRgb(0, 255, 0));
+}
+
+QTEST_MAIN(tst_qsgcanvasitem)
+
+#include "tst_qsgcanvasitem.moc"
@@ -0,0 +1,42 @@
+import QtQuick 2.0
+
+Rectangle {
+    width: 240
+    height: 240
+    color: "white"
+
+    property int shift: 0
+
+    Grid {
+        x: 10; y: 10
+        columns: 6
+        spacing: 4
+        Repeater {
+            model: 36
+            Rectangle {
+                width: 20; height: 20
+                color: (index + shift) % 7 == 0 ? "red" : "steelblue"
+                opacity: index % 5 == 0 ? 0.5 : 1
+            }
+        }
+    }
+
+    Rectangle {
+        x: 10 + shift; y: 160
+        width: 100; height: 60
+        border.width: 3
+        border.color: "black"
+        gradient: Gradient {
+            GradientStop { position: 0; color: "red" }
+            GradientStop { position: 1; color: "blue" }
+        }
+    }
+
+    Item {
+        x: 120; y: 160
+        width: 60; height: 60
+        clip: true
+        Rectangle { x: -10 + shift; y: -10; width: 40; height: 40; color: "green" }
+        Rectangle { x: 30; y: 30 - shift; width: 40; height: 40; color: "yellow"; opacity: 0.7 }
+    }
+}
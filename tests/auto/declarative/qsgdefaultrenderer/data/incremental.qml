@@ -0,0 +1,29 @@
+import QtQuick 2.0
+
+Rectangle {
+    width: 240
+    height: 120
+    color: "white"
+
+    function insertAt(index, shade) { listModel.insert(index, { "shade": shade }) }
+    function removeAt(index) { listModel.remove(index) }
+
+    ListModel {
+        id: listModel
+        ListElement { shade: 0 }
+        ListElement { shade: 1 }
+        ListElement { shade: 2 }
+    }
+
+    // Overlapping delegates, so that drawing them in the wrong order shows
+    Repeater {
+        model: listModel
+        Rectangle {
+            x: 10 + index * 15
+            y: 10 + (index % 3) * 10
+            width: 40; height: 60
+            color: shade % 3 == 2 ? Qt.rgba(0, 0, 1, 0.5) : (shade % 2 ? "steelblue" : "orange")
+            Rectangle { x: 5; y: 5; width: 10; height: 10; color: shade % 2 ? "black" : Qt.rgba(1, 0, 0, 0.5) }
+        }
+    }
+}
@@ -0,0 +1,191 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtest.h>
+#include <QtTest/QtTest>
+#include <QtDeclarative/qsgview.h>
+#include <QtDeclarative/qsgitem.h>
+#include <qsgflatcolormaterial.h>
+#include <qsgsimplerectnode.h>
+#include <private/qsgcanvas_p.h>
+#include <private/qsgcontext_p.h>
+#include <private/qsgdefaultrenderer_p.h>
+
+#ifdef Q_OS_SYMBIAN
+// In Symbian OS test data is located in applications private dir
+#define SRCDIR "."
+#endif
+
+class tst_qsgdefaultrenderer : public QObject
+{
+    Q_OBJECT
+public:
+    tst_qsgdefaultrenderer();
+
+private slots:
+    void batchingFlag();
+    void batching();
+    void incrementalLists_data();
+    void incrementalLists();
+
+private:
+    QSGDefaultRenderer *renderer(QSGView *view) const;
+};
+
+tst_qsgdefaultrenderer::tst_qsgdefaultrenderer()
+{
+    // Render in the GUI thread so that grabFrameBuffer() renders the scene on demand
+    qputenv("QML_NO_THREADED_RENDERER", "1");
+}
+
+QSGDefaultRenderer *tst_qsgdefaultrenderer::renderer(QSGView *view) const
+{
+    return qobject_cast<QSGDefaultRenderer *>(QSGCanvasPrivate::get(view)->context->renderer());
+}
+
+class CustomColorMaterial : public QSGFlatColorMaterial
+{
+};
+
+// Only the built-in nodes opt their materials in to batching
+void tst_qsgdefaultrenderer::batchingFlag()
+{
+    CustomColorMaterial custom;
+    QVERIFY(!(custom.flags() & QSGMaterial::CanBeBatched));
+
+    QSGSimpleRectNode node;
+    QVERIFY(node.material()->flags() & QSGMaterial::CanBeBatched);
+}
+
+// A batched frame must look exactly like the same frame drawn node by node,
+// both when the batches are built and when they are updated in place
+void tst_qsgdefaultrenderer::batching()
+{
+    QSGView view;
+    view.setSource(QUrl::fromLocalFile(SRCDIR "/data/batching.qml"));
+    QSGItem *root = view.rootObject();
+    QVERIFY(root);
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+
+    QSGDefaultRenderer *r = renderer(&view);
+    QVERIFY(r);
+
+    r->setGeometryBatchingEnabled(false);
+    QImage unbatched = view.grabFrameBuffer();
+    int unbatchedDrawCalls = r->statistics().drawCalls;
+    QCOMPARE(r->statistics().batches, 0);
+
+    r->setGeometryBatchingEnabled(true);
+    QImage batched = view.grabFrameBuffer();
+    QVERIFY(r->statistics().batches > 0);
+    QVERIFY(r->statistics().drawCalls < unbatchedDrawCalls);
+    QCOMPARE(batched, unbatched);
+
+    // Move nodes and change materials, so that the retained batches are updated
+    for (int shift = 1; shift <= 3; ++shift) {
+        root->setProperty("shift", shift);
+        view.repaint();
+
+        batched = view.grabFrameBuffer();
+        QVERIFY(r->statistics().batches > 0);
+
+        r->setGeometryBatchingEnabled(false);
+        unbatched = view.grabFrameBuffer();
+        r->setGeometryBatchingEnabled(true);
+
+        QCOMPARE(batched, unbatched);
+    }
+}
+
+void tst_qsgdefaultrenderer::incrementalLists_data()
+{
+    QTest::addColumn<bool>("batching");
+
+    QTest::newRow("unbatched") << false;
+    QTest::newRow("batched") << true;
+}
+
+// Nodes added and removed between frames are merged into the existing render lists.
+// The frame must look the same as when the lists are rebuilt from the whole tree.
+void tst_qsgdefaultrenderer::incrementalLists()
+{
+    QFETCH(bool, batching);
+
+    QSGView view;
+    view.setSource(QUrl::fromLocalFile(SRCDIR "/data/incremental.qml"));
+    QSGItem *root = view.rootObject();
+    QVERIFY(root);
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+
+    QSGDefaultRenderer *r = renderer(&view);
+    QVERIFY(r);
+    r->setGeometryBatchingEnabled(batching);
+    view.repaint();
+
+    for (int step = 0; step < 12; ++step) {
+        switch (step % 4) {
+        case 0:
+            QMetaObject::invokeMethod(root, "insertAt", Q_ARG(QVariant, 0), Q_ARG(QVariant, step));
+            break;
+        case 1:
+            QMetaObject::invokeMethod(root, "insertAt", Q_ARG(QVariant, 2), Q_ARG(QVariant, step));
+            break;
+        case 2:
+            QMetaObject::invokeMethod(root, "insertAt", Q_ARG(QVariant, step / 2), Q_ARG(QVariant, step + 1));
+            break;
+        case 3:
+            QMetaObject::invokeMethod(root, "removeAt", Q_ARG(QVariant, 1));
+            break;
+        }
+        view.repaint();
+        QImage incremental = view.grabFrameBuffer();
+
+        r->rootNode()->markDirty(QSGNode::DirtyForceUpdate);
+        QImage rebuilt = view.grabFrameBuffer();
+
+        QCOMPARE(incremental, rebuilt);
+    }
+}
+
+QTEST_MAIN(tst_qsgdefaultrenderer)
+
+#include "tst_qsgdefaultrenderer.moc"
@@ -0,0 +1,194 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtest.h>
+#include <QtTest/QtTest>
+#include <QtGui/qrawfont.h>
+#include <private/qsgdistancefielddiskcache_p.h>
+
+class tst_qsgdistancefielddiskcache : public QObject
+{
+    Q_OBJECT
+public:
+    tst_qsgdistancefielddiskcache() {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void insertAndReload();
+    void emptyGlyph();
+    void parameterMismatch();
+    void corruptFile();
+
+private:
+    QSGDistanceFieldDiskCache::Parameters parameters() const;
+    QImage distanceField(int seed) const;
+
+    QRawFont font;
+    QString path;
+};
+
+void tst_qsgdistancefielddiskcache::initTestCase()
+{
+    font = QRawFont::fromFont(QFont());
+    if (!font.isValid())
+        QSKIP("No usable font", SkipAll);
+
+    path = QDir::tempPath() + QLatin1String("/tst_qsgdistancefielddiskcache");
+    cleanupTestCase();
+}
+
+void tst_qsgdistancefielddiskcache::cleanupTestCase()
+{
+    QDir dir(path);
+    foreach (const QString &file, dir.entryList(QDir::Files))
+        dir.remove(file);
+    dir.rmdir(path);
+}
+
+QSGDistanceFieldDiskCache::Parameters tst_qsgdistancefielddiskcache::parameters() const
+{
+    QSGDistanceFieldDiskCache::Parameters p;
+    p.tileSize = 16;
+    p.scale = 16;
+    p.radius = 80;
+    p.baseFontSize = 54;
+    return p;
+}
+
+QImage tst_qsgdistancefielddiskcache::distanceField(int seed) const
+{
+    QImage image(16, 16, QImage::Format_Indexed8);
+    for (int y = 0; y < image.height(); ++y)
+        for (int x = 0; x < image.width(); ++x)
+            image.scanLine(y)[x] = uchar(seed + x * 16 + y);
+    return image;
+}
+
+void tst_qsgdistancefielddiskcache::insertAndReload()
+{
+    QImage image = distanceField(3);
+    QRectF rect(1.5, -30, 20, 31.25);
+    QString fileName;
+    {
+        QSGDistanceFieldDiskCache cache(font, parameters(), path);
+        fileName = cache.fileName();
+        QVERIFY(!cache.contains(1));
+
+        cache.insert(1, rect, image);
+        QVERIFY(cache.contains(1));
+        QRectF r;
+        QVERIFY(cache.glyphRect(1, &r));
+        QCOMPARE(r, rect);
+        QVERIFY(cache.flush());
+        QVERIFY(QFile::exists(fileName));
+    }
+
+    QSGDistanceFieldDiskCache cache(font, parameters(), path);
+    QCOMPARE(cache.fileName(), fileName);
+    QVERIFY(cache.contains(1));
+    QVERIFY(!cache.contains(2));
+
+    QRectF r;
+    QVERIFY(cache.glyphRect(1, &r));
+    QCOMPARE(r, rect);
+
+    const uchar *bits = cache.glyphImage(1);
+    QVERIFY(bits);
+    for (int y = 0; y < 16; ++y)
+        QVERIFY(!memcmp(bits + y * 16, image.constScanLine(y), 16));
+
+    // Adding glyphs keeps the existing ones
+    cache.insert(2, rect, distanceField(7));
+    QVERIFY(cache.flush());
+    QVERIFY(cache.contains(1));
+    QVERIFY(cache.contains(2));
+    QVERIFY(!memcmp(cache.glyphImage(2), distanceField(7).constScanLine(0), 16));
+}
+
+void tst_qsgdistancefielddiskcache::emptyGlyph()
+{
+    {
+        QSGDistanceFieldDiskCache cache(font, parameters(), path);
+        cache.insert(3, QRectF(), QImage());
+    }
+
+    QSGDistanceFieldDiskCache cache(font, parameters(), path);
+    QVERIFY(cache.contains(3));
+    QVERIFY(!cache.glyphImage(3));
+    QRectF r(1, 1, 1, 1);
+    QVERIFY(cache.glyphRect(3, &r));
+    QVERIFY(r.isEmpty());
+}
+
+void tst_qsgdistancefielddiskcache::parameterMismatch()
+{
+    {
+        QSGDistanceFieldDiskCache cache(font, parameters(), path);
+        cache.insert(4, QRectF(0, 0, 10, 10), distanceField(1));
+    }
+
+    QSGDistanceFieldDiskCache::Parameters p = parameters();
+    p.radius = 40;
+    QSGDistanceFieldDiskCache cache(font, p, path);
+    QVERIFY(!cache.contains(4));
+}
+
+void tst_qsgdistancefielddiskcache::corruptFile()
+{
+    QString fileName;
+    {
+        QSGDistanceFieldDiskCache cache(font, parameters(), path);
+        fileName = cache.fileName();
+        cache.insert(5, QRectF(0, 0, 10, 10), distanceField(1));
+    }
+
+    QFile file(fileName);
+    QVERIFY(file.open(QFile::ReadWrite));
+    file.resize(file.size() / 2);
+    file.close();
+
+    QSGDistanceFieldDiskCache cache(font, parameters(), path);
+    QVERIFY(!cache.contains(5));
+}
+
+QTEST_MAIN(tst_qsgdistancefielddiskcache)
+
+#include "tst_qsgdistancefielddiskcache.moc"
@@ -121,6 +121,7 @@ private slots:
     void enabled();
 
     void mouseGrab();
+    void mousePressOutsideParent();
     void polishOutsideAnimation();
 
 private:
@@ -831,6 +832,43 @@ void tst_qsgitem::mouseGrab()
     delete canvas;
 }
 
+// Items outside their parent's geometry still receive presses, also after they are
+// moved or resized
+void tst_qsgitem::mousePressOutsideParent()
+{
+    QSGCanvas *canvas = new QSGCanvas;
+    canvas->resize(200, 200);
+    canvas->show();
+
+    QSGItem *parent = new QSGItem;
+    parent->setSize(QSizeF(50, 50));
+    parent->setParentItem(canvas->rootItem());
+
+    TestItem *child = new TestItem(parent);
+    child->setAcceptedMouseButtons(Qt::LeftButton);
+    child->setPos(QPointF(100, 100));
+    child->setSize(QSizeF(20, 20));
+
+    QTest::mouseClick(canvas, Qt::LeftButton, 0, QPoint(110, 110));
+    QCOMPARE(child->pressCount, 1);
+
+    child->setPos(QPointF(150, 20));
+    QTest::mouseClick(canvas, Qt::LeftButton, 0, QPoint(110, 110));
+    QCOMPARE(child->pressCount, 1);
+    QTest::mouseClick(canvas, Qt::LeftButton, 0, QPoint(160, 30));
+    QCOMPARE(child->pressCount, 2);
+
+    child->setSize(QSizeF(40, 40));
+    QTest::mouseClick(canvas, Qt::LeftButton, 0, QPoint(185, 55));
+    QCOMPARE(child->pressCount, 3);
+
+    parent->setScale(0.5);
+    QTest::mouseClick(canvas, Qt::LeftButton, 0, QPoint(185, 55));
+    QCOMPARE(child->pressCount, 3);
+
+    delete canvas;
+}
+
 void tst_qsgitem::polishOutsideAnimation()
 {
     QSGCanvas *canvas = new QSGCanvas;
@@ -46,6 +46,7 @@
 #include <QtDeclarative/qdeclarativecontext.h>
 #include <QtDeclarative/qdeclarativeexpression.h>
 #include <QtDeclarative/private/qsgitem_p.h>
+#include <QtDeclarative/private/qsgcanvas_p.h>
 #include <QtDeclarative/private/qsglistview_p.h>
 #include <QtDeclarative/private/qsgtext_p.h>
 #include <QtDeclarative/private/qsgvisualitemmodel_p.h>
@@ -103,6 +104,7 @@ private slots:
     void sections();
     void sectionsDelegate();
     void cacheBuffer();
+    void cacheBufferDeferred();
     void positionViewAtIndex();
     void resetModel();
     void propertyChanges();
@@ -1677,8 +1679,10 @@ void tst_QSGListView::cacheBuffer()
     testObject->setCacheBuffer(400);
     QTRY_VERIFY(listview->cacheBuffer() == 400);
 
+    // Items in the buffer are created over the following frames
+    QTRY_VERIFY(findItems<QSGItem>(contentItem, "wrapper").count() > itemCount);
+    QTRY_VERIFY(listview->deferredItemCount() > 0);
     int newItemCount = findItems<QSGItem>(contentItem, "wrapper").count();
-    QTRY_VERIFY(newItemCount > itemCount);
 
     // Confirm items positioned correctly
     for (int i = 0; i < model.count() && i < newItemCount; ++i) {
@@ -1692,6 +1696,49 @@ void tst_QSGListView::cacheBuffer()
     delete testObject;
 }
 
+void tst_QSGListView::cacheBufferDeferred()
+{
+    QSGView *canvas = createView();
+
+    TestModel model;
+    for (int i = 0; i < 30; i++)
+        model.addItem("Item" + QString::number(i), "");
+
+    QDeclarativeContext *ctxt = canvas->rootContext();
+    ctxt->setContextProperty("testModel", &model);
+
+    TestObject *testObject = new TestObject;
+    testObject->setCacheBuffer(400);
+    ctxt->setContextProperty("testObject", testObject);
+
+    canvas->setSource(QUrl::fromLocalFile(SRCDIR "/data/listviewtest.qml"));
+
+    QSGListView *listview = findItem<QSGListView>(canvas->rootObject(), "list");
+    QVERIFY(listview != 0);
+    QCOMPARE(listview->cacheBuffer(), 400);
+    QSGItem *contentItem = listview->contentItem();
+    QVERIFY(contentItem != 0);
+
+    // The frame that lays out the view only creates the visible delegates
+    QSGCanvasPrivate::get(canvas)->polishItems();
+    int visibleCount = findItems<QSGItem>(contentItem, "wrapper").count();
+    QVERIFY(visibleCount > 0);
+    QVERIFY(visibleCount <= 320 / 20 + 1);
+    QCOMPARE(listview->deferredItemCount(), 0);
+
+    // The buffer is filled by the frames that follow
+    for (int i = 0; i < 100 && findItems<QSGItem>(contentItem, "wrapper").count() == visibleCount; ++i) {
+        QTest::qWait(10);
+        QSGCanvasPrivate::get(canvas)->polishItems();
+    }
+    int bufferedCount = findItems<QSGItem>(contentItem, "wrapper").count();
+    QVERIFY(bufferedCount > visibleCount);
+    QCOMPARE(listview->deferredItemCount(), bufferedCount - visibleCount);
+
+    delete canvas;
+    delete testObject;
+}
+
 void tst_QSGListView::positionViewAtIndex()
 {
     QSGView *canvas = createView();
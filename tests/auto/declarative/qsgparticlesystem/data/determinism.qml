@@ -0,0 +1,24 @@
+import QtQuick 2.0
+import QtQuick.Particles 2.0
+
+ParticleSystem {
+    id: sys
+    property string log: ""
+
+    Emitter {
+        emitRate: 3000
+        lifeSpan: 1000
+        speed: AngledDirection { angleVariation: 360; magnitude: 50; magnitudeVariation: 20 }
+    }
+    Gravity { angle: 90; acceleration: 20 }
+    Friction { factor: 0.5 }
+    Wander { pace: 100; xVariance: 50; yVariance: 50 }
+    PointAttractor { x: 100; y: 100; strength: 200 }
+
+    Affector {
+        objectName: "probe"
+        active: false
+        signal: true
+        onAffected: sys.log += x + "," + y + ";"
+    }
+}
@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtest.h>
+#include <QtTest/QtTest>
+#include <QtDeclarative/qdeclarativeengine.h>
+#include <QtDeclarative/qdeclarativecomponent.h>
+#include <QAbstractAnimation>
+
+#ifdef Q_OS_SYMBIAN
+// In Symbian OS test data is located in applications private dir
+#define SRCDIR "."
+#endif
+
+class tst_qsgparticlesystem : public QObject
+{
+    Q_OBJECT
+public:
+    tst_qsgparticlesystem() {}
+
+private slots:
+    void determinism_data();
+    void determinism();
+
+private:
+    QString simulate(int workerThreads);
+};
+
+// Steps the system by hand and returns the position of every live particle at the end
+QString tst_qsgparticlesystem::simulate(int workerThreads)
+{
+    QDeclarativeEngine engine;
+    QDeclarativeComponent component(&engine, QUrl::fromLocalFile(SRCDIR "/data/determinism.qml"));
+    qsrand(42);
+    QObject *system = component.create();
+    if (!system) {
+        qWarning() << component.errors();
+        return QString();
+    }
+    system->setProperty("workerThreads", workerThreads);
+
+    QAbstractAnimation *animation = system->findChild<QAbstractAnimation *>();
+    if (!animation) {
+        delete system;
+        return QString();
+    }
+    animation->stop();
+
+    int time = 0;
+    for (; time < 1200; time += 16)
+        animation->setCurrentTime(time);
+
+    QObject *probe = system->findChild<QObject *>("probe");
+    if (probe)
+        probe->setProperty("active", true);
+    animation->setCurrentTime(time);
+
+    QString log = system->property("log").toString();
+    delete system;
+    return log;
+}
+
+void tst_qsgparticlesystem::determinism_data()
+{
+    QTest::addColumn<int>("workerThreads");
+
+    QTest::newRow("1") << 1;
+    QTest::newRow("2") << 2;
+    QTest::newRow("4") << 4;
+}
+
+// Threaded simulation must give exactly the same particles for the same seed
+void tst_qsgparticlesystem::determinism()
+{
+    QFETCH(int, workerThreads);
+
+    QString reference = simulate(0);
+    QVERIFY(!reference.isEmpty());
+    QCOMPARE(simulate(0), reference);
+    QCOMPARE(simulate(workerThreads), reference);
+}
+
+QTEST_MAIN(tst_qsgparticlesystem)
+
+#include "tst_qsgparticlesystem.moc"
@@ -116,6 +116,7 @@ private slots:
     void treeModel();
     void changePreferredHighlight();
     void missingPercent();
+    void reuseItems();
 
 private:
     QSGView *createView();
@@ -1141,6 +1142,47 @@ void tst_QSGPathView::missingPercent()
     delete obj;
 }
 
+// Delegates that go into the pool are no longer on the path
+void tst_QSGPathView::reuseItems()
+{
+    QSGView *canvas = createView();
+    canvas->show();
+
+    TestModel model;
+    model.addItem("Ben", "12345");
+    model.addItem("Bohn", "2345");
+    model.addItem("Bob", "54321");
+    model.addItem("Bill", "4321");
+    model.addItem("Jinny", "679");
+    model.addItem("Milly", "73378");
+
+    QDeclarativeContext *ctxt = canvas->rootContext();
+    ctxt->setContextProperty("testModel", &model);
+
+    canvas->setSource(QUrl::fromLocalFile(SRCDIR "/data/pathview0.qml"));
+    qApp->processEvents();
+
+    QSGPathView *pathview = findItem<QSGPathView>(canvas->rootObject(), "view");
+    QVERIFY(pathview != 0);
+    pathview->setReuseItems(true);
+    QCOMPARE(findItems<QSGItem>(pathview, "wrapper").count(), 6);
+
+    pathview->setHighlightRangeMode(QSGPathView::NoHighlightRange);
+    pathview->setPathItemCount(2);
+
+    int pooled = 0;
+    foreach (QSGItem *item, findItems<QSGItem>(pathview, "wrapper")) {
+        if (item->isVisible()) {
+            QCOMPARE(item->property("onPath"), QVariant(true));
+        } else {
+            QCOMPARE(item->property("onPath"), QVariant(false));
+            ++pooled;
+        }
+    }
+    QVERIFY(pooled > 0);
+
+    delete canvas;
+}
 
 QTEST_MAIN(tst_QSGPathView)
 
@@ -0,0 +1,16 @@
+import QtQuick 2.0
+
+Column {
+    property alias count: repeater.model
+
+    Repeater {
+        id: repeater
+        model: 3
+        Rectangle {
+            objectName: "item" + index
+            color: "red"
+            width: 10 + index
+            height: 10
+        }
+    }
+}
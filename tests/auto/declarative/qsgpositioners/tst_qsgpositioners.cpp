@@ -91,6 +91,7 @@ private slots:
     void test_conflictinganchors();
     void test_mirroring();
     void test_allInvisible();
+    void test_batchedPositioning();
 private:
     QSGView *createView(const QString &filename);
 };
@@ -1345,6 +1346,55 @@ void tst_qsgpositioners::test_allInvisible()
     QVERIFY(column->height() == 0);
 }
 
+void tst_qsgpositioners::test_batchedPositioning()
+{
+    QSGView *canvas = createView(SRCDIR "/data/batchedpositioning.qml");
+
+    QSGColumn *column = qobject_cast<QSGColumn*>(canvas->rootObject());
+    QVERIFY(column);
+    QCOMPARE(column->height(), 30.0);
+    QCOMPARE(column->width(), 12.0);
+
+    // Items added together are positioned in one pass once control returns to the event loop
+    column->setProperty("count", 100);
+    QSGItem *last = column->findChild<QSGItem*>("item99");
+    QVERIFY(last);
+    QCOMPARE(last->y(), 0.0);
+    QTRY_COMPARE(last->y(), 990.0);
+    QCOMPARE(column->height(), 1000.0);
+    QCOMPARE(column->width(), 109.0);
+
+    QSGItem *item49 = column->findChild<QSGItem*>("item49");
+    QSGItem *item50 = column->findChild<QSGItem*>("item50");
+    QSGItem *item51 = column->findChild<QSGItem*>("item51");
+    QVERIFY(item49 && item50 && item51);
+    QCOMPARE(item51->y(), 510.0);
+
+    // Resizing an item moves the items after it
+    item50->setHeight(20);
+    QCOMPARE(item51->y(), 510.0);
+    QTRY_COMPARE(item51->y(), 520.0);
+    QCOMPARE(item49->y(), 490.0);
+    QCOMPARE(item50->y(), 500.0);
+    QCOMPARE(last->y(), 1000.0);
+    QCOMPARE(column->height(), 1010.0);
+
+    // Several changes are applied together
+    item49->setWidth(200);
+    item50->setVisible(false);
+    last->setHeight(30);
+    QTRY_COMPARE(item51->y(), 500.0);
+    QCOMPARE(last->y(), 980.0);
+    QCOMPARE(column->height(), 1010.0);
+    QCOMPARE(column->width(), 200.0);
+
+    // Shrinking the widest item shrinks the column
+    item49->setWidth(10);
+    QTRY_COMPARE(column->width(), 109.0);
+
+    delete canvas;
+}
+
 QSGView *tst_qsgpositioners::createView(const QString &filename)
 {
     QSGView *canvas = new QSGView(0);
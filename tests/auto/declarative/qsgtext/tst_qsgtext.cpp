@@ -44,6 +44,7 @@
 #include <QtDeclarative/qdeclarativecomponent.h>
 #include <private/qsgtext_p.h>
 #include <private/qsgtext_p_p.h>
+#include <private/qsgtextlayoutcache_p.h>
 #include <private/qdeclarativevaluetype_p.h>
 #include <QFontMetrics>
 #include <QGraphicsSceneMouseEvent>
@@ -111,6 +112,9 @@ private slots:
     void implicitSize();
 
     void qtbug_14734();
+
+    void sharedLayout();
+    void asynchronous();
 private:
     QStringList standard;
     QStringList richText;
@@ -566,19 +570,19 @@ void tst_qsgtext::horizontalAlignment_RightToLeft()
     // implicit alignment should follow the reading direction of RTL text
     QCOMPARE(text->hAlign(), QSGText::AlignRight);
     QCOMPARE(text->effectiveHAlign(), text->hAlign());
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() > canvas->width()/2);
+    QVERIFY(textPrivate->layout->layout.lineAt(0).naturalTextRect().left() > canvas->width()/2);
 
     // explicitly left aligned text
     text->setHAlign(QSGText::AlignLeft);
     QCOMPARE(text->hAlign(), QSGText::AlignLeft);
     QCOMPARE(text->effectiveHAlign(), text->hAlign());
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() < canvas->width()/2);
+    QVERIFY(textPrivate->layout->layout.lineAt(0).naturalTextRect().left() < canvas->width()/2);
 
     // explicitly right aligned text
     text->setHAlign(QSGText::AlignRight);
     QCOMPARE(text->hAlign(), QSGText::AlignRight);
     QCOMPARE(text->effectiveHAlign(), text->hAlign());
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() > canvas->width()/2);
+    QVERIFY(textPrivate->layout->layout.lineAt(0).naturalTextRect().left() > canvas->width()/2);
 
     // change to rich text
     QString textString = text->text();
@@ -610,13 +614,13 @@ void tst_qsgtext::horizontalAlignment_RightToLeft()
     text->setHAlign(QSGText::AlignHCenter);
     QCOMPARE(text->hAlign(), QSGText::AlignHCenter);
     QCOMPARE(text->effectiveHAlign(), text->hAlign());
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() < canvas->width()/2);
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().right() > canvas->width()/2);
+    QVERIFY(textPrivate->layout->layout.lineAt(0).naturalTextRect().left() < canvas->width()/2);
+    QVERIFY(textPrivate->layout->layout.lineAt(0).naturalTextRect().right() > canvas->width()/2);
 
     // reseted alignment should go back to following the text reading direction
     text->resetHAlign();
     QCOMPARE(text->hAlign(), QSGText::AlignRight);
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() > canvas->width()/2);
+    QVERIFY(textPrivate->layout->layout.lineAt(0).naturalTextRect().left() > canvas->width()/2);
 
     // mirror the text item
     QSGItemPrivate::get(text)->setLayoutMirror(true);
@@ -624,19 +628,19 @@ void tst_qsgtext::horizontalAlignment_RightToLeft()
     // mirrored implicit alignment should continue to follow the reading direction of the text
     QCOMPARE(text->hAlign(), QSGText::AlignRight);
     QCOMPARE(text->effectiveHAlign(), QSGText::AlignRight);
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() > canvas->width()/2);
+    QVERIFY(textPrivate->layout->layout.lineAt(0).naturalTextRect().left() > canvas->width()/2);
 
     // mirrored explicitly right aligned behaves as left aligned
     text->setHAlign(QSGText::AlignRight);
     QCOMPARE(text->hAlign(), QSGText::AlignRight);
     QCOMPARE(text->effectiveHAlign(), QSGText::AlignLeft);
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() < canvas->width()/2);
+    QVERIFY(textPrivate->layout->layout.lineAt(0).naturalTextRect().left() < canvas->width()/2);
 
     // mirrored explicitly left aligned behaves as right aligned
     text->setHAlign(QSGText::AlignLeft);
     QCOMPARE(text->hAlign(), QSGText::AlignLeft);
     QCOMPARE(text->effectiveHAlign(), QSGText::AlignRight);
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() > canvas->width()/2);
+    QVERIFY(textPrivate->layout->layout.lineAt(0).naturalTextRect().left() > canvas->width()/2);
 
     // disable mirroring
     QSGItemPrivate::get(text)->setLayoutMirror(false);
@@ -645,7 +649,7 @@ void tst_qsgtext::horizontalAlignment_RightToLeft()
     // English text should be implicitly left aligned
     text->setText("Hello world!");
     QCOMPARE(text->hAlign(), QSGText::AlignLeft);
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() < canvas->width()/2);
+    QVERIFY(textPrivate->layout->layout.lineAt(0).naturalTextRect().left() < canvas->width()/2);
 
 #ifndef Q_OS_MAC    // QTBUG-18040
     // empty text with implicit alignment follows the system locale-based
@@ -1387,6 +1391,111 @@ void tst_qsgtext::qtbug_14734()
     delete canvas;
 }
 
+void tst_qsgtext::sharedLayout()
+{
+    QString componentStr = "import QtQuick 2.0\n"
+                           "Item {\n"
+                           "    Text { objectName: \"a\"; text: \"Shared label\"; width: 50; wrapMode: Text.WordWrap }\n"
+                           "    Text { objectName: \"b\"; text: \"Shared label\"; width: 50; wrapMode: Text.WordWrap }\n"
+                           "    Text { objectName: \"c\"; text: \"Shared label\"; width: 100; wrapMode: Text.WordWrap }\n"
+                           "}\n";
+    QDeclarativeComponent component(&engine);
+    component.setData(componentStr.toLatin1(), QUrl::fromLocalFile(""));
+
+    QSGTextLayoutCache::resetCacheStatistics();
+    QObject *root = component.create();
+    QVERIFY(root);
+
+    QSGText *a = root->findChild<QSGText *>("a");
+    QSGText *b = root->findChild<QSGText *>("b");
+    QSGText *c = root->findChild<QSGText *>("c");
+    QVERIFY(a && b && c);
+
+    QCOMPARE(QSGTextPrivate::get(a)->layout, QSGTextPrivate::get(b)->layout);
+    QVERIFY(QSGTextPrivate::get(a)->layout != QSGTextPrivate::get(c)->layout);
+    QCOMPARE(a->lineCount(), b->lineCount());
+    QCOMPARE(a->paintedHeight(), b->paintedHeight());
+    QVERIFY(QSGTextLayoutCache::cacheStatistics().hits > 0);
+
+    // Changing one item does not affect the others
+    c->setWidth(50);
+    QCOMPARE(QSGTextPrivate::get(a)->layout, QSGTextPrivate::get(c)->layout);
+    a->setText("Another label");
+    QCOMPARE(b->text(), QString("Shared label"));
+    QCOMPARE(QSGTextPrivate::get(b)->layout->layout.text(), QString("Shared label"));
+
+    // With caching disabled each item has its own layout
+    int limit = QSGTextLayoutCache::cacheLimit();
+    QSGTextLayoutCache::setCacheLimit(0);
+    b->setText("Another label");
+    QVERIFY(QSGTextPrivate::get(a)->layout != QSGTextPrivate::get(b)->layout);
+    QCOMPARE(a->paintedWidth(), b->paintedWidth());
+
+    // Layouts are costed by the length of their text
+    QSGTextLayoutCache::setCacheLimit(limit);
+    QSGTextLayoutCache::CacheStatistics statistics = QSGTextLayoutCache::cacheStatistics();
+    QVERIFY(statistics.cost >= statistics.count);
+    QSGTextLayoutCache::setCacheLimit(QString("Longer label").length() - 1);
+    a->setText("Longer label");
+    b->setText("Longer label");
+    QVERIFY(QSGTextPrivate::get(a)->layout != QSGTextPrivate::get(b)->layout);
+    QSGTextLayoutCache::setCacheLimit(limit);
+
+    delete root;
+}
+
+void tst_qsgtext::asynchronous()
+{
+    QString componentStr = "import QtQuick 2.0\n"
+                           "Item {\n"
+                           "    Text { objectName: \"async\"; asynchronous: true; text: \"Laid out in a thread\"; width: 50; wrapMode: Text.WordWrap }\n"
+                           "    Text { objectName: \"sync\"; text: \"Laid out in a thread\"; width: 50; wrapMode: Text.WordWrap }\n"
+                           "}\n";
+    QDeclarativeComponent component(&engine);
+    component.setData(componentStr.toLatin1(), QUrl::fromLocalFile(""));
+    QObject *root = component.create();
+    QVERIFY(root);
+
+    QSGText *async = root->findChild<QSGText *>("async");
+    QSGText *sync = root->findChild<QSGText *>("sync");
+    QVERIFY(async && sync);
+    QCOMPARE(async->asynchronous(), true);
+    QCOMPARE(sync->asynchronous(), false);
+
+    // The text is sized once the layout thread has laid it out
+    QVERIFY(!QSGTextPrivate::get(async)->layout);
+    QTRY_VERIFY(QSGTextPrivate::get(async)->layout);
+    QCOMPARE(async->paintedWidth(), sync->paintedWidth());
+
+    // The glyph runs of the layout thread are drawn as they are
+    QVERIFY(QSGTextPrivate::get(async)->layout->thread != QThread::currentThread());
+    QVERIFY(QSGTextPrivate::get(async)->layout->glyphRunsValid);
+    QVERIFY(!QSGTextPrivate::get(async)->layoutThread);
+    QCOMPARE(async->paintedHeight(), sync->paintedHeight());
+    QCOMPARE(async->lineCount(), sync->lineCount());
+    QVERIFY(async->lineCount() > 1);
+
+    // Until then it keeps the size of the previous text
+    qreal paintedHeight = async->paintedHeight();
+    async->setText("Short");
+    sync->setText("Short");
+    QCOMPARE(async->paintedHeight(), paintedHeight);
+    QTRY_COMPARE(async->paintedHeight(), sync->paintedHeight());
+    QCOMPARE(async->lineCount(), 1);
+
+    // Only the latest of several changes is applied
+    async->setText("First");
+    async->setText("Laid out in a thread");
+    sync->setText("Laid out in a thread");
+    QTRY_COMPARE(QSGTextPrivate::get(async)->layoutKey.text, QString("Laid out in a thread"));
+    QCOMPARE(async->lineCount(), sync->lineCount());
+
+    // Deleting an item with a pending layout is safe
+    async->setText("Deleted before it is laid out");
+    delete root;
+    QTest::qWait(50);
+}
+
 QTEST_MAIN(tst_qsgtext)
 
 #include "tst_qsgtext.moc"
@@ -0,0 +1,22 @@
+import QtQuick 2.0
+
+VisualDataModel {
+    id: visualModel
+
+    property int createdCount: 0
+    property int reusedCount: 0
+
+    reuseItems: true
+    model: ListModel {
+        ListElement { name: "Item 1" }
+        ListElement { name: "Item 2" }
+        ListElement { name: "Item 3" }
+        ListElement { name: "Item 4" }
+    }
+    delegate: Text {
+        objectName: "name"
+        text: name + " " + index
+        Component.onCompleted: visualModel.createdCount++
+        Connections { target: model; onReused: visualModel.reusedCount++ }
+    }
+}
@@ -125,6 +125,7 @@ private slots:
     void singleRole();
     void modelProperties();
     void noDelegate();
+    void reuseItems();
 
 private:
     QDeclarativeEngine engine;
@@ -537,6 +538,36 @@ void tst_qsgvisualdatamodel::noDelegate()
     QCOMPARE(vdm->count(), 0);
 }
 
+void tst_qsgvisualdatamodel::reuseItems()
+{
+    QDeclarativeEngine engine;
+    QDeclarativeComponent c(&engine, QUrl::fromLocalFile(SRCDIR "/data/reuseitems.qml"));
+    QSGVisualDataModel *vdm = qobject_cast<QSGVisualDataModel*>(c.create());
+    QVERIFY(vdm != 0);
+    QVERIFY(vdm->reuseItems());
+
+    QSGText *item = qobject_cast<QSGText*>(vdm->item(0));
+    QVERIFY(item != 0);
+    QCOMPARE(item->text(), QString("Item 1 0"));
+    QCOMPARE(vdm->property("createdCount").toInt(), 1);
+
+    QCOMPARE(vdm->release(item), QSGVisualModel::ReleaseFlags(QSGVisualModel::Pooled));
+    QVERIFY(!item->isVisible());
+
+    // The released item is rebound to the new index rather than a new one being created
+    QCOMPARE(qobject_cast<QSGText*>(vdm->item(2)), item);
+    QCOMPARE(item->text(), QString("Item 3 2"));
+    QVERIFY(item->isVisible());
+    QCOMPARE(vdm->property("createdCount").toInt(), 1);
+    QCOMPARE(vdm->property("reusedCount").toInt(), 1);
+
+    // Items are destroyed as before once reuse is disabled
+    vdm->setReuseItems(false);
+    QCOMPARE(vdm->release(item), QSGVisualModel::ReleaseFlags(QSGVisualModel::Destroyed));
+
+    delete vdm;
+}
+
 
 template<typename T>
 T *tst_qsgvisualdatamodel::findItem(QSGItem *parent, const QString &objectName, int index)
@@ -1,7 +1,7 @@
 load(qttest_p4)
 TEMPLATE = app
 TARGET = tst_binding
-QT += declarative
+QT += declarative declarative-private
 macx:CONFIG -= app_bundle
 
 SOURCES += tst_binding.cpp testtypes.cpp
@@ -45,6 +45,12 @@
 #include <QDeclarativeComponent>
 #include <QFile>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <private/qdeclarativecomponent_p.h>
+#include <private/qdeclarativecompiler_p.h>
+#include <private/qdeclarativev4compiler_p.h>
+#include <private/qdeclarativev4program_p.h>
+#include <private/qdeclarativeengine_p.h>
 #include "testtypes.h"
 
 //TESTED_FILES=
@@ -73,6 +79,12 @@ private slots:
     void basicproperty();
     void creation_data();
     void creation();
+    void v4program_data();
+    void v4program();
+    void graph_data();
+    void graph();
+    void reevaluate_data();
+    void reevaluate();
 
 private:
     QDeclarativeEngine engine;
@@ -191,5 +203,191 @@ void tst_binding::creation()
     }
 }
 
+void tst_binding::v4program_data()
+{
+    QTest::addColumn<QString>("file");
+    QTest::addColumn<QString>("binding");
+    QTest::addColumn<bool>("optimize");
+
+    QStringList bindings;
+    bindings << "value * 2 + 10 * 3"
+             << "(value + 4 * 4) % 3"
+             << "value > 10 + 2 ? value - 1 : value + 1"
+             << "Math.max(value, 4 * 4) + Math.min(value, 2 - 3)"
+             << "value > 100 * 100 ? Math.floor(value / 2) : value * (1 + 1)";
+
+    foreach (const QString &binding, bindings) {
+        QTest::newRow(qPrintable(binding)) << SRCDIR "/data/localproperty.txt" << binding << false;
+        QTest::newRow(qPrintable(binding + " (optimized)")) << SRCDIR "/data/localproperty.txt" << binding << true;
+    }
+
+    foreach (QString binding, bindings) {
+        binding.replace("value", "myObject.value");
+        QTest::newRow(qPrintable(binding)) << SRCDIR "/data/idproperty.txt" << binding << false;
+        QTest::newRow(qPrintable(binding + " (optimized)")) << SRCDIR "/data/idproperty.txt" << binding << true;
+    }
+}
+
+// Compares the V4 programs built with and without the IR optimizer
+void tst_binding::v4program()
+{
+    QFETCH(QString, file);
+    QFETCH(QString, binding);
+    QFETCH(bool, optimize);
+
+    QDeclarativeV4Compiler::enableIROptimizer(optimize);
+    COMPONENT(file, binding);
+    QDeclarativeV4Compiler::enableIROptimizer(true);
+
+    QDeclarativeCompiledData *cc = QDeclarativeComponentPrivate::get(&c)->cc;
+    QVERIFY(cc != 0);
+    const int programIndex = cc->instruction(0)->init.compiledBinding;
+    QVERIFY2(programIndex != -1, "binding was not compiled to V4");
+    const QDeclarativeV4Program *program =
+        reinterpret_cast<const QDeclarativeV4Program *>(cc->datas.at(programIndex).constData());
+    qDebug() << "bytecode size:" << program->instructionCount;
+
+    MyQmlObject *object = qobject_cast<MyQmlObject *>(c.create());
+    QVERIFY(object != 0);
+    object->setValue(10);
+
+    int value = 0;
+    QBENCHMARK {
+        object->setValue(++value & 0xff);
+    }
+
+    delete object;
+}
+
+void tst_binding::graph_data()
+{
+    QTest::addColumn<bool>("chain");
+    QTest::addColumn<int>("sources");
+    QTest::addColumn<int>("middles");
+    QTest::addColumn<bool>("deferred");
+
+    QTest::newRow("diamond") << false << 5 << 2 << false;
+    QTest::newRow("diamond, deferred") << false << 5 << 2 << true;
+    QTest::newRow("fan-in") << false << 5 << 20 << false;
+    QTest::newRow("fan-in, deferred") << false << 5 << 20 << true;
+    QTest::newRow("fan-out") << false << 1 << 50 << false;
+    QTest::newRow("fan-out, deferred") << false << 1 << 50 << true;
+    QTest::newRow("uneven chain") << true << 1 << 10 << false;
+    QTest::newRow("uneven chain, deferred") << true << 1 << 10 << true;
+}
+
+// Every middle binding depends on every source, and the result on every middle.  For
+// chains each middle depends on the previous one, and the result on the first source 
+// and the last middle.  Each update changes all sources, as a model update would.
+void tst_binding::graph()
+{
+    QFETCH(bool, chain);
+    QFETCH(int, sources);
+    QFETCH(int, middles);
+    QFETCH(bool, deferred);
+
+    QString qml = QLatin1String("import Qt.test 1.0\nMyQmlObject {\n");
+    QStringList sourceNames;
+    for (int ii = 0; ii < sources; ++ii) {
+        sourceNames << QString(QLatin1String("p%1")).arg(ii);
+        qml += QString(QLatin1String("    property int p%1\n")).arg(ii);
+    }
+    QStringList middleNames;
+    for (int ii = 0; ii < middles; ++ii) {
+        middleNames << QString(QLatin1String("m%1")).arg(ii);
+        QString binding;
+        if (!chain)
+            binding = sourceNames.join(QLatin1String(" + "));
+        else if (ii == 0)
+            binding = QLatin1String("p0");
+        else
+            binding = QString(QLatin1String("m%1 + 1")).arg(ii - 1);
+        qml += QString(QLatin1String("    property int m%1: %2\n")).arg(ii).arg(binding);
+    }
+    if (chain)
+        qml += QString(QLatin1String("    result: p0 + m%1\n")).arg(middles - 1);
+    else
+        qml += QString(QLatin1String("    result: %1\n")).arg(middleNames.join(QLatin1String(" + ")));
+    qml += QLatin1String("}\n");
+
+    QDeclarativeEnginePrivate *ep = QDeclarativeEnginePrivate::get(&engine);
+    ep->setDeferredBindingUpdates(deferred);
+
+    QDeclarativeComponent c(&engine);
+    c.setData(qml.toUtf8(), QUrl());
+    MyQmlObject *object = qobject_cast<MyQmlObject *>(c.create());
+    QVERIFY2(object != 0, qPrintable(c.errorString()));
+
+    QDeclarativeEnginePrivate::BindingCounters start = ep->bindingCounters;
+    int value = 0;
+    int updates = 0;
+    QBENCHMARK {
+        ++value;
+        for (int ii = 0; ii < sources; ++ii)
+            object->setProperty(sourceNames.at(ii).toLatin1().constData(), value);
+        // The end of the event
+        ep->flushDirtyBindings();
+        ++updates;
+    }
+
+    int expected = chain ? 2 * value + middles - 1 : middles * sources * value;
+    QCOMPARE(object->result(), expected);
+
+    quint64 notifications = ep->bindingCounters.notifications - start.notifications;
+    quint64 evaluations = ep->bindingCounters.evaluations - start.evaluations;
+    qDebug("%.1f binding evaluations per update, %.1f saved", double(evaluations) / updates,
+           double(notifications - evaluations) / updates);
+
+    delete object;
+    ep->setDeferredBindingUpdates(false);
+}
+
+void tst_binding::reevaluate_data()
+{
+    QTest::addColumn<int>("dependencies");
+
+    QTest::newRow("1 dependency") << 1;
+    QTest::newRow("4 dependencies") << 4;
+    QTest::newRow("16 dependencies") << 16;
+}
+
+// Re-evaluates a binding that depends on the same properties every time.  The function 
+// call keeps it from being compiled to V4, so it goes through the dependency capture.
+void tst_binding::reevaluate()
+{
+    QFETCH(int, dependencies);
+
+    QString qml = QLatin1String("import Qt.test 1.0\nMyQmlObject {\n"
+                                "    function f(x) { return x }\n");
+    QString sum = QLatin1String("value");
+    for (int ii = 1; ii < dependencies; ++ii) {
+        qml += QString(QLatin1String("    property int p%1: %1\n")).arg(ii);
+        sum += QString(QLatin1String(" + p%1")).arg(ii);
+    }
+    qml += QString(QLatin1String("    result: f(%1)\n}\n")).arg(sum);
+
+    QDeclarativeComponent c(&engine);
+    c.setData(qml.toUtf8(), QUrl());
+    MyQmlObject *object = qobject_cast<MyQmlObject *>(c.create());
+    QVERIFY2(object != 0, qPrintable(c.errorString()));
+
+    static const int evaluations = 1000000;
+    qint64 elapsed = 0;
+    int runs = 0;
+    QBENCHMARK {
+        QElapsedTimer timer;
+        timer.start();
+        for (int ii = 0; ii < evaluations; ++ii)
+            object->setValue(ii);
+        elapsed += timer.nsecsElapsed();
+        ++runs;
+    }
+    qDebug("%.1f ns/evaluation", double(elapsed) / runs / evaluations);
+
+    QCOMPARE(object->result(), evaluations - 1 + dependencies * (dependencies - 1) / 2);
+
+    delete object;
+}
+
 QTEST_MAIN(tst_binding)
 #include "tst_binding.moc"
@@ -48,7 +48,10 @@
 #include <QtDeclarative/private/qdeclarativejsparser_p.h>
 #include <QtDeclarative/private/qdeclarativejslexer_p.h>
 #include <QtDeclarative/private/qdeclarativescriptparser_p.h>
+#include <QtDeclarative/private/qdeclarativeengine_p.h>
+#include <QtDeclarative/private/qdeclarativetypeloader_p.h>
 
+#include <QDir>
 #include <QFile>
 #include <QDebug>
 #include <QTextStream>
@@ -67,6 +70,9 @@ public:
 private slots:
     void boomblock();
 
+    void diskcache_data();
+    void diskcache();
+
     void jsparser_data();
     void jsparser();
 
@@ -105,6 +111,49 @@ void tst_compilation::boomblock()
     }
 }
 
+void tst_compilation::diskcache_data()
+{
+    QTest::addColumn<QString>("mode");
+
+    QTest::newRow("cold") << QString("cold");
+    QTest::newRow("warm") << QString("warm");
+    QTest::newRow("cached") << QString("cached");
+}
+
+// cold:   every iteration parses and compiles the file
+// warm:   every iteration reuses the engine's in memory component cache
+// cached: every iteration restores the compiled data from the disk cache
+void tst_compilation::diskcache()
+{
+    QFETCH(QString, mode);
+
+    QDir cacheDir(QDir::tempPath() + QLatin1String("/tst_compilation_cache"));
+    QUrl url = TEST_FILE("BoomBlock.qml");
+
+    QDeclarativeEngine engine;
+    QDeclarativeTypeLoader &typeLoader = QDeclarativeEnginePrivate::get(&engine)->typeLoader;
+    typeLoader.setDiskCacheEnabled(mode == QLatin1String("cached"));
+    typeLoader.setDiskCachePath(cacheDir.absolutePath());
+
+    // Populate the disk cache, and get rid of initialization effects
+    {
+        QDeclarativeComponent c(&engine, url);
+        QVERIFY(c.isReady());
+    }
+
+    if (mode != QLatin1String("warm"))
+        engine.clearComponentCache();
+
+    QBENCHMARK {
+        QDeclarativeComponent c(&engine, url);
+        if (mode != QLatin1String("warm"))
+            engine.clearComponentCache();
+    }
+
+    foreach (const QString &file, cacheDir.entryList(QDir::Files))
+        cacheDir.remove(file);
+}
+
 void tst_compilation::jsparser_data()
 {
     QTest::addColumn<QString>("file");
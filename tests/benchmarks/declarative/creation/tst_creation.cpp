@@ -79,6 +79,7 @@ private slots:
     void itemtree_cpp();
     void itemtree_data_cpp();
     void itemtree_qml();
+    void itemtree_delegate_qml();
     void itemtree_scene_cpp();
 
     void elements_data();
@@ -320,6 +321,20 @@ void tst_creation::itemtree_qml()
     }
 }
 
+// Run with QML_DISABLE_SUPER_INSTRUCTIONS=1 to compare against unfused bytecode
+void tst_creation::itemtree_delegate_qml()
+{
+    QDeclarativeComponent component(&engine, TEST_FILE("delegate.qml"));
+    QObject *obj = component.create();
+    QVERIFY(obj != 0);
+    delete obj;
+
+    QBENCHMARK {
+        QObject *obj = component.create();
+        delete obj;
+    }
+}
+
 void tst_creation::itemtree_scene_cpp()
 {
     QGraphicsScene scene;
@@ -9,10 +9,15 @@ SUBDIRS += \
            qdeclarativecomponent \
            qdeclarativeimage \
            qdeclarativemetaproperty \
+           qdeclarativepixmapcache \
+           particles \
            script \
            qmltime \
-           js
+           js \
+           listmodel \
+           sgtext \
+           sgpositioners
 
-contains(QT_CONFIG, opengl): SUBDIRS += painting
+contains(QT_CONFIG, opengl): SUBDIRS += painting sgrenderer sgcanvas sgitemviews
 
 include(../trusted-benchmarks.pri)
@@ -0,0 +1,16 @@
+import Qt.test 1.0
+
+TestObject {
+    id: root
+
+    function runtest() {
+        var r = root;
+
+        for (var ii = 0; ii < 500000; ++ii) {
+            r.overloadedMethod(ii)
+            r.overloadedMethod("Hello world!")
+            r.overloadedMethod(r)
+            r.overloadedMethod(ii, "Hello world!")
+        }
+    }
+}
@@ -43,21 +43,42 @@
 #define TESTTYPES_H
 
 #include <QtCore/qobject.h>
+#include <QtCore/qurl.h>
+#include <QtCore/qvariant.h>
+#include <QtCore/qrect.h>
 
 class TestObject : public QObject 
 {
     Q_OBJECT
     Q_PROPERTY(int intValue READ intValue);
     Q_PROPERTY(QString stringValue READ stringValue);
+    Q_PROPERTY(QUrl urlValue READ urlValue);
+    Q_PROPERTY(QVariant variantValue READ variantValue);
+    Q_PROPERTY(QRectF rectValue READ rectValue);
 
 public:
-    TestObject() : m_string("Hello world!") {}
+    TestObject() : m_string("Hello world!"), m_url("http://qt.nokia.com/") {}
 
     int intValue() const { return 13; }
     QString stringValue() const { return m_string; }
+    QUrl urlValue() const { return m_url; }
+    QVariant variantValue() const { return QVariant(13); }
+    QRectF rectValue() const { return QRectF(0, 0, 100, 100); }
+
+    Q_INVOKABLE int intMethod(int value) { return value; }
+    Q_INVOKABLE qreal realMethod(qreal value) { return value; }
+    Q_INVOKABLE QString stringMethod(const QString &value) { return value; }
+    Q_INVOKABLE QObject *objectMethod(QObject *value) { return value; }
+    Q_INVOKABLE void mixedMethod(int, qreal, bool, const QString &) {}
+
+    Q_INVOKABLE int overloadedMethod(int value) { return value; }
+    Q_INVOKABLE int overloadedMethod(const QString &value) { return value.length(); }
+    Q_INVOKABLE int overloadedMethod(QObject *value) { return value ? 1 : 0; }
+    Q_INVOKABLE int overloadedMethod(int value, const QString &) { return value; }
 
 private:
     QString m_string;
+    QUrl m_url;
 }; 
 
 void registerTypes();
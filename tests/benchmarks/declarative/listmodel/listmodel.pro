@@ -0,0 +1,8 @@
+load(qttest_p4)
+TEMPLATE = app
+TARGET = tst_listmodel
+QT += declarative declarative-private
+macx:CONFIG -= app_bundle
+CONFIG += release
+
+SOURCES += tst_listmodel.cpp
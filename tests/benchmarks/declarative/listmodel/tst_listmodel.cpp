@@ -0,0 +1,265 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QDeclarativeEngine>
+#include <QDeclarativeComponent>
+#include <private/qdeclarativelistmodel_p.h>
+
+#if defined(Q_OS_LINUX) && defined(__GLIBC__)
+#include <malloc.h>
+#define HAVE_MALLINFO
+#endif
+
+class tst_listmodel : public QObject
+{
+    Q_OBJECT
+public:
+    tst_listmodel() {}
+
+private slots:
+    void append_data();
+    void append();
+    void get_data();
+    void get();
+    void setProperty_data();
+    void setProperty();
+    void data_data();
+    void data();
+    void memory_data();
+    void memory();
+
+private:
+    QObject *createModel(bool nested);
+    void fill(QObject *item, int rows, bool bulk = true);
+
+    QDeclarativeEngine engine;
+};
+
+static const int rowCount = 10000;
+
+// A ListModel stays nested once list-type data has been added to it, so adding and
+// clearing such a row selects the nested storage for comparison.
+QObject *tst_listmodel::createModel(bool nested)
+{
+    QDeclarativeComponent component(&engine);
+    component.setData("import QtQuick 2.0\n"
+                      "Item {\n"
+                      "    property variant model: listModel\n"
+                      "    ListModel { id: listModel }\n"
+                      "    function init(nested) {\n"
+                      "        if (nested) { listModel.append({ list: [] }); listModel.clear() }\n"
+                      "    }\n"
+                      "    function row(i) {\n"
+                      "        return { name: 'Item ' + (i % 100), value: i, cost: i * 0.5, active: i % 2 == 0 }\n"
+                      "    }\n"
+                      "    function fill(count, bulk) {\n"
+                      "        if (bulk) {\n"
+                      "            var rows = []\n"
+                      "            for (var i = 0; i < count; ++i) rows.push(row(i))\n"
+                      "            listModel.append(rows)\n"
+                      "        } else {\n"
+                      "            for (var i = 0; i < count; ++i) listModel.append(row(i))\n"
+                      "        }\n"
+                      "    }\n"
+                      "    function clearModel() { listModel.clear() }\n"
+                      "    function readAll() {\n"
+                      "        var sum = 0\n"
+                      "        for (var i = 0; i < listModel.count; ++i) sum += listModel.get(i).value\n"
+                      "        return sum\n"
+                      "    }\n"
+                      "    function writeAll() {\n"
+                      "        for (var i = 0; i < listModel.count; ++i) listModel.setProperty(i, 'value', i + 1)\n"
+                      "    }\n"
+                      "}\n", QUrl());
+    QObject *item = component.create();
+    if (item)
+        QMetaObject::invokeMethod(item, "init", Q_ARG(QVariant, nested));
+    return item;
+}
+
+void tst_listmodel::fill(QObject *item, int rows, bool bulk)
+{
+    QMetaObject::invokeMethod(item, "fill", Q_ARG(QVariant, rows), Q_ARG(QVariant, bulk));
+}
+
+void tst_listmodel::append_data()
+{
+    QTest::addColumn<bool>("nested");
+    QTest::addColumn<bool>("bulk");
+
+    QTest::newRow("flat") << false << false;
+    QTest::newRow("flat, array") << false << true;
+    QTest::newRow("nested") << true << false;
+    QTest::newRow("nested, array") << true << true;
+}
+
+// Time to append rowCount rows from script
+void tst_listmodel::append()
+{
+    QFETCH(bool, nested);
+    QFETCH(bool, bulk);
+
+    QObject *item = createModel(nested);
+    QVERIFY(item);
+
+    QBENCHMARK {
+        fill(item, rowCount, bulk);
+        QMetaObject::invokeMethod(item, "clearModel");
+    }
+
+    delete item;
+}
+
+void tst_listmodel::get_data()
+{
+    QTest::addColumn<bool>("nested");
+
+    QTest::newRow("flat") << false;
+    QTest::newRow("nested") << true;
+}
+
+// Time to read one role of every row through get()
+void tst_listmodel::get()
+{
+    QFETCH(bool, nested);
+
+    QObject *item = createModel(nested);
+    QVERIFY(item);
+    fill(item, rowCount);
+
+    QBENCHMARK {
+        QMetaObject::invokeMethod(item, "readAll");
+    }
+
+    delete item;
+}
+
+void tst_listmodel::setProperty_data()
+{
+    QTest::addColumn<bool>("nested");
+
+    QTest::newRow("flat") << false;
+    QTest::newRow("nested") << true;
+}
+
+// Time to change one role of every row through setProperty()
+void tst_listmodel::setProperty()
+{
+    QFETCH(bool, nested);
+
+    QObject *item = createModel(nested);
+    QVERIFY(item);
+    fill(item, rowCount);
+
+    QBENCHMARK {
+        QMetaObject::invokeMethod(item, "writeAll");
+    }
+
+    delete item;
+}
+
+void tst_listmodel::data_data()
+{
+    QTest::addColumn<bool>("nested");
+
+    QTest::newRow("flat") << false;
+    QTest::newRow("nested") << true;
+}
+
+// Time to read every role of every row the way a view does
+void tst_listmodel::data()
+{
+    QFETCH(bool, nested);
+
+    QObject *item = createModel(nested);
+    QVERIFY(item);
+    fill(item, rowCount);
+
+    QDeclarativeListModel *model = qobject_cast<QDeclarativeListModel *>(item->property("model").value<QObject *>());
+    QVERIFY(model);
+    QList<int> roles = model->roles();
+
+    QBENCHMARK {
+        for (int i = 0; i < model->count(); ++i) {
+            foreach (int role, roles)
+                model->data(i, role);
+        }
+    }
+
+    delete item;
+}
+
+void tst_listmodel::memory_data()
+{
+    QTest::addColumn<bool>("nested");
+
+    QTest::newRow("flat") << false;
+    QTest::newRow("nested") << true;
+}
+
+// Heap used per row by a model with 100000 rows of four roles
+void tst_listmodel::memory()
+{
+#ifdef HAVE_MALLINFO
+    QFETCH(bool, nested);
+    const int rows = 100000;
+
+    QObject *item = createModel(nested);
+    QVERIFY(item);
+    engine.collectGarbage();
+
+    int before = mallinfo().uordblks;
+    fill(item, rows);
+    engine.collectGarbage();
+    int after = mallinfo().uordblks;
+
+    qDebug("%.1f bytes per row", double(after - before) / rows);
+
+    delete item;
+#else
+    QSKIP("Heap usage cannot be measured on this platform", SkipAll);
+#endif
+}
+
+QTEST_MAIN(tst_listmodel)
+
+#include "tst_listmodel.moc"
@@ -0,0 +1,136 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QDeclarativeEngine>
+#include <QDeclarativeComponent>
+#include <QAbstractAnimation>
+#include <QElapsedTimer>
+
+class tst_particles : public QObject
+{
+    Q_OBJECT
+public:
+    tst_particles() {}
+
+private slots:
+    void affectors_data();
+    void affectors();
+
+private:
+    QDeclarativeEngine engine;
+};
+
+static const int particleCount = 100000;
+static const int frameTime = 16;
+
+void tst_particles::affectors_data()
+{
+    QTest::addColumn<QString>("affector");
+    QTest::addColumn<int>("workerThreads");
+
+    const QString all = "Gravity { angle: 90; acceleration: 20 }\n"
+                        "Friction { factor: 0.5 }\n"
+                        "Wander { pace: 100; xVariance: 50; yVariance: 50 }\n"
+                        "PointAttractor { x: 500; y: 500; strength: 100 }";
+
+    QTest::newRow("none") << QString() << 0;
+    QTest::newRow("Gravity") << "Gravity { angle: 90; acceleration: 20 }" << 0;
+    QTest::newRow("Friction") << "Friction { factor: 0.5 }" << 0;
+    QTest::newRow("Wander") << "Wander { pace: 100; xVariance: 50; yVariance: 50 }" << 0;
+    QTest::newRow("PointAttractor") << "PointAttractor { x: 500; y: 500; strength: 100 }" << 0;
+    QTest::newRow("all") << all << 0;
+    QTest::newRow("all, 2 threads") << all << 2;
+    QTest::newRow("all, 4 threads") << all << 4;
+    // A non-empty area forces the per particle path, for comparison
+    QTest::newRow("all, per particle") << "Gravity { width: 1e6; height: 1e6; angle: 90; acceleration: 20 }\n"
+                                          "Friction { width: 1e6; height: 1e6; factor: 0.5 }\n"
+                                          "Wander { width: 1e6; height: 1e6; pace: 100; xVariance: 50; yVariance: 50 }\n"
+                                          "PointAttractor { width: 1e6; height: 1e6; x: 500; y: 500; strength: 100 }" << 0;
+}
+
+// Time per particle for one simulation tick with particleCount live particles
+void tst_particles::affectors()
+{
+    QFETCH(QString, affector);
+    QFETCH(int, workerThreads);
+
+    QString qml = QString::fromLatin1("import QtQuick.Particles 2.0\n"
+                                      "ParticleSystem {\n"
+                                      "    Emitter { emitRate: %1; lifeSpan: 1000; speed: PointDirection { x: 10; y: 10; xVariation: 10; yVariation: 10 } }\n"
+                                      "    %2\n"
+                                      "}\n").arg(particleCount).arg(affector);
+    QDeclarativeComponent component(&engine);
+    component.setData(qml.toUtf8(), QUrl());
+    QObject *system = component.create();
+    QVERIFY2(system, qPrintable(component.errorString()));
+    system->setProperty("workerThreads", workerThreads);
+
+    // The system is driven by an animation; step it by hand instead of through the timer
+    QAbstractAnimation *animation = system->findChild<QAbstractAnimation *>();
+    QVERIFY(animation);
+    animation->stop();
+
+    // Fill the system up before measuring
+    int time = 0;
+    while (time < 1000) {
+        time += frameTime;
+        animation->setCurrentTime(time);
+    }
+
+    qint64 elapsed = 0;
+    int ticks = 0;
+    QBENCHMARK {
+        QElapsedTimer timer;
+        timer.start();
+        time += frameTime;
+        animation->setCurrentTime(time);
+        elapsed += timer.nsecsElapsed();
+        ++ticks;
+    }
+    qDebug("%.2f ns/particle", double(elapsed) / ticks / particleCount);
+
+    delete system;
+}
+
+QTEST_MAIN(tst_particles)
+
+#include "tst_particles.moc"
@@ -0,0 +1,161 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QDeclarativeEngine>
+#include <QEventLoop>
+#include <QImage>
+#include <QDir>
+#include <QTime>
+#include <QThread>
+#include <private/qdeclarativepixmapcache_p.h>
+
+class PixmapCounter : public QObject
+{
+    Q_OBJECT
+public:
+    PixmapCounter(int count) : remaining(count) {}
+
+    QEventLoop loop;
+    int remaining;
+
+public slots:
+    void finished() {
+        if (--remaining == 0)
+            loop.quit();
+    }
+};
+
+class tst_qdeclarativepixmapcache : public QObject
+{
+    Q_OBJECT
+public:
+    tst_qdeclarativepixmapcache() {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void decode_data();
+    void decode();
+
+private:
+    QList<QUrl> files;
+    QString dir;
+};
+
+static const int imageCount = 200;
+
+void tst_qdeclarativepixmapcache::initTestCase()
+{
+    dir = QDir::tempPath() + QLatin1String("/tst_qdeclarativepixmapcache");
+    QDir().mkpath(dir);
+
+    // Noisy images, so that decoding is not trivially cheap
+    qsrand(0);
+    QImage image(256, 256, QImage::Format_RGB32);
+    for (int ii = 0; ii < imageCount; ++ii) {
+        for (int y = 0; y < image.height(); ++y) {
+            QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+            for (int x = 0; x < image.width(); ++x)
+                line[x] = qRgb(x + ii, y, qrand() & 0xff);
+        }
+
+        const QString fileName = dir + QString(QLatin1String("/image%1.%2"))
+                .arg(ii).arg(ii % 2 ? QLatin1String("png") : QLatin1String("jpg"));
+        QVERIFY(image.save(fileName));
+        files.append(QUrl::fromLocalFile(fileName));
+    }
+}
+
+void tst_qdeclarativepixmapcache::cleanupTestCase()
+{
+    foreach (const QUrl &url, files)
+        QFile::remove(url.toLocalFile());
+    QDir().rmdir(dir);
+}
+
+void tst_qdeclarativepixmapcache::decode_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("2 threads") << 2;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("8 threads") << 8;
+    QTest::newRow("ideal") << QThread::idealThreadCount();
+}
+
+// Time until all images, loaded asynchronously, are ready
+void tst_qdeclarativepixmapcache::decode()
+{
+    QFETCH(int, threads);
+
+    QDeclarativePixmap::setDecodeThreadCount(threads);
+    QDeclarativeEngine engine;
+
+    QBENCHMARK {
+        PixmapCounter counter(files.count());
+        QList<QDeclarativePixmap *> pixmaps;
+        foreach (const QUrl &url, files) {
+            QDeclarativePixmap *pixmap = new QDeclarativePixmap;
+            pixmap->load(&engine, url, QDeclarativePixmap::Asynchronous);
+            if (pixmap->isLoading())
+                pixmap->connectFinished(&counter, SLOT(finished()));
+            else
+                counter.finished();
+            pixmaps.append(pixmap);
+        }
+
+        if (counter.remaining)
+            counter.loop.exec();
+
+        foreach (QDeclarativePixmap *pixmap, pixmaps)
+            QVERIFY(pixmap->isReady());
+        qDeleteAll(pixmaps);
+    }
+
+    QDeclarativePixmap::setDecodeThreadCount(0);
+}
+
+QTEST_MAIN(tst_qdeclarativepixmapcache)
+
+#include "tst_qdeclarativepixmapcache.moc"
@@ -0,0 +1,31 @@
+import QtQuick 2.0
+
+Item {
+    width: 640
+    height: 640
+
+    Repeater {
+        model: 64
+        Item {
+            y: index * 10
+            width: 640
+            height: 10
+
+            Repeater {
+                model: 64
+                Rectangle {
+                    x: index * 10
+                    width: 10
+                    height: 10
+                    color: mouseArea.containsMouse ? "red" : "blue"
+
+                    MouseArea {
+                        id: mouseArea
+                        anchors.fill: parent
+                        hoverEnabled: true
+                    }
+                }
+            }
+        }
+    }
+}
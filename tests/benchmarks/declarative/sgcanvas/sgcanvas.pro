@@ -0,0 +1,16 @@
+load(qttest_p4)
+TEMPLATE = app
+TARGET = tst_sgcanvas
+QT += declarative declarative-private opengl
+macx:CONFIG -= app_bundle
+CONFIG += release
+
+SOURCES += tst_sgcanvas.cpp
+
+symbian {
+    importFiles.files = data
+    importFiles.path =
+    DEPLOYMENT += importFiles
+} else {
+    DEFINES += SRCDIR=\\\"$$PWD\\\"
+}
@@ -0,0 +1,94 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QtGui/qapplication.h>
+#include <QtGui/qevent.h>
+#include <QtDeclarative/qsgview.h>
+#include <private/qsgcanvas_p.h>
+
+#ifdef Q_OS_SYMBIAN
+// In Symbian OS test data is located in applications private dir
+#define SRCDIR "."
+#endif
+
+class tst_sgcanvas : public QObject
+{
+    Q_OBJECT
+public:
+    tst_sgcanvas() {}
+
+private slots:
+    void hover_data();
+    void hover();
+};
+
+void tst_sgcanvas::hover_data()
+{
+    QTest::addColumn<bool>("subtreeBounds");
+
+    QTest::newRow("full traversal") << false;
+    QTest::newRow("subtree bounds") << true;
+}
+
+// Cost of delivering a mouse move, and thereby hover events, to a grid of 4096 hover enabled items
+void tst_sgcanvas::hover()
+{
+    QFETCH(bool, subtreeBounds);
+
+    QSGView view;
+    view.setSource(QUrl::fromLocalFile(QLatin1String(SRCDIR "/data/grid.qml")));
+    QVERIFY(view.rootObject());
+    QSGCanvasPrivate::get(&view)->useSubtreeBounds = subtreeBounds;
+
+    int step = 0;
+    QBENCHMARK {
+        // Walk the diagonal so that every move enters a new item
+        QPoint pos(5 + (step % 64) * 10, 5 + (step % 64) * 10);
+        QMouseEvent event(QEvent::MouseMove, pos, Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+        QApplication::sendEvent(&view, &event);
+        ++step;
+    }
+}
+
+QTEST_MAIN(tst_sgcanvas)
+
+#include "tst_sgcanvas.moc"
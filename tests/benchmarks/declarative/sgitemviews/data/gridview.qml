@@ -0,0 +1,17 @@
+import QtQuick 2.0
+
+GridView {
+    id: view
+    width: 480; height: 640
+    cellWidth: 80; cellHeight: 80
+
+    property int createdCount: 0
+
+    model: myModel
+    delegate: Rectangle {
+        width: 76; height: 76
+        color: index % 2 ? "lightsteelblue" : "white"
+        Text { anchors.centerIn: parent; text: display }
+        Component.onCompleted: view.createdCount++
+    }
+}
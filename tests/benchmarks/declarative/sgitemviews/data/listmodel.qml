@@ -0,0 +1,24 @@
+import QtQuick 2.0
+
+ListView {
+    id: view
+    width: 480; height: 640
+
+    property int createdCount: 0
+
+    model: ListModel { id: listModel }
+    delegate: Rectangle {
+        width: view.width; height: 40
+        color: index % 2 ? "lightsteelblue" : "white"
+        Text { x: 10; anchors.verticalCenter: parent.verticalCenter; text: display }
+        Rectangle { x: parent.width - 40; y: 5; width: 30; height: 30; radius: 5; color: "steelblue" }
+        Component.onCompleted: view.createdCount++
+    }
+
+    Component.onCompleted: {
+        var rows = []
+        for (var i = 0; i < 10000; ++i)
+            rows.push({ display: "Item " + i, value: i })
+        listModel.append(rows)
+    }
+}
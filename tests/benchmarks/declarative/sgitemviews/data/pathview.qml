@@ -0,0 +1,21 @@
+import QtQuick 2.0
+
+PathView {
+    id: view
+    width: 480; height: 640
+
+    property int createdCount: 0
+
+    model: myModel
+    pathItemCount: 20
+    path: Path {
+        startX: 0; startY: 320
+        PathLine { x: 480; y: 320 }
+    }
+    delegate: Rectangle {
+        width: 40; height: 40
+        color: index % 2 ? "lightsteelblue" : "white"
+        Text { anchors.centerIn: parent; text: display }
+        Component.onCompleted: view.createdCount++
+    }
+}
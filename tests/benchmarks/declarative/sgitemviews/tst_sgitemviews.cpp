@@ -0,0 +1,190 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QElapsedTimer>
+#include <QStringListModel>
+#include <QtDeclarative/qdeclarativecontext.h>
+#include <QtDeclarative/qsgview.h>
+#include <QtDeclarative/qsgitem.h>
+
+#ifdef Q_OS_SYMBIAN
+// In Symbian OS test data is located in applications private dir
+#define SRCDIR "."
+#endif
+
+class tst_sgitemviews : public QObject
+{
+    Q_OBJECT
+public:
+    tst_sgitemviews();
+
+private slots:
+    void flick_data();
+    void flick();
+    void cacheBuffer_data();
+    void cacheBuffer();
+
+private:
+    QStringListModel model;
+};
+
+tst_sgitemviews::tst_sgitemviews()
+{
+    // Render synchronously in repaint() so that each frame can be timed
+    qputenv("QML_NO_THREADED_RENDERER", "1");
+
+    QStringList items;
+    for (int i = 0; i < 10000; ++i)
+        items << QString::fromLatin1("Item %1").arg(i);
+    model.setStringList(items);
+}
+
+void tst_sgitemviews::flick_data()
+{
+    QTest::addColumn<QString>("file");
+    QTest::addColumn<QByteArray>("property");
+    QTest::addColumn<qreal>("step");
+    QTest::addColumn<bool>("reuseItems");
+
+    QTest::newRow("ListView") << "listview.qml" << QByteArray("contentY") << qreal(13) << false;
+    QTest::newRow("ListView, reuse") << "listview.qml" << QByteArray("contentY") << qreal(13) << true;
+    QTest::newRow("ListView, ListModel") << "listmodel.qml" << QByteArray("contentY") << qreal(13) << false;
+    QTest::newRow("ListView, ListModel, reuse") << "listmodel.qml" << QByteArray("contentY") << qreal(13) << true;
+    QTest::newRow("GridView") << "gridview.qml" << QByteArray("contentY") << qreal(13) << false;
+    QTest::newRow("GridView, reuse") << "gridview.qml" << QByteArray("contentY") << qreal(13) << true;
+    QTest::newRow("PathView") << "pathview.qml" << QByteArray("offset") << qreal(0.3) << false;
+    QTest::newRow("PathView, reuse") << "pathview.qml" << QByteArray("offset") << qreal(0.3) << true;
+}
+
+// Time per frame, and delegates created per frame, while moving a view through a large model
+void tst_sgitemviews::flick()
+{
+    QFETCH(QString, file);
+    QFETCH(QByteArray, property);
+    QFETCH(qreal, step);
+    QFETCH(bool, reuseItems);
+
+    QSGView view;
+    view.rootContext()->setContextProperty("myModel", &model);
+    view.setSource(QUrl::fromLocalFile(QLatin1String(SRCDIR "/data/") + file));
+    QSGItem *root = view.rootObject();
+    QVERIFY(root);
+    root->setProperty("reuseItems", reuseItems);
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+    view.repaint();
+
+    int created = root->property("createdCount").toInt();
+    qint64 elapsed = 0;
+    int frames = 0;
+    qreal position = 0;
+    QBENCHMARK {
+        position += step;
+        if (position > 5000)
+            position = 0;
+        root->setProperty(property.constData(), position);
+
+        QElapsedTimer timer;
+        timer.start();
+        view.repaint();
+        elapsed += timer.nsecsElapsed();
+        ++frames;
+    }
+    created = root->property("createdCount").toInt() - created;
+    qDebug("%.1f us per frame, %.2f delegates created per frame", double(elapsed) / frames / 1000, double(created) / frames);
+}
+
+void tst_sgitemviews::cacheBuffer_data()
+{
+    QTest::addColumn<QString>("file");
+    QTest::addColumn<int>("cacheBuffer");
+
+    QTest::newRow("ListView") << "listview.qml" << 0;
+    QTest::newRow("ListView, cacheBuffer") << "listview.qml" << 1280;
+    QTest::newRow("GridView") << "gridview.qml" << 0;
+    QTest::newRow("GridView, cacheBuffer") << "gridview.qml" << 1280;
+}
+
+// Average and worst frame time while a fast flick exposes a new page every few frames.
+// The time includes moving the view, so delegate creation is part of the measurement.
+void tst_sgitemviews::cacheBuffer()
+{
+    QFETCH(QString, file);
+    QFETCH(int, cacheBuffer);
+
+    QSGView view;
+    view.rootContext()->setContextProperty("myModel", &model);
+    view.setSource(QUrl::fromLocalFile(QLatin1String(SRCDIR "/data/") + file));
+    QSGItem *root = view.rootObject();
+    QVERIFY(root);
+    root->setProperty("cacheBuffer", cacheBuffer);
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+    view.repaint();
+
+    qint64 elapsed = 0;
+    qint64 worst = 0;
+    int frames = 0;
+    qreal position = 0;
+    QBENCHMARK {
+        position += 160;
+        if (position > 20000)
+            position = 0;
+
+        QElapsedTimer timer;
+        timer.start();
+        root->setProperty("contentY", position);
+        QCoreApplication::processEvents();
+        view.repaint();
+        qint64 frame = timer.nsecsElapsed();
+        elapsed += frame;
+        worst = qMax(worst, frame);
+        ++frames;
+    }
+    qDebug("%.1f us per frame, worst frame %.1f us, %d delegates deferred",
+           double(elapsed) / frames / 1000, double(worst) / 1000,
+           root->property("deferredItemCount").toInt());
+}
+
+QTEST_MAIN(tst_sgitemviews)
+
+#include "tst_sgitemviews.moc"
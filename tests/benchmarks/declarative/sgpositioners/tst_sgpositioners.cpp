@@ -0,0 +1,123 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QDeclarativeEngine>
+#include <QDeclarativeComponent>
+#include <QElapsedTimer>
+#include <QtDeclarative/qsgitem.h>
+
+class tst_sgpositioners : public QObject
+{
+    Q_OBJECT
+public:
+    tst_sgpositioners() {}
+
+private slots:
+    void addChildren_data();
+    void addChildren();
+
+private:
+    QDeclarativeEngine engine;
+};
+
+void tst_sgpositioners::addChildren_data()
+{
+    QTest::addColumn<QString>("positioner");
+    QTest::addColumn<int>("count");
+
+    const char *positioners[] = { "Column {}", "Row {}", "Grid { columns: 20 }", "Flow { width: 500 }" };
+    const int counts[] = { 100, 500, 2000 };
+    for (unsigned int ii = 0; ii < sizeof(positioners) / sizeof(positioners[0]); ++ii) {
+        for (unsigned int jj = 0; jj < sizeof(counts) / sizeof(counts[0]); ++jj) {
+            QString name = QString::fromLatin1(positioners[ii]).section(QLatin1Char(' '), 0, 0);
+            QTest::newRow(qPrintable(name + QLatin1String(", ") + QString::number(counts[jj])))
+                    << QString::fromLatin1(positioners[ii]) << counts[jj];
+        }
+    }
+}
+
+// Adds count children to a completed positioner one at a time, as a Repeater filled from a
+// model does, and returns to the event loop once.  Reports the time per child, including
+// positioning them.
+void tst_sgpositioners::addChildren()
+{
+    QFETCH(QString, positioner);
+    QFETCH(int, count);
+
+    QDeclarativeComponent positionerComponent(&engine);
+    positionerComponent.setData(("import QtQuick 2.0\n" + positioner).toUtf8(), QUrl());
+    QSGItem *root = qobject_cast<QSGItem *>(positionerComponent.create());
+    QVERIFY2(root, qPrintable(positionerComponent.errorString()));
+
+    QDeclarativeComponent childComponent(&engine);
+    childComponent.setData("import QtQuick 2.0\nRectangle { width: 10; height: 10 }", QUrl());
+
+    qint64 elapsed = 0;
+    int runs = 0;
+    QBENCHMARK {
+        QList<QSGItem *> children;
+        for (int ii = 0; ii < count; ++ii) {
+            QSGItem *child = qobject_cast<QSGItem *>(childComponent.create());
+            QVERIFY(child);
+            children.append(child);
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int ii = 0; ii < count; ++ii)
+            children.at(ii)->setParentItem(root);
+        QCoreApplication::processEvents();
+        elapsed += timer.nsecsElapsed();
+        ++runs;
+
+        QVERIFY(root->width() > 0 && root->height() > 0);
+        qDeleteAll(children);
+        QCoreApplication::processEvents();
+    }
+    qDebug("%.1f ns/child", double(elapsed) / runs / count);
+
+    delete root;
+}
+
+QTEST_MAIN(tst_sgpositioners)
+
+#include "tst_sgpositioners.moc"
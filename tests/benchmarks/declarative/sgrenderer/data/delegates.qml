@@ -0,0 +1,29 @@
+import QtQuick 2.0
+
+Flickable {
+    width: 320
+    height: 480
+    contentHeight: column.height
+
+    Column {
+        id: column
+        Repeater {
+            model: 500
+            Rectangle {
+                width: 320
+                height: 24
+                color: index % 2 ? "#e0e0e0" : "#f0f0f0"
+                Rectangle {
+                    x: 4; y: 4
+                    width: 16; height: 16
+                    color: "steelblue"
+                }
+                Text {
+                    x: 24
+                    anchors.verticalCenter: parent.verticalCenter
+                    text: "Delegate " + index
+                }
+            }
+        }
+    }
+}
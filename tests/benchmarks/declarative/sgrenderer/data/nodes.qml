@@ -0,0 +1,17 @@
+import QtQuick 2.0
+
+Item {
+    width: 320
+    height: 480
+
+    Repeater {
+        model: 10000
+        Rectangle {
+            x: (index % 100) * 3
+            y: Math.floor(index / 100) * 4
+            width: 2
+            height: 3
+            color: ["red", "green", "blue", "#80ff0000"][index % 4]
+        }
+    }
+}
@@ -0,0 +1,160 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QElapsedTimer>
+#include <QtDeclarative/qdeclarativecomponent.h>
+#include <QtDeclarative/qsgview.h>
+#include <QtDeclarative/qsgitem.h>
+#include <private/qsgcanvas_p.h>
+#include <private/qsgcontext_p.h>
+#include <private/qsgdefaultrenderer_p.h>
+
+#ifdef Q_OS_SYMBIAN
+// In Symbian OS test data is located in applications private dir
+#define SRCDIR "."
+#endif
+
+class tst_sgrenderer : public QObject
+{
+    Q_OBJECT
+public:
+    tst_sgrenderer();
+
+private slots:
+    void scroll_data();
+    void scroll();
+    void addNode_data();
+    void addNode();
+};
+
+tst_sgrenderer::tst_sgrenderer()
+{
+    // Render synchronously in repaint() so the statistics can be read after each frame
+    qputenv("QML_NO_THREADED_RENDERER", "1");
+}
+
+void tst_sgrenderer::scroll_data()
+{
+    QTest::addColumn<bool>("batching");
+
+    QTest::newRow("unbatched") << false;
+    QTest::newRow("batched") << true;
+}
+
+// Time, draw calls and bytes sent to the GL per frame while scrolling a list of delegates
+void tst_sgrenderer::scroll()
+{
+    QFETCH(bool, batching);
+
+    QSGView view;
+    view.setSource(QUrl::fromLocalFile(SRCDIR "/data/delegates.qml"));
+    QSGItem *flickable = view.rootObject();
+    QVERIFY(flickable);
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+
+    QSGDefaultRenderer *renderer = qobject_cast<QSGDefaultRenderer *>(QSGCanvasPrivate::get(&view)->context->renderer());
+    QVERIFY(renderer);
+    renderer->setGeometryBatchingEnabled(batching);
+    view.repaint();
+
+    qint64 drawCalls = 0;
+    qint64 uploadedBytes = 0;
+    int frames = 0;
+    qreal contentY = 0;
+    QBENCHMARK {
+        contentY = contentY > 10000 ? 0 : contentY + 7;
+        flickable->setProperty("contentY", contentY);
+        view.repaint();
+        drawCalls += renderer->statistics().drawCalls;
+        uploadedBytes += renderer->statistics().uploadedBytes;
+        ++frames;
+    }
+    qDebug("%lld draw calls, %lld bytes uploaded per frame", drawCalls / frames, uploadedBytes / frames);
+}
+
+void tst_sgrenderer::addNode_data()
+{
+    QTest::addColumn<QString>("color");
+
+    QTest::newRow("opaque") << "blue";
+    QTest::newRow("transparent") << "#800000ff";
+}
+
+// Time to render a frame of 10000 nodes after one node was added to the scene
+void tst_sgrenderer::addNode()
+{
+    QFETCH(QString, color);
+
+    QSGView view;
+    view.setSource(QUrl::fromLocalFile(SRCDIR "/data/nodes.qml"));
+    QSGItem *root = view.rootObject();
+    QVERIFY(root);
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+    view.repaint();
+
+    QDeclarativeComponent component(view.engine());
+    component.setData(QString::fromLatin1("import QtQuick 2.0\n"
+                                          "Rectangle { width: 2; height: 3; color: \"%1\" }\n").arg(color).toUtf8(), QUrl());
+    QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+
+    qint64 elapsed = 0;
+    int frames = 0;
+    QBENCHMARK {
+        QSGItem *item = qobject_cast<QSGItem *>(component.create());
+        QVERIFY(item);
+        item->setPos(QPointF(frames % 300, frames % 480));
+        item->setParentItem(root);
+
+        QElapsedTimer timer;
+        timer.start();
+        view.repaint();
+        elapsed += timer.nsecsElapsed();
+        ++frames;
+    }
+    qDebug("%.1f us per frame", double(elapsed) / frames / 1000);
+}
+
+QTEST_MAIN(tst_sgrenderer)
+
+#include "tst_sgrenderer.moc"
@@ -0,0 +1,177 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <qtest.h>
+#include <QDeclarativeEngine>
+#include <QDeclarativeComponent>
+#include <QElapsedTimer>
+#include <private/qsgtext_p.h>
+#include <private/qsgtextlayoutcache_p.h>
+
+class tst_sgtext : public QObject
+{
+    Q_OBJECT
+public:
+    tst_sgtext() {}
+
+private slots:
+    void creation_data();
+    void creation();
+    void append_data();
+    void append();
+
+private:
+    QDeclarativeEngine engine;
+};
+
+static const int itemCount = 1000;
+
+void tst_sgtext::creation_data()
+{
+    QTest::addColumn<int>("distinct");
+    QTest::addColumn<bool>("cached");
+
+    QTest::newRow("10 labels") << 10 << true;
+    QTest::newRow("10 labels, uncached") << 10 << false;
+    QTest::newRow("100 labels") << 100 << true;
+    QTest::newRow("100 labels, uncached") << 100 << false;
+    QTest::newRow("unique") << itemCount << true;
+    QTest::newRow("unique, uncached") << itemCount << false;
+}
+
+// Creates itemCount text items showing only distinct different strings, as the
+// delegates of a view showing category labels would
+void tst_sgtext::creation()
+{
+    QFETCH(int, distinct);
+    QFETCH(bool, cached);
+
+    QString qml = QString::fromLatin1("import QtQuick 2.0\n"
+                                      "Item {\n"
+                                      "    Repeater {\n"
+                                      "        model: %1\n"
+                                      "        Text { width: 100; elide: Text.ElideRight; text: \"Category label \" + (index % %2) }\n"
+                                      "    }\n"
+                                      "}\n").arg(itemCount).arg(distinct);
+    QDeclarativeComponent component(&engine);
+    component.setData(qml.toUtf8(), QUrl());
+
+    int limit = QSGTextLayoutCache::cacheLimit();
+    QSGTextLayoutCache::setCacheLimit(cached ? limit : 0);
+    QSGTextLayoutCache::resetCacheStatistics();
+
+    int runs = 0;
+    QBENCHMARK {
+        QObject *root = component.create();
+        QVERIFY2(root, qPrintable(component.errorString()));
+        delete root;
+        ++runs;
+    }
+
+    QSGTextLayoutCache::CacheStatistics statistics = QSGTextLayoutCache::cacheStatistics();
+    qDebug("%.1f layouts per creation, %.1f shared", double(statistics.misses) / runs,
+           double(statistics.hits) / runs);
+
+    QSGTextLayoutCache::setCacheLimit(limit);
+}
+
+static const int paragraphCount = 10000;
+
+void tst_sgtext::append_data()
+{
+    QTest::addColumn<bool>("asynchronous");
+
+    QTest::newRow("synchronous") << false;
+    QTest::newRow("asynchronous") << true;
+}
+
+// Appends paragraphCount wrapped paragraphs at once, as a chat or log view filled from a
+// backlog would.  Reports how long the GUI thread is blocked by the creation, and how long
+// it takes until all paragraphs are sized.
+void tst_sgtext::append()
+{
+    QFETCH(bool, asynchronous);
+
+    QString qml = QString::fromLatin1("import QtQuick 2.0\n"
+                                      "Column {\n"
+                                      "    width: 400\n"
+                                      "    Repeater {\n"
+                                      "        model: %1\n"
+                                      "        Text {\n"
+                                      "            width: 400; wrapMode: Text.WordWrap; asynchronous: %2\n"
+                                      "            text: index + \": Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod \"\n"
+                                      "                + \"tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis \"\n"
+                                      "                + \"nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat.\"\n"
+                                      "        }\n"
+                                      "    }\n"
+                                      "}\n").arg(paragraphCount).arg(asynchronous ? "true" : "false");
+    QDeclarativeComponent component(&engine);
+    component.setData(qml.toUtf8(), QUrl());
+
+    qint64 blocked = 0;
+    qint64 total = 0;
+    int runs = 0;
+    QBENCHMARK {
+        QElapsedTimer timer;
+        timer.start();
+        QObject *root = component.create();
+        QVERIFY2(root, qPrintable(component.errorString()));
+        blocked += timer.elapsed();
+
+        // Text that has not been laid out yet has no painted size
+        QList<QSGText *> paragraphs = root->findChildren<QSGText *>();
+        QCOMPARE(paragraphs.count(), paragraphCount);
+        for (int i = 0; i < paragraphs.count(); ++i) {
+            while (paragraphs.at(i)->paintedHeight() <= 0)
+                QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        }
+        total += timer.elapsed();
+
+        delete root;
+        ++runs;
+    }
+    qDebug("%.1f ms blocked, %.1f ms until sized", double(blocked) / runs, double(total) / runs);
+}
+
+QTEST_MAIN(tst_sgtext)
+
+#include "tst_sgtext.moc"